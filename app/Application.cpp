@@ -4,25 +4,51 @@
 #include "Application.h"
 
 namespace vk_project_one {
-    Application::Application() {
+    Application::Application(const EngineConfig &engineConfig) : config(engineConfig) {
         spdlog::info("Initializing Application...");
-        window = std::make_unique<Window>(1920, 1080, "VkProjectOne v0.1");
-        vulkanEngine = std::make_unique<VulkanEngine>(window->getSdlWindow());
+        config.log();
+        windows.push_back(std::make_unique<Window>(1920, 1080, "VkProjectOne v0.1"));
+        // Further windows mirror the first, cascaded so they do not cover each other completely
+        for (uint32_t i = 1; i < config.windowCount; ++i) {
+            const int offset = 64 * static_cast<int>(i);
+            windows.push_back(std::make_unique<Window>(960, 540, "VkProjectOne v0.1 (" + std::to_string(i + 1) + ")",
+                                                       offset, offset));
+        }
+        createEngine();
         spdlog::info("Application Initialized.");
     }
 
+    void Application::createEngine() {
+        std::vector<SDL_Window *> sdlWindows;
+        for (const auto &window: windows) sdlWindows.push_back(window->getSdlWindow());
+        vulkanEngine = std::make_unique<VulkanEngine>(sdlWindows, config);
+    }
+
+    bool Application::recoverFromDeviceLoss() {
+        if (deviceRecoveries == MAX_DEVICE_RECOVERIES) {
+            spdlog::critical("Device lost {} times, giving up.", deviceRecoveries + 1);
+            return false;
+        }
+        deviceRecoveries++;
+        spdlog::warn("Device lost. Recreating the engine (attempt {} of {}).", deviceRecoveries,
+                     MAX_DEVICE_RECOVERIES);
+        vulkanEngine.reset(); // Every object of the lost device goes before the new one is created
+        createEngine();
+        return true;
+    }
+
     Application::~Application() {
         spdlog::info("Destroying Application...");
         vulkanEngine.reset();
-        window.reset();
+        windows.clear();
         spdlog::info("Application Destroyed.");
     }
 
-    void Application::run() const {
+    void Application::run() {
         mainLoop();
     }
 
-    void Application::mainLoop() const {
+    void Application::mainLoop() {
         bool quit = false;
         SDL_Event e;
         const auto startTime = std::chrono::high_resolution_clock::now();
@@ -32,14 +58,28 @@ namespace vk_project_one {
                 if (e.type == SDL_EVENT_QUIT) { // Use SDL_EVENT_QUIT
                     quit = true;
                 }
+                if (e.type == SDL_EVENT_WINDOW_CLOSE_REQUESTED) { // Closing any window ends the run
+                    quit = true;
+                }
                 if (e.type == SDL_EVENT_KEY_DOWN) { // Use SDL_EVENT_KEY_DOWN
                     if (e.key.scancode == SDL_SCANCODE_ESCAPE) {
                         quit = true;
                     }
+                    // Haze down / up (re-bakes the static atmosphere LUTs)
+                    if (e.key.scancode == SDL_SCANCODE_LEFTBRACKET) {
+                        vulkanEngine->setHaze(vulkanEngine->getHaze() * 0.8f);
+                    }
+                    if (e.key.scancode == SDL_SCANCODE_RIGHTBRACKET) {
+                        vulkanEngine->setHaze(vulkanEngine->getHaze() * 1.25f);
+                    }
+                    if (e.key.scancode == SDL_SCANCODE_M) { // Memory report with every allocation
+                        vulkanEngine->logMemoryReport(true);
+                    }
                 }
                 if (e.type == SDL_EVENT_WINDOW_RESIZED) { // Specific event for resize
                     spdlog::debug("Window resize event detected (SDL_EVENT_WINDOW_RESIZED).");
-                    vulkanEngine->notifyFramebufferResized(); // Signal engine to recreate swapchain
+                    // Signal engine to recreate that window's swapchain
+                    vulkanEngine->notifyFramebufferResized(SDL_GetWindowFromID(e.window.windowID));
                 }
             }
 
@@ -47,12 +87,23 @@ namespace vk_project_one {
             const float time = std::chrono::duration<float>(currentTime - startTime).count();
             vulkanEngine->updateCubeRotation(time); // Update UBO based on time
 
-            try {
-                vulkanEngine->drawFrame();
-            } catch (const VulkanEngine::SwapChainOutOfDateError &ood_err) {
-                spdlog::warn("{}", ood_err.what());
-            } catch (const std::exception &draw_err) {
-                spdlog::error("Error during drawFrame: {}", draw_err.what());
+            // Swapchain and device events come back as a status. Exceptions mean the engine cannot go on and
+            // are left to main(), so the loop itself has no handler to run through every frame.
+            switch (vulkanEngine->drawFrame()) {
+                case VulkanEngine::FrameStatus::Ok:
+                case VulkanEngine::FrameStatus::Recreated:
+                    break;
+                case VulkanEngine::FrameStatus::Skipped:
+                    SDL_WaitEventTimeout(nullptr, 100); // Minimized: sleep until the next event instead of spinning
+                    break;
+                case VulkanEngine::FrameStatus::DeviceLost:
+                    if (!recoverFromDeviceLoss()) quit = true;
+                    break;
+            }
+
+            if (config.benchmarkMode && config.benchmarkFrames > 0 &&
+                vulkanEngine->getFrameCount() >= config.benchmarkFrames) {
+                spdlog::info("Benchmark finished after {} frames.", vulkanEngine->getFrameCount());
                 quit = true;
             }
         }
@@ -4,25 +4,35 @@
 #pragma once
 #include "core/Window.h"
 #include "core/VulkanEngine.h"
+#include "core/EngineConfig.h"
 #include <spdlog/spdlog.h>
 #include <stdexcept>
 #include <chrono>
 
 #include <memory>
+#include <vector>
 
 // Use the new project namespace
 namespace vk_project_one {
 
 class Application {
 public:
-    Application();
+    explicit Application(const EngineConfig &engineConfig = {});
     ~Application();
-    void run() const;
+    void run();
 
 private:
-    std::unique_ptr<Window> window{};
+    // Times a lost device is answered by creating the engine again before the application gives up.
+    static constexpr uint32_t MAX_DEVICE_RECOVERIES = 3;
+
+    EngineConfig config;
+    std::vector<std::unique_ptr<Window>> windows{}; // The first one drives the render resolution
     std::unique_ptr<VulkanEngine> vulkanEngine{};
-    void mainLoop() const;
+    uint32_t deviceRecoveries = 0;
+    void createEngine();
+    // Replaces the engine after VK_ERROR_DEVICE_LOST; false once the retries are used up.
+    bool recoverFromDeviceLoss();
+    void mainLoop();
 };
 
 } // namespace VkGameProjectOne
\ No newline at end of file
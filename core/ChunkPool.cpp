@@ -0,0 +1,109 @@
+// ChunkPool.cpp
+
+#include "core/ChunkPool.h"
+#include <algorithm>
+
+namespace vk_project_one {
+    void ChunkPool::init(uint32_t count, uint32_t vertices, uint32_t indices, uint32_t slotsPerBlock) {
+        slotCount = count;
+        slotVertices = vertices;
+        slotIndices = indices;
+        blockSlots = std::max(slotsPerBlock, 1u);
+        freeSlots.resize(slotCount);
+        for (uint32_t i = 0; i < slotCount; ++i) freeSlots[i] = slotCount - 1 - i;
+        retiredSlots.clear();
+        slotStates.assign(slotCount, SlotState::Free);
+        slotOwners.assign(slotCount, 0);
+        blockUsed.assign((slotCount + blockSlots - 1) / blockSlots, 0);
+        stats = {};
+    }
+
+    uint32_t ChunkPool::allocate(uint32_t owner) {
+        if (freeSlots.empty()) {
+            stats.failedAllocations++;
+            return INVALID_SLOT;
+        }
+        const uint32_t slot = freeSlots.back();
+        freeSlots.pop_back();
+        slotStates[slot] = SlotState::Used;
+        slotOwners[slot] = owner;
+        blockUsed[slot / blockSlots]++;
+        stats.allocations++;
+        stats.peakUsed = std::max(stats.peakUsed, getUsedCount());
+        return slot;
+    }
+
+    void ChunkPool::release(uint32_t slot, uint64_t frame) {
+        slotStates[slot] = SlotState::Retired;
+        retiredSlots.push_back({slot, frame});
+    }
+
+    void ChunkPool::reclaim(uint64_t completedFrame) {
+        size_t count = 0;
+        while (count < retiredSlots.size() && retiredSlots[count].frame <= completedFrame) {
+            const uint32_t slot = retiredSlots[count++].slot;
+            slotStates[slot] = SlotState::Free;
+            blockUsed[slot / blockSlots]--;
+            freeSlots.push_back(slot);
+        }
+        retiredSlots.erase(retiredSlots.begin(), retiredSlots.begin() + static_cast<std::ptrdiff_t>(count));
+    }
+
+    bool ChunkPool::planMove(Move &move) {
+        // Source: the least occupied block with a live slot; ties go to the higher block, so chunks drift
+        // towards the start of the pool. Destination: the fullest block with a free slot; ties go lower.
+        const uint32_t blockCount = getBlockCount();
+        uint32_t source = INVALID_SLOT;
+        uint32_t target = INVALID_SLOT;
+        for (uint32_t block = 0; block < blockCount; ++block) {
+            const uint32_t first = block * blockSlots;
+            const uint32_t last = std::min(first + blockSlots, slotCount);
+            bool live = false;
+            bool free = false;
+            for (uint32_t slot = first; slot < last; ++slot) {
+                live = live || slotStates[slot] == SlotState::Used;
+                free = free || slotStates[slot] == SlotState::Free;
+            }
+            if (live && (source == INVALID_SLOT || blockUsed[block] <= blockUsed[source])) source = block;
+            if (free && (target == INVALID_SLOT || blockUsed[block] > blockUsed[target])) target = block;
+        }
+        // Into an emptier block would only shuffle the holes around
+        if (source == INVALID_SLOT || target == INVALID_SLOT || source == target ||
+            blockUsed[target] < blockUsed[source]) {
+            return false;
+        }
+
+        const uint32_t sourceFirst = source * blockSlots;
+        const uint32_t targetFirst = target * blockSlots;
+        uint32_t from = sourceFirst;
+        while (slotStates[from] != SlotState::Used) from++;
+        uint32_t to = targetFirst;
+        while (slotStates[to] != SlotState::Free) to++;
+
+        freeSlots.erase(std::find(freeSlots.begin(), freeSlots.end(), to));
+        slotStates[to] = SlotState::Used;
+        slotOwners[to] = slotOwners[from];
+        blockUsed[target]++;
+        stats.moves++;
+        move = {slotOwners[from], from, to};
+        return true;
+    }
+
+    uint32_t ChunkPool::getEmptyBlockCount() const {
+        return static_cast<uint32_t>(std::count(blockUsed.begin(), blockUsed.end(), 0u));
+    }
+
+    float ChunkPool::getFragmentation() const {
+        uint32_t occupiedSlots = 0;
+        for (uint32_t block = 0; block < getBlockCount(); ++block) {
+            if (blockUsed[block] > 0) occupiedSlots += std::min(blockSlots, slotCount - block * blockSlots);
+        }
+        if (occupiedSlots == 0) return 0.0f;
+        return 1.0f - static_cast<float>(getUsedCount()) / static_cast<float>(occupiedSlots);
+    }
+
+    void ChunkPool::resetStats() {
+        stats = {};
+        stats.peakUsed = getUsedCount();
+    }
+} // namespace VkGameProjectOne
@@ -0,0 +1,103 @@
+// ChunkPool.h
+
+#pragma once
+#include <cstdint>
+#include <vector>
+
+namespace vk_project_one {
+    // Fixed-size slots of a pair of shared vertex and index buffers, one streamed chunk per slot. Slot s
+    // holds its vertices from vertexOffset(s) and its indices (local to the chunk) from firstIndex(s), so a
+    // chunk is drawn with the buffers bound once. Allocation and release are O(1) through a free-slot stack.
+    // A released slot may still be read by frames in flight: it is retired with the frame that released it
+    // and only reused once reclaim() is told that frame has completed.
+    //
+    // Slots are grouped into blocks. Under churn the chunks spread thinly over many blocks; planMove()
+    // picks chunks to relocate from the sparsest block into denser ones, so that the occupied slots stay
+    // packed and whole blocks free up.
+    class ChunkPool {
+    public:
+        static constexpr uint32_t INVALID_SLOT = ~0u;
+
+        // A chunk to copy from one slot to another. The destination is already allocated to its owner;
+        // the source is released by the caller once the copy is recorded.
+        struct Move {
+            uint32_t owner;
+            uint32_t from;
+            uint32_t to;
+        };
+
+        // Statistics since the last resetStats(), for benchmark reporting.
+        struct Stats {
+            uint32_t allocations = 0;
+            uint32_t failedAllocations = 0; // No free slot
+            uint32_t peakUsed = 0;
+            uint32_t moves = 0; // Planned by planMove
+        };
+
+        void init(uint32_t slotCount, uint32_t slotVertices, uint32_t slotIndices, uint32_t blockSlots = 16);
+
+        // A free slot for the owner's chunk, or INVALID_SLOT when all are in use or retired.
+        uint32_t allocate(uint32_t owner);
+
+        // Returns the slot to the pool once `frame` has completed.
+        void release(uint32_t slot, uint64_t frame);
+
+        // Frees the slots released in frames up to completedFrame.
+        void reclaim(uint64_t completedFrame);
+
+        // Frees every retired slot (the device is idle).
+        void reclaimAll() { reclaim(~0ull); }
+
+        // Next relocation that compacts the pool: a live slot of the least occupied block into a free slot of
+        // the most occupied block that has one (and is at least as full). False when no move would help.
+        bool planMove(Move &move);
+
+        uint32_t vertexOffset(uint32_t slot) const { return slot * slotVertices; }
+
+        uint32_t firstIndex(uint32_t slot) const { return slot * slotIndices; }
+
+        uint32_t getSlotCount() const { return slotCount; }
+
+        uint32_t getSlotVertices() const { return slotVertices; }
+
+        uint32_t getSlotIndices() const { return slotIndices; }
+
+        uint32_t getBlockCount() const { return static_cast<uint32_t>(blockUsed.size()); }
+
+        // Slots holding a chunk (retired ones included).
+        uint32_t getUsedCount() const { return slotCount - static_cast<uint32_t>(freeSlots.size()); }
+
+        // Blocks without any used slot.
+        uint32_t getEmptyBlockCount() const;
+
+        // Share of the slots in occupied blocks that are free: 0 when the used slots fill their blocks.
+        float getFragmentation() const;
+
+        const Stats &getStats() const { return stats; }
+
+        void resetStats();
+
+    private:
+        enum class SlotState : uint8_t {
+            Free,
+            Used,
+            Retired // Released, waiting for its frame to complete
+        };
+
+        struct RetiredSlot {
+            uint32_t slot;
+            uint64_t frame;
+        };
+
+        uint32_t slotCount = 0;
+        uint32_t slotVertices = 0;
+        uint32_t slotIndices = 0;
+        uint32_t blockSlots = 1;
+        std::vector<uint32_t> freeSlots; // Stack; the lowest slots are handed out first after init
+        std::vector<RetiredSlot> retiredSlots; // In release order, so frames are ascending
+        std::vector<SlotState> slotStates;
+        std::vector<uint32_t> slotOwners;
+        std::vector<uint32_t> blockUsed; // Used and retired slots per block
+        Stats stats;
+    };
+} // namespace VkGameProjectOne
@@ -0,0 +1,143 @@
+// DeviceSelection.cpp
+
+#include "core/DeviceSelection.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <vector>
+#include <spdlog/spdlog.h>
+
+namespace vk_project_one {
+    static uint64_t typeRank(VkPhysicalDeviceType type) {
+        switch (type) {
+            case VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU: return 4;
+            case VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU: return 3;
+            case VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU: return 2;
+            case VK_PHYSICAL_DEVICE_TYPE_CPU: return 1;
+            default: return 0;
+        }
+    }
+
+    static const char *typeName(VkPhysicalDeviceType type) {
+        switch (type) {
+            case VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU: return "discrete";
+            case VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU: return "integrated";
+            case VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU: return "virtual";
+            case VK_PHYSICAL_DEVICE_TYPE_CPU: return "CPU (software)";
+            default: return "other";
+        }
+    }
+
+    DeviceCapabilities DeviceCapabilities::Query(VkPhysicalDevice device, uint32_t index) {
+        DeviceCapabilities caps;
+        caps.index = index;
+
+        VkPhysicalDeviceProperties properties;
+        vkGetPhysicalDeviceProperties(device, &properties);
+        caps.name = properties.deviceName;
+        caps.type = properties.deviceType;
+        caps.apiVersion = properties.apiVersion;
+
+        // The ID properties are core in 1.1; a 1.0 device keeps an all-zero UUID
+        if (caps.apiVersion >= VK_API_VERSION_1_1) {
+            VkPhysicalDeviceIDProperties idProperties{};
+            idProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ID_PROPERTIES;
+            VkPhysicalDeviceProperties2 properties2{};
+            properties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+            properties2.pNext = &idProperties;
+            vkGetPhysicalDeviceProperties2(device, &properties2);
+            std::copy(std::begin(idProperties.deviceUUID), std::end(idProperties.deviceUUID), caps.uuid);
+        }
+
+        VkPhysicalDeviceMemoryProperties memory;
+        vkGetPhysicalDeviceMemoryProperties(device, &memory);
+        for (uint32_t i = 0; i < memory.memoryHeapCount; ++i) {
+            if (memory.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) {
+                caps.deviceLocalBytes = std::max(caps.deviceLocalBytes, memory.memoryHeaps[i].size);
+            }
+        }
+
+        // The 1.1/1.2 feature structs may only be chained on devices that know them
+        if (caps.apiVersion >= VK_API_VERSION_1_2) {
+            VkPhysicalDeviceVulkan12Features vulkan12Features{};
+            vulkan12Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+            VkPhysicalDeviceVulkan11Features vulkan11Features{};
+            vulkan11Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_1_FEATURES;
+            vulkan11Features.pNext = &vulkan12Features;
+            VkPhysicalDeviceFeatures2 features{};
+            features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+            features.pNext = &vulkan11Features;
+            vkGetPhysicalDeviceFeatures2(device, &features);
+            caps.multiview = vulkan11Features.multiview;
+            caps.timelineSemaphore = vulkan12Features.timelineSemaphore;
+            caps.descriptorIndexing = vulkan12Features.descriptorIndexing;
+        }
+
+        uint32_t familyCount = 0;
+        vkGetPhysicalDeviceQueueFamilyProperties(device, &familyCount, nullptr);
+        std::vector<VkQueueFamilyProperties> families(familyCount);
+        vkGetPhysicalDeviceQueueFamilyProperties(device, &familyCount, families.data());
+        for (const VkQueueFamilyProperties &family: families) {
+            if ((family.queueFlags & VK_QUEUE_COMPUTE_BIT) && !(family.queueFlags & VK_QUEUE_GRAPHICS_BIT)) {
+                caps.computeOnlyQueue = true;
+            }
+        }
+        return caps;
+    }
+
+    std::string DeviceCapabilities::missingRequirement() const {
+        if (apiVersion < VK_API_VERSION_1_2) return "Vulkan 1.2";
+        if (!multiview) return "multiview";
+        return {};
+    }
+
+    uint64_t DeviceCapabilities::score() const {
+        const uint64_t optionalFeatures = (timelineSemaphore ? 1 : 0) + (computeOnlyQueue ? 1 : 0) +
+                                          (descriptorIndexing ? 1 : 0);
+        const uint64_t memoryMiB = std::min<uint64_t>(deviceLocalBytes >> 20, 0xffffffffull);
+        return typeRank(type) << 40 | optionalFeatures << 32 | memoryMiB;
+    }
+
+    bool DeviceCapabilities::matches(const std::string &selector) const {
+        if (selector.empty()) return false;
+        if (selector.size() <= 3 &&
+            std::all_of(selector.begin(), selector.end(), [](unsigned char c) { return std::isdigit(c); })) {
+            return std::stoul(selector) == index;
+        }
+
+        std::string hex;
+        for (unsigned char c: selector) {
+            if (c != '-') hex += static_cast<char>(std::tolower(c));
+        }
+        std::string uuidHex = uuidString();
+        uuidHex.erase(std::remove(uuidHex.begin(), uuidHex.end(), '-'), uuidHex.end());
+        if (hex == uuidHex) return true;
+
+        std::string lowerName, lowerSelector;
+        for (unsigned char c: name) lowerName += static_cast<char>(std::tolower(c));
+        for (unsigned char c: selector) lowerSelector += static_cast<char>(std::tolower(c));
+        return lowerName.find(lowerSelector) != std::string::npos;
+    }
+
+    std::string DeviceCapabilities::uuidString() const {
+        std::string result;
+        for (uint32_t i = 0; i < VK_UUID_SIZE; ++i) {
+            char digits[3];
+            std::snprintf(digits, sizeof(digits), "%02x", uuid[i]);
+            result += digits;
+            if (i == 3 || i == 5 || i == 7 || i == 9) result += '-';
+        }
+        return result;
+    }
+
+    void DeviceCapabilities::log(bool selected) const {
+        const std::string missing = missingRequirement();
+        spdlog::info("  Device [{}]: {} ({}, Vulkan {}.{}, {:.0f} MB device-local){}", index, name, typeName(type),
+                     VK_API_VERSION_MAJOR(apiVersion), VK_API_VERSION_MINOR(apiVersion),
+                     static_cast<double>(deviceLocalBytes) / (1024.0 * 1024.0), selected ? " <- selected" : "");
+        spdlog::info("    uuid {}, score {:#x}; timeline semaphores {}, compute-only queue {}, descriptor "
+                     "indexing {}, multiview {}{}", uuidString(), score(), timelineSemaphore ? "yes" : "no",
+                     computeOnlyQueue ? "yes" : "no", descriptorIndexing ? "yes" : "no", multiview ? "yes" : "no",
+                     missing.empty() ? "" : "; unusable, needs " + missing);
+    }
+} // namespace VkGameProjectOne
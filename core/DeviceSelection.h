@@ -0,0 +1,45 @@
+// DeviceSelection.h
+
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vulkan/vulkan.h>
+
+namespace vk_project_one {
+    // What a physical device offers that matters to the engine, queried once per device so that the
+    // devices can be ranked against each other and the chosen one's optional features enabled as present.
+    struct DeviceCapabilities {
+        uint32_t index = 0; // Position in vkEnumeratePhysicalDevices
+        std::string name;
+        VkPhysicalDeviceType type = VK_PHYSICAL_DEVICE_TYPE_OTHER;
+        uint32_t apiVersion = 0;
+        uint8_t uuid[VK_UUID_SIZE] = {};
+        VkDeviceSize deviceLocalBytes = 0; // Largest DEVICE_LOCAL heap
+        // Required
+        bool multiview = false; // The scene shaders reference gl_ViewIndex
+        // Optional, downgraded when missing
+        bool timelineSemaphore = false; // Orders the async compute batches
+        bool computeOnlyQueue = false; // A queue family with compute but no graphics (async compute)
+        bool descriptorIndexing = false; // Bindless descriptor arrays (reported only)
+
+        static DeviceCapabilities Query(VkPhysicalDevice device, uint32_t index);
+
+        // Why the engine cannot run on the device, empty if it can.
+        std::string missingRequirement() const;
+
+        // Higher is better: device type first (discrete > integrated > virtual > CPU), then the number of
+        // optional features, then device-local memory.
+        uint64_t score() const;
+
+        bool isSoftware() const { return type == VK_PHYSICAL_DEVICE_TYPE_CPU; }
+
+        // Selector from EngineConfig::gpu: an index, the device UUID in hex (dashes ignored) or a
+        // case-insensitive part of the name.
+        bool matches(const std::string &selector) const;
+
+        std::string uuidString() const;
+
+        // One line with the type, API version, memory and features.
+        void log(bool selected) const;
+    };
+} // namespace VkGameProjectOne
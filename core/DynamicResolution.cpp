@@ -0,0 +1,66 @@
+// DynamicResolution.cpp
+
+#include "core/DynamicResolution.h"
+#include <algorithm>
+#include <cmath>
+
+namespace vk_project_one {
+    DynamicResolution::DynamicResolution(const Settings &initialSettings) : settings(initialSettings),
+                                                                            scale(initialSettings.maxScale) {
+        resetStats();
+    }
+
+    float DynamicResolution::update(float gpuFrameMs) {
+        if (gpuFrameMs <= 0.0f) return scale;
+
+        smoothedMs = hasSample ? smoothedMs + (gpuFrameMs - smoothedMs) * settings.smoothing : gpuFrameMs;
+        hasSample = true;
+
+        stats.samples++;
+        stats.sumFrameMs += gpuFrameMs;
+        stats.maxFrameMs = std::max(stats.maxFrameMs, gpuFrameMs);
+
+        // Results lag by the frames in flight; wait until the last change is visible in the timings
+        if (++framesSinceChange < settings.settleFrames) {
+            stats.minScale = std::min(stats.minScale, scale);
+            stats.maxScale = std::max(stats.maxScale, scale);
+            return scale;
+        }
+
+        const float error = (smoothedMs - settings.targetFrameMs) / settings.targetFrameMs;
+        if (std::abs(error) > settings.deadBand) {
+            // GPU cost is roughly proportional to pixel count, i.e. to scale^2
+            const float desired = scale * std::sqrt(settings.targetFrameMs / smoothedMs);
+            const float step = std::clamp(desired - scale, -settings.maxStep, settings.maxStep);
+            const float newScale = std::clamp(scale + step, settings.minScale, settings.maxScale);
+
+            if (std::abs(newScale - scale) > 1e-4f) {
+                const int direction = newScale > scale ? 1 : -1;
+                if (lastDirection != 0 && direction != lastDirection) stats.directionChanges++;
+                lastDirection = direction;
+                scale = newScale;
+                framesSinceChange = 0;
+                stats.adjustments++;
+            }
+        }
+
+        stats.minScale = std::min(stats.minScale, scale);
+        stats.maxScale = std::max(stats.maxScale, scale);
+        return scale;
+    }
+
+    VkExtent2D DynamicResolution::ScaleExtent(VkExtent2D fullExtent, float scale) {
+        auto scaleAxis = [scale](uint32_t full) {
+            uint32_t scaled = static_cast<uint32_t>(static_cast<float>(full) * scale);
+            scaled = (scaled + 7u) & ~7u; // Round up to a multiple of 8
+            return std::clamp(scaled, 1u, full);
+        };
+        return {scaleAxis(fullExtent.width), scaleAxis(fullExtent.height)};
+    }
+
+    void DynamicResolution::resetStats() {
+        stats = {};
+        stats.minScale = scale;
+        stats.maxScale = scale;
+    }
+} // namespace VkGameProjectOne
@@ -0,0 +1,65 @@
+// DynamicResolution.h
+
+#pragma once
+#include <cstdint>
+#include <vulkan/vulkan.h>
+
+namespace vk_project_one {
+    // Picks the per-axis render scale for the offscreen scene target from measured GPU frame
+    // times. The controller works on a smoothed frame time, ignores errors inside a dead band,
+    // limits how far the scale may move per adjustment and waits for the frames in flight to
+    // drain between adjustments, which keeps the scale from oscillating around the target.
+    class DynamicResolution {
+    public:
+        struct Settings {
+            float targetFrameMs = 16.6f;
+            float minScale = 0.5f;
+            float maxScale = 1.0f;
+            float deadBand = 0.08f; // Relative error (+/-) around the target that is left alone
+            float maxStep = 0.05f; // Largest scale change per adjustment
+            uint32_t settleFrames = 3; // Frames to wait after a change before the next one (>= frames in flight)
+            float smoothing = 0.2f; // EMA weight of the newest frame time sample
+        };
+
+        // Statistics over the frames since the last resetStats(), for benchmark reporting.
+        struct Stats {
+            uint32_t samples = 0;
+            uint32_t adjustments = 0;
+            uint32_t directionChanges = 0; // Up->down or down->up reversals (oscillation indicator)
+            float minScale = 1.0f;
+            float maxScale = 0.0f;
+            float sumFrameMs = 0.0f;
+            float maxFrameMs = 0.0f;
+        };
+
+        explicit DynamicResolution(const Settings &settings);
+
+        // Feeds one GPU frame time measurement and returns the scale to render the next frame with.
+        float update(float gpuFrameMs);
+
+        float getScale() const { return scale; }
+
+        float getSmoothedFrameMs() const { return smoothedMs; }
+
+        // Scales the full-resolution extent, rounding to a multiple of 8 pixels so tiny scale
+        // changes do not produce a new extent every frame.
+        VkExtent2D scaledExtent(VkExtent2D fullExtent) const { return ScaleExtent(fullExtent, scale); }
+
+        static VkExtent2D ScaleExtent(VkExtent2D fullExtent, float scale);
+
+        const Stats &getStats() const { return stats; }
+
+        void resetStats();
+
+        const Settings &getSettings() const { return settings; }
+
+    private:
+        Settings settings;
+        float scale;
+        float smoothedMs = 0.0f;
+        bool hasSample = false;
+        uint32_t framesSinceChange = 0;
+        int lastDirection = 0; // -1 = shrinking, +1 = growing
+        Stats stats;
+    };
+} // namespace VkGameProjectOne
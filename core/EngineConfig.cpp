@@ -0,0 +1,331 @@
+// EngineConfig.cpp
+
+#include "core/EngineConfig.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <string_view>
+
+namespace vk_project_one {
+    // Splits "--key=value" into key and value. Returns false if the argument is not a "--" option.
+    static bool splitOption(std::string_view arg, std::string_view &key, std::string_view &value) {
+        if (arg.size() < 3 || arg.substr(0, 2) != "--") return false;
+        arg.remove_prefix(2);
+        const size_t eq = arg.find('=');
+        key = arg.substr(0, eq);
+        value = (eq == std::string_view::npos) ? std::string_view{} : arg.substr(eq + 1);
+        return true;
+    }
+
+    static float parseFloat(std::string_view key, std::string_view value, float fallback) {
+        try {
+            return std::stof(std::string(value));
+        } catch (const std::exception &) {
+            spdlog::warn("Invalid value '{}' for --{}, keeping {}", value, key, fallback);
+            return fallback;
+        }
+    }
+
+    static uint32_t parseUInt(std::string_view key, std::string_view value, uint32_t fallback) {
+        try {
+            return static_cast<uint32_t>(std::stoul(std::string(value)));
+        } catch (const std::exception &) {
+            spdlog::warn("Invalid value '{}' for --{}, keeping {}", value, key, fallback);
+            return fallback;
+        }
+    }
+
+    // Parses a comma-separated effect list ("fog,tonemap,...", "all" or "none") into a PostEffect mask
+    static uint32_t parsePostEffects(std::string_view value) {
+        uint32_t mask = 0;
+        while (!value.empty()) {
+            const size_t comma = value.find(',');
+            const std::string_view name = value.substr(0, comma);
+            if (name == "all") mask |= (1u << POST_EFFECT_COUNT) - 1;
+            else if (name == "fog") mask |= POST_FOG;
+            else if (name == "atmosphere") mask |= POST_ATMOSPHERE;
+            else if (name == "tonemap") mask |= POST_TONEMAP;
+            else if (name == "grading") mask |= POST_COLOR_GRADING;
+            else if (name == "vignette") mask |= POST_VIGNETTE;
+            else if (name == "dither") mask |= POST_DITHER;
+            else if (name != "none") spdlog::warn("Unknown post effect '{}'", name);
+            value = comma == std::string_view::npos ? std::string_view{} : value.substr(comma + 1);
+        }
+        return mask;
+    }
+
+    EngineConfig EngineConfig::FromCommandLine(int argc, char *argv[]) {
+        EngineConfig config{};
+        for (int i = 1; i < argc; ++i) {
+            std::string_view key, value;
+            if (argv[i] == nullptr || !splitOption(argv[i], key, value)) {
+                spdlog::warn("Ignoring unrecognized argument: {}", argv[i] ? argv[i] : "(null)");
+                continue;
+            }
+
+            if (key == "benchmark") {
+                config.benchmarkMode = true;
+                if (!value.empty()) config.benchmarkFrames = parseUInt(key, value, config.benchmarkFrames);
+            } else if (key == "compare") {
+                config.benchmarkMode = true; // Comparisons are reported through the benchmark log
+                if (value == "upscaler") config.benchmarkCompare = BenchmarkCompare::Upscaler;
+                else if (value == "post") config.benchmarkCompare = BenchmarkCompare::PostChain;
+                else if (value == "msaa") config.benchmarkCompare = BenchmarkCompare::Msaa;
+                else if (value == "impostor") config.benchmarkCompare = BenchmarkCompare::Impostor;
+                else if (value == "raymarch") config.benchmarkCompare = BenchmarkCompare::RayMarch;
+                else if (value == "views") config.benchmarkCompare = BenchmarkCompare::Views;
+                else if (value == "amortized") config.benchmarkCompare = BenchmarkCompare::Amortized;
+                else if (value == "async") config.benchmarkCompare = BenchmarkCompare::AsyncCompute;
+                else if (value == "resize") config.benchmarkCompare = BenchmarkCompare::Resize;
+                else spdlog::warn("Unknown benchmark comparison '{}'", value);
+            } else if (key == "memory-report") {
+                config.memoryReport = true;
+            } else if (key == "gpu") {
+                config.gpu = std::string(value);
+            } else if (key == "no-dynres") {
+                config.dynamicResolution = false;
+            } else if (key == "no-async-compute") {
+                config.asyncCompute = false;
+            } else if (key == "gpu-budget") {
+                config.amortizedBudgetMs = parseFloat(key, value, config.amortizedBudgetMs);
+            } else if (key == "target-ms") {
+                config.targetFrameTimeMs = parseFloat(key, value, config.targetFrameTimeMs);
+            } else if (key == "min-scale") {
+                config.minRenderScale = parseFloat(key, value, config.minRenderScale);
+            } else if (key == "max-scale") {
+                config.maxRenderScale = parseFloat(key, value, config.maxRenderScale);
+            } else if (key == "upscaler") {
+                if (value == "fsr") config.upscaler = UpscalerMode::Fsr;
+                else if (value == "bilinear") config.upscaler = UpscalerMode::Bilinear;
+                else spdlog::warn("Unknown upscaler '{}', expected 'bilinear' or 'fsr'", value);
+            } else if (key == "fsr-quality") {
+                // Standard FSR1 presets (scale factor per axis)
+                config.upscaler = UpscalerMode::Fsr;
+                if (value == "ultra-quality") config.upscaleFactor = 1.3f;
+                else if (value == "quality") config.upscaleFactor = 1.5f;
+                else if (value == "balanced") config.upscaleFactor = 1.7f;
+                else if (value == "performance") config.upscaleFactor = 2.0f;
+                else spdlog::warn("Unknown FSR quality preset '{}'", value);
+            } else if (key == "upscale-factor") {
+                config.upscaleFactor = parseFloat(key, value, config.upscaleFactor);
+            } else if (key == "sharpness") {
+                config.sharpness = parseFloat(key, value, config.sharpness);
+            } else if (key == "msaa") {
+                config.msaaSamples = parseUInt(key, value, config.msaaSamples);
+            } else if (key == "post") {
+                config.postEffects = parsePostEffects(value);
+            } else if (key == "exposure") {
+                config.exposure = parseFloat(key, value, config.exposure);
+            } else if (key == "fog-density") {
+                config.fogDensity = parseFloat(key, value, config.fogDensity);
+            } else if (key == "vignette") {
+                config.vignetteStrength = parseFloat(key, value, config.vignetteStrength);
+            } else if (key == "haze") {
+                config.haze = parseFloat(key, value, config.haze);
+            } else if (key == "views") {
+                config.viewCount = parseUInt(key, value, config.viewCount);
+            } else if (key == "stereo") {
+                config.viewLayout = ViewLayout::Stereo;
+            } else if (key == "eye-separation") {
+                config.eyeSeparation = parseFloat(key, value, config.eyeSeparation);
+            } else if (key == "no-multiview") {
+                config.multiview = false;
+            } else if (key == "windows") {
+                config.windowCount = parseUInt(key, value, config.windowCount);
+            } else if (key == "resize-delay") {
+                config.resizeDelayMs = parseUInt(key, value, config.resizeDelayMs);
+            } else if (key == "particles") {
+                config.particleCount = parseUInt(key, value, config.particleCount);
+            } else if (key == "particle-effect") {
+                if (value == "dust") config.particleEffect = ParticleEffect::Dust;
+                else if (value == "smoke") config.particleEffect = ParticleEffect::Smoke;
+                else if (value == "rain") config.particleEffect = ParticleEffect::Rain;
+                else spdlog::warn("Unknown particle effect '{}', expected 'dust', 'smoke' or 'rain'", value);
+            } else if (key == "props") {
+                config.propCount = parseUInt(key, value, config.propCount);
+            } else if (key == "prop-lod") {
+                config.propLodDistance = parseFloat(key, value, config.propLodDistance);
+            } else if (key == "prop-lods") {
+                config.propLodLevels = parseUInt(key, value, config.propLodLevels);
+            } else if (key == "prop-lod-error") {
+                config.propLodError = parseFloat(key, value, config.propLodError);
+            } else if (key == "prop-mesh") {
+                config.propMeshPath = std::string(value);
+            } else if (key == "terrain-step") {
+                config.terrainStep = parseUInt(key, value, config.terrainStep);
+            } else if (key == "stream-radius") {
+                config.streamRadius = parseFloat(key, value, config.streamRadius);
+            } else if (key == "defrag-budget") {
+                // Kilobytes on the command line, at most 64 MB
+                config.defragBytesPerFrame = std::min(parseUInt(key, value, config.defragBytesPerFrame >> 10), 65536u)
+                                             << 10;
+            } else if (key == "pom") {
+                config.parallaxRadius = parseFloat(key, value, config.parallaxRadius);
+            } else if (key == "pom-depth") {
+                config.parallaxDepth = parseFloat(key, value, config.parallaxDepth);
+            } else if (key == "far-field") {
+                if (value == "impostor") config.farField = FarFieldMode::Impostor;
+                else if (value == "raymarch") config.farField = FarFieldMode::RayMarch;
+                else spdlog::warn("Unknown far-field mode '{}', expected 'impostor' or 'raymarch'", value);
+            } else if (key == "far-split") {
+                config.farFieldSplit = parseFloat(key, value, config.farFieldSplit);
+            } else if (key == "impostor-refresh") {
+                config.impostorRefreshFrames = parseUInt(key, value, config.impostorRefreshFrames);
+            } else if (key == "impostor-move") {
+                config.impostorMoveThreshold = parseFloat(key, value, config.impostorMoveThreshold);
+            } else if (key == "impostor-size") {
+                config.impostorResolution = parseUInt(key, value, config.impostorResolution);
+            } else {
+                spdlog::warn("Ignoring unknown option: --{}", key);
+            }
+        }
+
+        // Keep the scale range sane regardless of what was passed in.
+        // The upscale factor caps the render scale; dynamic resolution may still go lower.
+        config.upscaleFactor = std::clamp(config.upscaleFactor, 1.0f, 4.0f);
+        config.sharpness = std::clamp(config.sharpness, 0.0f, 2.0f);
+        config.maxRenderScale = std::clamp(std::min(config.maxRenderScale, 1.0f / config.upscaleFactor), 0.1f, 1.0f);
+        config.minRenderScale = std::clamp(config.minRenderScale, 0.1f, config.maxRenderScale);
+        if (config.targetFrameTimeMs <= 0.0f) config.targetFrameTimeMs = 16.6f;
+        config.amortizedBudgetMs = std::max(config.amortizedBudgetMs, 0.0f);
+        // The comparison needs a budget to compare against eager recording
+        if (config.benchmarkCompare == BenchmarkCompare::Amortized && config.amortizedBudgetMs == 0.0f) {
+            config.amortizedBudgetMs = 1.0f;
+        }
+        if (config.benchmarkCompare == BenchmarkCompare::AsyncCompute) config.asyncCompute = true;
+        config.viewCount = std::clamp(config.viewCount, 1u, MAX_VIEWS);
+        if (config.viewLayout == ViewLayout::Stereo) config.viewCount = 2;
+        // The view sweep needs a range to sweep over
+        if (config.benchmarkCompare == BenchmarkCompare::Views && config.viewCount == 1) config.viewCount = MAX_VIEWS;
+        config.eyeSeparation = std::max(config.eyeSeparation, 0.0f);
+        config.windowCount = std::clamp(config.windowCount, 1u, MAX_WINDOWS);
+        config.resizeDelayMs = std::min(config.resizeDelayMs, 2000u);
+        config.particleCount = std::min(config.particleCount, MAX_PARTICLES);
+        config.propCount = std::min(config.propCount, MAX_PROPS);
+        config.propLodDistance = std::max(config.propLodDistance, 0.0f);
+        config.propLodLevels = std::clamp(config.propLodLevels, 1u, MAX_PROP_LODS);
+        config.propLodError = std::max(config.propLodError, 0.0f);
+        config.terrainStep = std::clamp(config.terrainStep, 1u, 16u);
+        config.streamRadius = std::max(config.streamRadius, 0.0f);
+        config.parallaxRadius = std::max(config.parallaxRadius, 0.0f);
+        config.parallaxDepth = std::clamp(config.parallaxDepth, 0.0f, 2.0f);
+        config.farFieldSplit = std::max(config.farFieldSplit, 0.0f);
+        config.impostorRefreshFrames = std::max(config.impostorRefreshFrames, 1u);
+        config.impostorMoveThreshold = std::max(config.impostorMoveThreshold, 0.0f);
+        config.impostorResolution = std::clamp(config.impostorResolution, 64u, 4096u);
+
+        // Far-field comparisons measure one specific far-field path
+        if (config.benchmarkCompare == BenchmarkCompare::Impostor) config.farField = FarFieldMode::Impostor;
+        if (config.benchmarkCompare == BenchmarkCompare::RayMarch) config.farField = FarFieldMode::RayMarch;
+
+        // Round the sample count down to a power of two in [1, 8]
+        config.msaaSamples = std::clamp(config.msaaSamples, 1u, 8u);
+        while (config.msaaSamples & (config.msaaSamples - 1)) config.msaaSamples &= config.msaaSamples - 1;
+        // Fog reads single-sample depth; multisampled depth is never resolved
+        if ((config.msaaSamples > 1 || config.benchmarkCompare == BenchmarkCompare::Msaa) &&
+            (config.postEffects & POST_FOG)) {
+            spdlog::warn("Fog is not supported together with MSAA and has been disabled.");
+            config.postEffects &= ~static_cast<uint32_t>(POST_FOG);
+        }
+        if ((config.msaaSamples > 1 || config.benchmarkCompare == BenchmarkCompare::Msaa) &&
+            (config.postEffects & POST_ATMOSPHERE)) {
+            spdlog::warn("The atmosphere is not supported together with MSAA and has been disabled.");
+            config.postEffects &= ~static_cast<uint32_t>(POST_ATMOSPHERE);
+        }
+        // The aerial perspective volume is built for a single camera frustum
+        if (config.viewCount > 1 && (config.postEffects & POST_ATMOSPHERE)) {
+            spdlog::warn("The atmosphere is not supported with multiple views and has been disabled.");
+            config.postEffects &= ~static_cast<uint32_t>(POST_ATMOSPHERE);
+        }
+        config.haze = std::max(config.haze, 0.0f);
+        return config;
+    }
+
+    void EngineConfig::log() const {
+        spdlog::info("Engine configuration:");
+        spdlog::info("  Benchmark mode: {} (frames: {}, compare: {})", benchmarkMode, benchmarkFrames,
+                     benchmarkCompare == BenchmarkCompare::Upscaler
+                         ? "upscaler"
+                         : benchmarkCompare == BenchmarkCompare::PostChain
+                               ? "post"
+                               : benchmarkCompare == BenchmarkCompare::Msaa
+                                     ? "msaa"
+                                     : benchmarkCompare == BenchmarkCompare::Impostor
+                                           ? "impostor"
+                                           : benchmarkCompare == BenchmarkCompare::RayMarch
+                                                 ? "raymarch"
+                                                 : benchmarkCompare == BenchmarkCompare::Views
+                                                       ? "views"
+                                                       : benchmarkCompare == BenchmarkCompare::Amortized
+                                                             ? "amortized"
+                                                             : benchmarkCompare == BenchmarkCompare::AsyncCompute
+                                                                   ? "async"
+                                                                   : benchmarkCompare == BenchmarkCompare::Resize
+                                                                         ? "resize"
+                                                                         : "none");
+        if (memoryReport) spdlog::info("  Memory report: after initialization and on exit");
+        spdlog::info("  MSAA: {}x", msaaSamples);
+        if (viewCount > 1) {
+            spdlog::info("  Views: {} ({}), {}", viewCount,
+                         viewLayout == ViewLayout::Stereo ? "stereo" : "wrap-around",
+                         multiview ? "multiview where possible" : "one draw set per viewport");
+        }
+        if (windowCount > 1) spdlog::info("  Windows: {} (one submit and one present per frame)", windowCount);
+        if (resizeDelayMs > 0) {
+            spdlog::info("  Resize: swapchain recreated once the size holds for {} ms", resizeDelayMs);
+        } else {
+            spdlog::info("  Resize: swapchain recreated on every resize event");
+        }
+        if (particleCount > 0) {
+            spdlog::info("  Particles: {} ({})", particleCount,
+                         particleEffect == ParticleEffect::Smoke
+                             ? "smoke"
+                             : particleEffect == ParticleEffect::Rain ? "rain" : "dust");
+        }
+        if (propCount > 0) {
+            if (propLodDistance > 0.0f) {
+                spdlog::info("  Props: {} ({} mesh levels at {:.1f} px error, impostors beyond {:.0f} units)",
+                             propCount, propLodLevels, propLodError, propLodDistance);
+            } else {
+                spdlog::info("  Props: {} ({} mesh levels at {:.1f} px error, no impostors)", propCount,
+                             propLodLevels, propLodError);
+            }
+            if (!propMeshPath.empty()) spdlog::info("  Prop mesh: {}", propMeshPath);
+        }
+        if (amortizedBudgetMs > 0.0f) {
+            spdlog::info("  Amortized GPU work: {:.2f} ms per frame", amortizedBudgetMs);
+        } else {
+            spdlog::info("  Amortized GPU work: off (jobs are recorded whole when requested)");
+        }
+        spdlog::info("  Device: {}", gpu.empty() ? "highest scored" : "'" + gpu + "' if usable");
+        spdlog::info("  Async compute: {}", asyncCompute ? "if the device has a compute-only queue family" : "off");
+        spdlog::info("  Dynamic resolution: {} (target {:.2f} ms, scale {:.2f}-{:.2f})",
+                     dynamicResolution, targetFrameTimeMs, minRenderScale, maxRenderScale);
+        spdlog::info("  Upscaler: {} (factor {:.2f}, sharpness {:.2f} stops)",
+                     upscaler == UpscalerMode::Fsr ? "FSR (EASU + RCAS)" : "bilinear blit", upscaleFactor, sharpness);
+        spdlog::info("  Post effects: fog={} atmosphere={} tonemap={} grading={} vignette={} dither={}",
+                     (postEffects & POST_FOG) != 0, (postEffects & POST_ATMOSPHERE) != 0,
+                     (postEffects & POST_TONEMAP) != 0,
+                     (postEffects & POST_COLOR_GRADING) != 0, (postEffects & POST_VIGNETTE) != 0,
+                     (postEffects & POST_DITHER) != 0);
+        if (parallaxRadius > 0.0f) {
+            spdlog::info("  Terrain: vertex every {} px, parallax detail within {:.0f} units ({:.2f} deep)", terrainStep,
+                         parallaxRadius, parallaxDepth);
+        } else {
+            spdlog::info("  Terrain: vertex every {} px, parallax detail off", terrainStep);
+        }
+        if (streamRadius > 0.0f) {
+            spdlog::info("  Terrain streaming: chunks within {:.0f} units, pool compaction {} KB/frame", streamRadius,
+                         defragBytesPerFrame >> 10);
+        } else {
+            spdlog::info("  Terrain streaming: off (all chunks loaded)");
+        }
+        if (farFieldSplit <= 0.0f) {
+            spdlog::info("  Terrain far field: off");
+        } else if (farField == FarFieldMode::RayMarch) {
+            spdlog::info("  Terrain far field: ray marched beyond {:.0f} units", farFieldSplit);
+        } else {
+            spdlog::info("  Terrain far field: impostor beyond {:.0f} units, {}px faces, refresh every {} frames or "
+                         "{:.1f} units", farFieldSplit, impostorResolution, impostorRefreshFrames, impostorMoveThreshold);
+        }
+    }
+} // namespace VkGameProjectOne
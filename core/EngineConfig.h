@@ -0,0 +1,152 @@
+// EngineConfig.h
+
+#pragma once
+#include <cstdint>
+#include <string>
+
+namespace vk_project_one {
+    // Upper bound for EngineConfig::viewCount; the per-view matrix arrays of the shaders have this size.
+    constexpr uint32_t MAX_VIEWS = 4;
+
+    // Upper bound for EngineConfig::windowCount.
+    constexpr uint32_t MAX_WINDOWS = 4;
+
+    // Upper bound for EngineConfig::particleCount (two pools of 32-byte particles, 256 MB).
+    constexpr uint32_t MAX_PARTICLES = 1u << 22;
+
+    // Upper bound for EngineConfig::propCount (instance buffers are rewritten every frame).
+    constexpr uint32_t MAX_PROPS = 1u << 20;
+
+    // Upper bound for EngineConfig::propLodLevels.
+    constexpr uint32_t MAX_PROP_LODS = 4;
+
+    // How the rendered scene region is scaled to the swapchain resolution.
+    enum class UpscalerMode {
+        Bilinear, // Fixed-function linear blit
+        Fsr // Compute EASU (edge-adaptive upsampling) + RCAS (sharpening)
+    };
+
+    // Effects of the fused post-processing pass (bit mask, in execution order).
+    enum PostEffect : uint32_t {
+        POST_FOG = 1u << 0, // Distance fog composite (needs scene depth)
+        POST_ATMOSPHERE = 1u << 1, // Scattered sky and aerial perspective from precomputed LUTs (needs scene depth)
+        POST_TONEMAP = 1u << 2, // ACES filmic tonemapping of the HDR scene
+        POST_COLOR_GRADING = 1u << 3, // 3D LUT color grading
+        POST_VIGNETTE = 1u << 4,
+        POST_DITHER = 1u << 5, // Triangular noise against 8-bit banding
+        POST_EFFECT_COUNT = 6
+    };
+
+    // How terrain beyond the far-field split distance is drawn.
+    enum class FarFieldMode {
+        Impostor, // Cube map re-rendered at a reduced rate
+        RayMarch // Per-pixel heightfield ray march over a min/max mip pyramid
+    };
+
+    // How multiple views split the window (see EngineConfig::viewCount).
+    enum class ViewLayout {
+        Wrap, // Side-by-side monitors: each view is turned by one field of view from its neighbour
+        Stereo // Two eyes offset by the eye separation, looking the same way
+    };
+
+    // Look and motion of the GPU particle system (see EngineConfig::particleCount).
+    enum class ParticleEffect {
+        Dust, // Drifts with the wind close to the ground and settles on it
+        Smoke, // Rises and spreads out
+        Rain // Falls from above the camera and dies on impact
+    };
+
+    // A/B comparison run in benchmark mode: the two variants alternate every report interval.
+    enum class BenchmarkCompare {
+        None,
+        Upscaler, // Configured upscaler vs native-resolution rendering
+        PostChain, // Fused post pass vs one pass per effect
+        Msaa, // Sweep over the supported MSAA sample counts (not A/B)
+        Impostor, // Sweep over far-field impostor split distances, starting with none (not A/B)
+        RayMarch, // Ray-marched vs rasterized terrain beyond the far-field split
+        Views, // Sweep over view counts from 1 up to viewCount (not A/B)
+        Amortized, // Budgeted time-sliced GPU jobs vs recording them whole when requested
+        AsyncCompute, // Particles and post-processing on the async compute queue vs on the graphics queue
+        Resize // CPU cost of drawFrame while the first window is resized every few frames vs left alone
+    };
+
+    // Runtime settings for the engine, filled from the command line in main().
+    struct EngineConfig {
+        // --- Benchmark ---
+        bool benchmarkMode = false; // Log per-subsystem GPU timings and controller statistics
+        uint32_t benchmarkFrames = 0; // Quit after this many frames in benchmark mode (0 = run until closed)
+        BenchmarkCompare benchmarkCompare = BenchmarkCompare::None;
+        bool memoryReport = false; // Log every device allocation and the totals per category after init and on exit
+
+        // --- Device ---
+        std::string gpu; // Physical device: index, UUID or part of the name (empty = highest scored device)
+
+        // --- Dynamic Resolution ---
+        bool dynamicResolution = true;
+        float targetFrameTimeMs = 16.6f; // GPU frame time the controller tries to hold
+        float minRenderScale = 0.5f; // Lower bound for the per-axis render scale
+        float maxRenderScale = 1.0f; // Upper bound (1.0 = native swapchain resolution)
+
+        // --- Amortized GPU Work ---
+        float amortizedBudgetMs = 1.0f; // GPU time per frame for sliced jobs like impostor refreshes (0 = eager)
+
+        // --- Async Compute ---
+        bool asyncCompute = true; // Particles and post on a compute-only queue family when the device has one
+
+        // --- Upscaling ---
+        UpscalerMode upscaler = UpscalerMode::Bilinear;
+        float upscaleFactor = 1.0f; // Output / render size per axis (1.5 = quality, 2.0 = performance)
+        float sharpness = 0.2f; // RCAS sharpness in stops (0 = sharpest)
+
+        // --- Anti-Aliasing ---
+        uint32_t msaaSamples = 1; // Requested MSAA sample count (1, 2, 4, 8); clamped to device support
+
+        // --- Post Processing ---
+        uint32_t postEffects = 0; // PostEffect mask; 0 disables the post pass (LDR scene)
+        float exposure = 1.0f;
+        float fogDensity = 0.002f; // Per world unit
+        float vignetteStrength = 0.35f;
+        float haze = 1.0f; // Atmosphere: Mie (aerosol) density relative to a clear day
+
+        // --- Multiple Views ---
+        uint32_t viewCount = 1; // Views side by side in the window, culled once and drawn in one scene pass
+        ViewLayout viewLayout = ViewLayout::Wrap;
+        float eyeSeparation = 0.064f; // Stereo: world units between the eyes
+        bool multiview = true; // Broadcast one pass to every view (multiview); false = one draw set per viewport
+
+        // --- Windows ---
+        uint32_t windowCount = 1; // Windows presented by the one device; the extra ones mirror the first
+        uint32_t resizeDelayMs = 100; // Swapchain recreation waits for the size to hold this long (0 = at once)
+
+        // --- Particles ---
+        uint32_t particleCount = 0; // Particles kept alive around the camera by compute passes (0 = off)
+        ParticleEffect particleEffect = ParticleEffect::Dust;
+
+        // --- Props ---
+        uint32_t propCount = 0; // Trees and rocks scattered over the terrain (0 = off)
+        float propLodDistance = 80.0f; // Beyond this, props are drawn as baked impostor quads (0 = always meshes)
+        uint32_t propLodLevels = MAX_PROP_LODS; // Mesh levels per prop, the full-detail one included (1 = no chain)
+        float propLodError = 1.0f; // Largest simplification error a mesh level may show, in pixels
+        std::string propMeshPath; // Binary glTF mesh used instead of the procedural tree (empty = procedural)
+
+        // --- Terrain Detail ---
+        uint32_t terrainStep = 1; // Mesh vertex every N heightmap pixels (1 = full resolution)
+        float streamRadius = 0.0f; // Chunks are streamed in within this distance, evicted beyond (0 = all loaded)
+        uint32_t defragBytesPerFrame = 256u << 10; // Streamed chunks relocated per frame to compact the pool (0 = off)
+        float parallaxRadius = 0.0f; // Parallax occlusion mapped detail within this distance (0 = off)
+        float parallaxDepth = 0.15f; // Relief depth of the detail texture in world units
+
+        // --- Terrain Far Field ---
+        FarFieldMode farField = FarFieldMode::Impostor;
+        float farFieldSplit = 0.0f; // Distance beyond which terrain is not rasterized as geometry (0 = off)
+        uint32_t impostorRefreshFrames = 120; // Re-render the impostor at least this often
+        float impostorMoveThreshold = 16.0f; // ... or once the camera is this far from where it was rendered
+        uint32_t impostorResolution = 512; // Cube face size in pixels
+
+        // Parses "--key" / "--key=value" arguments. Unknown arguments are logged and ignored.
+        static EngineConfig FromCommandLine(int argc, char *argv[]);
+
+        // Logs the effective configuration.
+        void log() const;
+    };
+} // namespace VkGameProjectOne
@@ -0,0 +1,31 @@
+// Frustum.cpp
+
+#include "core/Frustum.h"
+
+namespace vk_project_one {
+    Frustum::Frustum(const glm::mat4 &viewProj) {
+        // Gribb/Hartmann: each plane is a sum or difference of rows of the matrix (glm is column-major)
+        const glm::vec4 row0(viewProj[0][0], viewProj[1][0], viewProj[2][0], viewProj[3][0]);
+        const glm::vec4 row1(viewProj[0][1], viewProj[1][1], viewProj[2][1], viewProj[3][1]);
+        const glm::vec4 row2(viewProj[0][2], viewProj[1][2], viewProj[2][2], viewProj[3][2]);
+        const glm::vec4 row3(viewProj[0][3], viewProj[1][3], viewProj[2][3], viewProj[3][3]);
+        planes[0] = row3 + row0; // Left
+        planes[1] = row3 - row0; // Right
+        planes[2] = row3 + row1; // Bottom
+        planes[3] = row3 - row1; // Top
+        planes[4] = row2; // Near (z >= 0 with a zero-to-one depth range)
+        planes[5] = row3 - row2; // Far
+        for (glm::vec4 &plane: planes) plane /= glm::length(glm::vec3(plane));
+    }
+
+    bool Frustum::intersects(const glm::vec3 &boundsMin, const glm::vec3 &boundsMax) const {
+        for (const glm::vec4 &plane: planes) {
+            // Corner of the box furthest along the plane normal
+            const glm::vec3 positive(plane.x >= 0.0f ? boundsMax.x : boundsMin.x,
+                                     plane.y >= 0.0f ? boundsMax.y : boundsMin.y,
+                                     plane.z >= 0.0f ? boundsMax.z : boundsMin.z);
+            if (glm::dot(glm::vec3(plane), positive) + plane.w < 0.0f) return false;
+        }
+        return true;
+    }
+} // namespace VkGameProjectOne
@@ -0,0 +1,23 @@
+// Frustum.h
+
+#pragma once
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm/glm.hpp>
+
+namespace vk_project_one {
+    // View frustum as six inward-facing planes, extracted from a view-projection matrix with a
+    // [0, 1] depth range. Used to cull bounding boxes on the CPU before recording draws.
+    class Frustum {
+    public:
+        Frustum() = default;
+
+        explicit Frustum(const glm::mat4 &viewProj);
+
+        // Conservative: boxes straddling a corner of the frustum may be reported as visible.
+        bool intersects(const glm::vec3 &boundsMin, const glm::vec3 &boundsMax) const;
+
+    private:
+        glm::vec4 planes[6]{}; // xyz = normal, w = distance; inside where dot(n, p) + w >= 0
+    };
+} // namespace VkGameProjectOne
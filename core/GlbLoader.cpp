@@ -0,0 +1,771 @@
+// GlbLoader.cpp
+
+#include "core/GlbLoader.h"
+
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace vk_project_one {
+    // Parsed JSON value; objects keep their members in file order
+    struct GlbJson {
+        enum class Type { Null, Bool, Number, String, Array, Object };
+
+        Type type = Type::Null;
+        bool boolean = false;
+        double number = 0.0;
+        std::string string;
+        std::vector<GlbJson> array;
+        std::vector<std::pair<std::string, GlbJson>> object;
+
+        const GlbJson *find(std::string_view key) const {
+            if (type != Type::Object) return nullptr;
+            for (const auto &member: object) {
+                if (member.first == key) return &member.second;
+            }
+            return nullptr;
+        }
+
+        // Element of a member array, or nullptr
+        const GlbJson *at(std::string_view key, size_t index) const {
+            const GlbJson *values = find(key);
+            if (!values || values->type != Type::Array || index >= values->array.size()) return nullptr;
+            return &values->array[index];
+        }
+
+        double numberOr(std::string_view key, double fallback) const {
+            const GlbJson *value = find(key);
+            return value && value->type == Type::Number ? value->number : fallback;
+        }
+    };
+
+    namespace {
+        constexpr uint32_t GLB_MAGIC = 0x46546C67; // "glTF"
+        constexpr uint32_t GLB_CHUNK_JSON = 0x4E4F534A;
+        constexpr uint32_t GLB_CHUNK_BIN = 0x004E4942;
+
+        constexpr uint32_t COMPONENT_BYTE = 5120;
+        constexpr uint32_t COMPONENT_UNSIGNED_BYTE = 5121;
+        constexpr uint32_t COMPONENT_SHORT = 5122;
+        constexpr uint32_t COMPONENT_UNSIGNED_SHORT = 5123;
+        constexpr uint32_t COMPONENT_UNSIGNED_INT = 5125;
+        constexpr uint32_t COMPONENT_FLOAT = 5126;
+        constexpr uint32_t MODE_TRIANGLES = 4;
+        constexpr size_t DECODE_CHUNK = 3 * 65536; // Elements per decode job (whole triangles for indices)
+
+        float elapsedMs(std::chrono::high_resolution_clock::time_point start) {
+            return std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+        }
+
+        // Recursive descent over the JSON chunk; throws std::runtime_error with the byte offset
+        class JsonParser {
+        public:
+            JsonParser(const char *begin, const char *end) : start(begin), cursor(begin), end(end) {}
+
+            GlbJson parseDocument() {
+                GlbJson value = parseValue(0);
+                skipWhitespace();
+                if (cursor != end) fail("trailing characters");
+                return value;
+            }
+
+        private:
+            static constexpr int MAX_DEPTH = 64;
+            const char *start;
+            const char *cursor;
+            const char *end;
+
+            [[noreturn]] void fail(const char *what) const {
+                throw std::runtime_error("GLB JSON: " + std::string(what) + " at byte " +
+                                         std::to_string(cursor - start));
+            }
+
+            void skipWhitespace() {
+                // GLB pads the JSON chunk with spaces; some writers pad with zeros
+                while (cursor != end && (*cursor == ' ' || *cursor == '\t' || *cursor == '\n' || *cursor == '\r' ||
+                                         *cursor == '\0')) {
+                    ++cursor;
+                }
+            }
+
+            void expect(std::string_view literal) {
+                if (static_cast<size_t>(end - cursor) < literal.size() ||
+                    std::string_view(cursor, literal.size()) != literal) {
+                    fail("unexpected token");
+                }
+                cursor += literal.size();
+            }
+
+            GlbJson parseValue(int depth) {
+                if (depth > MAX_DEPTH) fail("nesting too deep");
+                skipWhitespace();
+                if (cursor == end) fail("unexpected end");
+                GlbJson value;
+                switch (*cursor) {
+                    case '{':
+                        value.type = GlbJson::Type::Object;
+                        ++cursor;
+                        skipWhitespace();
+                        if (cursor != end && *cursor == '}') {
+                            ++cursor;
+                            return value;
+                        }
+                        while (true) {
+                            skipWhitespace();
+                            std::string key = parseString();
+                            skipWhitespace();
+                            expect(":");
+                            value.object.emplace_back(std::move(key), parseValue(depth + 1));
+                            skipWhitespace();
+                            if (cursor != end && *cursor == ',') {
+                                ++cursor;
+                                continue;
+                            }
+                            expect("}");
+                            return value;
+                        }
+                    case '[':
+                        value.type = GlbJson::Type::Array;
+                        ++cursor;
+                        skipWhitespace();
+                        if (cursor != end && *cursor == ']') {
+                            ++cursor;
+                            return value;
+                        }
+                        while (true) {
+                            value.array.push_back(parseValue(depth + 1));
+                            skipWhitespace();
+                            if (cursor != end && *cursor == ',') {
+                                ++cursor;
+                                continue;
+                            }
+                            expect("]");
+                            return value;
+                        }
+                    case '"':
+                        value.type = GlbJson::Type::String;
+                        value.string = parseString();
+                        return value;
+                    case 't':
+                        expect("true");
+                        value.type = GlbJson::Type::Bool;
+                        value.boolean = true;
+                        return value;
+                    case 'f':
+                        expect("false");
+                        value.type = GlbJson::Type::Bool;
+                        return value;
+                    case 'n':
+                        expect("null");
+                        return value;
+                    default:
+                        value.type = GlbJson::Type::Number;
+                        value.number = parseNumber();
+                        return value;
+                }
+            }
+
+            double parseNumber() {
+                const char *first = cursor;
+                while (cursor != end && (std::isdigit(static_cast<unsigned char>(*cursor)) || *cursor == '-' ||
+                                         *cursor == '+' || *cursor == '.' || *cursor == 'e' || *cursor == 'E')) {
+                    ++cursor;
+                }
+                if (first == cursor) fail("unexpected character");
+                const std::string text(first, cursor);
+                char *parsedEnd = nullptr;
+                const double number = std::strtod(text.c_str(), &parsedEnd);
+                if (parsedEnd != text.c_str() + text.size()) fail("malformed number");
+                return number;
+            }
+
+            // Escapes are decoded; \u code points are written as UTF-8 (surrogate pairs are not joined)
+            std::string parseString() {
+                expect("\"");
+                std::string result;
+                while (true) {
+                    if (cursor == end) fail("unterminated string");
+                    const char c = *cursor++;
+                    if (c == '"') return result;
+                    if (c != '\\') {
+                        result.push_back(c);
+                        continue;
+                    }
+                    if (cursor == end) fail("unterminated escape");
+                    const char escape = *cursor++;
+                    switch (escape) {
+                        case 'b': result.push_back('\b');
+                            break;
+                        case 'f': result.push_back('\f');
+                            break;
+                        case 'n': result.push_back('\n');
+                            break;
+                        case 'r': result.push_back('\r');
+                            break;
+                        case 't': result.push_back('\t');
+                            break;
+                        case 'u': {
+                            if (end - cursor < 4) fail("short unicode escape");
+                            char *parsedEnd = nullptr;
+                            const std::string digits(cursor, 4);
+                            const uint32_t code = static_cast<uint32_t>(std::strtoul(digits.c_str(), &parsedEnd, 16));
+                            if (parsedEnd != digits.c_str() + 4) fail("malformed unicode escape");
+                            cursor += 4;
+                            if (code < 0x80) {
+                                result.push_back(static_cast<char>(code));
+                            } else if (code < 0x800) {
+                                result.push_back(static_cast<char>(0xC0 | (code >> 6)));
+                                result.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+                            } else {
+                                result.push_back(static_cast<char>(0xE0 | (code >> 12)));
+                                result.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+                                result.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+                            }
+                            break;
+                        }
+                        default: result.push_back(escape); // \" \\ \/
+                    }
+                }
+            }
+        };
+
+        uint32_t readU32(const std::byte *bytes) {
+            uint32_t value;
+            std::memcpy(&value, bytes, sizeof(value));
+            return value;
+        }
+
+        uint32_t componentSize(uint32_t componentType) {
+            switch (componentType) {
+                case COMPONENT_BYTE:
+                case COMPONENT_UNSIGNED_BYTE: return 1;
+                case COMPONENT_SHORT:
+                case COMPONENT_UNSIGNED_SHORT: return 2;
+                case COMPONENT_UNSIGNED_INT:
+                case COMPONENT_FLOAT: return 4;
+                default: throw std::runtime_error("GLB: unknown accessor component type " +
+                                                  std::to_string(componentType));
+            }
+        }
+
+        // Component `component` of element `index` as a float, applying the normalization rules of glTF
+        float readComponent(const GlbFile::Accessor &accessor, uint32_t index, uint32_t component) {
+            if (accessor.data.empty()) return 0.0f;
+            const std::byte *at = accessor.data.data() + static_cast<size_t>(index) * accessor.stride +
+                                  component * componentSize(accessor.componentType);
+            switch (accessor.componentType) {
+                case COMPONENT_FLOAT: {
+                    float value;
+                    std::memcpy(&value, at, sizeof(value));
+                    return value;
+                }
+                case COMPONENT_UNSIGNED_BYTE: {
+                    const float value = static_cast<float>(static_cast<uint8_t>(*at));
+                    return accessor.normalized ? value / 255.0f : value;
+                }
+                case COMPONENT_BYTE: {
+                    const float value = static_cast<float>(static_cast<int8_t>(*at));
+                    return accessor.normalized ? std::max(value / 127.0f, -1.0f) : value;
+                }
+                case COMPONENT_UNSIGNED_SHORT: {
+                    uint16_t raw;
+                    std::memcpy(&raw, at, sizeof(raw));
+                    return accessor.normalized ? static_cast<float>(raw) / 65535.0f : static_cast<float>(raw);
+                }
+                case COMPONENT_SHORT: {
+                    int16_t raw;
+                    std::memcpy(&raw, at, sizeof(raw));
+                    return accessor.normalized
+                               ? std::max(static_cast<float>(raw) / 32767.0f, -1.0f)
+                               : static_cast<float>(raw);
+                }
+                default: {
+                    uint32_t raw;
+                    std::memcpy(&raw, at, sizeof(raw));
+                    return static_cast<float>(raw);
+                }
+            }
+        }
+
+        glm::vec3 readVec3(const GlbFile::Accessor &accessor, uint32_t index) {
+            if (accessor.componentType == COMPONENT_FLOAT && !accessor.data.empty()) {
+                float value[3];
+                std::memcpy(value, accessor.data.data() + static_cast<size_t>(index) * accessor.stride, sizeof(value));
+                return glm::vec3(value[0], value[1], value[2]);
+            }
+            return glm::vec3(readComponent(accessor, index, 0), readComponent(accessor, index, 1),
+                             readComponent(accessor, index, 2));
+        }
+
+        uint32_t readIndex(const GlbFile::Accessor &accessor, uint32_t index) {
+            const std::byte *at = accessor.data.data() + static_cast<size_t>(index) * accessor.stride;
+            switch (accessor.componentType) {
+                case COMPONENT_UNSIGNED_BYTE: return static_cast<uint8_t>(*at);
+                case COMPONENT_UNSIGNED_SHORT: {
+                    uint16_t value;
+                    std::memcpy(&value, at, sizeof(value));
+                    return value;
+                }
+                case COMPONENT_UNSIGNED_INT: return readU32(at);
+                default: throw std::runtime_error("GLB: index accessors must be unsigned integers");
+            }
+        }
+
+        glm::mat4 nodeTransform(const GlbJson &node) {
+            if (const GlbJson *matrix = node.find("matrix"); matrix && matrix->array.size() == 16) {
+                glm::mat4 result(1.0f); // Column-major, like glm
+                for (int i = 0; i < 16; ++i) result[i / 4][i % 4] = static_cast<float>(matrix->array[i].number);
+                return result;
+            }
+            glm::vec3 translation(0.0f);
+            glm::quat rotation(1.0f, 0.0f, 0.0f, 0.0f);
+            glm::vec3 scale(1.0f);
+            if (const GlbJson *t = node.find("translation"); t && t->array.size() == 3) {
+                translation = glm::vec3(t->array[0].number, t->array[1].number, t->array[2].number);
+            }
+            if (const GlbJson *r = node.find("rotation"); r && r->array.size() == 4) {
+                // glTF stores x, y, z, w; glm::quat takes w first
+                rotation = glm::quat(static_cast<float>(r->array[3].number), static_cast<float>(r->array[0].number),
+                                     static_cast<float>(r->array[1].number), static_cast<float>(r->array[2].number));
+            }
+            if (const GlbJson *s = node.find("scale"); s && s->array.size() == 3) {
+                scale = glm::vec3(s->array[0].number, s->array[1].number, s->array[2].number);
+            }
+            return glm::translate(glm::mat4(1.0f), translation) * glm::mat4_cast(rotation) *
+                   glm::scale(glm::mat4(1.0f), scale);
+        }
+
+        // One triangle primitive placed by one node, and where its data goes in the merged mesh
+        struct PrimitiveInstance {
+            const GlbJson *primitive;
+            glm::mat4 transform;
+            size_t firstVertex;
+            size_t vertexCount;
+            size_t firstIndex;
+            size_t indexCount;
+        };
+
+        // Walks the default scene (or every mesh once if the file has no scenes) in node order
+        std::vector<PrimitiveInstance> collectPrimitives(const GlbFile &file) {
+            const GlbJson &root = file.json();
+            std::vector<PrimitiveInstance> instances;
+            size_t vertexCount = 0;
+            size_t indexCount = 0;
+            uint32_t skipped = 0;
+            auto addMesh = [&](uint32_t meshIndex, const glm::mat4 &transform) {
+                const GlbJson *mesh = root.at("meshes", meshIndex);
+                const GlbJson *primitives = mesh ? mesh->find("primitives") : nullptr;
+                if (!primitives) throw std::runtime_error("GLB: node references missing mesh");
+                for (const GlbJson &primitive: primitives->array) {
+                    const GlbJson *attributes = primitive.find("attributes");
+                    const GlbJson *position = attributes ? attributes->find("POSITION") : nullptr;
+                    if (primitive.numberOr("mode", MODE_TRIANGLES) != MODE_TRIANGLES || !position) {
+                        skipped++;
+                        continue;
+                    }
+                    const GlbFile::Accessor positions = file.accessor(static_cast<uint32_t>(position->number));
+                    const GlbJson *indices = primitive.find("indices");
+                    const size_t primitiveIndices = indices
+                                                        ? file.accessor(static_cast<uint32_t>(indices->number)).count
+                                                        : positions.count;
+                    instances.push_back({
+                        &primitive, transform, vertexCount, positions.count, indexCount, primitiveIndices / 3 * 3
+                    });
+                    vertexCount += positions.count;
+                    indexCount += primitiveIndices / 3 * 3;
+                }
+            };
+
+            const GlbJson *scene = root.at("scenes", static_cast<size_t>(root.numberOr("scene", 0.0)));
+            if (scene && scene->find("nodes")) {
+                // Explicit stack; glTF node hierarchies are trees, the depth bound catches cycles
+                std::vector<std::pair<uint32_t, glm::mat4>> stack;
+                for (const GlbJson &node: scene->find("nodes")->array) {
+                    stack.emplace_back(static_cast<uint32_t>(node.number), glm::mat4(1.0f));
+                }
+                std::reverse(stack.begin(), stack.end());
+                const GlbJson *nodes = root.find("nodes");
+                const size_t nodeCount = nodes ? nodes->array.size() : 0;
+                size_t visited = 0;
+                while (!stack.empty()) {
+                    auto [nodeIndex, parent] = stack.back();
+                    stack.pop_back();
+                    if (nodeIndex >= nodeCount || ++visited > nodeCount * 64) {
+                        throw std::runtime_error("GLB: invalid node hierarchy");
+                    }
+                    const GlbJson &node = nodes->array[nodeIndex];
+                    const glm::mat4 transform = parent * nodeTransform(node);
+                    if (const GlbJson *mesh = node.find("mesh")) {
+                        addMesh(static_cast<uint32_t>(mesh->number), transform);
+                    }
+                    if (const GlbJson *children = node.find("children")) {
+                        for (auto child = children->array.rbegin(); child != children->array.rend(); ++child) {
+                            stack.emplace_back(static_cast<uint32_t>(child->number), transform);
+                        }
+                    }
+                }
+            } else if (const GlbJson *meshes = root.find("meshes")) {
+                for (uint32_t mesh = 0; mesh < meshes->array.size(); ++mesh) addMesh(mesh, glm::mat4(1.0f));
+            }
+            if (skipped > 0) spdlog::warn("GLB: skipped {} non-triangle or position-less primitives.", skipped);
+            return instances;
+        }
+
+        // Runs count jobs on up to hardware_concurrency threads; the first exception is rethrown
+        uint32_t parallelFor(size_t count, const std::function<void(size_t)> &job) {
+            const uint32_t threadCount = static_cast<uint32_t>(
+                std::min<size_t>(count, std::max(std::thread::hardware_concurrency(), 1u)));
+            std::atomic<size_t> next{0};
+            std::exception_ptr failure;
+            std::atomic<bool> failed{false};
+            auto worker = [&] {
+                for (size_t i = next++; i < count && !failed; i = next++) {
+                    try {
+                        job(i);
+                    } catch (...) {
+                        if (!failed.exchange(true)) failure = std::current_exception();
+                    }
+                }
+            };
+            std::vector<std::thread> threads;
+            for (uint32_t i = 1; i < threadCount; ++i) threads.emplace_back(worker);
+            worker();
+            for (std::thread &thread: threads) thread.join();
+            if (failure) std::rethrow_exception(failure);
+            return std::max(threadCount, 1u);
+        }
+    }
+
+    GlbFile::GlbFile(const std::string &path) {
+        const auto mapStart = std::chrono::high_resolution_clock::now();
+#ifdef _WIN32
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                  FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE) throw std::runtime_error("GLB: cannot open " + path);
+        mapping.fileHandle = file;
+        LARGE_INTEGER fileSize{};
+        GetFileSizeEx(file, &fileSize);
+        mapping.size = static_cast<size_t>(fileSize.QuadPart);
+        if (mapping.size > 0) mapping.mappingHandle = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping.mappingHandle) {
+            mapping.data = static_cast<const std::byte *>(MapViewOfFile(mapping.mappingHandle, FILE_MAP_READ, 0, 0, 0));
+        }
+        if (!mapping.data) throw std::runtime_error("GLB: cannot map " + path);
+#else
+        const int descriptor = open(path.c_str(), O_RDONLY);
+        if (descriptor < 0) throw std::runtime_error("GLB: cannot open " + path);
+        struct stat status{};
+        const size_t fileSize = fstat(descriptor, &status) == 0 ? static_cast<size_t>(status.st_size) : 0;
+        void *view = fileSize > 0 ? mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, descriptor, 0) : MAP_FAILED;
+        close(descriptor); // The mapping keeps the file alive
+        if (view == MAP_FAILED) throw std::runtime_error("GLB: cannot map " + path);
+        madvise(view, fileSize, MADV_WILLNEED);
+        mapping.data = static_cast<const std::byte *>(view);
+        mapping.size = fileSize;
+#endif
+        mapMs = elapsedMs(mapStart);
+
+        // 12-byte header, then chunks of {length, type, data}; JSON first, BIN optional
+        const std::byte *data = mapping.data;
+        const size_t size = mapping.size;
+        auto invalid = [&](const char *what) {
+            return std::runtime_error("GLB: " + path + ": " + what);
+        };
+        if (size < 20 || readU32(data) != GLB_MAGIC) throw invalid("not a binary glTF file");
+        if (readU32(data + 4) != 2) throw invalid("unsupported glTF version");
+        if (readU32(data + 8) > size) throw invalid("truncated file");
+        std::span<const std::byte> jsonChunk;
+        for (size_t offset = 12; offset + 8 <= size;) {
+            const size_t length = readU32(data + offset);
+            const uint32_t type = readU32(data + offset + 4);
+            if (offset + 8 + length > size) throw invalid("truncated chunk");
+            const std::span<const std::byte> chunk(data + offset + 8, length);
+            if (type == GLB_CHUNK_JSON && jsonChunk.empty()) jsonChunk = chunk;
+            else if (type == GLB_CHUNK_BIN && binaryChunk.empty()) binaryChunk = chunk;
+            offset += 8 + (length + 3) / 4 * 4;
+        }
+        if (jsonChunk.empty()) throw invalid("missing JSON chunk");
+
+        const auto parseStart = std::chrono::high_resolution_clock::now();
+        const char *json = reinterpret_cast<const char *>(jsonChunk.data());
+        try {
+            root = std::make_unique<GlbJson>(JsonParser(json, json + jsonChunk.size()).parseDocument());
+        } catch (const std::runtime_error &e) {
+            throw invalid(e.what());
+        }
+        parseMs = elapsedMs(parseStart);
+    }
+
+    GlbFile::~GlbFile() = default;
+
+    GlbFile::Mapping::~Mapping() {
+#ifdef _WIN32
+        if (data) UnmapViewOfFile(data);
+        if (mappingHandle) CloseHandle(mappingHandle);
+        if (fileHandle) CloseHandle(fileHandle);
+#else
+        if (data) munmap(const_cast<std::byte *>(data), size);
+#endif
+    }
+
+    std::span<const std::byte> GlbFile::bufferView(uint32_t index) const {
+        const GlbJson *view = root->at("bufferViews", index);
+        if (!view) throw std::runtime_error("GLB: missing buffer view " + std::to_string(index));
+        if (view->numberOr("buffer", 0.0) != 0.0) throw std::runtime_error("GLB: external buffers are not supported");
+        const size_t offset = static_cast<size_t>(view->numberOr("byteOffset", 0.0));
+        const size_t length = static_cast<size_t>(view->numberOr("byteLength", 0.0));
+        if (offset + length > binaryChunk.size()) throw std::runtime_error("GLB: buffer view exceeds the binary chunk");
+        return binaryChunk.subspan(offset, length);
+    }
+
+    bool GlbFile::Accessor::packed() const {
+        return stride == components * componentSize(componentType);
+    }
+
+    GlbFile::Accessor GlbFile::accessor(uint32_t index) const {
+        const GlbJson *description = root->at("accessors", index);
+        if (!description) throw std::runtime_error("GLB: missing accessor " + std::to_string(index));
+        Accessor result;
+        result.count = static_cast<uint32_t>(description->numberOr("count", 0.0));
+        result.componentType = static_cast<uint32_t>(description->numberOr("componentType", 0.0));
+        const GlbJson *normalized = description->find("normalized");
+        result.normalized = normalized && normalized->boolean;
+        const GlbJson *type = description->find("type");
+        const std::string &typeName = type ? type->string : std::string();
+        result.components = typeName == "SCALAR" ? 1 : typeName == "VEC2" ? 2 : typeName == "VEC3" ? 3
+                                                   : typeName == "VEC4" ? 4 : 0;
+        if (result.components == 0) throw std::runtime_error("GLB: unsupported accessor type '" + typeName + "'");
+        const uint32_t elementSize = result.components * componentSize(result.componentType);
+        result.stride = elementSize;
+        if (const GlbJson *viewIndex = description->find("bufferView")) {
+            const std::span<const std::byte> view = bufferView(static_cast<uint32_t>(viewIndex->number));
+            const GlbJson *viewDescription = root->at("bufferViews", static_cast<size_t>(viewIndex->number));
+            result.stride = std::max(static_cast<uint32_t>(viewDescription->numberOr("byteStride", 0.0)), elementSize);
+            const size_t offset = static_cast<size_t>(description->numberOr("byteOffset", 0.0));
+            const size_t span = result.count == 0
+                                    ? 0
+                                    : static_cast<size_t>(result.count - 1) * result.stride + elementSize;
+            if (offset + span > view.size()) throw std::runtime_error("GLB: accessor exceeds its buffer view");
+            result.data = view.subspan(offset, span);
+        }
+        return result;
+    }
+
+    namespace GlbLoader {
+        MeshLayout MeasureMesh(const GlbFile &file) {
+            MeshLayout layout;
+            for (const PrimitiveInstance &instance: collectPrimitives(file)) {
+                layout.vertexCount += instance.vertexCount;
+                layout.indexCount += instance.indexCount;
+            }
+            return layout;
+        }
+
+        void DecodeMesh(const GlbFile &file, PropVertex *outVertices, uint32_t *outIndices, GlbLoadStats *stats) {
+            const auto decodeStart = std::chrono::high_resolution_clock::now();
+            const GlbJson &root = file.json();
+            const std::vector<PrimitiveInstance> instances = collectPrimitives(file);
+
+            // A job decodes up to DECODE_CHUNK elements of one attribute stream of one primitive, so large
+            // primitives are spread over the threads as well; every job writes its own output range
+            enum class Stream { Position, Normal, Color, Index };
+            struct DecodeJob {
+                size_t instance;
+                Stream stream;
+                uint32_t begin;
+                uint32_t end;
+            };
+            std::vector<DecodeJob> jobs;
+            std::vector<uint8_t> needsNormals(instances.size(), 0);
+            for (size_t i = 0; i < instances.size(); ++i) {
+                needsNormals[i] = instances[i].primitive->find("attributes")->find("NORMAL") ? 0 : 1;
+                for (Stream stream: {Stream::Position, Stream::Normal, Stream::Color, Stream::Index}) {
+                    const size_t count = stream == Stream::Index ? instances[i].indexCount : instances[i].vertexCount;
+                    for (size_t begin = 0; begin < count; begin += DECODE_CHUNK) {
+                        jobs.push_back({
+                            i, stream, static_cast<uint32_t>(begin),
+                            static_cast<uint32_t>(std::min(begin + DECODE_CHUNK, count))
+                        });
+                    }
+                }
+            }
+            std::atomic<size_t> directBytes{0};
+            std::atomic<size_t> convertedBytes{0};
+            const uint32_t threads = parallelFor(jobs.size(), [&](size_t jobIndex) {
+                const DecodeJob &job = jobs[jobIndex];
+                const PrimitiveInstance &instance = instances[job.instance];
+                const GlbJson &attributes = *instance.primitive->find("attributes");
+                PropVertex *vertices = outVertices + instance.firstVertex;
+                const uint32_t vertexCount = static_cast<uint32_t>(instance.vertexCount);
+
+                switch (job.stream) {
+                    case Stream::Position: {
+                        const GlbFile::Accessor positions = file.accessor(
+                            static_cast<uint32_t>(attributes.find("POSITION")->number));
+                        for (uint32_t v = job.begin; v < job.end; ++v) {
+                            vertices[v].pos = glm::vec3(instance.transform * glm::vec4(readVec3(positions, v), 1.0f));
+                        }
+                        convertedBytes += static_cast<size_t>(job.end - job.begin) * positions.stride;
+                        break;
+                    }
+                    case Stream::Normal: {
+                        if (needsNormals[job.instance]) break; // Generated once positions and indices are in
+                        const GlbFile::Accessor normals = file.accessor(
+                            static_cast<uint32_t>(attributes.find("NORMAL")->number));
+                        if (normals.count < vertexCount) throw std::runtime_error("GLB: NORMAL count mismatch");
+                        const glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(instance.transform)));
+                        for (uint32_t v = job.begin; v < job.end; ++v) {
+                            const glm::vec3 world = normalMatrix * readVec3(normals, v);
+                            const float length = glm::length(world);
+                            vertices[v].normal = length > 0.0f ? world / length : glm::vec3(0.0f, 1.0f, 0.0f);
+                        }
+                        convertedBytes += static_cast<size_t>(job.end - job.begin) * normals.stride;
+                        break;
+                    }
+                    case Stream::Color: {
+                        glm::vec4 baseColor(1.0f);
+                        if (const GlbJson *material = instance.primitive->find("material")) {
+                            const GlbJson *description = root.at("materials", static_cast<size_t>(material->number));
+                            const GlbJson *pbr = description ? description->find("pbrMetallicRoughness") : nullptr;
+                            const GlbJson *factor = pbr ? pbr->find("baseColorFactor") : nullptr;
+                            if (factor && factor->array.size() == 4) {
+                                baseColor = glm::vec4(factor->array[0].number, factor->array[1].number,
+                                                      factor->array[2].number, factor->array[3].number);
+                            }
+                        }
+                        const GlbJson *color = attributes.find("COLOR_0");
+                        if (!color) {
+                            for (uint32_t v = job.begin; v < job.end; ++v) vertices[v].color = glm::vec3(baseColor);
+                            break;
+                        }
+                        const GlbFile::Accessor colors = file.accessor(static_cast<uint32_t>(color->number));
+                        if (colors.count < vertexCount) throw std::runtime_error("GLB: COLOR_0 count mismatch");
+                        for (uint32_t v = job.begin; v < job.end; ++v) {
+                            vertices[v].color = readVec3(colors, v) * glm::vec3(baseColor);
+                        }
+                        convertedBytes += static_cast<size_t>(job.end - job.begin) * colors.stride;
+                        break;
+                    }
+                    case Stream::Index: {
+                        uint32_t *indices = outIndices + instance.firstIndex;
+                        const GlbJson *indexAccessor = instance.primitive->find("indices");
+                        // A mirroring transform turns the triangles inside out; swap two corners back
+                        const bool mirrored = glm::determinant(glm::mat3(instance.transform)) < 0.0f;
+                        const uint32_t base = static_cast<uint32_t>(instance.firstVertex);
+                        if (!indexAccessor) {
+                            for (uint32_t i = job.begin; i < job.end; ++i) indices[i] = base + i;
+                        } else {
+                            const GlbFile::Accessor source =
+                                    file.accessor(static_cast<uint32_t>(indexAccessor->number));
+                            if (source.data.empty()) throw std::runtime_error("GLB: index accessor without data");
+                            if (source.componentType == COMPONENT_UNSIGNED_INT && source.packed() && base == 0 &&
+                                !mirrored) {
+                                // Already what the index buffer holds
+                                std::memcpy(indices + job.begin, source.data.data() + job.begin * sizeof(uint32_t),
+                                            (job.end - job.begin) * sizeof(uint32_t));
+                                directBytes += (job.end - job.begin) * sizeof(uint32_t);
+                            } else {
+                                for (uint32_t i = job.begin; i < job.end; ++i) indices[i] = base + readIndex(source, i);
+                                convertedBytes += static_cast<size_t>(job.end - job.begin) * source.stride;
+                            }
+                            for (uint32_t i = job.begin; i < job.end; ++i) {
+                                if (indices[i] - base >= vertexCount) {
+                                    throw std::runtime_error("GLB: index out of range");
+                                }
+                            }
+                        }
+                        if (mirrored) {
+                            for (uint32_t i = job.begin; i + 2 < job.end; i += 3) {
+                                std::swap(indices[i + 1], indices[i + 2]);
+                            }
+                        }
+                        break;
+                    }
+                }
+            });
+
+            // Area-weighted smooth normals for primitives that came without them
+            parallelFor(instances.size(), [&](size_t instanceIndex) {
+                if (!needsNormals[instanceIndex]) return;
+                const PrimitiveInstance &instance = instances[instanceIndex];
+                PropVertex *vertices = outVertices + instance.firstVertex;
+                const uint32_t *indices = outIndices + instance.firstIndex;
+                for (size_t v = 0; v < instance.vertexCount; ++v) vertices[v].normal = glm::vec3(0.0f);
+                for (size_t i = 0; i + 2 < instance.indexCount; i += 3) {
+                    PropVertex &a = outVertices[indices[i]];
+                    PropVertex &b = outVertices[indices[i + 1]];
+                    PropVertex &c = outVertices[indices[i + 2]];
+                    const glm::vec3 faceNormal = glm::cross(b.pos - a.pos, c.pos - a.pos);
+                    a.normal += faceNormal;
+                    b.normal += faceNormal;
+                    c.normal += faceNormal;
+                }
+                for (size_t v = 0; v < instance.vertexCount; ++v) {
+                    const float length = glm::length(vertices[v].normal);
+                    vertices[v].normal = length > 0.0f ? vertices[v].normal / length : glm::vec3(0.0f, 1.0f, 0.0f);
+                }
+            });
+
+            if (stats) {
+                stats->fileBytes = file.fileSize();
+                stats->primitives = static_cast<uint32_t>(instances.size());
+                stats->directBytes = directBytes;
+                stats->convertedBytes = convertedBytes;
+                stats->threads = threads;
+                stats->mapMs = file.mapMs;
+                stats->parseMs = file.parseMs;
+                stats->decodeMs = elapsedMs(decodeStart);
+            }
+        }
+
+        bool LoadMesh(const std::string &path, PropMesh &outMesh, GlbLoadStats *stats) {
+            try {
+                const GlbFile file(path);
+                const MeshLayout layout = MeasureMesh(file);
+                if (layout.indexCount == 0) {
+                    spdlog::error("GLB '{}' contains no triangles.", path);
+                    return false;
+                }
+                outMesh.vertices.resize(layout.vertexCount);
+                outMesh.indices.resize(layout.indexCount);
+                DecodeMesh(file, outMesh.vertices.data(), outMesh.indices.data(), stats);
+            } catch (const std::exception &e) {
+                spdlog::error("Failed to load '{}': {}", path, e.what());
+                return false;
+            }
+            outMesh.boundsMin = glm::vec3(std::numeric_limits<float>::max());
+            outMesh.boundsMax = glm::vec3(std::numeric_limits<float>::lowest());
+            for (const PropVertex &vertex: outMesh.vertices) {
+                outMesh.boundsMin = glm::min(outMesh.boundsMin, vertex.pos);
+                outMesh.boundsMax = glm::max(outMesh.boundsMax, vertex.pos);
+            }
+            return true;
+        }
+    }
+} // namespace VkGameProjectOne
@@ -0,0 +1,98 @@
+// GlbLoader.h
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include "Props.h"
+
+namespace vk_project_one {
+    struct GlbJson;
+
+    // A binary glTF 2.0 file, memory-mapped. The JSON chunk is parsed once on open; the binary chunk is
+    // never copied, buffer views and accessors are handed out as spans into the mapping.
+    class GlbFile {
+    public:
+        // Throws std::runtime_error if the file cannot be mapped or is not a GLB 2.0 container.
+        explicit GlbFile(const std::string &path);
+
+        ~GlbFile();
+
+        GlbFile(const GlbFile &) = delete;
+
+        GlbFile &operator=(const GlbFile &) = delete;
+
+        size_t fileSize() const { return mapping.size; }
+        const GlbJson &json() const { return *root; }
+
+        // Bytes of a buffer view (embedded binary chunk only; external buffers are not supported).
+        std::span<const std::byte> bufferView(uint32_t index) const;
+
+        // Element layout of an accessor and the bytes it covers (stride = distance between elements).
+        struct Accessor {
+            std::span<const std::byte> data; // Empty for accessors without a buffer view (all zeros)
+            uint32_t count = 0;
+            uint32_t componentType = 0; // GL enum, e.g. 5126 = FLOAT
+            uint32_t components = 0; // 1 (SCALAR) to 4 (VEC4)
+            uint32_t stride = 0;
+            bool normalized = false;
+
+            // True if the elements are tightly packed, as a Vulkan vertex or index buffer expects them
+            bool packed() const;
+        };
+
+        Accessor accessor(uint32_t index) const;
+
+        float mapMs = 0.0f; // Time to open and map the file
+        float parseMs = 0.0f; // Time to parse the JSON chunk
+
+    private:
+        // Owns the mapped view, so it is also released when the constructor throws after mapping
+        struct Mapping {
+            const std::byte *data = nullptr;
+            size_t size = 0;
+#ifdef _WIN32
+            void *fileHandle = nullptr;
+            void *mappingHandle = nullptr;
+#endif
+            ~Mapping();
+        } mapping;
+
+        std::span<const std::byte> binaryChunk;
+        std::unique_ptr<GlbJson> root;
+    };
+
+    struct GlbLoadStats {
+        size_t fileBytes = 0;
+        uint32_t primitives = 0; // Triangle primitive instances (a mesh used by two nodes counts twice)
+        size_t directBytes = 0; // Copied straight from the mapping (already in the target format)
+        size_t convertedBytes = 0; // Decoded from another format or transformed
+        uint32_t threads = 0;
+        float mapMs = 0.0f;
+        float parseMs = 0.0f;
+        float decodeMs = 0.0f;
+    };
+
+    namespace GlbLoader {
+        // Sizes of the merged mesh LoadMesh produces, so callers can provide the destination themselves.
+        struct MeshLayout {
+            size_t vertexCount = 0;
+            size_t indexCount = 0;
+        };
+
+        MeshLayout MeasureMesh(const GlbFile &file);
+
+        // Decodes every triangle primitive of the default scene, with its node transform applied, into
+        // one PropVertex / uint32 index stream (e.g. a mapped staging buffer) sized by MeasureMesh.
+        // Accessors are decoded in parallel; indices that are already packed uint32 are copied as they
+        // are. Normals are generated for primitives without them, colors come from COLOR_0 times the
+        // material base color. Throws std::runtime_error on malformed accessors.
+        void DecodeMesh(const GlbFile &file, PropVertex *outVertices, uint32_t *outIndices,
+                        GlbLoadStats *stats = nullptr);
+
+        // MeasureMesh and DecodeMesh into a PropMesh with bounds; logs and returns false on failure.
+        bool LoadMesh(const std::string &path, PropMesh &outMesh, GlbLoadStats *stats = nullptr);
+    }
+} // namespace VkGameProjectOne
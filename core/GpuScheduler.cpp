@@ -0,0 +1,95 @@
+// GpuScheduler.cpp
+
+#include "core/GpuScheduler.h"
+#include "core/GpuTimer.h"
+#include <algorithm>
+
+namespace vk_project_one {
+    // Weight of the newest per-slice measurement
+    constexpr float SLICE_COST_WEIGHT = 0.25f;
+
+    void GpuScheduler::init(GpuTimer *gpuTimer, uint32_t frames, float budget) {
+        timer = gpuTimer;
+        framesInFlight = frames;
+        budgetMs = budget;
+    }
+
+    uint32_t GpuScheduler::addJob(const std::string &name, uint32_t sliceCount, RecordSlice recordSlice) {
+        Job job;
+        job.name = name;
+        job.sliceCount = std::max(sliceCount, 1u);
+        job.recordSlice = std::move(recordSlice);
+        job.scope = timer->registerScope(name);
+        job.slicesIn.assign(framesInFlight, 0);
+        jobs.push_back(std::move(job));
+        return static_cast<uint32_t>(jobs.size() - 1);
+    }
+
+    void GpuScheduler::request(uint32_t jobId, bool urgent) {
+        Job &job = jobs[jobId];
+        job.nextSlice = 0;
+        job.urgent = job.urgent || urgent;
+        queue.erase(std::remove(queue.begin(), queue.end(), jobId), queue.end());
+        if (job.urgent) {
+            // Behind the urgent jobs already queued
+            auto position = std::find_if(queue.begin(), queue.end(), [this](uint32_t other) {
+                return !jobs[other].urgent;
+            });
+            queue.insert(position, jobId);
+        } else {
+            queue.push_back(jobId);
+        }
+        job.pending = true;
+    }
+
+    void GpuScheduler::record(VkCommandBuffer commandBuffer, uint32_t frameIndex) {
+        for (Job &job: jobs) job.slicesIn[frameIndex] = 0;
+        if (queue.empty()) return;
+
+        // Unmeasured slices are assumed to use the whole budget, so a new job starts one slice per frame
+        const bool eager = budgetMs <= 0.0f;
+        float plannedMs = 0.0f;
+        bool recordedAny = false;
+        while (!queue.empty()) {
+            Job &job = jobs[queue.front()];
+            const float costMs = job.sliceMs > 0.0f ? job.sliceMs : budgetMs;
+            if (recordedAny && !eager && !job.urgent && plannedMs + costMs > budgetMs) break;
+
+            timer->beginScope(commandBuffer, job.scope);
+            while (job.nextSlice < job.sliceCount) {
+                job.recordSlice(commandBuffer, job.nextSlice++);
+                job.slicesIn[frameIndex]++;
+                plannedMs += costMs;
+                stats.slices++;
+                recordedAny = true;
+                const float nextCostMs = job.sliceMs > 0.0f ? job.sliceMs : budgetMs;
+                if (!eager && !job.urgent && plannedMs + nextCostMs > budgetMs) break;
+            }
+            timer->endScope(commandBuffer, job.scope);
+
+            if (job.nextSlice < job.sliceCount) break; // Out of budget in the middle of this job
+            job.pending = false;
+            job.urgent = false;
+            stats.completions++;
+            queue.erase(queue.begin());
+        }
+        if (recordedAny) stats.frames++;
+    }
+
+    void GpuScheduler::collect(uint32_t frameIndex) {
+        float frameMs = 0.0f;
+        for (Job &job: jobs) {
+            const uint32_t slices = job.slicesIn[frameIndex];
+            if (slices == 0) continue;
+            const float ms = timer->getLastMs(job.scope);
+            if (ms <= 0.0f) continue; // Timestamps unsupported or not available
+            const float sliceMs = ms / static_cast<float>(slices);
+            job.sliceMs = job.sliceMs > 0.0f ? job.sliceMs + (sliceMs - job.sliceMs) * SLICE_COST_WEIGHT : sliceMs;
+            frameMs += ms;
+        }
+        if (frameMs <= 0.0f) return;
+        stats.msSum += frameMs;
+        stats.maxFrameMs = std::max(stats.maxFrameMs, frameMs);
+        if (budgetMs > 0.0f && frameMs > budgetMs) stats.overBudgetFrames++;
+    }
+} // namespace VkGameProjectOne
@@ -0,0 +1,86 @@
+// GpuScheduler.h
+
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+namespace vk_project_one {
+    class GpuTimer;
+
+    // Spreads GPU work that may take several frames (cube map refreshes, LUT bakes, ...) over the frames
+    // that follow its request. Each job is a fixed number of slices recorded in order; every frame records
+    // the pending slices that fit into a GPU-time budget, based on the per-slice cost measured with a
+    // GpuTimer scope per job. At least one slice is recorded per frame so every job finishes.
+    class GpuScheduler {
+    public:
+        // Records one slice, outside of any render pass. Slices of a job are recorded in order, but
+        // possibly in different frames (and command buffers).
+        using RecordSlice = std::function<void(VkCommandBuffer commandBuffer, uint32_t slice)>;
+
+        // Statistics over the frames since the last resetStats(), for benchmark reporting.
+        struct Stats {
+            uint32_t frames = 0; // Frames that recorded at least one slice
+            uint32_t slices = 0;
+            uint32_t completions = 0; // Jobs whose last slice was recorded
+            uint32_t overBudgetFrames = 0; // Measured frames whose slices took longer than the budget
+            float msSum = 0.0f; // Measured GPU time of all slices
+            float maxFrameMs = 0.0f; // Most GPU time spent on slices in one frame
+        };
+
+        // budgetMs <= 0 records every pending slice in the frame of the request (no amortization).
+        void init(GpuTimer *timer, uint32_t framesInFlight, float budgetMs);
+
+        // Registers a job and its timer scope (named after the job). Call during initialization.
+        uint32_t addJob(const std::string &name, uint32_t sliceCount, RecordSlice recordSlice);
+
+        // (Re)starts a job from its first slice. Urgent jobs record all their slices in the next frame,
+        // for results that are needed right away (e.g. the first bake).
+        void request(uint32_t job, bool urgent = false);
+
+        bool isPending(uint32_t job) const { return jobs[job].pending; }
+
+        // Records the slices of this frame, outside of any render pass, after GpuTimer::beginFrame.
+        void record(VkCommandBuffer commandBuffer, uint32_t frameIndex);
+
+        // Updates the slice costs from this frame slot. Call after GpuTimer::collect for the slot.
+        void collect(uint32_t frameIndex);
+
+        // True if the frame slot recorded slices of the job (until its next record).
+        bool recordedIn(uint32_t job, uint32_t frameIndex) const { return jobs[job].slicesIn[frameIndex] > 0; }
+
+        uint32_t getScope(uint32_t job) const { return jobs[job].scope; }
+
+        float getSliceMs(uint32_t job) const { return jobs[job].sliceMs; }
+
+        float getBudgetMs() const { return budgetMs; }
+
+        void setBudgetMs(float ms) { budgetMs = ms; }
+
+        const Stats &getStats() const { return stats; }
+
+        void resetStats() { stats = {}; }
+
+    private:
+        struct Job {
+            std::string name;
+            uint32_t sliceCount = 0;
+            RecordSlice recordSlice;
+            uint32_t scope = 0;
+            uint32_t nextSlice = 0;
+            bool pending = false;
+            bool urgent = false;
+            float sliceMs = 0.0f; // Smoothed GPU time of one slice (0 = not measured yet)
+            std::vector<uint32_t> slicesIn; // Slices recorded per frame slot
+        };
+
+        GpuTimer *timer = nullptr;
+        uint32_t framesInFlight = 0;
+        float budgetMs = 0.0f;
+        std::vector<Job> jobs;
+        std::vector<uint32_t> queue; // Pending jobs, urgent ones first, then in request order
+        Stats stats;
+    };
+} // namespace VkGameProjectOne
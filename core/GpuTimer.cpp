@@ -0,0 +1,131 @@
+// GpuTimer.cpp
+
+#include "core/GpuTimer.h"
+#include "core/VkCheck.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+
+namespace vk_project_one {
+    // Weight of the newest sample in the exponential moving average
+    constexpr float AVERAGE_WEIGHT = 0.1f;
+
+    GpuTimer::~GpuTimer() {
+        destroy();
+    }
+
+    void GpuTimer::init(VkDevice vkDevice, VkPhysicalDevice physicalDevice, uint32_t queueFamilyIndex,
+                        uint32_t frames, uint32_t scopeCapacity) {
+        device = vkDevice;
+        framesInFlight = frames;
+        maxScopes = scopeCapacity;
+
+        VkPhysicalDeviceProperties properties;
+        vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+
+        uint32_t queueFamilyCount = 0;
+        vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, nullptr);
+        std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+        vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, queueFamilies.data());
+
+        const uint32_t validBits = queueFamilyIndex < queueFamilyCount
+                                       ? queueFamilies[queueFamilyIndex].timestampValidBits
+                                       : 0;
+        if (validBits == 0 || properties.limits.timestampPeriod == 0.0f) {
+            spdlog::warn("GPU timestamps not supported on queue family {}. GPU timings disabled.", queueFamilyIndex);
+            return;
+        }
+        timestampPeriodNs = properties.limits.timestampPeriod;
+        timestampMask = validBits >= 64 ? ~0ull : ((1ull << validBits) - 1);
+
+        VkQueryPoolCreateInfo poolInfo{};
+        poolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+        poolInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+        poolInfo.queryCount = framesInFlight * maxScopes * 2; // Begin + end per scope per frame
+
+        VkResult result = vkCreateQueryPool(device, &poolInfo, nullptr, &queryPool);
+        VK_CHECK(result, "Failed to create timestamp query pool");
+
+        writtenScopes.assign(framesInFlight, std::vector<bool>(maxScopes, false));
+        readback.resize(static_cast<size_t>(maxScopes) * 2 * 2);
+        spdlog::info("GPU timer created ({} scopes x {} frames, period {:.2f} ns, {} valid bits).",
+                     maxScopes, framesInFlight, timestampPeriodNs, validBits);
+    }
+
+    void GpuTimer::destroy() {
+        if (queryPool != VK_NULL_HANDLE) vkDestroyQueryPool(device, queryPool, nullptr);
+        queryPool = VK_NULL_HANDLE;
+    }
+
+    uint32_t GpuTimer::registerScope(const std::string &name) {
+        for (uint32_t i = 0; i < scopes.size(); ++i) {
+            if (scopes[i].name == name) return i;
+        }
+        if (scopes.size() >= maxScopes && maxScopes != 0) {
+            spdlog::error("GpuTimer: scope capacity ({}) exceeded by '{}'", maxScopes, name);
+            throw std::runtime_error("GpuTimer scope capacity exceeded");
+        }
+        scopes.push_back({name});
+        return static_cast<uint32_t>(scopes.size() - 1);
+    }
+
+    void GpuTimer::beginFrame(VkCommandBuffer commandBuffer, uint32_t frameIndex) {
+        if (!isSupported()) return;
+        recordingFrame = frameIndex;
+        vkCmdResetQueryPool(commandBuffer, queryPool, queryIndex(frameIndex, 0, false), maxScopes * 2);
+        std::fill(writtenScopes[frameIndex].begin(), writtenScopes[frameIndex].end(), false);
+    }
+
+    void GpuTimer::beginScope(VkCommandBuffer commandBuffer, uint32_t scopeId, VkPipelineStageFlagBits stage) {
+        if (!isSupported()) return;
+        vkCmdWriteTimestamp(commandBuffer, stage, queryPool, queryIndex(recordingFrame, scopeId, false));
+    }
+
+    void GpuTimer::endScope(VkCommandBuffer commandBuffer, uint32_t scopeId, VkPipelineStageFlagBits stage) {
+        if (!isSupported()) return;
+        vkCmdWriteTimestamp(commandBuffer, stage, queryPool, queryIndex(recordingFrame, scopeId, true));
+        writtenScopes[recordingFrame][scopeId] = true;
+    }
+
+    bool GpuTimer::collect(uint32_t frameIndex) {
+        if (!isSupported()) return false;
+        const auto &written = writtenScopes[frameIndex];
+        if (std::find(written.begin(), written.end(), true) == written.end()) return false; // Slice never recorded
+
+        // Read the whole slice in one call; unwritten scopes simply report "not available"
+        const VkResult result = vkGetQueryPoolResults(device, queryPool, queryIndex(frameIndex, 0, false),
+                                                      maxScopes * 2, readback.size() * sizeof(uint64_t),
+                                                      readback.data(), 2 * sizeof(uint64_t),
+                                                      VK_QUERY_RESULT_64_BIT |
+                                                      VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+        if (result != VK_SUCCESS && result != VK_NOT_READY) {
+            spdlog::warn("vkGetQueryPoolResults failed! VkResult: {}", static_cast<int>(result));
+            return false;
+        }
+
+        bool any = false;
+        for (uint32_t i = 0; i < scopes.size(); ++i) {
+            if (!writtenScopes[frameIndex][i]) continue;
+            const uint64_t *begin = &readback[static_cast<size_t>(i) * 4];
+            const uint64_t *end = begin + 2;
+            if (begin[1] == 0 || end[1] == 0) continue; // Not available yet
+
+            const uint64_t ticks = ((end[0] & timestampMask) - (begin[0] & timestampMask)) & timestampMask;
+            const float ms = static_cast<float>(static_cast<double>(ticks) * timestampPeriodNs * 1e-6);
+            Scope &scope = scopes[i];
+            scope.lastMs = ms;
+            scope.averageMs = scope.measured ? scope.averageMs + (ms - scope.averageMs) * AVERAGE_WEIGHT : ms;
+            scope.measured = true;
+            any = true;
+        }
+        std::fill(writtenScopes[frameIndex].begin(), writtenScopes[frameIndex].end(), false);
+        return any;
+    }
+
+    float GpuTimer::getLastMs(uint32_t scopeId) const {
+        return scopeId < scopes.size() ? scopes[scopeId].lastMs : 0.0f;
+    }
+
+    float GpuTimer::getAverageMs(uint32_t scopeId) const {
+        return scopeId < scopes.size() ? scopes[scopeId].averageMs : 0.0f;
+    }
+} // namespace VkGameProjectOne
@@ -0,0 +1,79 @@
+// GpuTimer.h
+
+#pragma once
+#include <vector>
+#include <string>
+#include <vulkan/vulkan.h>
+
+namespace vk_project_one {
+    // Timestamp-query based GPU profiler. Each frame in flight owns its own slice of the
+    // query pool, so results for a frame slot can be read right after its fence has been
+    // waited on without stalling the GPU.
+    class GpuTimer {
+    public:
+        GpuTimer() = default;
+
+        ~GpuTimer();
+
+        GpuTimer(const GpuTimer &) = delete;
+
+        GpuTimer &operator=(const GpuTimer &) = delete;
+
+        // Creates the query pool. Leaves the timer disabled (all calls become no-ops) if the
+        // queue family does not support timestamps.
+        void init(VkDevice device, VkPhysicalDevice physicalDevice, uint32_t queueFamilyIndex,
+                  uint32_t framesInFlight, uint32_t maxScopes = 16);
+
+        void destroy();
+
+        bool isSupported() const { return queryPool != VK_NULL_HANDLE; }
+
+        // Registers a named scope and returns its id. Call during initialization.
+        uint32_t registerScope(const std::string &name);
+
+        // Resets this frame's queries. Must be recorded outside of a render pass, before any scope.
+        void beginFrame(VkCommandBuffer commandBuffer, uint32_t frameIndex);
+
+        void beginScope(VkCommandBuffer commandBuffer, uint32_t scopeId,
+                        VkPipelineStageFlagBits stage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT);
+
+        void endScope(VkCommandBuffer commandBuffer, uint32_t scopeId,
+                      VkPipelineStageFlagBits stage = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT);
+
+        // Reads back the results written by this frame slot. Call after waiting on the slot's fence.
+        // Returns false if no (complete) results were available.
+        bool collect(uint32_t frameIndex);
+
+        // Most recent and smoothed (EMA) duration of a scope in milliseconds. 0 if never measured.
+        float getLastMs(uint32_t scopeId) const;
+
+        float getAverageMs(uint32_t scopeId) const;
+
+        const std::string &getScopeName(uint32_t scopeId) const { return scopes[scopeId].name; }
+
+        uint32_t getScopeCount() const { return static_cast<uint32_t>(scopes.size()); }
+
+    private:
+        struct Scope {
+            std::string name;
+            float lastMs = 0.0f;
+            float averageMs = 0.0f;
+            bool measured = false;
+        };
+
+        VkDevice device = VK_NULL_HANDLE;
+        VkQueryPool queryPool = VK_NULL_HANDLE;
+        uint32_t maxScopes = 0;
+        uint32_t framesInFlight = 0;
+        float timestampPeriodNs = 1.0f;
+        uint64_t timestampMask = ~0ull;
+        uint32_t recordingFrame = 0;
+        std::vector<Scope> scopes;
+        std::vector<std::vector<bool> > writtenScopes; // [frame][scope]: both timestamps recorded
+        std::vector<uint64_t> readback; // Scratch buffer: {value, availability} pairs
+
+        uint32_t queryIndex(uint32_t frameIndex, uint32_t scopeId, bool end) const {
+            return (frameIndex * maxScopes + scopeId) * 2 + (end ? 1 : 0);
+        }
+    };
+} // namespace VkGameProjectOne
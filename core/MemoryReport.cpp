@@ -0,0 +1,159 @@
+// MemoryReport.cpp
+
+#include "core/MemoryReport.h"
+#include <algorithm>
+#include <vector>
+#include <spdlog/spdlog.h>
+
+namespace vk_project_one {
+    static double toMiB(VkDeviceSize bytes) {
+        return static_cast<double>(bytes) / (1024.0 * 1024.0);
+    }
+
+    static std::string memoryFlagsString(VkMemoryPropertyFlags flags) {
+        std::string result;
+        auto add = [&](VkMemoryPropertyFlags bit, const char *name) {
+            if (!(flags & bit)) return;
+            if (!result.empty()) result += '|';
+            result += name;
+        };
+        add(VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, "device-local");
+        add(VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT, "host-visible");
+        add(VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, "coherent");
+        add(VK_MEMORY_PROPERTY_HOST_CACHED_BIT, "cached");
+        add(VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT, "lazy");
+        return result.empty() ? "none" : result;
+    }
+
+    // Count, allocated bytes and bytes lost to rounding of one group of allocations.
+    struct MemoryTotals {
+        uint32_t count = 0;
+        VkDeviceSize bytes = 0;
+        VkDeviceSize wasted = 0;
+
+        void add(VkDeviceSize allocated, VkDeviceSize requested) {
+            count++;
+            bytes += allocated;
+            wasted += allocated - std::min(requested, allocated);
+        }
+    };
+
+    void MemoryReport::add(VkDeviceMemory memory, const MemoryTag &tag, VkDeviceSize requestedSize,
+                           VkDeviceSize allocationSize, uint32_t memoryType) {
+        allocations[memory] = {tag, requestedSize, allocationSize, memoryType};
+    }
+
+    void MemoryReport::remove(VkDeviceMemory memory) {
+        allocations.erase(memory);
+    }
+
+    void MemoryReport::setEstimate(const std::string &name, MemoryCategory category, VkDeviceSize bytes) {
+        if (bytes == 0) estimates.erase(name);
+        else estimates[name] = {category, bytes};
+    }
+
+    void MemoryReport::log(bool listAllocations) const {
+        MemoryTotals categories[static_cast<size_t>(MemoryCategory::Count)];
+        std::vector<MemoryTotals> heaps(memoryProperties.memoryHeapCount);
+        std::vector<MemoryTotals> types(memoryProperties.memoryTypeCount);
+        MemoryTotals total;
+        for (const auto &[memory, allocation]: allocations) {
+            categories[static_cast<size_t>(allocation.tag.category)].add(allocation.allocationSize,
+                                                                         allocation.requestedSize);
+            types[allocation.memoryType].add(allocation.allocationSize, allocation.requestedSize);
+            heaps[memoryProperties.memoryTypes[allocation.memoryType].heapIndex].add(allocation.allocationSize,
+                                                                                    allocation.requestedSize);
+            total.add(allocation.allocationSize, allocation.requestedSize);
+        }
+        MemoryTotals estimated;
+        for (const auto &[name, estimate]: estimates) {
+            categories[static_cast<size_t>(estimate.category)].add(estimate.bytes, estimate.bytes);
+            estimated.add(estimate.bytes, estimate.bytes);
+        }
+
+        spdlog::info("Memory report: {} allocations, {:.2f} MiB ({:.2f} KiB lost to size/alignment rounding), plus "
+                     "{:.2f} MiB of driver-owned swapchain images (estimated)", total.count, toMiB(total.bytes),
+                     static_cast<double>(total.wasted) / 1024.0, toMiB(estimated.bytes));
+        for (uint32_t i = 0; i < static_cast<uint32_t>(MemoryCategory::Count); ++i) {
+            const MemoryTotals &category = categories[i];
+            if (category.count == 0) continue;
+            spdlog::info("  {:<16} {:>4} x {:9.2f} MiB, {:8.2f} KiB wasted",
+                         categoryName(static_cast<MemoryCategory>(i)), category.count, toMiB(category.bytes),
+                         static_cast<double>(category.wasted) / 1024.0);
+        }
+        for (uint32_t i = 0; i < memoryProperties.memoryHeapCount; ++i) {
+            const VkMemoryHeap &heap = memoryProperties.memoryHeaps[i];
+            spdlog::info("  Heap {} ({}, {:.0f} MiB): {} allocations, {:.2f} MiB ({:.2f}%)", i,
+                         heap.flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT ? "VRAM" : "host", toMiB(heap.size),
+                         heaps[i].count, toMiB(heaps[i].bytes),
+                         heap.size > 0 ? 100.0 * static_cast<double>(heaps[i].bytes) / static_cast<double>(heap.size)
+                                       : 0.0);
+        }
+        for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; ++i) {
+            if (types[i].count == 0) continue;
+            const VkMemoryType &type = memoryProperties.memoryTypes[i];
+            spdlog::info("    Type {} (heap {}, {}): {} allocations, {:.2f} MiB, {:.2f} KiB wasted", i,
+                         type.heapIndex, memoryFlagsString(type.propertyFlags), types[i].count, toMiB(types[i].bytes),
+                         static_cast<double>(types[i].wasted) / 1024.0);
+        }
+        if (!listAllocations) return;
+
+        std::vector<const Allocation *> sorted;
+        sorted.reserve(allocations.size());
+        for (const auto &[memory, allocation]: allocations) sorted.push_back(&allocation);
+        std::sort(sorted.begin(), sorted.end(), [](const Allocation *a, const Allocation *b) {
+            return a->allocationSize > b->allocationSize;
+        });
+        for (const Allocation *allocation: sorted) {
+            spdlog::info("    {:<32} {:<16} type {:>2} {:10.3f} MiB ({} B requested)", allocation->tag.name,
+                         categoryName(allocation->tag.category), allocation->memoryType,
+                         toMiB(allocation->allocationSize), allocation->requestedSize);
+        }
+        for (const auto &[name, estimate]: estimates) {
+            spdlog::info("    {:<32} {:<16} driver  {:10.3f} MiB (estimated)", name, categoryName(estimate.category),
+                         toMiB(estimate.bytes));
+        }
+    }
+
+    void MemoryReport::logSummary() const {
+        VkDeviceSize categories[static_cast<size_t>(MemoryCategory::Count)] = {};
+        for (const auto &[memory, allocation]: allocations) {
+            categories[static_cast<size_t>(allocation.tag.category)] += allocation.allocationSize;
+        }
+        for (const auto &[name, estimate]: estimates) {
+            categories[static_cast<size_t>(estimate.category)] += estimate.bytes;
+        }
+        std::string line;
+        VkDeviceSize total = 0;
+        for (uint32_t i = 0; i < static_cast<uint32_t>(MemoryCategory::Count); ++i) {
+            if (categories[i] == 0) continue;
+            line += fmt::format(", {} {:.1f}", categoryName(static_cast<MemoryCategory>(i)), toMiB(categories[i]));
+            total += categories[i];
+        }
+        spdlog::info("[Benchmark]   Memory: {:.1f} MiB in {} allocations{}", toMiB(total), allocations.size(), line);
+    }
+
+    void MemoryReport::logLeaks() const {
+        for (const auto &[memory, allocation]: allocations) {
+            spdlog::warn("Memory leak: '{}' ({}, {:.3f} MiB) was never freed", allocation.tag.name,
+                         categoryName(allocation.tag.category), toMiB(allocation.allocationSize));
+        }
+    }
+
+    const char *MemoryReport::categoryName(MemoryCategory category) {
+        switch (category) {
+            case MemoryCategory::TerrainVertices: return "terrain vertices";
+            case MemoryCategory::TerrainIndices: return "terrain indices";
+            case MemoryCategory::TerrainTextures: return "terrain textures";
+            case MemoryCategory::Staging: return "staging";
+            case MemoryCategory::Uniform: return "uniform";
+            case MemoryCategory::RenderTarget: return "render targets";
+            case MemoryCategory::Lut: return "LUTs";
+            case MemoryCategory::Particles: return "particles";
+            case MemoryCategory::Props: return "props";
+            case MemoryCategory::Geometry: return "geometry";
+            case MemoryCategory::Swapchain: return "swapchain";
+            default: return "other";
+        }
+    }
+} // namespace VkGameProjectOne
@@ -0,0 +1,78 @@
+// MemoryReport.h
+
+#pragma once
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vulkan/vulkan.h>
+
+namespace vk_project_one {
+    // What a device memory allocation is for, the grouping of the memory report.
+    enum class MemoryCategory : uint32_t {
+        TerrainVertices,
+        TerrainIndices,
+        TerrainTextures, // Detail and heightfield textures
+        Staging, // Host-visible upload and readback buffers
+        Uniform,
+        RenderTarget, // Scene, post and upscale targets, impostor faces
+        Lut, // Color grading and atmosphere lookup tables
+        Particles,
+        Props, // Prop meshes, instances and the impostor atlas
+        Geometry, // Other vertex and index buffers
+        Swapchain, // Presentable images; owned by the driver, so estimated from their size
+        Count
+    };
+
+    // Category and debug name of an allocation (the name is also given to the object with VK_EXT_debug_utils).
+    struct MemoryTag {
+        MemoryCategory category;
+        std::string name;
+    };
+
+    // Tracks every live device memory allocation with its tag, size and memory type, and logs where the
+    // memory goes: totals per category, per heap and per memory type, including the bytes lost to the
+    // size and alignment rounding of the memory requirements.
+    class MemoryReport {
+    public:
+        void init(const VkPhysicalDeviceMemoryProperties &properties) { memoryProperties = properties; }
+
+        // requestedSize is what the resource asked for, allocationSize what its memory requirements made of it.
+        void add(VkDeviceMemory memory, const MemoryTag &tag, VkDeviceSize requestedSize, VkDeviceSize allocationSize,
+                 uint32_t memoryType);
+
+        void remove(VkDeviceMemory memory);
+
+        // Memory the engine does not allocate itself (swapchain images), by name; 0 bytes removes the entry.
+        void setEstimate(const std::string &name, MemoryCategory category, VkDeviceSize bytes);
+
+        size_t getAllocationCount() const { return allocations.size(); }
+
+        // Totals per category, heap and memory type; with allocations, every allocation largest first.
+        void log(bool allocations) const;
+
+        // One line of per-category totals, for the benchmark log.
+        void logSummary() const;
+
+        // Warns about tracked allocations that were never freed (call once everything is destroyed).
+        void logLeaks() const;
+
+        static const char *categoryName(MemoryCategory category);
+
+    private:
+        struct Allocation {
+            MemoryTag tag;
+            VkDeviceSize requestedSize = 0;
+            VkDeviceSize allocationSize = 0;
+            uint32_t memoryType = 0;
+        };
+
+        struct Estimate {
+            MemoryCategory category;
+            VkDeviceSize bytes;
+        };
+
+        VkPhysicalDeviceMemoryProperties memoryProperties{};
+        std::unordered_map<VkDeviceMemory, Allocation> allocations;
+        std::unordered_map<std::string, Estimate> estimates;
+    };
+} // namespace VkGameProjectOne
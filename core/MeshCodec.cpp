@@ -0,0 +1,345 @@
+// MeshCodec.cpp
+
+#include "core/MeshCodec.h"
+#include <algorithm>
+#include <cstring>
+
+namespace vk_project_one::MeshCodec {
+    namespace {
+        constexpr uint32_t VERTEX_MAGIC = 0x31435856; // "VXC1"
+        constexpr uint32_t INDEX_MAGIC = 0x31435849; // "IXC1"
+        constexpr size_t BLOCK_VERTICES = 256;
+        constexpr size_t GROUP_SIZE = 16;
+        constexpr size_t MAX_STRIDE = 256;
+        constexpr uint32_t EDGE_FIFO_SIZE = 15;
+        constexpr uint32_t VERTEX_FIFO_SIZE = 14;
+        constexpr uint8_t NO_EDGE = 0xF0;
+        constexpr uint8_t EXPLICIT_VERTEX = 15;
+
+        uint32_t zigzag(uint32_t delta) {
+            return (delta << 1) ^ static_cast<uint32_t>(static_cast<int32_t>(delta) >> 31);
+        }
+
+        uint32_t unzigzag(uint32_t value) {
+            return (value >> 1) ^ (0u - (value & 1u));
+        }
+
+        void writeU32(std::vector<uint8_t> &out, uint32_t value) {
+            const size_t at = out.size();
+            out.resize(at + sizeof(value));
+            std::memcpy(out.data() + at, &value, sizeof(value));
+        }
+
+        bool readU32(const uint8_t *&data, const uint8_t *end, uint32_t &value) {
+            if (end - data < static_cast<ptrdiff_t>(sizeof(value))) return false;
+            std::memcpy(&value, data, sizeof(value));
+            data += sizeof(value);
+            return true;
+        }
+
+        void writeVarint(std::vector<uint8_t> &out, uint32_t value) {
+            while (value >= 0x80) {
+                out.push_back(static_cast<uint8_t>(value | 0x80));
+                value >>= 7;
+            }
+            out.push_back(static_cast<uint8_t>(value));
+        }
+
+        bool readVarint(const uint8_t *&data, const uint8_t *end, uint32_t &value) {
+            value = 0;
+            for (uint32_t shift = 0; shift < 35; shift += 7) {
+                if (data == end) return false;
+                const uint8_t byte = *data++;
+                value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+                if (!(byte & 0x80)) return true;
+            }
+            return false;
+        }
+
+        // Bits per value of a group: header code 0-3 -> 0, 2, 4 or 8 bits
+        constexpr uint32_t GROUP_BITS[4] = {0, 2, 4, 8};
+
+        void encodePlane(std::vector<uint8_t> &out, const uint8_t *plane, size_t count) {
+            const size_t groups = (count + GROUP_SIZE - 1) / GROUP_SIZE;
+            const size_t headerAt = out.size();
+            out.resize(headerAt + (groups + 3) / 4, 0);
+            for (size_t g = 0; g < groups; ++g) {
+                uint8_t values[GROUP_SIZE] = {};
+                std::memcpy(values, plane + g * GROUP_SIZE, std::min(GROUP_SIZE, count - g * GROUP_SIZE));
+                const uint8_t largest = *std::max_element(values, values + GROUP_SIZE);
+                const uint32_t code = largest == 0 ? 0 : largest < 4 ? 1 : largest < 16 ? 2 : 3;
+                out[headerAt + g / 4] |= static_cast<uint8_t>(code << (2 * (g % 4)));
+                const uint32_t bits = GROUP_BITS[code];
+                if (bits == 8) {
+                    out.insert(out.end(), values, values + GROUP_SIZE);
+                } else if (bits > 0) {
+                    const uint32_t perByte = 8 / bits;
+                    for (size_t i = 0; i < GROUP_SIZE; i += perByte) {
+                        uint8_t packed = 0;
+                        for (uint32_t k = 0; k < perByte; ++k) {
+                            packed |= static_cast<uint8_t>(values[i + k] << (k * bits));
+                        }
+                        out.push_back(packed);
+                    }
+                }
+            }
+        }
+
+        // Unpacks a plane of count values (rounded up to whole groups) and ORs them into byte `shift` of words
+        bool decodePlane(const uint8_t *&data, const uint8_t *end, uint32_t *words, uint32_t shift, size_t count) {
+            const size_t groups = (count + GROUP_SIZE - 1) / GROUP_SIZE;
+            const uint8_t *header = data;
+            if (static_cast<size_t>(end - data) < (groups + 3) / 4) return false;
+            data += (groups + 3) / 4;
+            for (size_t g = 0; g < groups; ++g) {
+                const uint32_t code = (header[g / 4] >> (2 * (g % 4))) & 3u;
+                uint32_t *values = words + g * GROUP_SIZE;
+                const size_t payload = GROUP_BITS[code] * GROUP_SIZE / 8;
+                if (static_cast<size_t>(end - data) < payload) return false;
+                // Fixed-size loops per width, so each case compiles to straight-line or vector code
+                switch (code) {
+                    case 0:
+                        break;
+                    case 1:
+                        for (size_t i = 0; i < GROUP_SIZE; ++i) {
+                            values[i] |= ((data[i / 4] >> (2 * (i % 4))) & 3u) << shift;
+                        }
+                        break;
+                    case 2:
+                        for (size_t i = 0; i < GROUP_SIZE; ++i) {
+                            values[i] |= ((data[i / 2] >> (4 * (i % 2))) & 15u) << shift;
+                        }
+                        break;
+                    default:
+                        for (size_t i = 0; i < GROUP_SIZE; ++i) values[i] |= static_cast<uint32_t>(data[i]) << shift;
+                        break;
+                }
+                data += payload;
+            }
+            return true;
+        }
+
+        struct Edge {
+            uint32_t a = ~0u;
+            uint32_t b = ~0u;
+        };
+
+        // State shared by the index encoder and decoder; both sides update it identically
+        struct IndexCoderState {
+            Edge edges[EDGE_FIFO_SIZE];
+            uint32_t edgeOffset = 0;
+            uint32_t vertices[VERTEX_FIFO_SIZE];
+            uint32_t vertexOffset = 0;
+            uint32_t next = 0; // Lowest vertex not referenced yet (meshes tend to use them in order)
+            uint32_t last = 0; // Base of explicit deltas
+
+            IndexCoderState() { std::fill(std::begin(vertices), std::end(vertices), ~0u); }
+
+            void pushEdge(uint32_t a, uint32_t b) {
+                edges[edgeOffset] = {a, b};
+                edgeOffset = (edgeOffset + 1) % EDGE_FIFO_SIZE;
+            }
+
+            const Edge &edge(uint32_t recency) const {
+                return edges[(edgeOffset + EDGE_FIFO_SIZE - 1 - recency) % EDGE_FIFO_SIZE];
+            }
+
+            void pushVertex(uint32_t v) {
+                vertices[vertexOffset] = v;
+                vertexOffset = (vertexOffset + 1) % VERTEX_FIFO_SIZE;
+            }
+
+            uint32_t vertex(uint32_t recency) const {
+                return vertices[(vertexOffset + VERTEX_FIFO_SIZE - 1 - recency) % VERTEX_FIFO_SIZE];
+            }
+
+            // A neighbour across an edge of (x, y, z) walks that edge the other way
+            void finishTriangle(uint32_t x, uint32_t y, uint32_t z) {
+                pushEdge(z, y);
+                pushEdge(x, z);
+                next = std::max({next, x + 1, y + 1, z + 1});
+            }
+        };
+    }
+
+    std::vector<uint8_t> EncodeVertices(const void *vertices, size_t vertexCount, size_t stride) {
+        std::vector<uint8_t> out;
+        if (stride == 0 || stride % 4 != 0 || stride > MAX_STRIDE) return out;
+        writeU32(out, VERTEX_MAGIC);
+        writeU32(out, static_cast<uint32_t>(vertexCount));
+        writeU32(out, static_cast<uint32_t>(stride));
+
+        const size_t words = stride / 4;
+        const uint8_t *source = static_cast<const uint8_t *>(vertices);
+        uint32_t previous[MAX_STRIDE / 4] = {};
+        uint32_t deltas[BLOCK_VERTICES];
+        uint8_t plane[BLOCK_VERTICES];
+        for (size_t first = 0; first < vertexCount; first += BLOCK_VERTICES) {
+            const size_t count = std::min(BLOCK_VERTICES, vertexCount - first);
+            for (size_t w = 0; w < words; ++w) {
+                uint32_t base = previous[w];
+                for (size_t v = 0; v < count; ++v) {
+                    uint32_t word;
+                    std::memcpy(&word, source + (first + v) * stride + 4 * w, sizeof(word));
+                    deltas[v] = zigzag(word - base);
+                    base = word;
+                }
+                previous[w] = base;
+                for (uint32_t byte = 0; byte < 4; ++byte) {
+                    for (size_t v = 0; v < count; ++v) plane[v] = static_cast<uint8_t>(deltas[v] >> (8 * byte));
+                    encodePlane(out, plane, count);
+                }
+            }
+        }
+        return out;
+    }
+
+    bool DecodeVertices(void *destination, size_t vertexCount, size_t stride, const uint8_t *data, size_t size) {
+        const uint8_t *end = data + size;
+        uint32_t magic, count32, stride32;
+        if (!readU32(data, end, magic) || !readU32(data, end, count32) || !readU32(data, end, stride32)) return false;
+        if (magic != VERTEX_MAGIC || count32 != vertexCount || stride32 != stride || stride % 4 != 0 ||
+            stride > MAX_STRIDE) {
+            return false;
+        }
+
+        const size_t words = stride / 4;
+        uint8_t *target = static_cast<uint8_t *>(destination);
+        uint32_t previous[MAX_STRIDE / 4] = {};
+        // Deltas of the block, word-major; vertices are then rebuilt one stride-wide row at a time
+        alignas(16) uint32_t deltas[MAX_STRIDE / 4][BLOCK_VERTICES];
+        for (size_t first = 0; first < vertexCount; first += BLOCK_VERTICES) {
+            const size_t count = std::min(BLOCK_VERTICES, vertexCount - first);
+            for (size_t w = 0; w < words; ++w) {
+                std::fill(deltas[w], deltas[w] + BLOCK_VERTICES, 0u);
+                for (uint32_t byte = 0; byte < 4; ++byte) {
+                    if (!decodePlane(data, end, deltas[w], 8 * byte, count)) return false;
+                }
+            }
+            for (size_t w = 0; w < words; ++w) {
+                uint32_t value = previous[w];
+                for (size_t v = 0; v < count; ++v) {
+                    value += unzigzag(deltas[w][v]);
+                    deltas[w][v] = value;
+                }
+                previous[w] = value;
+            }
+            for (size_t v = 0; v < count; ++v) {
+                uint8_t *row = target + (first + v) * stride;
+                for (size_t w = 0; w < words; ++w) std::memcpy(row + 4 * w, &deltas[w][v], 4);
+            }
+        }
+        return data == end;
+    }
+
+    std::vector<uint8_t> EncodeIndices(const uint32_t *indices, size_t indexCount) {
+        std::vector<uint8_t> out;
+        if (indexCount % 3 != 0) return out; // Not a triangle list; dropping the rest would lose indices silently
+        writeU32(out, INDEX_MAGIC);
+        writeU32(out, static_cast<uint32_t>(indexCount));
+        const size_t triangleCount = indexCount / 3;
+        const size_t codesAt = out.size();
+        out.resize(codesAt + triangleCount); // Code bytes first, explicit vertices after them
+        IndexCoderState state;
+        auto writeExplicit = [&](uint32_t v) {
+            writeVarint(out, zigzag(v - state.last));
+            state.last = v;
+            state.pushVertex(v);
+        };
+
+        for (size_t t = 0; t < triangleCount; ++t) {
+            const uint32_t a = indices[3 * t], b = indices[3 * t + 1], c = indices[3 * t + 2];
+            const uint32_t rotations[3][3] = {{a, b, c}, {b, c, a}, {c, a, b}};
+            uint32_t edgeRecency = EDGE_FIFO_SIZE;
+            const uint32_t *triangle = rotations[0];
+            for (uint32_t recency = 0; recency < EDGE_FIFO_SIZE && edgeRecency == EDGE_FIFO_SIZE; ++recency) {
+                const Edge &edge = state.edge(recency);
+                for (const uint32_t *rotation: rotations) {
+                    if (edge.a == rotation[0] && edge.b == rotation[1]) {
+                        edgeRecency = recency;
+                        triangle = rotation;
+                        break;
+                    }
+                }
+            }
+
+            if (edgeRecency == EDGE_FIFO_SIZE) {
+                out[codesAt + t] = NO_EDGE;
+                writeExplicit(a);
+                writeExplicit(b);
+                writeExplicit(c);
+                state.pushEdge(b, a);
+                state.finishTriangle(a, b, c);
+                continue;
+            }
+            const uint32_t z = triangle[2];
+            uint8_t vertexCode = EXPLICIT_VERTEX;
+            if (z == state.next) {
+                vertexCode = 0;
+                state.pushVertex(z);
+            } else {
+                for (uint32_t recency = 0; recency < VERTEX_FIFO_SIZE; ++recency) {
+                    if (state.vertex(recency) == z) {
+                        vertexCode = static_cast<uint8_t>(recency + 1);
+                        break;
+                    }
+                }
+                if (vertexCode == EXPLICIT_VERTEX) writeExplicit(z);
+            }
+            out[codesAt + t] = static_cast<uint8_t>(edgeRecency << 4 | vertexCode);
+            state.finishTriangle(triangle[0], triangle[1], z);
+        }
+        return out;
+    }
+
+    bool DecodeIndices(uint32_t *destination, size_t indexCount, const uint8_t *data, size_t size) {
+        const uint8_t *end = data + size;
+        uint32_t magic, count32;
+        if (!readU32(data, end, magic) || !readU32(data, end, count32)) return false;
+        if (magic != INDEX_MAGIC || count32 != indexCount || indexCount % 3 != 0) return false;
+        const size_t triangleCount = indexCount / 3;
+        if (static_cast<size_t>(end - data) < triangleCount) return false;
+        const uint8_t *codes = data;
+        data += triangleCount;
+        IndexCoderState state;
+        auto readExplicit = [&](uint32_t &v) {
+            uint32_t encoded;
+            if (!readVarint(data, end, encoded)) return false;
+            v = state.last + unzigzag(encoded);
+            state.last = v;
+            state.pushVertex(v);
+            return true;
+        };
+
+        for (size_t t = 0; t < triangleCount; ++t) {
+            const uint8_t code = codes[t];
+            uint32_t *triangle = destination + 3 * t;
+            if (code == NO_EDGE) {
+                if (!readExplicit(triangle[0]) || !readExplicit(triangle[1]) || !readExplicit(triangle[2])) {
+                    return false;
+                }
+                state.pushEdge(triangle[1], triangle[0]);
+                state.finishTriangle(triangle[0], triangle[1], triangle[2]);
+                continue;
+            }
+            const uint32_t edgeRecency = code >> 4;
+            const uint32_t vertexCode = code & 15u;
+            if (edgeRecency >= EDGE_FIFO_SIZE) return false;
+            const Edge edge = state.edge(edgeRecency);
+            uint32_t z;
+            if (vertexCode == 0) {
+                z = state.next;
+                state.pushVertex(z);
+            } else if (vertexCode == EXPLICIT_VERTEX) {
+                if (!readExplicit(z)) return false;
+            } else {
+                z = state.vertex(vertexCode - 1);
+            }
+            triangle[0] = edge.a;
+            triangle[1] = edge.b;
+            triangle[2] = z;
+            state.finishTriangle(edge.a, edge.b, z);
+        }
+        return data == end;
+    }
+} // namespace VkGameProjectOne
@@ -0,0 +1,30 @@
+// MeshCodec.h
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace vk_project_one::MeshCodec {
+    // Vertex streams: blocks of up to 256 vertices. Every 32-bit word of a vertex is delta coded
+    // against the same word of the previous vertex and zigzagged, the deltas are split into four
+    // byte planes, and each plane is stored in groups of 16 bytes bit-packed at 0, 2, 4 or 8 bits
+    // (2-bit width per group in a header). Decoding has no data-dependent branches inside a group and
+    // reconstructs all words of a vertex at once, so it vectorizes; destination may be mapped memory.
+    // stride must be a multiple of 4 and at most 256 bytes.
+    std::vector<uint8_t> EncodeVertices(const void *vertices, size_t vertexCount, size_t stride);
+
+    // Returns false if the data is truncated or was encoded with another count or stride.
+    bool DecodeVertices(void *destination, size_t vertexCount, size_t stride, const uint8_t *data, size_t size);
+
+    // Triangle lists: each triangle is one code byte naming an edge in a 15-entry FIFO of recent edges
+    // (high nibble) and how its third vertex is found (low nibble: the next unseen vertex, one of the
+    // last 14 new vertices, or an explicit zigzag varint delta). Triangles that share no recent edge
+    // store all three vertices explicitly. Decoded triangles may be rotated; winding is preserved.
+    // indexCount must be a multiple of 3; a trailing partial triangle yields an empty (undecodable) result.
+    std::vector<uint8_t> EncodeIndices(const uint32_t *indices, size_t indexCount);
+
+    // Returns false if the data is truncated or was encoded with another index count, or if indexCount is not
+    // a multiple of 3.
+    bool DecodeIndices(uint32_t *destination, size_t indexCount, const uint8_t *data, size_t size);
+} // namespace VkGameProjectOne
@@ -0,0 +1,268 @@
+// MeshSimplifier.cpp
+
+#include "core/MeshSimplifier.h"
+#include <algorithm>
+#include <cmath>
+
+namespace vk_project_one {
+    namespace {
+        // Sum of area-weighted squared distances to a set of planes, as a symmetric 4x4 matrix
+        struct Quadric {
+            double a00 = 0.0, a01 = 0.0, a02 = 0.0, a11 = 0.0, a12 = 0.0, a22 = 0.0;
+            double b0 = 0.0, b1 = 0.0, b2 = 0.0, c = 0.0;
+            double weight = 0.0; // Total area of the planes
+
+            void addPlane(const glm::dvec3 &n, double d, double area) {
+                a00 += area * n.x * n.x;
+                a01 += area * n.x * n.y;
+                a02 += area * n.x * n.z;
+                a11 += area * n.y * n.y;
+                a12 += area * n.y * n.z;
+                a22 += area * n.z * n.z;
+                b0 += area * n.x * d;
+                b1 += area * n.y * d;
+                b2 += area * n.z * d;
+                c += area * d * d;
+                weight += area;
+            }
+
+            Quadric &operator+=(const Quadric &other) {
+                a00 += other.a00;
+                a01 += other.a01;
+                a02 += other.a02;
+                a11 += other.a11;
+                a12 += other.a12;
+                a22 += other.a22;
+                b0 += other.b0;
+                b1 += other.b1;
+                b2 += other.b2;
+                c += other.c;
+                weight += other.weight;
+                return *this;
+            }
+
+            double evaluate(const glm::dvec3 &p) const {
+                const double value = a00 * p.x * p.x + a11 * p.y * p.y + a22 * p.z * p.z +
+                                     2.0 * (a01 * p.x * p.y + a02 * p.x * p.z + a12 * p.y * p.z) +
+                                     2.0 * (b0 * p.x + b1 * p.y + b2 * p.z) + c;
+                return std::max(value, 0.0); // Rounding can dip below zero
+            }
+        };
+
+        struct Collapse {
+            uint32_t from;
+            uint32_t to;
+            double cost;
+        };
+
+        double attributeDistance2(const PropVertex &a, const PropVertex &b) {
+            const glm::vec3 normal = a.normal - b.normal;
+            const glm::vec3 color = a.color - b.color;
+            return glm::dot(normal, normal) + glm::dot(color, color);
+        }
+    }
+
+    namespace MeshSimplifier {
+        std::vector<uint32_t> Simplify(const PropMesh &mesh, const std::vector<uint32_t> &indices,
+                                       size_t targetIndexCount, float attributeWeight, float &error) {
+            const std::vector<PropVertex> &vertices = mesh.vertices;
+            const size_t vertexCount = vertices.size();
+            std::vector<uint32_t> result = indices;
+            error = 0.0f;
+
+            // Input triangle planes, and the ones each vertex stands for: its own triangles and those of
+            // the vertices collapsed onto it. Their distances bound the error, which the area-weighted
+            // quadric average would understate.
+            std::vector<Quadric> quadrics(vertexCount);
+            std::vector<glm::dvec4> planes;
+            std::vector<std::vector<uint32_t>> vertexPlanes(vertexCount);
+            for (size_t i = 0; i + 2 < result.size(); i += 3) {
+                const glm::dvec3 a(vertices[result[i]].pos);
+                const glm::dvec3 b(vertices[result[i + 1]].pos);
+                const glm::dvec3 c(vertices[result[i + 2]].pos);
+                glm::dvec3 normal = glm::cross(b - a, c - a);
+                const double length = glm::length(normal);
+                if (length <= 0.0) continue;
+                normal /= length;
+                for (size_t k = 0; k < 3; ++k) {
+                    quadrics[result[i + k]].addPlane(normal, -glm::dot(normal, a), length * 0.5);
+                    vertexPlanes[result[i + k]].push_back(static_cast<uint32_t>(planes.size()));
+                }
+                planes.emplace_back(normal, -glm::dot(normal, a));
+            }
+
+            std::vector<uint32_t> triangleOffsets(vertexCount + 1);
+            std::vector<uint32_t> vertexTriangles;
+            std::vector<uint64_t> edges;
+            std::vector<uint8_t> border(vertexCount);
+            std::vector<uint8_t> touched(vertexCount);
+            std::vector<uint32_t> remap(vertexCount);
+            std::vector<Collapse> collapses;
+
+            // Each pass collapses a set of edges with disjoint neighbourhoods, cheapest first
+            while (result.size() > targetIndexCount) {
+                const size_t triangleCount = result.size() / 3;
+
+                // Triangles around each vertex (offsets into vertexTriangles)
+                std::fill(triangleOffsets.begin(), triangleOffsets.end(), 0u);
+                for (uint32_t index: result) triangleOffsets[index + 1]++;
+                for (size_t v = 0; v < vertexCount; ++v) triangleOffsets[v + 1] += triangleOffsets[v];
+                vertexTriangles.resize(result.size());
+                std::vector<uint32_t> fill(triangleOffsets.begin(), triangleOffsets.end() - 1);
+                for (size_t i = 0; i < result.size(); ++i) {
+                    vertexTriangles[fill[result[i]]++] = static_cast<uint32_t>(i / 3);
+                }
+
+                // Edges used by one triangle only are open borders; their vertices stay in place
+                edges.clear();
+                for (size_t i = 0; i < result.size(); i += 3) {
+                    for (size_t k = 0; k < 3; ++k) {
+                        const uint32_t a = result[i + k];
+                        const uint32_t b = result[i + (k + 1) % 3];
+                        edges.push_back(static_cast<uint64_t>(std::min(a, b)) << 32 | std::max(a, b));
+                    }
+                }
+                std::sort(edges.begin(), edges.end());
+                std::fill(border.begin(), border.end(), uint8_t{0});
+                collapses.clear();
+                for (size_t i = 0; i < edges.size();) {
+                    size_t end = i + 1;
+                    while (end < edges.size() && edges[end] == edges[i]) ++end;
+                    const uint32_t a = static_cast<uint32_t>(edges[i] >> 32);
+                    const uint32_t b = static_cast<uint32_t>(edges[i] & 0xffffffffu);
+                    if (end - i == 1) {
+                        border[a] = 1;
+                        border[b] = 1;
+                    } else {
+                        collapses.push_back({a, b, 0.0});
+                    }
+                    i = end;
+                }
+
+                // Cheaper direction of every interior edge; the cost is the quadric error of moving the
+                // source onto the target plus the attribute penalty
+                auto cost = [&](uint32_t from, uint32_t to) {
+                    return quadrics[from].evaluate(glm::dvec3(vertices[to].pos)) +
+                           attributeWeight * quadrics[from].weight * attributeDistance2(vertices[from], vertices[to]);
+                };
+                size_t candidateCount = 0;
+                for (const Collapse &edge: collapses) {
+                    const bool forward = !border[edge.from];
+                    const bool backward = !border[edge.to];
+                    if (!forward && !backward) continue;
+                    const double forwardCost = forward ? cost(edge.from, edge.to) : 0.0;
+                    const double backwardCost = backward ? cost(edge.to, edge.from) : 0.0;
+                    collapses[candidateCount++] = !backward || (forward && forwardCost <= backwardCost)
+                                                      ? Collapse{edge.from, edge.to, forwardCost}
+                                                      : Collapse{edge.to, edge.from, backwardCost};
+                }
+                collapses.resize(candidateCount);
+                std::sort(collapses.begin(), collapses.end(), [](const Collapse &a, const Collapse &b) {
+                    return a.cost < b.cost;
+                });
+
+                for (size_t v = 0; v < vertexCount; ++v) remap[v] = static_cast<uint32_t>(v);
+                std::fill(touched.begin(), touched.end(), uint8_t{0});
+                size_t remaining = triangleCount;
+                size_t applied = 0;
+                for (const Collapse &collapse: collapses) {
+                    if (remaining * 3 <= targetIndexCount) break;
+                    if (touched[collapse.from] || touched[collapse.to]) continue;
+
+                    // Reject collapses that turn a surviving triangle around
+                    const glm::vec3 target = vertices[collapse.to].pos;
+                    bool flips = false;
+                    size_t removed = 0;
+                    for (uint32_t t = triangleOffsets[collapse.from]; t < triangleOffsets[collapse.from + 1]; ++t) {
+                        const uint32_t *triangle = &result[3 * vertexTriangles[t]];
+                        if (triangle[0] == collapse.to || triangle[1] == collapse.to || triangle[2] == collapse.to) {
+                            removed++;
+                            continue;
+                        }
+                        glm::vec3 corners[3];
+                        for (size_t k = 0; k < 3; ++k) corners[k] = vertices[triangle[k]].pos;
+                        const glm::vec3 before = glm::cross(corners[1] - corners[0], corners[2] - corners[0]);
+                        for (size_t k = 0; k < 3; ++k) {
+                            if (triangle[k] == collapse.from) corners[k] = target;
+                        }
+                        const glm::vec3 after = glm::cross(corners[1] - corners[0], corners[2] - corners[0]);
+                        if (glm::dot(before, after) <= 0.0f) {
+                            flips = true;
+                            break;
+                        }
+                    }
+                    if (flips) continue;
+
+                    remap[collapse.from] = collapse.to;
+                    // Every corner of the rewritten triangles against the planes merged into the source, whose
+                    // surface they now cover: distance to a plane is linear over a triangle, so the corners bound
+                    // the whole triangle
+                    std::vector<uint32_t> &sourcePlanes = vertexPlanes[collapse.from];
+                    std::vector<uint32_t> &targetPlanes = vertexPlanes[collapse.to];
+                    auto measure = [&](const glm::vec3 &position) {
+                        for (uint32_t plane: sourcePlanes) {
+                            const double distance = std::abs(glm::dot(glm::dvec3(planes[plane]),
+                                                                      glm::dvec3(position)) + planes[plane].w);
+                            error = std::max(error, static_cast<float>(distance));
+                        }
+                    };
+                    measure(target);
+                    for (uint32_t t = triangleOffsets[collapse.from]; t < triangleOffsets[collapse.from + 1]; ++t) {
+                        const uint32_t *triangle = &result[3 * vertexTriangles[t]];
+                        if (triangle[0] == collapse.to || triangle[1] == collapse.to || triangle[2] == collapse.to) {
+                            continue; // Degenerates and is removed
+                        }
+                        for (size_t k = 0; k < 3; ++k) {
+                            if (triangle[k] != collapse.from) measure(vertices[triangle[k]].pos);
+                        }
+                    }
+                    const size_t previousCount = targetPlanes.size();
+                    targetPlanes.insert(targetPlanes.end(), sourcePlanes.begin(), sourcePlanes.end());
+                    std::inplace_merge(targetPlanes.begin(), targetPlanes.begin() + previousCount, targetPlanes.end());
+                    targetPlanes.erase(std::unique(targetPlanes.begin(), targetPlanes.end()), targetPlanes.end());
+                    sourcePlanes = {};
+                    quadrics[collapse.to] += quadrics[collapse.from];
+                    for (uint32_t t = triangleOffsets[collapse.from]; t < triangleOffsets[collapse.from + 1]; ++t) {
+                        const uint32_t *triangle = &result[3 * vertexTriangles[t]];
+                        for (size_t k = 0; k < 3; ++k) touched[triangle[k]] = 1;
+                    }
+                    touched[collapse.to] = 1;
+                    remaining -= std::min(removed, remaining);
+                    applied++;
+                }
+                if (applied == 0) break;
+
+                size_t kept = 0;
+                for (size_t i = 0; i < result.size(); i += 3) {
+                    const uint32_t a = remap[result[i]];
+                    const uint32_t b = remap[result[i + 1]];
+                    const uint32_t c = remap[result[i + 2]];
+                    if (a == b || b == c || a == c) continue;
+                    result[kept++] = a;
+                    result[kept++] = b;
+                    result[kept++] = c;
+                }
+                result.resize(kept);
+            }
+            return result;
+        }
+
+        std::vector<PropLod> BuildLodChain(const PropMesh &mesh, uint32_t levels, float attributeWeight) {
+            std::vector<PropLod> chain(1);
+            chain[0].indices = mesh.indices;
+            while (chain.size() < levels) {
+                const PropLod &previous = chain.back();
+                PropLod lod;
+                float levelError = 0.0f;
+                lod.indices = Simplify(mesh, previous.indices, previous.indices.size() / 6 * 3, attributeWeight,
+                                       levelError);
+                // Each level is measured against the one before it; the deviations add up at most
+                lod.error = previous.error + levelError;
+                // A level that barely differs from the previous one is not worth a switch
+                if (lod.indices.size() * 10 > previous.indices.size() * 9) break;
+                chain.push_back(std::move(lod));
+            }
+            return chain;
+        }
+    }
+} // namespace VkGameProjectOne
@@ -0,0 +1,35 @@
+// MeshSimplifier.h
+
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Props.h"
+
+namespace vk_project_one {
+    // One level of detail of a prop mesh. The indices refer to the vertices of the full-detail mesh,
+    // so every level of a chain shares one vertex range and only adds an index range.
+    struct PropLod {
+        std::vector<uint32_t> indices;
+        float error = 0.0f; // Bound on the deviation from the full-detail surface, in mesh units
+    };
+
+    namespace MeshSimplifier {
+        // Quadric error metric edge collapse (Garland-Heckbert) toward targetIndexCount indices.
+        // Vertices only collapse onto neighbouring vertices, so positions, normals and colors of the
+        // result are all taken from the input; collapses across differing normals or colors cost
+        // attributeWeight extra per unit of squared attribute difference. Vertices on open borders
+        // (including attribute seams, where the mesh duplicates vertices) never move, and collapses
+        // that would flip a triangle are rejected. May stop above the target when nothing can
+        // collapse any more. error is set to the largest distance of a corner of a rewritten triangle
+        // from the planes of the input triangles merged into its collapsed vertex (the surface those
+        // triangles now cover); the corners bound the whole triangles against these planes. The
+        // quadrics only rank the collapses.
+        std::vector<uint32_t> Simplify(const PropMesh &mesh, const std::vector<uint32_t> &indices,
+                                       size_t targetIndexCount, float attributeWeight, float &error);
+
+        // levels entries: the full-detail mesh, then each level with about half the triangles of the
+        // previous one, every level simplified from the one before it. A level's error is the sum of
+        // the errors of the simplifications that led to it, so it never understates the deviation.
+        std::vector<PropLod> BuildLodChain(const PropMesh &mesh, uint32_t levels, float attributeWeight = 1.0f);
+    }
+} // namespace VkGameProjectOne
@@ -0,0 +1,215 @@
+// Props.cpp
+
+#include "core/Props.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <map>
+#include <random>
+#include <utility>
+
+namespace vk_project_one {
+    std::vector<VkVertexInputBindingDescription> PropVertex::getBindingDescriptions() {
+        return {
+            {0, sizeof(PropVertex), VK_VERTEX_INPUT_RATE_VERTEX},
+            {1, sizeof(PropInstance), VK_VERTEX_INPUT_RATE_INSTANCE}
+        };
+    }
+
+    std::vector<VkVertexInputAttributeDescription> PropVertex::getAttributeDescriptions() {
+        return {
+            {0, 0, VK_FORMAT_R32G32B32_SFLOAT, offsetof(PropVertex, pos)},
+            {1, 0, VK_FORMAT_R32G32B32_SFLOAT, offsetof(PropVertex, normal)},
+            {2, 0, VK_FORMAT_R32G32B32_SFLOAT, offsetof(PropVertex, color)},
+            {3, 1, VK_FORMAT_R32G32B32A32_SFLOAT, offsetof(PropInstance, positionScale)},
+            {4, 1, VK_FORMAT_R32G32B32A32_SFLOAT, offsetof(PropInstance, params)}
+        };
+    }
+
+    namespace {
+        constexpr float TWO_PI = 6.28318530718f;
+
+        // Appends a triangle facing the way its vertex normals point (drops degenerate ones), so the
+        // generators need not track winding. Outward faces end up counter-clockwise.
+        void addTriangle(PropMesh &mesh, uint32_t a, uint32_t b, uint32_t c) {
+            const PropVertex &va = mesh.vertices[a];
+            const PropVertex &vb = mesh.vertices[b];
+            const PropVertex &vc = mesh.vertices[c];
+            const glm::vec3 faceNormal = glm::cross(vb.pos - va.pos, vc.pos - va.pos);
+            if (glm::dot(faceNormal, faceNormal) < 1e-12f) return;
+            if (glm::dot(faceNormal, va.normal + vb.normal + vc.normal) < 0.0f) std::swap(b, c);
+            mesh.indices.insert(mesh.indices.end(), {a, b, c});
+        }
+
+        // Surface of revolution around the Y axis through the (radius, height) profile, bottom to top
+        void addRevolved(PropMesh &mesh, const std::vector<glm::vec2> &profile, uint32_t segments,
+                         const glm::vec3 &color) {
+            const uint32_t first = static_cast<uint32_t>(mesh.vertices.size());
+            for (size_t k = 0; k < profile.size(); ++k) {
+                // Normal perpendicular to the profile tangent, pointing away from the axis
+                const glm::vec2 prev = profile[k > 0 ? k - 1 : k];
+                const glm::vec2 next = profile[k + 1 < profile.size() ? k + 1 : k];
+                const glm::vec2 tangent = glm::normalize(next - prev);
+                const glm::vec2 profileNormal(tangent.y, -tangent.x);
+                for (uint32_t s = 0; s <= segments; ++s) {
+                    const float angle = TWO_PI * static_cast<float>(s) / static_cast<float>(segments);
+                    const glm::vec3 around(std::cos(angle), 0.0f, std::sin(angle));
+                    PropVertex vertex{};
+                    vertex.pos = around * profile[k].x + glm::vec3(0.0f, profile[k].y, 0.0f);
+                    vertex.normal = glm::normalize(around * profileNormal.x + glm::vec3(0.0f, profileNormal.y, 0.0f));
+                    vertex.color = color;
+                    mesh.vertices.push_back(vertex);
+                }
+            }
+            const uint32_t stride = segments + 1;
+            for (uint32_t k = 0; k + 1 < profile.size(); ++k) {
+                for (uint32_t s = 0; s < segments; ++s) {
+                    const uint32_t a = first + k * stride + s;
+                    const uint32_t b = a + 1;
+                    const uint32_t c = a + stride + 1;
+                    const uint32_t d = a + stride;
+                    addTriangle(mesh, a, d, c);
+                    addTriangle(mesh, a, c, b);
+                }
+            }
+        }
+
+        // Downward-facing disc closing the bottom of a revolved part
+        void addBottomCap(PropMesh &mesh, float radius, float height, uint32_t segments, const glm::vec3 &color) {
+            const uint32_t center = static_cast<uint32_t>(mesh.vertices.size());
+            mesh.vertices.push_back({glm::vec3(0.0f, height, 0.0f), glm::vec3(0.0f, -1.0f, 0.0f), color});
+            for (uint32_t s = 0; s < segments; ++s) {
+                const float angle = TWO_PI * static_cast<float>(s) / static_cast<float>(segments);
+                mesh.vertices.push_back({
+                    glm::vec3(radius * std::cos(angle), height, radius * std::sin(angle)),
+                    glm::vec3(0.0f, -1.0f, 0.0f), color
+                });
+            }
+            for (uint32_t s = 0; s < segments; ++s) {
+                addTriangle(mesh, center, center + 1 + s, center + 1 + (s + 1) % segments);
+            }
+        }
+
+        void computeBounds(PropMesh &mesh) {
+            mesh.boundsMin = glm::vec3(std::numeric_limits<float>::max());
+            mesh.boundsMax = glm::vec3(std::numeric_limits<float>::lowest());
+            for (const PropVertex &vertex: mesh.vertices) {
+                mesh.boundsMin = glm::min(mesh.boundsMin, vertex.pos);
+                mesh.boundsMax = glm::max(mesh.boundsMax, vertex.pos);
+            }
+        }
+    }
+
+    namespace Props {
+        PropMesh BuildTree(uint32_t segments, uint32_t rings) {
+            PropMesh mesh;
+            const glm::vec3 bark(0.36f, 0.25f, 0.16f);
+            addRevolved(mesh, {{0.28f, 0.0f}, {0.22f, 2.2f}}, segments / 2, bark);
+
+            // Three cones, each overlapping the one below; base radius, base height, cone height
+            const glm::vec3 tiers[3] = {{2.2f, 1.6f, 3.2f}, {1.7f, 3.3f, 2.8f}, {1.1f, 4.9f, 2.4f}};
+            const glm::vec3 needles[3] = {{0.10f, 0.25f, 0.12f}, {0.12f, 0.29f, 0.13f}, {0.14f, 0.33f, 0.15f}};
+            for (uint32_t tier = 0; tier < 3; ++tier) {
+                std::vector<glm::vec2> profile;
+                for (uint32_t ring = 0; ring <= rings; ++ring) {
+                    const float t = static_cast<float>(ring) / static_cast<float>(rings);
+                    profile.emplace_back(tiers[tier].x * (1.0f - t), tiers[tier].y + tiers[tier].z * t);
+                }
+                addRevolved(mesh, profile, segments, needles[tier]);
+                addBottomCap(mesh, tiers[tier].x, tiers[tier].y, segments, needles[tier] * 0.7f);
+            }
+            computeBounds(mesh);
+            return mesh;
+        }
+
+        PropMesh BuildRock(uint32_t subdivisions, uint32_t seed) {
+            // Icosahedron
+            const float t = (1.0f + std::sqrt(5.0f)) * 0.5f;
+            std::vector<glm::vec3> positions = {
+                {-1, t, 0}, {1, t, 0}, {-1, -t, 0}, {1, -t, 0}, {0, -1, t}, {0, 1, t},
+                {0, -1, -t}, {0, 1, -t}, {t, 0, -1}, {t, 0, 1}, {-t, 0, -1}, {-t, 0, 1}
+            };
+            std::vector<uint32_t> triangles = {
+                0, 11, 5, 0, 5, 1, 0, 1, 7, 0, 7, 10, 0, 10, 11, 1, 5, 9, 5, 11, 4, 11, 10, 2, 10, 7, 6, 7, 1, 8,
+                3, 9, 4, 3, 4, 2, 3, 2, 6, 3, 6, 8, 3, 8, 9, 4, 9, 5, 2, 4, 11, 6, 2, 10, 8, 6, 7, 9, 8, 1
+            };
+            for (glm::vec3 &position: positions) position = glm::normalize(position);
+
+            // Split every triangle into four, sharing the edge midpoints
+            for (uint32_t level = 0; level < subdivisions; ++level) {
+                std::map<std::pair<uint32_t, uint32_t>, uint32_t> midpoints;
+                auto midpoint = [&](uint32_t a, uint32_t b) {
+                    const std::pair<uint32_t, uint32_t> key = std::minmax(a, b);
+                    auto it = midpoints.find(key);
+                    if (it != midpoints.end()) return it->second;
+                    positions.push_back(glm::normalize(positions[a] + positions[b]));
+                    const uint32_t index = static_cast<uint32_t>(positions.size() - 1);
+                    midpoints.emplace(key, index);
+                    return index;
+                };
+                std::vector<uint32_t> split;
+                split.reserve(triangles.size() * 4);
+                for (size_t i = 0; i < triangles.size(); i += 3) {
+                    const uint32_t a = triangles[i], b = triangles[i + 1], c = triangles[i + 2];
+                    const uint32_t ab = midpoint(a, b), bc = midpoint(b, c), ca = midpoint(c, a);
+                    split.insert(split.end(), {a, ab, ca, b, bc, ab, c, ca, bc, ab, bc, ca});
+                }
+                triangles = std::move(split);
+            }
+
+            // Lumpy, flattened boulder: a few seeded waves over the sphere, squashed and sunk into the ground
+            std::mt19937 random(seed);
+            std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+            glm::vec4 waves[4];
+            for (glm::vec4 &wave: waves) {
+                wave = glm::vec4(glm::normalize(glm::vec3(unit(random), unit(random), unit(random)) + 1e-3f),
+                                 unit(random) * 3.14159f);
+            }
+            PropMesh mesh;
+            mesh.vertices.resize(positions.size());
+            for (size_t i = 0; i < positions.size(); ++i) {
+                const glm::vec3 &direction = positions[i];
+                float radius = 1.0f;
+                for (uint32_t w = 0; w < 4; ++w) {
+                    const float frequency = 2.0f + 1.5f * static_cast<float>(w);
+                    radius += 0.16f / static_cast<float>(w + 1) *
+                            std::sin(glm::dot(direction, glm::vec3(waves[w])) * frequency + waves[w].w);
+                }
+                mesh.vertices[i].pos = direction * radius * glm::vec3(1.2f, 0.75f, 1.0f) - glm::vec3(0.0f, 0.2f, 0.0f);
+                const float shade = 0.42f + 0.06f * std::sin(direction.y * 9.0f + static_cast<float>(seed));
+                mesh.vertices[i].color = glm::vec3(shade, shade * 0.96f, shade * 0.9f);
+            }
+
+            // Smooth normals from the displaced faces; the sphere's outward winding is kept
+            std::vector<glm::vec3> normals(positions.size(), glm::vec3(0.0f));
+            for (size_t i = 0; i < triangles.size(); i += 3) {
+                const glm::vec3 &a = mesh.vertices[triangles[i]].pos;
+                const glm::vec3 &b = mesh.vertices[triangles[i + 1]].pos;
+                const glm::vec3 &c = mesh.vertices[triangles[i + 2]].pos;
+                const glm::vec3 faceNormal = glm::cross(b - a, c - a);
+                for (size_t k = 0; k < 3; ++k) normals[triangles[i + k]] += faceNormal;
+            }
+            for (size_t i = 0; i < positions.size(); ++i) {
+                // Guard against normals that cancel out on a strongly displaced vertex
+                mesh.vertices[i].normal = glm::dot(normals[i], normals[i]) > 1e-12f
+                                              ? glm::normalize(normals[i])
+                                              : positions[i];
+            }
+            for (size_t i = 0; i < triangles.size(); i += 3) {
+                addTriangle(mesh, triangles[i], triangles[i + 1], triangles[i + 2]);
+            }
+            computeBounds(mesh);
+            return mesh;
+        }
+
+        glm::vec3 HemiOctahedralDirection(uint32_t x, uint32_t y, uint32_t frames) {
+            // Frame centers span [-1, 1] including the edges, so the horizon and the zenith both have a frame
+            const float scale = frames > 1 ? 2.0f / static_cast<float>(frames - 1) : 0.0f;
+            const glm::vec2 grid(static_cast<float>(x) * scale - 1.0f, static_cast<float>(y) * scale - 1.0f);
+            // Undo the 45 degree rotation that maps the diamond |x| + |z| <= 1 onto the square
+            const glm::vec2 p((grid.x + grid.y) * 0.5f, (grid.x - grid.y) * 0.5f);
+            return glm::normalize(glm::vec3(p.x, std::max(1.0f - std::abs(p.x) - std::abs(p.y), 0.0f), p.y));
+        }
+    }
+} // namespace VkGameProjectOne
@@ -0,0 +1,58 @@
+// Props.h
+
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <vulkan/vulkan.h>
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm/glm.hpp>
+
+namespace vk_project_one {
+    // Kinds of props scattered over the terrain; each has one mesh and one pair of impostor atlas layers.
+    enum class PropType : uint32_t {
+        Tree,
+        Rock,
+        Count
+    };
+
+    constexpr uint32_t PROP_TYPE_COUNT = static_cast<uint32_t>(PropType::Count);
+
+    // Vertex of a prop mesh (binding 0); instances come from binding 1 (see PropInstance).
+    struct PropVertex {
+        glm::vec3 pos;
+        glm::vec3 normal;
+        glm::vec3 color;
+
+        // Vertex binding 0 and instance binding 1 with their attributes (locations 0-2 and 3-4)
+        static std::vector<VkVertexInputBindingDescription> getBindingDescriptions();
+
+        static std::vector<VkVertexInputAttributeDescription> getAttributeDescriptions();
+    };
+
+    // One placed prop, as read by the prop shaders
+    struct PropInstance {
+        glm::vec4 positionScale; // xyz = base position on the terrain, w = uniform scale
+        glm::vec4 params; // x = rotation about Y in radians, y = PropType
+    };
+
+    struct PropMesh {
+        std::vector<PropVertex> vertices;
+        std::vector<uint32_t> indices;
+        glm::vec3 boundsMin{0.0f};
+        glm::vec3 boundsMax{0.0f};
+    };
+
+    namespace Props {
+        // Conifer: a trunk cylinder under three stacked cones. segments = vertices around each ring.
+        PropMesh BuildTree(uint32_t segments, uint32_t rings);
+
+        // Boulder: a subdivided icosahedron with its vertices pushed in and out by a hash of the seed.
+        PropMesh BuildRock(uint32_t subdivisions, uint32_t seed);
+
+        // Direction (unit, y >= 0) from the prop toward the camera of frame (x, y) of a hemi-octahedral
+        // frames x frames grid: the upper half of the octahedron unfolded into a square, so every frame
+        // covers a similar solid angle of the directions props are seen from.
+        glm::vec3 HemiOctahedralDirection(uint32_t x, uint32_t y, uint32_t frames);
+    }
+} // namespace VkGameProjectOne
@@ -0,0 +1,39 @@
+// ResourceReport.cpp
+
+#include "core/ResourceReport.h"
+#include <spdlog/spdlog.h>
+
+namespace vk_project_one {
+    static double toMiB(VkDeviceSize bytes) {
+        return static_cast<double>(bytes) / (1024.0 * 1024.0);
+    }
+
+    void ResourceReport::log(VkExtent2D extent) const {
+        spdlog::info("Resource report: {} render targets, traffic per frame at {}x{}", attachments.size(),
+                     extent.width, extent.height);
+
+        VkDeviceSize allocated = 0, committed = 0, loaded = 0, stored = 0, avoided = 0;
+        for (const Attachment &attachment: attachments) {
+            const char *memoryKind = attachment.lazilyAllocated
+                                         ? "lazy"
+                                         : attachment.transient
+                                               ? "transient"
+                                               : "resident";
+            spdlog::info("  {:<14} format {:>3} x{} {:>9} {:8.2f} MiB (committed {:8.2f} MiB) | load {:7.2f} "
+                         "store {:7.2f} avoided {:7.2f} MiB", attachment.name, static_cast<int>(attachment.format),
+                         attachment.samples, memoryKind, toMiB(attachment.allocationSize), toMiB(attachment.committedSize),
+                         toMiB(attachment.loadBytes), toMiB(attachment.storeBytes), toMiB(attachment.avoidedBytes));
+            allocated += attachment.allocationSize;
+            committed += attachment.committedSize;
+            loaded += attachment.loadBytes;
+            stored += attachment.storeBytes;
+            avoided += attachment.avoidedBytes;
+        }
+
+        spdlog::info("  Total: {:.2f} MiB allocated, {:.2f} MiB committed ({:.2f} MiB saved by lazy allocation)",
+                     toMiB(allocated), toMiB(committed), toMiB(allocated - committed));
+        spdlog::info("  Attachment traffic: {:.2f} MiB/frame ({:.2f} load + {:.2f} store), {:.2f} MiB/frame "
+                     "avoided by load/store ops", toMiB(loaded + stored), toMiB(loaded), toMiB(stored),
+                     toMiB(avoided));
+    }
+} // namespace VkGameProjectOne
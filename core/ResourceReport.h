@@ -0,0 +1,39 @@
+// ResourceReport.h
+
+#pragma once
+#include <string>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+namespace vk_project_one {
+    // Lists the render targets of the current swapchain configuration with their memory footprint
+    // and per-frame attachment traffic, so the effect of transient attachments and load/store ops
+    // can be read from the log.
+    class ResourceReport {
+    public:
+        struct Attachment {
+            std::string name;
+            VkFormat format = VK_FORMAT_UNDEFINED;
+            uint32_t samples = 1;
+            VkDeviceSize allocationSize = 0; // Memory requirement of the image
+            VkDeviceSize committedSize = 0; // Backing actually committed (lazily allocated memory may stay at 0)
+            bool transient = false; // TRANSIENT_ATTACHMENT usage, never read after the render pass
+            bool lazilyAllocated = false; // Bound to LAZILY_ALLOCATED memory
+            VkDeviceSize loadBytes = 0; // Read from memory at render pass begin (LOAD_OP_LOAD)
+            VkDeviceSize storeBytes = 0; // Written to memory at render pass end (STORE_OP_STORE)
+            VkDeviceSize avoidedBytes = 0; // Traffic skipped by CLEAR/DONT_CARE compared to LOAD/STORE
+        };
+
+        void clear() { attachments.clear(); }
+
+        void addAttachment(const Attachment &attachment) { attachments.push_back(attachment); }
+
+        const std::vector<Attachment> &getAttachments() const { return attachments; }
+
+        // Logs every attachment and the totals. Traffic is per frame at the given extent.
+        void log(VkExtent2D extent) const;
+
+    private:
+        std::vector<Attachment> attachments;
+    };
+} // namespace VkGameProjectOne
@@ -0,0 +1,123 @@
+// StreamingScheduler.cpp
+
+#include "core/StreamingScheduler.h"
+#include <algorithm>
+
+namespace vk_project_one {
+    static bool isReady(const std::future<std::vector<uint8_t>> &task) {
+        return task.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    }
+
+    void StreamingScheduler::init(const Settings &newSettings, ReadFunction readFunction,
+                                  DecodeFunction decodeFunction, UploadFunction uploadFunction) {
+        settings = newSettings;
+        settings.maxReads = std::max(settings.maxReads, 1u);
+        settings.maxDecodes = std::max(settings.maxDecodes, 1u);
+        read = std::move(readFunction);
+        decode = std::move(decodeFunction);
+        upload = std::move(uploadFunction);
+    }
+
+    void StreamingScheduler::request(uint32_t key, float priority, bool critical) {
+        auto [it, inserted] = requests.try_emplace(key);
+        Request &entry = it->second;
+        if (inserted) stats.requested++;
+        entry.priority = priority;
+        entry.renewed = true;
+        if (critical && !entry.critical) entry.criticalSince = Clock::now();
+        entry.critical = entry.critical || critical;
+    }
+
+    void StreamingScheduler::update() {
+        // Cancel what the owner no longer asks for; running tasks cannot be interrupted, so their futures are
+        // kept until they finish (a destroyed std::async future would block here)
+        for (auto it = requests.begin(); it != requests.end();) {
+            if (it->second.renewed) {
+                it->second.renewed = false;
+                ++it;
+                continue;
+            }
+            stats.cancelled++;
+            if (it->second.task.valid()) {
+                stats.cancelledInFlight++;
+                abandoned.push_back({it->second.stage, std::move(it->second.task)});
+            }
+            it = requests.erase(it);
+        }
+        std::erase_if(abandoned, [](const AbandonedTask &abandonedTask) { return isReady(abandonedTask.task); });
+
+        // Collect finished reads and decodes, and rank what is left. Abandoned tasks keep their thread busy,
+        // so they count against the caps until they finish.
+        uint32_t reading = 0;
+        uint32_t decoding = 0;
+        for (const AbandonedTask &abandonedTask: abandoned) {
+            if (abandonedTask.stage == Stage::Reading) reading++;
+            else decoding++;
+        }
+        std::vector<std::pair<uint32_t, Request *>> order;
+        order.reserve(requests.size());
+        for (auto &[key, entry]: requests) {
+            if (entry.task.valid() && isReady(entry.task)) {
+                entry.data = entry.task.get();
+                entry.stage = entry.stage == Stage::Reading ? Stage::Read : Stage::Decoded;
+            }
+            if (entry.stage == Stage::Reading) reading++;
+            if (entry.stage == Stage::Decoding) decoding++;
+            order.emplace_back(key, &entry);
+        }
+        std::sort(order.begin(), order.end(), [](const auto &a, const auto &b) {
+            if (a.second->critical != b.second->critical) return a.second->critical;
+            return a.second->priority > b.second->priority;
+        });
+
+        uint64_t uploadBytes = 0;
+        std::vector<uint32_t> uploaded;
+        for (auto &[key, entry]: order) {
+            switch (entry->stage) {
+                case Stage::Decoded:
+                    // The first upload always fits so that one large resource cannot stall the queue
+                    if (!uploaded.empty() && uploadBytes + entry->data.size() > settings.uploadBytesPerUpdate) break;
+                    uploadBytes += entry->data.size();
+                    stats.uploaded++;
+                    stats.uploadedBytes += entry->data.size();
+                    if (entry->critical) {
+                        stats.criticalMs.push_back(std::chrono::duration<float, std::milli>(
+                            Clock::now() - entry->criticalSince).count());
+                    }
+                    upload(key, std::move(entry->data));
+                    uploaded.push_back(key);
+                    break;
+                case Stage::Read:
+                    if (decoding >= settings.maxDecodes) break;
+                    decoding++;
+                    entry->stage = Stage::Decoding;
+                    entry->task = std::async(std::launch::async, decode, key, std::move(entry->data));
+                    break;
+                case Stage::Queued:
+                    if (reading >= settings.maxReads) break;
+                    reading++;
+                    entry->stage = Stage::Reading;
+                    entry->task = std::async(std::launch::async, read, key);
+                    break;
+                default:
+                    break;
+            }
+        }
+        for (uint32_t key: uploaded) requests.erase(key);
+    }
+
+    void StreamingScheduler::drain() {
+        for (auto &[key, entry]: requests) {
+            if (entry.task.valid()) entry.task.wait();
+        }
+        for (const AbandonedTask &abandonedTask: abandoned) abandonedTask.task.wait();
+        requests.clear();
+        abandoned.clear();
+    }
+
+    uint32_t StreamingScheduler::countInStage(Stage stage) const {
+        return static_cast<uint32_t>(std::count_if(requests.begin(), requests.end(), [stage](const auto &entry) {
+            return entry.second.stage == stage;
+        }));
+    }
+} // namespace VkGameProjectOne
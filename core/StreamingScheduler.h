@@ -0,0 +1,102 @@
+// StreamingScheduler.h
+
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <unordered_map>
+#include <vector>
+
+namespace vk_project_one {
+    // Orders the loading of streamed resources (terrain chunks, ...) by how much they are needed. Every frame
+    // the owner renews the requests it still wants with a current priority; a request that is not renewed
+    // before the next update() is cancelled, whatever stage it is in. Each request is read and decoded on
+    // worker threads and uploaded on the thread calling update(), and each of the three stages has its own
+    // cap: reads and decodes in flight, upload bytes per update. The caps count the tasks of cancelled
+    // requests until they finish, so cancelling cannot make room for more threads than the caps allow.
+    class StreamingScheduler {
+    public:
+        // Worker thread: fetches the stored bytes of a resource.
+        using ReadFunction = std::function<std::vector<uint8_t>(uint32_t key)>;
+        // Worker thread: turns the stored bytes into the data to upload.
+        using DecodeFunction = std::function<std::vector<uint8_t>(uint32_t key, std::vector<uint8_t> data)>;
+        // update() thread: makes the decoded data available to the renderer.
+        using UploadFunction = std::function<void(uint32_t key, std::vector<uint8_t> data)>;
+
+        struct Settings {
+            uint32_t maxReads = 8; // Reads in flight
+            uint32_t maxDecodes = 2; // Decodes in flight
+            uint64_t uploadBytesPerUpdate = 4ull << 20; // At least one upload per update regardless
+        };
+
+        // Statistics since the last resetStats(), for benchmark reporting.
+        struct Stats {
+            uint32_t requested = 0; // New requests (renewals not counted)
+            uint32_t uploaded = 0;
+            uint64_t uploadedBytes = 0;
+            uint32_t cancelled = 0; // Not renewed before their upload
+            uint32_t cancelledInFlight = 0; // ... of which had a read or decode running (wasted work)
+            std::vector<float> criticalMs; // Time from the first critical request to the upload, per request
+        };
+
+        enum class Stage {
+            Queued,
+            Reading,
+            Read, // Waiting for a decode slot
+            Decoding,
+            Decoded // Waiting for the upload budget
+        };
+
+        void init(const Settings &settings, ReadFunction read, DecodeFunction decode, UploadFunction upload);
+
+        // Asks for a resource in this frame; repeated requests update the priority. Critical requests are
+        // needed on screen right now: they go before all others and their time to upload is measured.
+        void request(uint32_t key, float priority, bool critical);
+
+        // Cancels the requests not renewed since the last update, collects finished reads and decodes,
+        // uploads decoded data in priority order within the byte budget, and starts new decodes and reads
+        // in priority order up to their caps.
+        void update();
+
+        // Waits for every read and decode in flight and drops all requests.
+        void drain();
+
+        bool isRequested(uint32_t key) const { return requests.contains(key); }
+
+        uint32_t countInStage(Stage stage) const;
+
+        const Settings &getSettings() const { return settings; }
+
+        const Stats &getStats() const { return stats; }
+
+        void resetStats() { stats = {}; }
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        struct Request {
+            float priority = 0.0f;
+            bool critical = false;
+            bool renewed = true; // Requested since the last update
+            Clock::time_point criticalSince;
+            Stage stage = Stage::Queued;
+            std::future<std::vector<uint8_t>> task; // Read or decode in flight
+            std::vector<uint8_t> data; // Output of the last finished stage
+        };
+
+        // Running read or decode of a cancelled request; it still holds its slot under the stage's cap.
+        struct AbandonedTask {
+            Stage stage; // Reading or Decoding
+            std::future<std::vector<uint8_t>> task;
+        };
+
+        Settings settings;
+        ReadFunction read;
+        DecodeFunction decode;
+        UploadFunction upload;
+        std::unordered_map<uint32_t, Request> requests;
+        std::vector<AbandonedTask> abandoned;
+        Stats stats;
+    };
+} // namespace VkGameProjectOne
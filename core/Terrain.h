@@ -26,6 +26,15 @@ namespace VkProjectOne {
         }
     };
 
+    // Square block of grid quads whose triangles occupy one contiguous index range,
+    // with its world-space bounds for culling
+    struct TerrainChunk {
+        uint32_t firstIndex;
+        uint32_t indexCount;
+        glm::vec3 boundsMin;
+        glm::vec3 boundsMax;
+    };
+
     // Class to hold the generated terrain mesh data
     class Terrain {
     public:
@@ -5,6 +5,8 @@
 
 #include <spdlog/spdlog.h>
 #include <cmath>
+#include <algorithm>
+#include <limits>
 
 // Ensure stb_image is implemented in exactly ONE .cpp file in your project
 // If it's implemented elsewhere, just include the header normally.
@@ -29,21 +31,23 @@ namespace VkProjectOne::TerrainLoader {
     }
 
     // Helper function to calculate normal using finite difference / cross product
+    // Neighbors are taken `step` pixels away, scaleXY being the world distance between them.
     glm::vec3 calculateNormal(int x, int z, int width, int height, float scaleXY, float scaleY,
-                              const stbi_uc *heightmapData, int channels) {
+                              const stbi_uc *heightmapData, int channels, int step = 1) {
         // Get heights of neighboring pixels (using helper to handle boundaries)
-        float hl = getHeight(x - 1, z, width, height, heightmapData, channels) * scaleY; // Left
-        float hr = getHeight(x + 1, z, width, height, heightmapData, channels) * scaleY; // Right
-        float hd = getHeight(x, z - 1, width, height, heightmapData, channels) * scaleY; // Down (back)
-        float hu = getHeight(x, z + 1, width, height, heightmapData, channels) * scaleY; // Up (forward)
+        float hl = getHeight(x - step, z, width, height, heightmapData, channels) * scaleY; // Left
+        float hr = getHeight(x + step, z, width, height, heightmapData, channels) * scaleY; // Right
+        float hd = getHeight(x, z - step, width, height, heightmapData, channels) * scaleY; // Down (back)
+        float hu = getHeight(x, z + step, width, height, heightmapData, channels) * scaleY; // Up (forward)
 
         // Calculate normal using cross product of vectors along X and Z axes
         // Vector along Z: (0, hu - hd, 2 * scaleXY) assuming Z increases "up" on map
         // Vector along X: (2 * scaleXY, hr - hl, 0) assuming X increases "right" on map
+        // (Their cross product, divided by 2 * scaleXY; the spacing matters once step > 1)
         glm::vec3 normal = glm::normalize(glm::vec3(
-            scaleXY * (hl - hr), // X component depends on height difference left-right
-            2.0f * scaleXY, // Y component (adjust scale based on XY scale) - this is simplified, see notes
-            scaleXY * (hd - hu) // Z component depends on height difference down-up
+            hl - hr, // X component depends on height difference left-right
+            2.0f * scaleXY, // Y component: twice the sample spacing
+            hd - hu // Z component depends on height difference down-up
         ));
 
         // A more standard cross-product approach:
@@ -59,7 +63,10 @@ namespace VkProjectOne::TerrainLoader {
         float scaleXY,
         float scaleY,
         std::vector<TerrainVertex> &outVertices,
-        std::vector<uint32_t> &outIndices) {
+        std::vector<uint32_t> &outIndices,
+        std::vector<TerrainChunk> *outChunks,
+        uint32_t chunkQuads,
+        uint32_t sampleStep) {
         spdlog::info("Loading terrain from heightmap: {}", heightmapPath);
 
         int width, height, channels;
@@ -80,23 +87,30 @@ namespace VkProjectOne::TerrainLoader {
         }
 
 
+        // Mesh grid: every sampleStep-th pixel (a trailing partial step is dropped)
+        const int step = static_cast<int>(std::max(sampleStep, 1u));
+        const int gridWidth = (width - 1) / step + 1;
+        const int gridHeight = (height - 1) / step + 1;
+
         outVertices.clear();
         outIndices.clear();
-        outVertices.reserve(static_cast<size_t>(width) * height); // Pre-allocate memory
-        outIndices.reserve(static_cast<size_t>(width - 1) * (height - 1) * 6); // 6 indices per quad
+        outVertices.reserve(static_cast<size_t>(gridWidth) * gridHeight); // Pre-allocate memory
+        outIndices.reserve(static_cast<size_t>(gridWidth - 1) * (gridHeight - 1) * 6); // 6 indices per quad
 
         // Generate Vertices
         spdlog::debug("Generating terrain vertices...");
-        for (int z = 0; z < height; ++z) {
-            for (int x = 0; x < width; ++x) {
+        for (int gz = 0; gz < gridHeight; ++gz) {
+            for (int gx = 0; gx < gridWidth; ++gx) {
                 TerrainVertex vertex;
+                const int x = gx * step;
+                const int z = gz * step;
 
                 // Position
                 float terrainHeight = getHeight(x, z, width, height, pixels, channels) * scaleY;
                 vertex.pos = glm::vec3(x * scaleXY, terrainHeight, z * scaleXY);
 
-                // Normal (Calculate based on neighbors)
-                vertex.normal = calculateNormal(x, z, width, height, scaleXY, scaleY, pixels, channels);
+                // Normal (Calculate based on neighbors one grid step away)
+                vertex.normal = calculateNormal(x, z, width, height, scaleXY * step, scaleY, pixels, channels, step);
 
                 // Texture Coordinates (Stretch texture over the whole terrain)
                 vertex.texCoord = glm::vec2(
@@ -112,25 +126,60 @@ namespace VkProjectOne::TerrainLoader {
 
         // Generate Indices (Triangle List for grid)
         spdlog::debug("Generating terrain indices...");
-        for (int z = 0; z < height - 1; ++z) {
-            for (int x = 0; x < width - 1; ++x) {
-                // Indices for the 4 corners of the quad
-                uint32_t topLeft = z * width + x;
-                uint32_t topRight = topLeft + 1;
-                uint32_t bottomLeft = (z + 1) * width + x;
-                uint32_t bottomRight = bottomLeft + 1;
-
-                // Add indices for the two triangles forming the quad
-                // Triangle 1: Top-Left -> Bottom-Left -> Top-Right
-                outIndices.push_back(topLeft);
-                outIndices.push_back(bottomLeft);
-                outIndices.push_back(topRight);
-
-                // Triangle 2: Top-Right -> Bottom-Left -> Bottom-Right
-                outIndices.push_back(topRight);
-                outIndices.push_back(bottomLeft);
-                outIndices.push_back(bottomRight);
+        auto addQuad = [&](int x, int z) {
+            // Indices for the 4 corners of the quad
+            uint32_t topLeft = z * gridWidth + x;
+            uint32_t topRight = topLeft + 1;
+            uint32_t bottomLeft = (z + 1) * gridWidth + x;
+            uint32_t bottomRight = bottomLeft + 1;
+
+            // Add indices for the two triangles forming the quad
+            // Triangle 1: Top-Left -> Bottom-Left -> Top-Right
+            outIndices.push_back(topLeft);
+            outIndices.push_back(bottomLeft);
+            outIndices.push_back(topRight);
+
+            // Triangle 2: Top-Right -> Bottom-Left -> Bottom-Right
+            outIndices.push_back(topRight);
+            outIndices.push_back(bottomLeft);
+            outIndices.push_back(bottomRight);
+        };
+
+        if (!outChunks) {
+            for (int z = 0; z < gridHeight - 1; ++z) {
+                for (int x = 0; x < gridWidth - 1; ++x) {
+                    addQuad(x, z);
+                }
+            }
+        } else {
+            // Same triangles, ordered block by block so that each chunk can be drawn (or culled) on its own
+            const int chunkSize = static_cast<int>(std::max(chunkQuads, 1u));
+            outChunks->clear();
+            for (int cz = 0; cz < gridHeight - 1; cz += chunkSize) {
+                for (int cx = 0; cx < gridWidth - 1; cx += chunkSize) {
+                    TerrainChunk chunk{};
+                    chunk.firstIndex = static_cast<uint32_t>(outIndices.size());
+                    chunk.boundsMin = glm::vec3(std::numeric_limits<float>::max());
+                    chunk.boundsMax = glm::vec3(std::numeric_limits<float>::lowest());
+                    const int endZ = std::min(cz + chunkSize, gridHeight - 1);
+                    const int endX = std::min(cx + chunkSize, gridWidth - 1);
+                    for (int z = cz; z < endZ; ++z) {
+                        for (int x = cx; x < endX; ++x) {
+                            addQuad(x, z);
+                        }
+                    }
+                    for (int z = cz; z <= endZ; ++z) {
+                        for (int x = cx; x <= endX; ++x) {
+                            const glm::vec3 &pos = outVertices[static_cast<size_t>(z) * gridWidth + x].pos;
+                            chunk.boundsMin = glm::min(chunk.boundsMin, pos);
+                            chunk.boundsMax = glm::max(chunk.boundsMax, pos);
+                        }
+                    }
+                    chunk.indexCount = static_cast<uint32_t>(outIndices.size()) - chunk.firstIndex;
+                    outChunks->push_back(chunk);
+                }
             }
+            spdlog::debug("Split terrain into {} chunks of {}x{} quads.", outChunks->size(), chunkSize, chunkSize);
         }
         spdlog::debug("Generated {} indices.", outIndices.size());
 
@@ -14,6 +14,10 @@ namespace VkProjectOne::TerrainLoader {
          * @param scaleY Scaling factor for the height (Y dimension) based on pixel intensity.
          * @param outVertices [Output] Vector to be filled with generated TerrainVertex data.
          * @param outIndices [Output] Vector to be filled with generated index data (triangle list).
+         * @param outChunks [Output, optional] If given, indices are emitted chunk by chunk and each chunk's
+         *                  index range and bounds are stored here.
+         * @param chunkQuads Edge length of a chunk in grid quads.
+         * @param sampleStep Place a vertex at every sampleStep-th heightmap pixel (1 = full resolution).
          * @return True if loading and generation were successful, false otherwise.
          */
     bool LoadFromHeightmap(
@@ -21,7 +25,10 @@ namespace VkProjectOne::TerrainLoader {
         float scaleXY,
         float scaleY,
         std::vector<TerrainVertex> &outVertices,
-        std::vector<uint32_t> &outIndices);
+        std::vector<uint32_t> &outIndices,
+        std::vector<TerrainChunk> *outChunks = nullptr,
+        uint32_t chunkQuads = 32,
+        uint32_t sampleStep = 1);
 
     // Helper function (optional, could be private in .cpp)
     // float getHeight(int x, int z, int width, int height, const unsigned char* heightmapData, int channels);
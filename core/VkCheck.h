@@ -0,0 +1,14 @@
+// VkCheck.h
+
+#pragma once
+#include <spdlog/spdlog.h>
+#include <stdexcept>
+#include <string>
+#include <vulkan/vulkan.h>
+
+// --- VK_CHECK Macro ---
+#define VK_CHECK(result, msg) \
+    if (result != VK_SUCCESS) { \
+        spdlog::critical("Vulkan call failed: {} - VkResult: {}", msg, static_cast<int>(result)); \
+        throw std::runtime_error(std::string(msg) + " failed!"); \
+    }
@@ -12,6 +12,15 @@
 #include <fstream>
 #include <chrono>
 #include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <functional>
+#include <future>
+#include <thread>
+#include <unordered_map>
 
 // Dependencies
 #include <SDL3/SDL.h>
@@ -23,9 +32,35 @@
 #include <glm/gtc/matrix_transform.hpp>
 
 #include "TerrainLoader.h"
+#include "MeshSimplifier.h"
+#include "GlbLoader.h"
+#include "MeshCodec.h"
+#include "VkCheck.h"
 
 // --- Constants ---
 constexpr int MAX_FRAMES_IN_FLIGHT = 2;
+constexpr float CAMERA_NEAR = 0.5f; // Projection planes, shared with the fog and impostor depth reconstruction
+constexpr float CAMERA_FAR = 2000.0f; // Covers the whole terrain
+constexpr float CAMERA_FOV_Y = 45.0f; // Degrees
+constexpr float TERRAIN_HEIGHT_SCALE = 10.0f; // World units at full heightmap intensity
+constexpr float TERRAIN_CELL_SIZE = 1.0f; // World units between heightmap samples
+constexpr float STREAM_LOOKAHEAD_SECONDS = 1.0f; // Terrain streaming requests chunks this far ahead of the camera
+constexpr float STREAM_EVICT_MARGIN = 1.25f; // ... and evicts them this much farther out than the stream radius
+constexpr uint32_t RAY_MARCH_MAX_STEPS = 256; // Far-field rays give up (and show sky) after this many steps
+constexpr float DETAIL_TILE_SIZE = 4.0f; // World units covered by one repeat of the detail height texture
+constexpr uint32_t PARALLAX_MAX_STEPS = 32; // Parallax occlusion layers at grazing angles
+constexpr uint32_t PARTICLE_GROUP_SIZE = 256; // local_size_x of shaders/particle.comp
+constexpr uint32_t PROP_ATLAS_FRAMES = 8; // Impostor frames per atlas row and column
+constexpr uint32_t PROP_ATLAS_FRAME_SIZE = 128; // Pixels per frame at mip 0
+constexpr uint32_t PROP_ATLAS_LEVELS = 4; // Down to 16-pixel frames
+const glm::vec3 SUN_DIRECTION = glm::normalize(glm::vec3(0.42f, 0.82f, 0.38f)); // As in terrain_shading.glsl
+constexpr float ATMOSPHERE_KM_PER_UNIT = 0.01f; // Scale of the scene for the atmosphere (1 unit = 10 m)
+constexpr float ATMOSPHERE_AERIAL_DEPTH_KM = 32.0f; // Depth covered by the aerial perspective volume
+constexpr float ATMOSPHERE_GROUND_ALBEDO = 0.3f;
+constexpr float SUN_ILLUMINANCE = 8.0f; // Scene-referred scale of the sky and aerial perspective light
+constexpr uint32_t POST_BINDING_COUNT = 7; // See shaders/post.comp
+// Transmittance, multiple scattering, sky view and aerial perspective (slices in depth)
+constexpr VkExtent3D ATMOSPHERE_LUT_EXTENTS[4] = {{256, 64, 1}, {32, 32, 1}, {192, 108, 1}, {32, 32, 32}};
 
 // List of validation layers to enable (if requested)
 const std::vector<const char *> validationLayers = {
@@ -47,13 +82,6 @@ const bool enableValidationLayers = false;
 const bool enableValidationLayers = true;
 #endif
 
-// --- VK_CHECK Macro ---
-#define VK_CHECK(result, msg) \
-    if (result != VK_SUCCESS) { \
-        spdlog::critical("Vulkan call failed: {} - VkResult: {}", msg, static_cast<int>(result)); \
-        throw std::runtime_error(std::string(msg) + " failed!"); \
-    }
-
 namespace vk_project_one {
     // --- Static Helper Functions ---
 
@@ -79,6 +107,146 @@ namespace vk_project_one {
         return buffer;
     }
 
+    // Builds a single-mip, single-layer image layout transition barrier
+    static VkImageMemoryBarrier makeImageBarrier(VkImage image, VkImageLayout oldLayout, VkImageLayout newLayout,
+                                                 VkAccessFlags srcAccessMask, VkAccessFlags dstAccessMask,
+                                                 VkImageAspectFlags aspectMask = VK_IMAGE_ASPECT_COLOR_BIT) {
+        VkImageMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.image = image;
+        barrier.subresourceRange = {aspectMask, 0, 1, 0, 1};
+        barrier.oldLayout = oldLayout;
+        barrier.newLayout = newLayout;
+        barrier.srcAccessMask = srcAccessMask;
+        barrier.dstAccessMask = dstAccessMask;
+        return barrier;
+    }
+
+    // Approximate storage size of one texel, for memory and bandwidth estimates
+    static uint32_t formatBytesPerPixel(VkFormat format) {
+        switch (format) {
+            case VK_FORMAT_R16G16B16A16_SFLOAT:
+                return 8;
+            case VK_FORMAT_D32_SFLOAT_S8_UINT:
+                return 5;
+            default:
+                return 4; // RGBA8/BGRA8 (UNORM or SRGB), A2B10G10R10, D32, D24S8
+        }
+    }
+
+    // Push constants shared by the EASU and RCAS compute shaders
+    struct UpscalePushConstants {
+        glm::vec4 con0; // EASU: input/output scale + offset, RCAS: x = sharpness
+        glm::ivec4 extents; // xy = output size, zw = readable input size
+    };
+
+    // Push constants of the post-processing compute shader (see shaders/post.comp)
+    struct PostPushConstants {
+        glm::vec4 fogColorDensity; // rgb = fog color, a = density per world unit
+        glm::vec4 camera; // x = near, y = far, z = exposure, w = vignette strength
+        glm::ivec4 extents; // xy = processed size, zw = full target size
+        glm::uvec4 frame; // x = frame index
+        glm::vec4 rayX; // xyz = camera right * tan(half horizontal fov), w = sun direction x
+        glm::vec4 rayY; // xyz = camera down * tan(half vertical fov), w = sun direction y
+        glm::vec4 rayZ; // xyz = camera forward, w = sun direction z
+        glm::vec4 atmosphere; // x = camera height in km, y = km per world unit, z = sun illuminance, w = aerial depth
+    };
+
+    // Push constants of the atmosphere LUT passes (see shaders/atmosphere.comp)
+    struct AtmospherePushConstants {
+        glm::vec4 medium; // x = Rayleigh density, y = Mie density, z = ground albedo, w = aerial depth in km
+        glm::vec4 sun; // xyz = direction to the sun, w = camera height in km
+        glm::vec4 rayX; // Same camera rays as PostPushConstants
+        glm::vec4 rayY;
+        glm::vec4 rayZ;
+    };
+
+    // Corner rays of a camera looking along forward (y up): right and down scaled to the frustum edges
+    static void cameraRays(const glm::vec3 &forward, float aspect, glm::vec3 &rayX, glm::vec3 &rayY) {
+        const float tanHalfFovY = std::tan(glm::radians(CAMERA_FOV_Y) * 0.5f);
+        const glm::vec3 right = glm::normalize(glm::cross(forward, glm::vec3(0.0f, 1.0f, 0.0f)));
+        rayX = right * (tanHalfFovY * aspect);
+        rayY = glm::cross(forward, right) * tanHalfFovY;
+    }
+
+    // Push constants of the terrain shaders (see shaders/terrain.vert)
+    struct TerrainPushConstants {
+        glm::mat4 viewProj;
+        glm::vec4 eye; // xyz = position the distance ring is measured from, w = terrain height scale
+        glm::vec4 ring; // x = min distance, y = max distance, z = 1 to write the distance into alpha
+        glm::vec4 detail; // x = parallax radius, y = relief depth, z = detail tile size, w = max steps
+    };
+
+    // Push constants of the impostor composite shaders (see shaders/impostor.frag)
+    struct ImpostorPushConstants {
+        glm::mat4 invViewProj;
+        glm::vec4 eye; // xyz = camera position, w = near plane
+        glm::vec4 center; // xyz = impostor center, w = far plane
+        glm::vec4 forward; // xyz = view direction, w = depth of the full-screen triangle
+    };
+
+    // Push constants of the ray-marched far field (see shaders/raymarch.frag). Both composites share
+    // the full-screen triangle of impostor.vert, so forward sits at the same offset in each.
+    struct RayMarchPushConstants {
+        glm::mat4 invViewProj;
+        glm::vec4 eye; // xyz = camera position, w = near plane
+        glm::vec4 grid; // xy = world xz of the first height sample, z = cell size, w = far plane
+        glm::vec4 forward; // xyz = view direction, w = depth of the full-screen triangle
+        glm::vec4 ray; // x = start distance, y = max steps, z = top mip level, w = terrain height scale
+    };
+
+    // One particle in the pools (see shaders/particle.comp)
+    struct ParticleData {
+        glm::vec4 positionLife; // xyz = world position, w = remaining life in seconds
+        glm::vec4 velocitySize; // xyz = velocity, w = billboard size
+    };
+
+    // Counters and indirect arguments written by the particle passes
+    struct ParticleState {
+        uint32_t alive[2]; // Live particles per pool
+        uint32_t emitted; // Appended by the emit pass this frame
+        uint32_t pad;
+        VkDispatchIndirectCommand simulateArgs; // Next simulate pass, one thread per live particle
+        uint32_t simulatePad;
+        VkDrawIndirectCommand drawArgs; // Six vertices per live particle
+    };
+
+    // Push constants of the particle compute passes (see shaders/particle.comp)
+    struct ParticlePushConstants {
+        glm::vec4 emitter; // xyz = emission center (camera position), w = emission radius
+        glm::vec4 grid; // xy = world xz of the first height sample, z = cell size, w = time step
+        glm::vec4 wind; // xyz = wind velocity, w = time in seconds
+        glm::uvec4 counts; // x = pool capacity, y = particles to emit, z = source pool index, w = random seed
+    };
+
+    // Push constants of the particle billboards (see shaders/particle.vert)
+    struct ParticleDrawPushConstants {
+        glm::vec4 eye; // xyz = camera position
+        glm::uvec4 view; // x = view drawn into its viewport (without multiview)
+    };
+
+    // Emission per ParticleEffect: mean lifetime (sets the emission rate) and radius around the camera
+    struct ParticleEffectSettings {
+        float meanLife;
+        float radius;
+    };
+
+    static constexpr ParticleEffectSettings PARTICLE_EFFECTS[3] = {
+        {6.0f, 48.0f}, // Dust
+        {8.0f, 32.0f}, // Smoke
+        {2.5f, 40.0f} // Rain: most drops reach the ground well before their 4 s
+    };
+    static const glm::vec3 PARTICLE_WIND{2.5f, 0.0f, 1.0f};
+
+    // Push constants of the prop mesh, impostor and atlas bake shaders (see shaders/prop_common.glsl)
+    struct PropPushConstants {
+        glm::mat4 viewProj;
+        glm::vec4 eye; // xyz = camera position, w = impostor frames per atlas row
+        glm::vec4 bounds[PROP_TYPE_COUNT]; // Per PropType: xyz = local bounding sphere center, w = radius
+    };
+
     // --- Vulkan Debug Callback Implementation ---
     VKAPI_ATTR VkBool32 VKAPI_CALL VulkanEngine::debugCallback(
         VkDebugUtilsMessageSeverityFlagBitsEXT messageSeverity,
@@ -155,11 +323,17 @@ namespace vk_project_one {
     };
 
     // --- VulkanEngine Constructor / Destructor ---
-    VulkanEngine::VulkanEngine(SDL_Window *sdlWindow) : window(sdlWindow) {
-        if (!window) {
+    VulkanEngine::VulkanEngine(const std::vector<SDL_Window *> &sdlWindows, const EngineConfig &engineConfig)
+        : window(sdlWindows.empty() ? nullptr : sdlWindows.front()), config(engineConfig) {
+        if (!window || std::find(sdlWindows.begin(), sdlWindows.end(), nullptr) != sdlWindows.end()) {
             spdlog::critical("VulkanEngine requires a valid SDL_Window!");
             throw std::runtime_error("Window pointer passed to VulkanEngine was null!");
         }
+        for (size_t i = 1; i < sdlWindows.size(); ++i) {
+            WindowOutput output{};
+            output.window = sdlWindows[i];
+            windowOutputs.push_back(output);
+        }
         spdlog::info("Initializing VulkanEngine...");
         try {
             initVulkan();
@@ -193,18 +367,66 @@ namespace vk_project_one {
 
     void VulkanEngine::initVulkan() {
         spdlog::debug("Starting Vulkan initialization sequence...");
+        if (config.benchmarkCompare == BenchmarkCompare::PostChain && config.postEffects == 0) {
+            spdlog::warn("Post-processing comparison requested without --post effects. Comparison disabled.");
+            config.benchmarkCompare = BenchmarkCompare::None;
+        }
+        if (config.dynamicResolution && config.benchmarkCompare != BenchmarkCompare::None) {
+            // The benchmark alternates two variants, which would confuse the controller
+            spdlog::info("Benchmark comparison: dynamic resolution disabled for stable comparisons.");
+            config.dynamicResolution = false;
+        }
+        if (config.dynamicResolution) {
+            DynamicResolution::Settings settings{};
+            settings.targetFrameMs = config.targetFrameTimeMs;
+            settings.minScale = config.minRenderScale;
+            settings.maxScale = config.maxRenderScale;
+            settings.settleFrames = MAX_FRAMES_IN_FLIGHT + 1;
+            dynamicResolution = std::make_unique<DynamicResolution>(settings);
+        }
         createInstance();
         setupDebugMessenger();
         createSurface();
         pickPhysicalDevice();
+        // The view sweep starts with a single view and works up to the configured count
+        viewCount = config.benchmarkCompare == BenchmarkCompare::Views ? 1 : config.viewCount;
+        if (config.benchmarkCompare == BenchmarkCompare::Views) {
+            benchmarkViewFrameMs.assign(config.viewCount, 0.0f);
+            benchmarkViewRecordMs.assign(config.viewCount, 0.0f);
+        }
+        const std::vector<VkSampleCountFlagBits> sampleCounts = getSupportedSampleCounts();
+        if (config.benchmarkCompare == BenchmarkCompare::Msaa) {
+            benchmarkSampleCounts = sampleCounts;
+            benchmarkSampleSceneMs.assign(sampleCounts.size(), 0.0f);
+            msaaSamples = sampleCounts.front();
+        } else {
+            // Highest supported count that does not exceed the request
+            for (VkSampleCountFlagBits samples: sampleCounts) {
+                if (static_cast<uint32_t>(samples) <= config.msaaSamples) msaaSamples = samples;
+            }
+            if (static_cast<uint32_t>(msaaSamples) != config.msaaSamples) {
+                spdlog::warn("{}x MSAA is not supported, using {}x.", config.msaaSamples,
+                             static_cast<int>(msaaSamples));
+            }
+        }
+        VkPhysicalDeviceMemoryProperties memoryProperties;
+        vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memoryProperties);
+        memoryReport.init(memoryProperties);
         createLogicalDevice();
         createSwapChain();
         createImageViews();
+        createSceneTargets();
         createRenderPass();
         createDescriptorSetLayout();
+        createImpostorTargets();
         createGraphicsPipeline();
         createFramebuffers();
+        updateResourceReport();
         createCommandPool();
+        createUpscalerPipelines();
+        createPostProcessPipelines();
+        createPostProcessTargets();
+        createUpscalerTargets();
         createVertexBuffer();
         createIndexBuffer();
         createUniformBuffers();
@@ -212,14 +434,33 @@ namespace vk_project_one {
         createDescriptorSets();
         createCommandBuffers();
         createSyncObjects();
+        createAsyncCompute();
+        createWindowOutputs();
+        initGpuTiming();
+        loadTerrain();
+        createTerrainDetail();
+        createTerrainPipelines(); // The ray-marched far field needs the heightfield from loadTerrain
+        createParticleSystem(); // Collides with the same heightfield
+        createParticleDrawPipeline();
+        createPropPipelines();
+        if (config.memoryReport) logMemoryReport(true);
+        spdlog::debug("Vulkan initialization sequence complete.");
+    }
+
+    void VulkanEngine::loadTerrain() {
         std::vector<VkProjectOne::TerrainVertex> terrainVertices;
         std::vector<uint32_t> terrainIndices;
-        if (VkProjectOne::TerrainLoader::LoadFromHeightmap("assets/heightmaps/terrain_one_hmap.png", 1.0f, 10.0f,
-                                                           terrainVertices, terrainIndices)) {
+        if (VkProjectOne::TerrainLoader::LoadFromHeightmap("assets/heightmaps/terrain_one_hmap.png", TERRAIN_CELL_SIZE,
+                                                           TERRAIN_HEIGHT_SCALE, terrainVertices, terrainIndices,
+                                                           &terrainChunks, 32, config.terrainStep)) {
             terrainIndexCount = terrainIndices.size(); // Store index count member
-            // Now call your Vulkan buffer creation functions using these vectors
-            createTerrainVertexBuffer(terrainVertices); // You'll need to write this helper
-            createTerrainIndexBuffer(terrainIndices); // You'll need to write this helper
+            // Streamed chunks get their own buffers; the whole-terrain ones are not needed then
+            if (config.streamRadius > 0.0f) {
+                createTerrainStreaming(terrainVertices, terrainIndices);
+            } else {
+                createTerrainVertexBuffer(terrainVertices);
+                createTerrainIndexBuffer(terrainIndices);
+            }
             spdlog::debug("Terrain Mesh Loaded: Vertices={}, Indices={}", terrainVertices.size(), terrainIndexCount);
             if (!terrainVertices.empty()) {
                 spdlog::debug("First vertex pos: ({}, {}, {})", terrainVertices[0].pos.x, terrainVertices[0].pos.y, terrainVertices[0].pos.z);
@@ -230,7 +471,611 @@ namespace vk_project_one {
             spdlog::error("Failed to load terrain mesh data.");
             throw std::runtime_error("Failed to load terrain mesh data.");
         }
-        spdlog::debug("Vulkan initialization sequence complete.");
+
+        // A coarser mesh spreads the same heightmap over fewer vertices; parallax detail makes up for
+        // the lost relief near the camera. Log what was saved against the full-resolution mesh.
+        terrainCellSize = TERRAIN_CELL_SIZE * static_cast<float>(config.terrainStep);
+        if (config.terrainStep > 1) {
+            const size_t fullVertices = terrainVertices.size() * config.terrainStep * config.terrainStep;
+            spdlog::info("Terrain mesh decimated to every {} px: {} vertices and {} triangles instead of ~{} "
+                         "vertices.", config.terrainStep, terrainVertices.size(), terrainIndexCount / 3, fullVertices);
+        }
+
+        terrainBoundsMin = glm::vec3(std::numeric_limits<float>::max());
+        terrainBoundsMax = glm::vec3(std::numeric_limits<float>::lowest());
+        for (const VkProjectOne::TerrainChunk &chunk: terrainChunks) {
+            terrainBoundsMin = glm::min(terrainBoundsMin, chunk.boundsMin);
+            terrainBoundsMax = glm::max(terrainBoundsMax, chunk.boundsMax);
+        }
+
+        // Impostor sweep: no impostor first (the baseline), then splits at fractions of the terrain size
+        const float size = std::max(terrainBoundsMax.x - terrainBoundsMin.x, terrainBoundsMax.z - terrainBoundsMin.z);
+        if (config.benchmarkCompare == BenchmarkCompare::Impostor) {
+            benchmarkSplits = {0.0f, size / 16.0f, size / 8.0f, size / 4.0f, size / 2.0f};
+            benchmarkSplitFrameMs.assign(benchmarkSplits.size(), 0.0f);
+            benchmarkSplitIndex = 0;
+        }
+        if (config.benchmarkCompare == BenchmarkCompare::RayMarch && config.farFieldSplit <= 0.0f) {
+            config.farFieldSplit = size / 8.0f;
+        }
+
+        // Ray-marched far field and particle collisions both read the vertex heights
+        if (isRayMarchUsed() || config.particleCount > 0) {
+            const uint32_t gridWidth = static_cast<uint32_t>(
+                                           std::lround((terrainBoundsMax.x - terrainBoundsMin.x) / terrainCellSize)) + 1;
+            createHeightfield(terrainVertices, gridWidth, static_cast<uint32_t>(terrainVertices.size()) / gridWidth);
+        }
+        if (config.benchmarkMode) measureTerrainCodec(terrainVertices, terrainIndices);
+        createProps(terrainVertices);
+    }
+
+    void VulkanEngine::createTerrainStreaming(const std::vector<VkProjectOne::TerrainVertex> &vertices,
+                                              const std::vector<uint32_t> &indices) {
+        // The compressed chunks stay in memory and stand in for a chunk archive on disk
+        terrainChunkPayloads.assign(terrainChunks.size(), {});
+        terrainChunkSlots.assign(terrainChunks.size(), ChunkPool::INVALID_SLOT);
+        size_t packedBytes = 0;
+        uint32_t slotVertices = 0;
+        uint32_t slotIndices = 0;
+        std::vector<VkProjectOne::TerrainVertex> chunkVertices;
+        std::vector<uint32_t> chunkIndices;
+        std::unordered_map<uint32_t, uint32_t> localIndex;
+        for (size_t i = 0; i < terrainChunks.size(); ++i) {
+            const VkProjectOne::TerrainChunk &chunk = terrainChunks[i];
+            chunkVertices.clear();
+            chunkIndices.clear();
+            localIndex.clear();
+            for (uint32_t j = chunk.firstIndex; j < chunk.firstIndex + chunk.indexCount; ++j) {
+                auto [it, inserted] = localIndex.try_emplace(indices[j], static_cast<uint32_t>(chunkVertices.size()));
+                if (inserted) chunkVertices.push_back(vertices[indices[j]]);
+                chunkIndices.push_back(it->second);
+            }
+            TerrainChunkPayload &payload = terrainChunkPayloads[i];
+            payload.vertexCount = static_cast<uint32_t>(chunkVertices.size());
+            slotVertices = std::max(slotVertices, payload.vertexCount);
+            slotIndices = std::max(slotIndices, chunk.indexCount);
+            payload.packedVertices = MeshCodec::EncodeVertices(chunkVertices.data(), chunkVertices.size(),
+                                                               sizeof(VkProjectOne::TerrainVertex));
+            payload.packedIndices = MeshCodec::EncodeIndices(chunkIndices.data(), chunkIndices.size());
+            packedBytes += payload.packedVertices.size() + payload.packedIndices.size();
+        }
+
+        // Enough slots for the chunks touching the eviction disks around the camera and its look-ahead
+        // position; slots are sized for the largest chunk (edge chunks may be smaller)
+        const VkProjectOne::TerrainChunk &first = terrainChunks.front();
+        const float chunkSize = std::max(first.boundsMax.x - first.boundsMin.x, first.boundsMax.z - first.boundsMin.z);
+        const float reach = config.streamRadius * STREAM_EVICT_MARGIN + chunkSize * 1.5f;
+        const double diskChunks = std::ceil(3.14159265 * reach * reach / (chunkSize * chunkSize));
+        const uint32_t slotCount = static_cast<uint32_t>(std::min<double>(2.0 * diskChunks, terrainChunks.size()));
+        terrainChunkPool.init(slotCount, slotVertices, slotIndices);
+        // Transfer source as well: compaction copies chunks between slots of the same buffer
+        const VkBufferUsageFlags poolUsage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+        createBuffer({MemoryCategory::TerrainVertices, "terrain vertex pool"},
+                     static_cast<VkDeviceSize>(slotCount) * slotVertices * sizeof(VkProjectOne::TerrainVertex),
+                     poolUsage | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                     terrainVertexBuffer, terrainVertexBufferMemory);
+        createBuffer({MemoryCategory::TerrainIndices, "terrain index pool"},
+                     static_cast<VkDeviceSize>(slotCount) * slotIndices * sizeof(uint32_t),
+                     poolUsage | VK_BUFFER_USAGE_INDEX_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                     terrainIndexBuffer, terrainIndexBufferMemory);
+
+        // Reads hand the compressed chunk to the decode stage, which expands it to vertices then indices
+        StreamingScheduler::Settings settings;
+        settings.maxDecodes = std::max(std::thread::hardware_concurrency() / 2, 1u);
+        auto read = [this](uint32_t chunk) {
+            const TerrainChunkPayload &payload = terrainChunkPayloads[chunk];
+            std::vector<uint8_t> data(payload.packedVertices);
+            data.insert(data.end(), payload.packedIndices.begin(), payload.packedIndices.end());
+            return data;
+        };
+        auto decode = [this](uint32_t chunk, std::vector<uint8_t> packed) {
+            const TerrainChunkPayload &payload = terrainChunkPayloads[chunk];
+            const size_t vertexBytes = payload.vertexCount * sizeof(VkProjectOne::TerrainVertex);
+            std::vector<uint8_t> data(vertexBytes + terrainChunks[chunk].indexCount * sizeof(uint32_t));
+            const size_t packedVertexBytes = payload.packedVertices.size();
+            if (!MeshCodec::DecodeVertices(data.data(), payload.vertexCount, sizeof(VkProjectOne::TerrainVertex),
+                                           packed.data(), packedVertexBytes) ||
+                !MeshCodec::DecodeIndices(reinterpret_cast<uint32_t *>(data.data() + vertexBytes),
+                                          terrainChunks[chunk].indexCount, packed.data() + packedVertexBytes,
+                                          packed.size() - packedVertexBytes)) {
+                throw std::runtime_error("Failed to decode a streamed terrain chunk");
+            }
+            return data;
+        };
+        auto upload = [this](uint32_t chunk, std::vector<uint8_t> data) { uploadTerrainChunk(chunk, data); };
+        terrainStreamer.init(settings, read, decode, upload);
+
+        // An update uploads within its byte budget, or a single chunk above it, so a region holds the larger
+        const VkDeviceSize slotBytes = slotVertices * sizeof(VkProjectOne::TerrainVertex) +
+                                       slotIndices * sizeof(uint32_t);
+        terrainStagingRegionBytes = std::max<VkDeviceSize>(settings.uploadBytesPerUpdate, slotBytes);
+        createBuffer({MemoryCategory::Staging, "terrain chunk staging ring"},
+                     terrainStagingRegionBytes * MAX_FRAMES_IN_FLIGHT, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                     VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                     terrainStagingBuffer, terrainStagingBufferMemory);
+        VK_CHECK(vkMapMemory(device, terrainStagingBufferMemory, 0, VK_WHOLE_SIZE, 0, &terrainStagingMapped),
+                 "Failed to map terrain chunk staging ring");
+        streamingUpdateTime = std::chrono::steady_clock::now();
+
+        const size_t rawBytes = vertices.size() * sizeof(VkProjectOne::TerrainVertex) +
+                                indices.size() * sizeof(uint32_t);
+        const size_t poolBytes = static_cast<size_t>(slotCount) * (slotVertices * sizeof(VkProjectOne::TerrainVertex) +
+                                                                   slotIndices * sizeof(uint32_t));
+        spdlog::info("Terrain streaming: {} chunks within {:.0f} units, {:.1f} MB compressed ({:.1f} MB as one mesh); "
+                     "pool of {} slots ({} vertices, {} indices each), {:.1f} MB; staging ring {:.1f} MB",
+                     terrainChunks.size(),
+                     config.streamRadius, static_cast<double>(packedBytes) / (1024.0 * 1024.0),
+                     static_cast<double>(rawBytes) / (1024.0 * 1024.0), slotCount, slotVertices, slotIndices,
+                     static_cast<double>(poolBytes) / (1024.0 * 1024.0),
+                     static_cast<double>(terrainStagingRegionBytes * MAX_FRAMES_IN_FLIGHT) / (1024.0 * 1024.0));
+    }
+
+    void VulkanEngine::measureTerrainCodec(const std::vector<VkProjectOne::TerrainVertex> &vertices,
+                                           const std::vector<uint32_t> &indices) {
+        constexpr int DECODE_RUNS = 5;
+        using Clock = std::chrono::steady_clock;
+        auto seconds = [](Clock::time_point start) {
+            return std::chrono::duration<double>(Clock::now() - start).count();
+        };
+        const size_t vertexBytes = vertices.size() * sizeof(VkProjectOne::TerrainVertex);
+        const size_t indexBytes = indices.size() * sizeof(uint32_t);
+        if (vertexBytes == 0 || indexBytes == 0) return;
+
+        Clock::time_point start = Clock::now();
+        const std::vector<uint8_t> packedVertices = MeshCodec::EncodeVertices(
+            vertices.data(), vertices.size(), sizeof(VkProjectOne::TerrainVertex));
+        const std::vector<uint8_t> packedIndices = MeshCodec::EncodeIndices(indices.data(), indices.size());
+        const double encodeSeconds = seconds(start);
+
+        // Decode where a streamed chunk would go: straight into mapped upload memory
+        VkBuffer stagingBuffer;
+        VkDeviceMemory stagingBufferMemory;
+        createBuffer({MemoryCategory::Staging, "terrain codec staging"},
+                     vertexBytes + indexBytes, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                     VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                     stagingBuffer, stagingBufferMemory);
+        void *data;
+        VK_CHECK(vkMapMemory(device, stagingBufferMemory, 0, vertexBytes + indexBytes, 0, &data),
+                 "Failed to map mesh codec staging buffer");
+        auto *decodedVertices = static_cast<VkProjectOne::TerrainVertex *>(data);
+        auto *decodedIndices = reinterpret_cast<uint32_t *>(static_cast<uint8_t *>(data) + vertexBytes);
+
+        bool valid = true;
+        start = Clock::now();
+        for (int run = 0; run < DECODE_RUNS; ++run) {
+            valid &= MeshCodec::DecodeVertices(decodedVertices, vertices.size(), sizeof(VkProjectOne::TerrainVertex),
+                                               packedVertices.data(), packedVertices.size());
+        }
+        const double vertexSeconds = seconds(start) / DECODE_RUNS;
+        start = Clock::now();
+        for (int run = 0; run < DECODE_RUNS; ++run) {
+            valid &= MeshCodec::DecodeIndices(decodedIndices, indices.size(), packedIndices.data(),
+                                              packedIndices.size());
+        }
+        const double indexSeconds = seconds(start) / DECODE_RUNS;
+
+        // Vertices must match bit for bit; triangles may come back rotated
+        valid = valid && std::memcmp(decodedVertices, vertices.data(), vertexBytes) == 0;
+        for (size_t i = 0; valid && i + 2 < indices.size(); i += 3) {
+            const uint32_t *triangle = decodedIndices + i;
+            bool match = false;
+            for (size_t r = 0; r < 3; ++r) {
+                match |= triangle[0] == indices[i + r] && triangle[1] == indices[i + (r + 1) % 3] &&
+                        triangle[2] == indices[i + (r + 2) % 3];
+            }
+            valid = match;
+        }
+        vkUnmapMemory(device, stagingBufferMemory);
+        vkDestroyBuffer(device, stagingBuffer, nullptr);
+        freeMemory(stagingBufferMemory);
+
+        if (!valid) {
+            spdlog::error("Mesh codec: terrain mesh did not survive an encode/decode round trip.");
+            return;
+        }
+        spdlog::info("Mesh codec: terrain vertices {:.2f} MB -> {:.2f} MB ({:.2f}:1), decode {:.2f} GB/s; "
+                     "indices {:.2f} MB -> {:.2f} MB ({:.2f}:1), decode {:.2f} GB/s; encode {:.1f} ms.",
+                     vertexBytes / 1e6, packedVertices.size() / 1e6,
+                     static_cast<double>(vertexBytes) / packedVertices.size(), vertexBytes / vertexSeconds / 1e9,
+                     indexBytes / 1e6, packedIndices.size() / 1e6,
+                     static_cast<double>(indexBytes) / packedIndices.size(), indexBytes / indexSeconds / 1e9,
+                     encodeSeconds * 1000.0);
+    }
+
+    void VulkanEngine::createHeightfield(const std::vector<VkProjectOne::TerrainVertex> &vertices, uint32_t gridWidth,
+                                         uint32_t gridHeight) {
+        spdlog::debug("Creating heightfield textures...");
+        // Level 0 has one texel per grid cell: the min/max of its four corner heights. Each further
+        // level reduces 2x2 texels (Vulkan mip sizes round down, so the last row and column of a
+        // level also absorb a leftover odd one; the shader treats them as wider).
+        const uint32_t cellsX = gridWidth - 1;
+        const uint32_t cellsZ = gridHeight - 1;
+        auto heightAt = [&](uint32_t x, uint32_t z) { return vertices[static_cast<size_t>(z) * gridWidth + x].pos.y; };
+        std::vector<std::vector<glm::vec2> > levels(1);
+        levels[0].resize(static_cast<size_t>(cellsX) * cellsZ);
+        for (uint32_t z = 0; z < cellsZ; ++z) {
+            for (uint32_t x = 0; x < cellsX; ++x) {
+                const float h[4] = {heightAt(x, z), heightAt(x + 1, z), heightAt(x, z + 1), heightAt(x + 1, z + 1)};
+                levels[0][static_cast<size_t>(z) * cellsX + x] = {
+                    std::min(std::min(h[0], h[1]), std::min(h[2], h[3])),
+                    std::max(std::max(h[0], h[1]), std::max(h[2], h[3]))
+                };
+            }
+        }
+        uint32_t levelWidth = cellsX;
+        uint32_t levelHeight = cellsZ;
+        while (levelWidth > 1 || levelHeight > 1) {
+            const uint32_t parentWidth = std::max(levelWidth / 2, 1u);
+            const uint32_t parentHeight = std::max(levelHeight / 2, 1u);
+            std::vector<glm::vec2> parent(static_cast<size_t>(parentWidth) * parentHeight,
+                                          glm::vec2(std::numeric_limits<float>::max(),
+                                                    std::numeric_limits<float>::lowest()));
+            const std::vector<glm::vec2> &child = levels.back();
+            for (uint32_t z = 0; z < levelHeight; ++z) {
+                for (uint32_t x = 0; x < levelWidth; ++x) {
+                    glm::vec2 &bounds = parent[static_cast<size_t>(std::min(z / 2, parentHeight - 1)) * parentWidth +
+                                               std::min(x / 2, parentWidth - 1)];
+                    const glm::vec2 &childBounds = child[static_cast<size_t>(z) * levelWidth + x];
+                    bounds.x = std::min(bounds.x, childBounds.x);
+                    bounds.y = std::max(bounds.y, childBounds.y);
+                }
+            }
+            levels.push_back(std::move(parent));
+            levelWidth = parentWidth;
+            levelHeight = parentHeight;
+        }
+        heightBoundsLevels = static_cast<uint32_t>(levels.size());
+
+        VkImageCreateInfo imageInfo{};
+        imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        imageInfo.imageType = VK_IMAGE_TYPE_2D;
+        imageInfo.extent = {gridWidth, gridHeight, 1};
+        imageInfo.mipLevels = 1;
+        imageInfo.arrayLayers = 1;
+        imageInfo.format = VK_FORMAT_R32_SFLOAT;
+        imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+        imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        imageInfo.usage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+        imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+        imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        createImage({MemoryCategory::TerrainTextures, "terrain heights"},
+                    imageInfo, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, heightImage, heightImageMemory, true);
+        heightImageView = createImageView(heightImage, VK_FORMAT_R32_SFLOAT, VK_IMAGE_ASPECT_COLOR_BIT);
+        imageInfo.extent = {cellsX, cellsZ, 1};
+        imageInfo.mipLevels = heightBoundsLevels;
+        imageInfo.format = VK_FORMAT_R32G32_SFLOAT;
+        createImage({MemoryCategory::TerrainTextures, "terrain height bounds"},
+                    imageInfo, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, heightBoundsImage, heightBoundsImageMemory);
+        heightBoundsImageView = createImageView(heightBoundsImage, VK_FORMAT_R32G32_SFLOAT, VK_IMAGE_ASPECT_COLOR_BIT,
+                                                VK_IMAGE_VIEW_TYPE_2D, 0, 1, heightBoundsLevels);
+
+        // Upload the heights and every pyramid level through one staging buffer
+        const VkDeviceSize heightBytes = static_cast<VkDeviceSize>(gridWidth) * gridHeight * sizeof(float);
+        VkDeviceSize dataSize = heightBytes;
+        for (const std::vector<glm::vec2> &level: levels) dataSize += level.size() * sizeof(glm::vec2);
+        VkBuffer stagingBuffer;
+        VkDeviceMemory stagingBufferMemory;
+        createBuffer({MemoryCategory::Staging, "height bounds staging"}, dataSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                     VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                     stagingBuffer, stagingBufferMemory);
+        void *data;
+        VK_CHECK(vkMapMemory(device, stagingBufferMemory, 0, dataSize, 0, &data),
+                 "Failed to map heightfield staging buffer");
+        float *heights = static_cast<float *>(data);
+        for (size_t i = 0; i < vertices.size(); ++i) heights[i] = vertices[i].pos.y;
+        std::vector<VkBufferImageCopy> regions(levels.size());
+        VkDeviceSize offset = heightBytes;
+        for (uint32_t level = 0; level < heightBoundsLevels; ++level) {
+            memcpy(static_cast<char *>(data) + offset, levels[level].data(), levels[level].size() * sizeof(glm::vec2));
+            regions[level].bufferOffset = offset;
+            regions[level].imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, level, 0, 1};
+            regions[level].imageExtent = {std::max(cellsX >> level, 1u), std::max(cellsZ >> level, 1u), 1};
+            offset += levels[level].size() * sizeof(glm::vec2);
+        }
+        vkUnmapMemory(device, stagingBufferMemory);
+
+        VkCommandBuffer commandBuffer = beginSingleTimeCommands();
+        VkImageMemoryBarrier toTransfer[2] = {
+            makeImageBarrier(heightImage, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 0,
+                             VK_ACCESS_TRANSFER_WRITE_BIT),
+            makeImageBarrier(heightBoundsImage, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 0,
+                             VK_ACCESS_TRANSFER_WRITE_BIT)
+        };
+        toTransfer[1].subresourceRange.levelCount = heightBoundsLevels;
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             0, 0, nullptr, 0, nullptr, 2, toTransfer);
+        VkBufferImageCopy heightRegion{};
+        heightRegion.imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
+        heightRegion.imageExtent = {gridWidth, gridHeight, 1};
+        vkCmdCopyBufferToImage(commandBuffer, stagingBuffer, heightImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                               1, &heightRegion);
+        vkCmdCopyBufferToImage(commandBuffer, stagingBuffer, heightBoundsImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                               heightBoundsLevels, regions.data());
+        VkImageMemoryBarrier toShader[2] = {
+            makeImageBarrier(heightImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                             VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT),
+            makeImageBarrier(heightBoundsImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                             VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_ACCESS_TRANSFER_WRITE_BIT,
+                             VK_ACCESS_SHADER_READ_BIT)
+        };
+        toShader[1].subresourceRange.levelCount = heightBoundsLevels;
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0,
+                             0, nullptr, 0, nullptr, 2, toShader);
+        endSingleTimeCommands(commandBuffer);
+        vkDestroyBuffer(device, stagingBuffer, nullptr);
+        freeMemory(stagingBufferMemory);
+
+        VkSamplerCreateInfo samplerInfo{};
+        samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+        samplerInfo.magFilter = VK_FILTER_NEAREST;
+        samplerInfo.minFilter = VK_FILTER_NEAREST;
+        samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+        samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.maxLod = static_cast<float>(heightBoundsLevels);
+        VK_CHECK(vkCreateSampler(device, &samplerInfo, nullptr, &heightfieldSampler),
+                 "Failed to create heightfield sampler");
+
+        VkDescriptorSetLayoutBinding bindings[2]{};
+        for (uint32_t i = 0; i < 2; ++i) {
+            bindings[i].binding = i;
+            bindings[i].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+            bindings[i].descriptorCount = 1;
+            bindings[i].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+        }
+        VkDescriptorSetLayoutCreateInfo layoutInfo{};
+        layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        layoutInfo.bindingCount = 2;
+        layoutInfo.pBindings = bindings;
+        VK_CHECK(vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &rayMarchDescriptorSetLayout),
+                 "Failed to create ray march descriptor set layout");
+
+        VkDescriptorPoolSize poolSize{VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 2};
+        VkDescriptorPoolCreateInfo poolInfo{};
+        poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        poolInfo.poolSizeCount = 1;
+        poolInfo.pPoolSizes = &poolSize;
+        poolInfo.maxSets = 1;
+        VK_CHECK(vkCreateDescriptorPool(device, &poolInfo, nullptr, &rayMarchDescriptorPool),
+                 "Failed to create ray march descriptor pool");
+
+        VkDescriptorSetAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocInfo.descriptorPool = rayMarchDescriptorPool;
+        allocInfo.descriptorSetCount = 1;
+        allocInfo.pSetLayouts = &rayMarchDescriptorSetLayout;
+        VK_CHECK(vkAllocateDescriptorSets(device, &allocInfo, &rayMarchDescriptorSet),
+                 "Failed to allocate ray march descriptor set");
+
+        const VkDescriptorImageInfo imageInfos[2] = {
+            {heightfieldSampler, heightImageView, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL},
+            {heightfieldSampler, heightBoundsImageView, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL}
+        };
+        VkWriteDescriptorSet writes[2]{};
+        for (uint32_t i = 0; i < 2; ++i) {
+            writes[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            writes[i].dstSet = rayMarchDescriptorSet;
+            writes[i].dstBinding = i;
+            writes[i].descriptorCount = 1;
+            writes[i].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+            writes[i].pImageInfo = &imageInfos[i];
+        }
+        vkUpdateDescriptorSets(device, 2, writes, 0, nullptr);
+
+        spdlog::info("Heightfield created ({}x{} heights, {} min/max levels, {:.1f} MB).", gridWidth,
+                     gridHeight, heightBoundsLevels, static_cast<double>(dataSize) / (1024.0 * 1024.0));
+    }
+
+    void VulkanEngine::cleanupHeightfield() {
+        if (rayMarchDescriptorPool != VK_NULL_HANDLE) vkDestroyDescriptorPool(device, rayMarchDescriptorPool, nullptr);
+        rayMarchDescriptorPool = VK_NULL_HANDLE; // Set is freed with the pool
+        rayMarchDescriptorSet = VK_NULL_HANDLE;
+        if (rayMarchDescriptorSetLayout != VK_NULL_HANDLE)
+            vkDestroyDescriptorSetLayout(device, rayMarchDescriptorSetLayout, nullptr);
+        rayMarchDescriptorSetLayout = VK_NULL_HANDLE;
+        if (heightfieldSampler != VK_NULL_HANDLE) vkDestroySampler(device, heightfieldSampler, nullptr);
+        heightfieldSampler = VK_NULL_HANDLE;
+        if (heightImageView != VK_NULL_HANDLE) vkDestroyImageView(device, heightImageView, nullptr);
+        heightImageView = VK_NULL_HANDLE;
+        if (heightImage != VK_NULL_HANDLE) vkDestroyImage(device, heightImage, nullptr);
+        heightImage = VK_NULL_HANDLE;
+        if (heightImageMemory != VK_NULL_HANDLE) freeMemory(heightImageMemory);
+        heightImageMemory = VK_NULL_HANDLE;
+        if (heightBoundsImageView != VK_NULL_HANDLE) vkDestroyImageView(device, heightBoundsImageView, nullptr);
+        heightBoundsImageView = VK_NULL_HANDLE;
+        if (heightBoundsImage != VK_NULL_HANDLE) vkDestroyImage(device, heightBoundsImage, nullptr);
+        heightBoundsImage = VK_NULL_HANDLE;
+        if (heightBoundsImageMemory != VK_NULL_HANDLE) freeMemory(heightBoundsImageMemory);
+        heightBoundsImageMemory = VK_NULL_HANDLE;
+    }
+
+    void VulkanEngine::createTerrainDetail() {
+        constexpr uint32_t DETAIL_SIZE = 256;
+        constexpr VkFormat detailFormat = VK_FORMAT_R8_UNORM;
+        spdlog::debug("Creating terrain detail height texture...");
+
+        // Procedural tileable relief: four octaves of value noise whose lattice periods divide the
+        // texture size, so the pattern wraps seamlessly. Stands in for an authored detail map.
+        auto lattice = [](uint32_t x, uint32_t y, uint32_t octave) {
+            uint32_t h = x * 374761393u + y * 668265263u + octave * 2246822519u;
+            h = (h ^ (h >> 13)) * 1274126177u;
+            return static_cast<float>((h ^ (h >> 16)) & 0xFFFFu) / 65535.0f;
+        };
+        std::vector<float> heights(DETAIL_SIZE * DETAIL_SIZE, 0.0f);
+        float amplitudeSum = 0.0f;
+        float amplitude = 1.0f;
+        for (uint32_t octave = 0, period = 8; octave < 4; ++octave, period *= 2, amplitude *= 0.5f) {
+            const float cell = static_cast<float>(DETAIL_SIZE) / static_cast<float>(period);
+            for (uint32_t y = 0; y < DETAIL_SIZE; ++y) {
+                for (uint32_t x = 0; x < DETAIL_SIZE; ++x) {
+                    const float fx = static_cast<float>(x) / cell;
+                    const float fy = static_cast<float>(y) / cell;
+                    const uint32_t x0 = static_cast<uint32_t>(fx) % period;
+                    const uint32_t y0 = static_cast<uint32_t>(fy) % period;
+                    const uint32_t x1 = (x0 + 1) % period;
+                    const uint32_t y1 = (y0 + 1) % period;
+                    float tx = fx - std::floor(fx);
+                    float ty = fy - std::floor(fy);
+                    tx = tx * tx * (3.0f - 2.0f * tx);
+                    ty = ty * ty * (3.0f - 2.0f * ty);
+                    const float top = glm::mix(lattice(x0, y0, octave), lattice(x1, y0, octave), tx);
+                    const float bottom = glm::mix(lattice(x0, y1, octave), lattice(x1, y1, octave), tx);
+                    heights[y * DETAIL_SIZE + x] += amplitude * glm::mix(top, bottom, ty);
+                }
+            }
+            amplitudeSum += amplitude;
+        }
+
+        // Full mip chain, box filtered on the CPU (the texture is tiny)
+        std::vector<std::vector<uint8_t> > levels(1, std::vector<uint8_t>(heights.size()));
+        for (size_t i = 0; i < heights.size(); ++i) {
+            levels[0][i] = static_cast<uint8_t>(std::lround(heights[i] / amplitudeSum * 255.0f));
+        }
+        for (uint32_t size = DETAIL_SIZE / 2; size >= 1; size /= 2) {
+            const std::vector<uint8_t> &child = levels.back();
+            std::vector<uint8_t> parent(static_cast<size_t>(size) * size);
+            for (uint32_t y = 0; y < size; ++y) {
+                for (uint32_t x = 0; x < size; ++x) {
+                    const size_t c = static_cast<size_t>(2 * y) * (2 * size) + 2 * x;
+                    parent[static_cast<size_t>(y) * size + x] = static_cast<uint8_t>(
+                        (child[c] + child[c + 1] + child[c + 2 * size] + child[c + 2 * size + 1] + 2) / 4);
+                }
+            }
+            levels.push_back(std::move(parent));
+        }
+        const uint32_t levelCount = static_cast<uint32_t>(levels.size());
+
+        VkImageCreateInfo imageInfo{};
+        imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        imageInfo.imageType = VK_IMAGE_TYPE_2D;
+        imageInfo.extent = {DETAIL_SIZE, DETAIL_SIZE, 1};
+        imageInfo.mipLevels = levelCount;
+        imageInfo.arrayLayers = 1;
+        imageInfo.format = detailFormat;
+        imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+        imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        imageInfo.usage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+        imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+        imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        createImage({MemoryCategory::TerrainTextures, "terrain detail"},
+                    imageInfo, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, terrainDetailImage, terrainDetailImageMemory);
+        terrainDetailImageView = createImageView(terrainDetailImage, detailFormat, VK_IMAGE_ASPECT_COLOR_BIT,
+                                                 VK_IMAGE_VIEW_TYPE_2D, 0, 1, levelCount);
+
+        // Upload every level through one staging buffer
+        VkDeviceSize dataSize = 0;
+        for (const std::vector<uint8_t> &level: levels) dataSize += level.size();
+        VkBuffer stagingBuffer;
+        VkDeviceMemory stagingBufferMemory;
+        createBuffer({MemoryCategory::Staging, "terrain detail staging"}, dataSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                     VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                     stagingBuffer, stagingBufferMemory);
+        void *data;
+        VK_CHECK(vkMapMemory(device, stagingBufferMemory, 0, dataSize, 0, &data),
+                 "Failed to map terrain detail staging buffer");
+        std::vector<VkBufferImageCopy> regions(levelCount);
+        VkDeviceSize offset = 0;
+        for (uint32_t level = 0; level < levelCount; ++level) {
+            memcpy(static_cast<char *>(data) + offset, levels[level].data(), levels[level].size());
+            regions[level].bufferOffset = offset;
+            regions[level].imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, level, 0, 1};
+            regions[level].imageExtent = {DETAIL_SIZE >> level, DETAIL_SIZE >> level, 1};
+            offset += levels[level].size();
+        }
+        vkUnmapMemory(device, stagingBufferMemory);
+
+        VkCommandBuffer commandBuffer = beginSingleTimeCommands();
+        VkImageMemoryBarrier toTransfer = makeImageBarrier(terrainDetailImage, VK_IMAGE_LAYOUT_UNDEFINED,
+                                                           VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 0,
+                                                           VK_ACCESS_TRANSFER_WRITE_BIT);
+        toTransfer.subresourceRange.levelCount = levelCount;
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             0, 0, nullptr, 0, nullptr, 1, &toTransfer);
+        vkCmdCopyBufferToImage(commandBuffer, stagingBuffer, terrainDetailImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                               levelCount, regions.data());
+        VkImageMemoryBarrier toShader = makeImageBarrier(terrainDetailImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                                         VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                                                         VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT);
+        toShader.subresourceRange.levelCount = levelCount;
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                             0, 0, nullptr, 0, nullptr, 1, &toShader);
+        endSingleTimeCommands(commandBuffer);
+        vkDestroyBuffer(device, stagingBuffer, nullptr);
+        freeMemory(stagingBufferMemory);
+
+        VkSamplerCreateInfo samplerInfo{};
+        samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+        samplerInfo.magFilter = VK_FILTER_LINEAR;
+        samplerInfo.minFilter = VK_FILTER_LINEAR;
+        samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
+        samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+        samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+        samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+        samplerInfo.maxLod = static_cast<float>(levelCount);
+        VK_CHECK(vkCreateSampler(device, &samplerInfo, nullptr, &terrainDetailSampler),
+                 "Failed to create terrain detail sampler");
+
+        // Every terrain pipeline shares this layout, including the permutations without parallax
+        VkDescriptorSetLayoutBinding binding{};
+        binding.binding = 0;
+        binding.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        binding.descriptorCount = 1;
+        binding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+        VkDescriptorSetLayoutCreateInfo layoutInfo{};
+        layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        layoutInfo.bindingCount = 1;
+        layoutInfo.pBindings = &binding;
+        VK_CHECK(vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &terrainDescriptorSetLayout),
+                 "Failed to create terrain descriptor set layout");
+
+        VkDescriptorPoolSize poolSize{VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1};
+        VkDescriptorPoolCreateInfo poolInfo{};
+        poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        poolInfo.poolSizeCount = 1;
+        poolInfo.pPoolSizes = &poolSize;
+        poolInfo.maxSets = 1;
+        VK_CHECK(vkCreateDescriptorPool(device, &poolInfo, nullptr, &terrainDescriptorPool),
+                 "Failed to create terrain descriptor pool");
+
+        VkDescriptorSetAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocInfo.descriptorPool = terrainDescriptorPool;
+        allocInfo.descriptorSetCount = 1;
+        allocInfo.pSetLayouts = &terrainDescriptorSetLayout;
+        VK_CHECK(vkAllocateDescriptorSets(device, &allocInfo, &terrainDescriptorSet),
+                 "Failed to allocate terrain descriptor set");
+
+        const VkDescriptorImageInfo detailInfo{
+            terrainDetailSampler, terrainDetailImageView, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
+        };
+        VkWriteDescriptorSet write{};
+        write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write.dstSet = terrainDescriptorSet;
+        write.dstBinding = 0;
+        write.descriptorCount = 1;
+        write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        write.pImageInfo = &detailInfo;
+        vkUpdateDescriptorSets(device, 1, &write, 0, nullptr);
+        spdlog::debug("Terrain detail texture created ({}^2, {} levels).", DETAIL_SIZE, levelCount);
+    }
+
+    void VulkanEngine::cleanupTerrainDetail() {
+        if (terrainDescriptorPool != VK_NULL_HANDLE) vkDestroyDescriptorPool(device, terrainDescriptorPool, nullptr);
+        terrainDescriptorPool = VK_NULL_HANDLE; // Set is freed with the pool
+        terrainDescriptorSet = VK_NULL_HANDLE;
+        if (terrainDescriptorSetLayout != VK_NULL_HANDLE)
+            vkDestroyDescriptorSetLayout(device, terrainDescriptorSetLayout, nullptr);
+        terrainDescriptorSetLayout = VK_NULL_HANDLE;
+        if (terrainDetailSampler != VK_NULL_HANDLE) vkDestroySampler(device, terrainDetailSampler, nullptr);
+        terrainDetailSampler = VK_NULL_HANDLE;
+        if (terrainDetailImageView != VK_NULL_HANDLE) vkDestroyImageView(device, terrainDetailImageView, nullptr);
+        terrainDetailImageView = VK_NULL_HANDLE;
+        if (terrainDetailImage != VK_NULL_HANDLE) vkDestroyImage(device, terrainDetailImage, nullptr);
+        terrainDetailImage = VK_NULL_HANDLE;
+        if (terrainDetailImageMemory != VK_NULL_HANDLE) freeMemory(terrainDetailImageMemory);
+        terrainDetailImageMemory = VK_NULL_HANDLE;
     }
 
     // --- Resource Creation Methods ---
@@ -355,6 +1200,9 @@ namespace vk_project_one {
         } else {
             spdlog::warn("vkCreateDebugUtilsMessengerEXT function pointer not found. Cannot create debug messenger.");
         }
+        // Names allocations after their memory report tags in validation messages and capture tools
+        setDebugObjectName = (PFN_vkSetDebugUtilsObjectNameEXT) vkGetInstanceProcAddr(
+            instance, "vkSetDebugUtilsObjectNameEXT");
     }
 
     bool VulkanEngine::checkValidationLayerSupport() {
@@ -429,6 +1277,16 @@ namespace vk_project_one {
             }
             i++;
         }
+
+        // Dedicated compute families usually map to separate hardware queues that run beside graphics
+        for (uint32_t family = 0; family < queueFamilyCount; ++family) {
+            const VkQueueFlags flags = queueFamilies[family].queueFlags;
+            if ((flags & VK_QUEUE_COMPUTE_BIT) && !(flags & VK_QUEUE_GRAPHICS_BIT)) {
+                indices.computeFamily = family;
+                spdlog::trace("Found async compute queue family: index {}", family);
+                break;
+            }
+        }
         return indices;
     }
 
@@ -455,24 +1313,29 @@ namespace vk_project_one {
     }
 
     VulkanEngine::SwapChainSupportDetails VulkanEngine::querySwapChainSupport(VkPhysicalDevice queryDevice) const {
+        return querySwapChainSupport(queryDevice, surface);
+    }
+
+    VulkanEngine::SwapChainSupportDetails VulkanEngine::querySwapChainSupport(VkPhysicalDevice queryDevice,
+                                                                              VkSurfaceKHR querySurface) const {
         SwapChainSupportDetails details;
         // Get capabilities
-        vkGetPhysicalDeviceSurfaceCapabilitiesKHR(queryDevice, surface, &details.capabilities);
+        vkGetPhysicalDeviceSurfaceCapabilitiesKHR(queryDevice, querySurface, &details.capabilities);
 
         // Get formats
         uint32_t formatCount;
-        vkGetPhysicalDeviceSurfaceFormatsKHR(queryDevice, surface, &formatCount, nullptr);
+        vkGetPhysicalDeviceSurfaceFormatsKHR(queryDevice, querySurface, &formatCount, nullptr);
         if (formatCount != 0) {
             details.formats.resize(formatCount);
-            vkGetPhysicalDeviceSurfaceFormatsKHR(queryDevice, surface, &formatCount, details.formats.data());
+            vkGetPhysicalDeviceSurfaceFormatsKHR(queryDevice, querySurface, &formatCount, details.formats.data());
         }
 
         // Get present modes
         uint32_t presentModeCount;
-        vkGetPhysicalDeviceSurfacePresentModesKHR(queryDevice, surface, &presentModeCount, nullptr);
+        vkGetPhysicalDeviceSurfacePresentModesKHR(queryDevice, querySurface, &presentModeCount, nullptr);
         if (presentModeCount != 0) {
             details.presentModes.resize(presentModeCount);
-            vkGetPhysicalDeviceSurfacePresentModesKHR(queryDevice, surface, &presentModeCount,
+            vkGetPhysicalDeviceSurfacePresentModesKHR(queryDevice, querySurface, &presentModeCount,
                                                       details.presentModes.data());
         }
         return details;
@@ -528,31 +1391,41 @@ namespace vk_project_one {
         std::vector<VkPhysicalDevice> devices(deviceCount);
         vkEnumeratePhysicalDevices(instance, &deviceCount, devices.data());
 
+        // Rank every usable device; --gpu picks one by index, UUID or name instead. Software renderers rank
+        // last and are only used when nothing else can run the engine.
+        std::vector<DeviceCapabilities> capabilities;
+        std::vector<bool> usable;
+        for (uint32_t i = 0; i < deviceCount; ++i) {
+            capabilities.push_back(DeviceCapabilities::Query(devices[i], i));
+            usable.push_back(capabilities[i].missingRequirement().empty() && isDeviceSuitable(devices[i]));
+        }
+        int selected = -1;
+        if (!config.gpu.empty()) {
+            for (uint32_t i = 0; i < deviceCount && selected < 0; ++i) {
+                if (capabilities[i].matches(config.gpu) && usable[i]) selected = static_cast<int>(i);
+            }
+            if (selected < 0) spdlog::warn("--gpu={} matches no usable device, selecting by score.", config.gpu);
+        }
+        if (selected < 0) {
+            for (uint32_t i = 0; i < deviceCount; ++i) {
+                if (usable[i] && (selected < 0 || capabilities[i].score() > capabilities[selected].score())) {
+                    selected = static_cast<int>(i);
+                }
+            }
+        }
+
         spdlog::info("Found {} Vulkan-capable device(s):", deviceCount);
-        int suitableDeviceIndex = -1;
-        int currentDeviceIndex = 0;
-        for (const auto &device: devices) {
-            VkPhysicalDeviceProperties deviceProperties;
-            vkGetPhysicalDeviceProperties(device, &deviceProperties);
-            spdlog::info("  Device [{}]: {}", currentDeviceIndex, deviceProperties.deviceName);
-            if (isDeviceSuitable(device)) {
-                physicalDevice = device; // Select the first suitable device
-                suitableDeviceIndex = currentDeviceIndex;
-                spdlog::info("    -> Selected as suitable device.");
-                // Optional: Prefer discrete GPUs
-                // if (deviceProperties.deviceType == VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU) {
-                //     break; // Found preferred type
-                // }
-                break; // Select the first suitable one found
-            }
-            currentDeviceIndex++;
-        }
-
-        if (physicalDevice == VK_NULL_HANDLE) {
+        for (uint32_t i = 0; i < deviceCount; ++i) capabilities[i].log(static_cast<int>(i) == selected);
+        if (selected < 0) {
             spdlog::critical("Failed to find a suitable GPU!");
             throw std::runtime_error("Failed to find a suitable GPU!");
         }
-        spdlog::info("Physical device selected: index {}", suitableDeviceIndex);
+        physicalDevice = devices[selected];
+        deviceCapabilities = capabilities[selected];
+        if (deviceCapabilities.isSoftware()) {
+            spdlog::warn("Rendering on a software device ({}); expect low frame rates.", deviceCapabilities.name);
+        }
+        spdlog::info("Physical device selected: index {}", selected);
     }
 
 
@@ -567,6 +1440,18 @@ namespace vk_project_one {
             indices.presentFamily.value()
         };
 
+        // Async compute needs a compute-only family and timeline semaphores to order its batches
+        asyncComputeAvailable = config.asyncCompute && indices.computeFamily.has_value() &&
+                                deviceCapabilities.timelineSemaphore;
+        if (asyncComputeAvailable) {
+            uniqueQueueFamilies.insert(indices.computeFamily.value());
+            sharedQueueFamilies[0] = indices.graphicsFamily.value();
+            sharedQueueFamilies[1] = indices.computeFamily.value();
+        } else if (config.asyncCompute) {
+            spdlog::info("Async compute unavailable ({}), compute passes stay on the graphics queue.",
+                         indices.computeFamily ? "no timeline semaphores" : "no compute-only queue family");
+        }
+
         float queuePriority = 1.0f; // Priority between 0.0 and 1.0
         for (uint32_t queueFamilyIndex: uniqueQueueFamilies) {
             VkDeviceQueueCreateInfo queueCreateInfo{};
@@ -581,6 +1466,14 @@ namespace vk_project_one {
         // Specify device features we want to use (start with none)
         VkPhysicalDeviceFeatures deviceFeatures{};
         // deviceFeatures.samplerAnisotropy = VK_TRUE; // Example feature
+        // Multiview is mandatory since Vulkan 1.1; the scene shaders reference gl_ViewIndex either way
+        VkPhysicalDeviceVulkan11Features vulkan11Features{};
+        vulkan11Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_1_FEATURES;
+        vulkan11Features.multiview = VK_TRUE;
+        VkPhysicalDeviceVulkan12Features vulkan12Features{};
+        vulkan12Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+        vulkan12Features.timelineSemaphore = asyncComputeAvailable ? VK_TRUE : VK_FALSE;
+        vulkan11Features.pNext = &vulkan12Features;
 
         // Enable portability subset feature if needed (required by MoltenVK)
         VkPhysicalDevicePortabilitySubsetFeaturesKHR portabilityFeatures = {};
@@ -596,6 +1489,7 @@ namespace vk_project_one {
         createInfo.queueCreateInfoCount = static_cast<uint32_t>(queueCreateInfos.size());
         createInfo.pQueueCreateInfos = queueCreateInfos.data();
         createInfo.pEnabledFeatures = &deviceFeatures; // Link features structure
+        createInfo.pNext = &vulkan11Features;
 
         // Link portability features struct on macOS
 #ifdef __APPLE__
@@ -627,6 +1521,10 @@ namespace vk_project_one {
         spdlog::info("Logical device created.");
         spdlog::debug("Retrieved graphics queue (family {}) and present queue (family {}).",
                       indices.graphicsFamily.value(), indices.presentFamily.value());
+        if (asyncComputeAvailable) {
+            vkGetDeviceQueue(device, indices.computeFamily.value(), 0, &computeQueue);
+            spdlog::info("Async compute queue: family {}.", indices.computeFamily.value());
+        }
     }
 
 
@@ -660,7 +1558,7 @@ namespace vk_project_one {
         return VK_PRESENT_MODE_FIFO_KHR;
     }
 
-    VkExtent2D VulkanEngine::chooseSwapExtent(const VkSurfaceCapabilitiesKHR &capabilities) {
+    VkExtent2D VulkanEngine::chooseSwapExtent(const VkSurfaceCapabilitiesKHR &capabilities, SDL_Window *targetWindow) {
         // If currentExtent is defined, use it
         if (capabilities.currentExtent.width != std::numeric_limits<uint32_t>::max()) {
             spdlog::debug("Chosen swap extent: {}x{} (from capabilities.currentExtent)",
@@ -670,7 +1568,7 @@ namespace vk_project_one {
         } else {
             // Otherwise, get size from SDL window and clamp to capabilities
             int width, height;
-            SDL_GetWindowSizeInPixels(window, &width, &height); // Use SDL func for high-DPI awareness
+            SDL_GetWindowSizeInPixels(targetWindow, &width, &height); // Use SDL func for high-DPI awareness
             spdlog::debug("Window drawable size: {}x{}", width, height);
 
             VkExtent2D actualExtent = {
@@ -693,12 +1591,19 @@ namespace vk_project_one {
     // --- Swapchain Creation ---
 
     void VulkanEngine::createSwapChain() {
+        createSwapChain(surface, window, swapChain, swapChainImages, swapChainImageFormat, swapChainExtent);
+        presentExtent = swapChainExtent;
+    }
+
+    void VulkanEngine::createSwapChain(VkSurfaceKHR targetSurface, SDL_Window *targetWindow,
+                                       VkSwapchainKHR &targetSwapChain, std::vector<VkImage> &images,
+                                       VkFormat &imageFormat, VkExtent2D &imageExtent, VkSwapchainKHR oldSwapChain) {
         spdlog::debug("Creating swap chain...");
-        SwapChainSupportDetails swapChainSupport = querySwapChainSupport(physicalDevice);
+        SwapChainSupportDetails swapChainSupport = querySwapChainSupport(physicalDevice, targetSurface);
 
         VkSurfaceFormatKHR surfaceFormat = chooseSwapSurfaceFormat(swapChainSupport.formats);
         VkPresentModeKHR presentMode = chooseSwapPresentMode(swapChainSupport.presentModes);
-        VkExtent2D extent = chooseSwapExtent(swapChainSupport.capabilities);
+        VkExtent2D extent = chooseSwapExtent(swapChainSupport.capabilities, targetWindow);
 
         // Determine number of images in swap chain (request one more than min for triple buffering potential)
         uint32_t imageCount = swapChainSupport.capabilities.minImageCount + 1;
@@ -711,13 +1616,18 @@ namespace vk_project_one {
 
         VkSwapchainCreateInfoKHR createInfo{};
         createInfo.sType = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR;
-        createInfo.surface = surface;
+        createInfo.surface = targetSurface;
         createInfo.minImageCount = imageCount;
         createInfo.imageFormat = surfaceFormat.format;
         createInfo.imageColorSpace = surfaceFormat.colorSpace;
         createInfo.imageExtent = extent;
         createInfo.imageArrayLayers = 1; // Usually 1 unless doing stereoscopic rendering
-        createInfo.imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT; // Draw directly to images
+        // The scene is rendered offscreen and blitted in, so swapchain images must be transfer destinations
+        if (!(swapChainSupport.capabilities.supportedUsageFlags & VK_IMAGE_USAGE_TRANSFER_DST_BIT)) {
+            spdlog::critical("Swap chain images do not support VK_IMAGE_USAGE_TRANSFER_DST_BIT!");
+            throw std::runtime_error("Swap chain images do not support transfer destination usage!");
+        }
+        createInfo.imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
 
         // Handle queue families (concurrent vs exclusive)
         vk_project_one::QueueFamilyIndices indices = findQueueFamilies(physicalDevice);
@@ -744,22 +1654,23 @@ namespace vk_project_one {
         createInfo.presentMode = presentMode;
         createInfo.clipped = VK_TRUE; // Allow clipping of obscured pixels
 
-        // Handle old swapchain if recreating
-        createInfo.oldSwapchain = VK_NULL_HANDLE; // Set later if recreating
+        // A replaced swapchain hands its resources over and is retired (null after a full recreation)
+        createInfo.oldSwapchain = oldSwapChain;
 
         // Create the swapchain
-        VkResult result = vkCreateSwapchainKHR(device, &createInfo, nullptr, &swapChain);
+        VkResult result = vkCreateSwapchainKHR(device, &createInfo, nullptr, &targetSwapChain);
         VK_CHECK(result, "Failed to create swap chain!");
 
         // Retrieve swap chain images
-        vkGetSwapchainImagesKHR(device, swapChain, &imageCount, nullptr); // Get actual count
-        swapChainImages.resize(imageCount);
-        vkGetSwapchainImagesKHR(device, swapChain, &imageCount, swapChainImages.data());
-        spdlog::info("Swap chain created with {} images.", static_cast<int>(imageCount));
+        vkGetSwapchainImagesKHR(device, targetSwapChain, &imageCount, nullptr); // Get actual count
+        images.resize(imageCount);
+        vkGetSwapchainImagesKHR(device, targetSwapChain, &imageCount, images.data());
+        spdlog::info("Swap chain created with {} images ({}x{}).", static_cast<int>(imageCount), extent.width,
+                     extent.height);
 
         // Store format and extent for later use
-        swapChainImageFormat = surfaceFormat.format;
-        swapChainExtent = extent;
+        imageFormat = surfaceFormat.format;
+        imageExtent = extent;
     }
 
     void VulkanEngine::createImageViews() {
@@ -767,296 +1678,3316 @@ namespace vk_project_one {
         swapChainImageViews.resize(swapChainImages.size());
 
         for (size_t i = 0; i < swapChainImages.size(); i++) {
-            VkImageViewCreateInfo createInfo{};
-            createInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
-            createInfo.image = swapChainImages[i];
-            createInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
-            createInfo.format = swapChainImageFormat;
-            // Component mapping (identity mapping)
-            createInfo.components.r = VK_COMPONENT_SWIZZLE_IDENTITY;
-            createInfo.components.g = VK_COMPONENT_SWIZZLE_IDENTITY;
-            createInfo.components.b = VK_COMPONENT_SWIZZLE_IDENTITY;
-            createInfo.components.a = VK_COMPONENT_SWIZZLE_IDENTITY;
-            // Subresource range (color target, no mipmapping, single layer)
-            createInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-            createInfo.subresourceRange.baseMipLevel = 0;
-            createInfo.subresourceRange.levelCount = 1;
-            createInfo.subresourceRange.baseArrayLayer = 0;
-            createInfo.subresourceRange.layerCount = 1;
-
-            VkResult result = vkCreateImageView(device, &createInfo, nullptr, &swapChainImageViews[i]);
-            VK_CHECK(result, "Failed to create image view for swap chain image " + std::to_string(i));
+            swapChainImageViews[i] = createImageView(swapChainImages[i], swapChainImageFormat,
+                                                     VK_IMAGE_ASPECT_COLOR_BIT);
         }
         spdlog::debug("Created {} swap chain image views.", static_cast<int>(swapChainImageViews.size()));
     }
 
-    // --- Render Pass ---
+    // --- Further Windows ---
 
-    void VulkanEngine::createRenderPass() {
-        spdlog::debug("Creating render pass...");
-        // Define the color attachment (matches swapchain image format)
-        VkAttachmentDescription colorAttachment{};
-        colorAttachment.format = swapChainImageFormat;
-        colorAttachment.samples = VK_SAMPLE_COUNT_1_BIT; // No multisampling yet
-        colorAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR; // Clear framebuffer before drawing
-        colorAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE; // Store result to be presented
-        colorAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-        colorAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-        colorAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED; // Layout before render pass
-        colorAttachment.finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR; // Layout after render pass (for presentation)
+    void VulkanEngine::createWindowOutputs() {
+        if (windowOutputs.empty()) return;
+        if (!sceneBlitSupported) {
+            // The frame can only be scaled into windows of other sizes with a blit
+            spdlog::warn("Swap chain format does not support blits. Only the first window is rendered to.");
+            windowOutputs.clear();
+            return;
+        }
+        spdlog::debug("Creating {} further window output(s)...", windowOutputs.size());
+        const uint32_t presentFamily = findQueueFamilies(physicalDevice).presentFamily.value();
 
-        // Attachment reference for the subpass
-        VkAttachmentReference colorAttachmentRef{};
-        colorAttachmentRef.attachment = 0; // Index in the pAttachments array
-        colorAttachmentRef.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL; // Layout during subpass
+        VkCommandBufferAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        allocInfo.commandPool = commandPool;
+        allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        allocInfo.commandBufferCount = MAX_FRAMES_IN_FLIGHT;
+        VkSemaphoreCreateInfo semaphoreInfo{};
+        semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
 
-        // Define the subpass
-        VkSubpassDescription subpass{};
-        subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
-        subpass.colorAttachmentCount = 1;
-        subpass.pColorAttachments = &colorAttachmentRef;
-        // No depth, input, resolve, or preserve attachments for now
+        for (WindowOutput &output: windowOutputs) {
+            if (!SDL_Vulkan_CreateSurface(output.window, instance, nullptr, &output.surface)) {
+                std::string errorMsg = "SDL_Vulkan_CreateSurface failed: " + std::string(SDL_GetError());
+                spdlog::critical(errorMsg);
+                throw std::runtime_error(errorMsg);
+            }
+            // The device was picked for the first window; every other one has to be presentable from the same queue
+            VkBool32 presentSupport = VK_FALSE;
+            vkGetPhysicalDeviceSurfaceSupportKHR(physicalDevice, presentFamily, output.surface, &presentSupport);
+            if (!presentSupport) {
+                spdlog::critical("The present queue cannot present to a further window!");
+                throw std::runtime_error("Present queue does not support a further window's surface!");
+            }
 
-        // Subpass dependency (ensures render pass waits for image acquisition)
-        VkSubpassDependency dependency{};
-        dependency.srcSubpass = VK_SUBPASS_EXTERNAL; // Implicit subpass before render pass
-        dependency.dstSubpass = 0; // Our first (and only) subpass
-        dependency.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT; // Stage producing the output
-        dependency.srcAccessMask = 0; // Access mask for the source stage
-        dependency.dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT; // Stage consuming the input
-        dependency.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT; // Access required by destination stage
+            output.commandBuffers.resize(MAX_FRAMES_IN_FLIGHT);
+            VK_CHECK(vkAllocateCommandBuffers(device, &allocInfo, output.commandBuffers.data()),
+                     "Failed to allocate window output command buffers!");
+            output.imageAvailableSemaphores.resize(MAX_FRAMES_IN_FLIGHT);
+            output.renderFinishedSemaphores.resize(MAX_FRAMES_IN_FLIGHT);
+            for (uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i) {
+                VK_CHECK(vkCreateSemaphore(device, &semaphoreInfo, nullptr, &output.imageAvailableSemaphores[i]),
+                         "Failed to create window output semaphore!");
+                VK_CHECK(vkCreateSemaphore(device, &semaphoreInfo, nullptr, &output.renderFinishedSemaphores[i]),
+                         "Failed to create window output semaphore!");
+            }
+            createWindowOutputSwapChain(output);
+        }
+        spdlog::info("{} window(s) share the device, one submit and one present per frame.",
+                     windowOutputs.size() + 1);
+    }
 
-        // Define the render pass
-        VkRenderPassCreateInfo renderPassInfo{};
-        renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
-        renderPassInfo.attachmentCount = 1;
-        renderPassInfo.pAttachments = &colorAttachment;
-        renderPassInfo.subpassCount = 1;
-        renderPassInfo.pSubpasses = &subpass;
-        renderPassInfo.dependencyCount = 1;
-        renderPassInfo.pDependencies = &dependency;
+    void VulkanEngine::createWindowOutputSwapChain(WindowOutput &output, VkSwapchainKHR oldSwapChain) {
+        int width = 0, height = 0;
+        SDL_GetWindowSizeInPixels(output.window, &width, &height);
+        if (width == 0 || height == 0) {
+            // Minimized: skipped until it has a size again (the first window is the one that pauses rendering)
+            output.resized = true;
+            return;
+        }
+        createSwapChain(output.surface, output.window, output.swapChain, output.images, output.imageFormat,
+                        output.extent, oldSwapChain);
+        output.imageViews.resize(output.images.size());
+        for (size_t i = 0; i < output.images.size(); ++i) {
+            output.imageViews[i] = createImageView(output.images[i], output.imageFormat, VK_IMAGE_ASPECT_COLOR_BIT);
+        }
+        output.resized = false;
+    }
 
-        VkResult result = vkCreateRenderPass(device, &renderPassInfo, nullptr, &renderPass);
-        VK_CHECK(result, "Failed to create render pass!");
-        spdlog::info("Render pass created.");
+    void VulkanEngine::cleanupWindowOutputSwapChain(WindowOutput &output) {
+        for (VkImageView imageView: output.imageViews) vkDestroyImageView(device, imageView, nullptr);
+        output.imageViews.clear();
+        output.images.clear();
+        if (output.swapChain != VK_NULL_HANDLE) vkDestroySwapchainKHR(device, output.swapChain, nullptr);
+        output.swapChain = VK_NULL_HANDLE;
     }
 
+    void VulkanEngine::recreateWindowOutputSwapChain(WindowOutput &output) {
+        // The window only receives a blit of the frame, so its swapchain is all there is to replace
+        const VkSwapchainKHR oldSwapChain = output.swapChain;
+        std::vector<VkImageView> oldImageViews = std::move(output.imageViews);
+        output.imageViews.clear();
+        output.images.clear();
+        output.swapChain = VK_NULL_HANDLE;
+        createWindowOutputSwapChain(output, oldSwapChain);
+        retireSwapChain(oldSwapChain, std::move(oldImageViews));
+        output.pendingResize = {};
+        if (output.swapChain != VK_NULL_HANDLE) resizeStats.swapChainOnly++;
+    }
 
-    // --- Descriptor Sets (for Uniform Buffer) ---
+    void VulkanEngine::cleanupWindowOutputs() {
+        for (WindowOutput &output: windowOutputs) {
+            if (device != VK_NULL_HANDLE) {
+                cleanupWindowOutputSwapChain(output);
+                for (VkSemaphore semaphore: output.imageAvailableSemaphores) {
+                    vkDestroySemaphore(device, semaphore, nullptr);
+                }
+                for (VkSemaphore semaphore: output.renderFinishedSemaphores) {
+                    vkDestroySemaphore(device, semaphore, nullptr);
+                }
+            }
+            output.imageAvailableSemaphores.clear();
+            output.renderFinishedSemaphores.clear();
+            output.commandBuffers.clear(); // Freed with the command pool
+            if (output.surface != VK_NULL_HANDLE) vkDestroySurfaceKHR(instance, output.surface, nullptr);
+            output.surface = VK_NULL_HANDLE;
+        }
+    }
 
-    void VulkanEngine::createDescriptorSetLayout() {
-        spdlog::debug("Creating descriptor set layout...");
-        // Define layout binding for the Uniform Buffer Object (UBO)
-        VkDescriptorSetLayoutBinding uboLayoutBinding{};
-        uboLayoutBinding.binding = 0; // Binding point used in the shader (layout(binding = 0))
-        uboLayoutBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-        uboLayoutBinding.descriptorCount = 1; // Number of descriptors in the binding (just one UBO)
-        uboLayoutBinding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT; // UBO is used in the vertex shader
-        uboLayoutBinding.pImmutableSamplers = nullptr; // Optional
+    void VulkanEngine::notifyFramebufferResized(SDL_Window *resizedWindow) {
+        for (WindowOutput &output: windowOutputs) {
+            if (output.window == resizedWindow) {
+                noteResize(output.pendingResize);
+                return;
+            }
+        }
+        noteSwapChainResize();
+    }
 
-        // Create the descriptor set layout
-        VkDescriptorSetLayoutCreateInfo layoutInfo{};
-        layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
-        layoutInfo.bindingCount = 1;
-        layoutInfo.pBindings = &uboLayoutBinding;
+    // --- Frame State ---
 
-        VkResult result = vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &descriptorSetLayout);
-        VK_CHECK(result, "Failed to create descriptor set layout!");
-        spdlog::info("Descriptor set layout created.");
+    static const char *swapChainStateName(int state) {
+        constexpr const char *NAMES[] = {"ready", "resizing", "minimized", "device lost"};
+        return NAMES[state];
     }
 
+    void VulkanEngine::setSwapChainState(SwapChainState state) {
+        // Device loss is terminal: only a new engine recovers from it
+        if (swapChainState == state || swapChainState == SwapChainState::DeviceLost) return;
+        spdlog::debug("Swap chain state: {} -> {}", swapChainStateName(static_cast<int>(swapChainState)),
+                      swapChainStateName(static_cast<int>(state)));
+        swapChainState = state;
+    }
 
-    // --- Graphics Pipeline ---
+    bool VulkanEngine::checkDeviceLost(VkResult result, const char *operation) {
+        if (result != VK_ERROR_DEVICE_LOST) return false;
+        spdlog::critical("Device lost while {}.", operation);
+        setSwapChainState(SwapChainState::DeviceLost);
+        return true;
+    }
 
-    // Helper to create shader modules
-    VkShaderModule VulkanEngine::createShaderModule(const std::vector<char> &code) {
-        VkShaderModuleCreateInfo createInfo{};
+    void VulkanEngine::noteSwapChainResize() {
+        noteResize(pendingResize);
+        if (swapChainState == SwapChainState::Ready) setSwapChainState(SwapChainState::Resizing);
+    }
+
+    // --- Resize Coalescing ---
+
+    void VulkanEngine::noteResize(PendingResize &resize) {
+        const auto now = std::chrono::steady_clock::now();
+        if (!resize.pending) resize.firstEvent = now;
+        resize.pending = true;
+        resize.lastEvent = now;
+        resize.events++;
+        resizeStats.events++;
+    }
+
+    bool VulkanEngine::isResizeDue(const PendingResize &resize) const {
+        if (!resize.pending) return false;
+        const auto now = std::chrono::steady_clock::now();
+        const std::chrono::milliseconds delay(config.resizeDelayMs);
+        return now - resize.lastEvent >= delay || now - resize.firstEvent >= 4 * delay;
+    }
+
+    bool VulkanEngine::handleResize(bool outOfDate) {
+        if (isResizeDue(pendingResize) || (outOfDate && !sceneBlitSupported)) {
+            spdlog::info("Recreating swap chain after {} resize event(s).", pendingResize.events);
+            recreateSwapChain();
+            return swapChainState == SwapChainState::Ready;
+        }
+        if (!outOfDate) return false;
+        replaceSwapChain(); // Keeps presenting until the size settles
+        // A minimized window gets no new swapchain, so the frame counts as skipped rather than recreated
+        return swapChainState == SwapChainState::Resizing;
+    }
+
+    void VulkanEngine::replaceSwapChain() {
+        int width = 0, height = 0;
+        SDL_GetWindowSizeInPixels(window, &width, &height);
+        if (width == 0 || height == 0) {
+            recreateSwapChain(); // Defers to the Minimized state until the window has a size again
+            return;
+        }
+
+        const VkSwapchainKHR oldSwapChain = swapChain;
+        std::vector<VkImageView> oldImageViews = std::move(swapChainImageViews);
+        swapChainImageViews.clear();
+        createSwapChain(surface, window, swapChain, swapChainImages, swapChainImageFormat, presentExtent,
+                        oldSwapChain);
+        createImageViews();
+        retireSwapChain(oldSwapChain, std::move(oldImageViews));
+        resizeStats.swapChainOnly++;
+        spdlog::debug("Swap chain replaced at {}x{}; render targets stay at {}x{} until the size settles.",
+                      presentExtent.width, presentExtent.height, swapChainExtent.width, swapChainExtent.height);
+    }
+
+    void VulkanEngine::retireSwapChain(VkSwapchainKHR oldSwapChain, std::vector<VkImageView> imageViews) {
+        if (oldSwapChain == VK_NULL_HANDLE) return; // Minimized window, nothing was presented from it
+        RetiredSwapChain retired;
+        retired.swapChain = oldSwapChain;
+        retired.imageViews = std::move(imageViews);
+        retired.retiredFrame = frameCount;
+        retiredSwapChains.push_back(std::move(retired));
+    }
+
+    void VulkanEngine::destroyRetiredSwapChains(bool all) {
+        // A frame's fence is waited on MAX_FRAMES_IN_FLIGHT frames later; one more frame covers its present
+        auto destroy = [&](RetiredSwapChain &retired) {
+            if (!all && frameCount < retired.retiredFrame + MAX_FRAMES_IN_FLIGHT + 1) return false;
+            for (VkImageView imageView: retired.imageViews) vkDestroyImageView(device, imageView, nullptr);
+            if (retired.swapChain != VK_NULL_HANDLE) vkDestroySwapchainKHR(device, retired.swapChain, nullptr);
+            return true;
+        };
+        std::erase_if(retiredSwapChains, destroy);
+    }
+
+    VkImageView VulkanEngine::createImageView(VkImage image, VkFormat format, VkImageAspectFlags aspectFlags,
+                                              VkImageViewType viewType, uint32_t baseArrayLayer,
+                                              uint32_t layerCount, uint32_t levelCount) {
+        VkImageViewCreateInfo createInfo{};
+        createInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        createInfo.image = image;
+        createInfo.viewType = viewType;
+        createInfo.format = format;
+        // Component mapping (identity mapping)
+        createInfo.components.r = VK_COMPONENT_SWIZZLE_IDENTITY;
+        createInfo.components.g = VK_COMPONENT_SWIZZLE_IDENTITY;
+        createInfo.components.b = VK_COMPONENT_SWIZZLE_IDENTITY;
+        createInfo.components.a = VK_COMPONENT_SWIZZLE_IDENTITY;
+        // Subresource range (one mip level and layer unless a mip chain, cube or array view is requested)
+        createInfo.subresourceRange.aspectMask = aspectFlags;
+        createInfo.subresourceRange.baseMipLevel = 0;
+        createInfo.subresourceRange.levelCount = levelCount;
+        createInfo.subresourceRange.baseArrayLayer = baseArrayLayer;
+        createInfo.subresourceRange.layerCount = layerCount;
+
+        VkImageView imageView;
+        VkResult result = vkCreateImageView(device, &createInfo, nullptr, &imageView);
+        VK_CHECK(result, "Failed to create image view");
+        return imageView;
+    }
+
+    // --- Offscreen Scene Target ---
+
+    void VulkanEngine::createSceneTargets() {
+        spdlog::debug("Creating offscreen scene target...");
+
+        // Scaling the rendered region into the swapchain image needs blit support on both ends
+        VkFormatProperties formatProperties;
+        vkGetPhysicalDeviceFormatProperties(physicalDevice, swapChainImageFormat, &formatProperties);
+        constexpr VkFormatFeatureFlags blitFeatures = VK_FORMAT_FEATURE_BLIT_SRC_BIT | VK_FORMAT_FEATURE_BLIT_DST_BIT |
+                                                      VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT;
+        sceneBlitSupported = (formatProperties.optimalTilingFeatures & blitFeatures) == blitFeatures;
+        if (!sceneBlitSupported && dynamicResolution) {
+            spdlog::warn("Swap chain format does not support linear blits. Dynamic resolution disabled.");
+            dynamicResolution.reset();
+        }
+        if (!sceneBlitSupported && config.upscaler == UpscalerMode::Fsr) {
+            spdlog::warn("Swap chain format does not support blits. FSR upscaler disabled.");
+            config.upscaler = UpscalerMode::Bilinear;
+        }
+        if (!sceneBlitSupported && config.postEffects != 0) {
+            // The HDR post output can only reach the swapchain through a format-converting blit
+            spdlog::warn("Swap chain format does not support blits. Post-processing disabled.");
+            config.postEffects = 0;
+        }
+
+        // Post-processing works on an HDR scene; otherwise render straight in the swapchain format.
+        // The post pass and the FSR passes sample the scene target from compute; the bilinear path blits from it.
+        sceneColorFormat = config.postEffects != 0 ? VK_FORMAT_R16G16B16A16_SFLOAT : swapChainImageFormat;
+        VkImageUsageFlags usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+        if (config.postEffects != 0 || config.upscaler == UpscalerMode::Fsr) {
+            usage |= VK_IMAGE_USAGE_SAMPLED_BIT;
+            sceneFinalLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        } else {
+            sceneFinalLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+        }
+
+        // Allocated at the maximum (swapchain) size; the render extent only selects a sub-region.
+        // Under multiview each view gets a layer of its own, one view wide.
+        const bool multiview = isMultiviewUsed();
+        const uint32_t layers = multiview ? viewCount : 1;
+        const uint32_t targetWidth = swapChainExtent.width / layers;
+        const VkImageViewType viewType = multiview ? VK_IMAGE_VIEW_TYPE_2D_ARRAY : VK_IMAGE_VIEW_TYPE_2D;
+        if (viewCount > 1 && config.multiview && !multiview) {
+            spdlog::info("Multiview needs the plain blit path (no post effects, FSR or far field); drawing each "
+                         "view into its own viewport instead.");
+        }
+        createImage({MemoryCategory::RenderTarget, "scene color"},
+                    targetWidth, swapChainExtent.height, sceneColorFormat, usage,
+                    VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, sceneColorImage, sceneColorImageMemory,
+                    VK_SAMPLE_COUNT_1_BIT, layers, true);
+        sceneColorImageView = createImageView(sceneColorImage, sceneColorFormat, VK_IMAGE_ASPECT_COLOR_BIT, viewType,
+                                              0, layers);
+
+        // Depth that is never read after the scene pass lives only in tile memory where possible
+        const bool depthSampled = isDepthSampled();
+        depthFormat = findDepthFormat(depthSampled);
+        VkImageUsageFlags depthUsage = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
+        depthUsage |= depthSampled ? VK_IMAGE_USAGE_SAMPLED_BIT : VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT;
+        createImage({MemoryCategory::RenderTarget, "scene depth"},
+                    targetWidth, swapChainExtent.height, depthFormat, depthUsage,
+                    VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, sceneDepthImage, sceneDepthImageMemory, msaaSamples, layers,
+                    depthSampled);
+        sceneDepthImageView = createImageView(sceneDepthImage, depthFormat, VK_IMAGE_ASPECT_DEPTH_BIT, viewType, 0,
+                                              layers);
+
+        // Multisampled color is resolved inside the render pass and never read afterwards
+        if (msaaSamples != VK_SAMPLE_COUNT_1_BIT) {
+            createImage({MemoryCategory::RenderTarget, "MSAA color"},
+                        targetWidth, swapChainExtent.height, sceneColorFormat,
+                        VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT,
+                        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, msaaColorImage, msaaColorImageMemory, msaaSamples, layers);
+            msaaColorImageView = createImageView(msaaColorImage, sceneColorFormat, VK_IMAGE_ASPECT_COLOR_BIT, viewType,
+                                                 0, layers);
+        }
+
+        renderExtent = computeRenderExtent();
+        spdlog::info("Scene target created ({}x{}, {} layer(s)), rendering at {}x{} for {} view(s).", targetWidth,
+                     swapChainExtent.height, layers, renderExtent.width, renderExtent.height, viewCount);
+    }
+
+    void VulkanEngine::cleanupSceneTargets() {
+        // Everything that references the scene targets goes first
+        cleanupUpscalerTargets();
+        cleanupPostProcessTargets();
+        if (sceneFramebuffer != VK_NULL_HANDLE) vkDestroyFramebuffer(device, sceneFramebuffer, nullptr);
+        sceneFramebuffer = VK_NULL_HANDLE;
+        if (msaaColorImageView != VK_NULL_HANDLE) vkDestroyImageView(device, msaaColorImageView, nullptr);
+        msaaColorImageView = VK_NULL_HANDLE;
+        if (msaaColorImage != VK_NULL_HANDLE) vkDestroyImage(device, msaaColorImage, nullptr);
+        msaaColorImage = VK_NULL_HANDLE;
+        if (msaaColorImageMemory != VK_NULL_HANDLE) freeMemory(msaaColorImageMemory);
+        msaaColorImageMemory = VK_NULL_HANDLE;
+        if (sceneDepthImageView != VK_NULL_HANDLE) vkDestroyImageView(device, sceneDepthImageView, nullptr);
+        sceneDepthImageView = VK_NULL_HANDLE;
+        if (sceneDepthImage != VK_NULL_HANDLE) vkDestroyImage(device, sceneDepthImage, nullptr);
+        sceneDepthImage = VK_NULL_HANDLE;
+        if (sceneDepthImageMemory != VK_NULL_HANDLE) freeMemory(sceneDepthImageMemory);
+        sceneDepthImageMemory = VK_NULL_HANDLE;
+        if (sceneColorImageView != VK_NULL_HANDLE) vkDestroyImageView(device, sceneColorImageView, nullptr);
+        sceneColorImageView = VK_NULL_HANDLE;
+        if (sceneColorImage != VK_NULL_HANDLE) vkDestroyImage(device, sceneColorImage, nullptr);
+        sceneColorImage = VK_NULL_HANDLE;
+        if (sceneColorImageMemory != VK_NULL_HANDLE) freeMemory(sceneColorImageMemory);
+        sceneColorImageMemory = VK_NULL_HANDLE;
+    }
+
+    std::vector<VkSampleCountFlagBits> VulkanEngine::getSupportedSampleCounts() const {
+        VkPhysicalDeviceProperties properties;
+        vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+        const VkSampleCountFlags supported = properties.limits.framebufferColorSampleCounts &
+                                             properties.limits.framebufferDepthSampleCounts;
+
+        std::vector<VkSampleCountFlagBits> counts;
+        for (VkSampleCountFlagBits samples: {
+                 VK_SAMPLE_COUNT_1_BIT, VK_SAMPLE_COUNT_2_BIT, VK_SAMPLE_COUNT_4_BIT, VK_SAMPLE_COUNT_8_BIT
+             }) {
+            if (supported & samples) counts.push_back(samples);
+        }
+        return counts;
+    }
+
+    void VulkanEngine::setSampleCount(VkSampleCountFlagBits samples) {
+        spdlog::info("Switching to {}x MSAA...", static_cast<int>(samples));
+        // The sample count is baked into the attachments, the render pass and the pipelines
+        destroyScenePass();
+        msaaSamples = samples;
+        createScenePass();
+    }
+
+    void VulkanEngine::setViewCount(uint32_t count) {
+        spdlog::info("Switching to {} view(s)...", count);
+        // Under multiview the view count is baked into the layered attachments and the render pass
+        destroyScenePass();
+        viewCount = count;
+        createScenePass();
+    }
+
+    void VulkanEngine::destroyScenePass() {
+        VkResult waitResult = vkDeviceWaitIdle(device);
+        if (waitResult != VK_SUCCESS) {
+            spdlog::error("vkDeviceWaitIdle failed before rebuilding the scene pass! VkResult: {}",
+                          static_cast<int>(waitResult));
+        }
+        cleanupSceneTargets();
+        cleanupTerrainPipelines();
+        cleanupParticleDrawPipeline();
+        cleanupPropPipelines();
+        if (graphicsPipeline != VK_NULL_HANDLE) vkDestroyPipeline(device, graphicsPipeline, nullptr);
+        graphicsPipeline = VK_NULL_HANDLE;
+        if (pipelineLayout != VK_NULL_HANDLE) vkDestroyPipelineLayout(device, pipelineLayout, nullptr);
+        pipelineLayout = VK_NULL_HANDLE;
+        if (renderPass != VK_NULL_HANDLE) vkDestroyRenderPass(device, renderPass, nullptr);
+        renderPass = VK_NULL_HANDLE;
+    }
+
+    void VulkanEngine::createScenePass() {
+        createSceneTargets();
+        createPostProcessTargets();
+        createUpscalerTargets();
+        createRenderPass();
+        createGraphicsPipeline();
+        createTerrainPipelines();
+        createParticleDrawPipeline();
+        createPropPipelines();
+        createFramebuffers();
+        updateResourceReport();
+    }
+
+    bool VulkanEngine::isMultiviewUsed() const {
+        return viewCount > 1 && config.multiview && config.postEffects == 0 && config.upscaler != UpscalerMode::Fsr &&
+               sceneBlitSupported && !isImpostorUsed() && !isRayMarchUsed();
+    }
+
+    VkRect2D VulkanEngine::viewRegion(uint32_t view) const {
+        const uint32_t width = renderExtent.width / viewCount;
+        const int32_t x = isMultiviewUsed() ? 0 : static_cast<int32_t>(view * width);
+        return {{x, 0}, {width, renderExtent.height}};
+    }
+
+    float VulkanEngine::viewAspect() const {
+        return static_cast<float>(swapChainExtent.width) / static_cast<float>(viewCount * swapChainExtent.height);
+    }
+
+    bool VulkanEngine::isDepthSampled() const {
+        return (config.postEffects & (POST_FOG | POST_ATMOSPHERE)) != 0;
+    }
+
+    VkExtent2D VulkanEngine::computeRenderExtent() const {
+        const bool nativePhase = benchmarkPhaseB && config.benchmarkCompare == BenchmarkCompare::Upscaler;
+        if (nativePhase || !sceneBlitSupported) return swapChainExtent;
+        if (dynamicResolution) return dynamicResolution->scaledExtent(swapChainExtent);
+        return DynamicResolution::ScaleExtent(swapChainExtent, config.maxRenderScale);
+    }
+
+    // --- FSR Upscaler ---
+
+    void VulkanEngine::createUpscalerPipelines() {
+        if (config.upscaler != UpscalerMode::Fsr) return;
+        spdlog::debug("Creating FSR upscaler pipelines...");
+
+        // Shaders use texelFetch with explicit clamping, so filtering is irrelevant
+        VkSamplerCreateInfo samplerInfo{};
+        samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+        samplerInfo.magFilter = VK_FILTER_NEAREST;
+        samplerInfo.minFilter = VK_FILTER_NEAREST;
+        samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+        samplerInfo.maxLod = 0.0f;
+        VK_CHECK(vkCreateSampler(device, &samplerInfo, nullptr, &upscaleSampler), "Failed to create upscale sampler");
+
+        // binding 0: input image, binding 1: output storage image (same layout for EASU and RCAS)
+        VkDescriptorSetLayoutBinding bindings[2]{};
+        bindings[0].binding = 0;
+        bindings[0].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        bindings[0].descriptorCount = 1;
+        bindings[0].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        bindings[1].binding = 1;
+        bindings[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+        bindings[1].descriptorCount = 1;
+        bindings[1].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+
+        VkDescriptorSetLayoutCreateInfo layoutInfo{};
+        layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        layoutInfo.bindingCount = 2;
+        layoutInfo.pBindings = bindings;
+        VK_CHECK(vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &upscaleDescriptorSetLayout),
+                 "Failed to create upscale descriptor set layout");
+
+        VkPushConstantRange pushConstantRange{};
+        pushConstantRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        pushConstantRange.offset = 0;
+        pushConstantRange.size = sizeof(UpscalePushConstants);
+
+        VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+        pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        pipelineLayoutInfo.setLayoutCount = 1;
+        pipelineLayoutInfo.pSetLayouts = &upscaleDescriptorSetLayout;
+        pipelineLayoutInfo.pushConstantRangeCount = 1;
+        pipelineLayoutInfo.pPushConstantRanges = &pushConstantRange;
+        VK_CHECK(vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &upscalePipelineLayout),
+                 "Failed to create upscale pipeline layout");
+
+        auto createComputePipeline = [this](const std::string &path, VkPipeline &pipeline) {
+            VkShaderModule shaderModule = createShaderModule(readFile(path));
+            VkComputePipelineCreateInfo pipelineInfo{};
+            pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+            pipelineInfo.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+            pipelineInfo.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+            pipelineInfo.stage.module = shaderModule;
+            pipelineInfo.stage.pName = "main";
+            pipelineInfo.layout = upscalePipelineLayout;
+            VkResult result = vkCreateComputePipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &pipeline);
+            vkDestroyShaderModule(device, shaderModule, nullptr);
+            VK_CHECK(result, "Failed to create compute pipeline from " + path);
+        };
+        createComputePipeline("shaders/easu.spv", easuPipeline);
+        createComputePipeline("shaders/rcas.spv", rcasPipeline);
+        spdlog::info("FSR upscaler pipelines created.");
+    }
+
+    void VulkanEngine::createUpscalerTargets() {
+        if (config.upscaler != UpscalerMode::Fsr) return;
+        spdlog::debug("Creating FSR upscaler targets...");
+
+        // Both intermediates are output-sized; RGBA8 UNORM storage support is mandatory
+        constexpr VkFormat upscaleFormat = VK_FORMAT_R8G8B8A8_UNORM;
+        createImage({MemoryCategory::RenderTarget, "upscale"},
+                    swapChainExtent.width, swapChainExtent.height, upscaleFormat,
+                    VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                    upscaleImage, upscaleImageMemory);
+        upscaleImageView = createImageView(upscaleImage, upscaleFormat, VK_IMAGE_ASPECT_COLOR_BIT);
+        createImage({MemoryCategory::RenderTarget, "sharpen"},
+                    swapChainExtent.width, swapChainExtent.height, upscaleFormat,
+                    VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                    sharpenImage, sharpenImageMemory);
+        sharpenImageView = createImageView(sharpenImage, upscaleFormat, VK_IMAGE_ASPECT_COLOR_BIT);
+
+        VkDescriptorPoolSize poolSizes[2]{};
+        poolSizes[0].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        poolSizes[0].descriptorCount = 2;
+        poolSizes[1].type = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+        poolSizes[1].descriptorCount = 2;
+
+        VkDescriptorPoolCreateInfo poolInfo{};
+        poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        poolInfo.poolSizeCount = 2;
+        poolInfo.pPoolSizes = poolSizes;
+        poolInfo.maxSets = 2;
+        VK_CHECK(vkCreateDescriptorPool(device, &poolInfo, nullptr, &upscaleDescriptorPool),
+                 "Failed to create upscale descriptor pool");
+
+        VkDescriptorSetLayout layouts[] = {upscaleDescriptorSetLayout, upscaleDescriptorSetLayout};
+        VkDescriptorSet sets[2];
+        VkDescriptorSetAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocInfo.descriptorPool = upscaleDescriptorPool;
+        allocInfo.descriptorSetCount = 2;
+        allocInfo.pSetLayouts = layouts;
+        VK_CHECK(vkAllocateDescriptorSets(device, &allocInfo, sets), "Failed to allocate upscale descriptor sets");
+        easuDescriptorSet = sets[0];
+        rcasDescriptorSet = sets[1];
+
+        // EASU: scene (or post output) -> upscaleImage, RCAS: upscaleImage -> sharpenImage
+        VkDescriptorImageInfo imageInfos[4]{};
+        imageInfos[0] = {
+            upscaleSampler, config.postEffects != 0 ? postImageView : sceneColorImageView,
+            VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
+        };
+        imageInfos[1] = {VK_NULL_HANDLE, upscaleImageView, VK_IMAGE_LAYOUT_GENERAL};
+        imageInfos[2] = {upscaleSampler, upscaleImageView, VK_IMAGE_LAYOUT_GENERAL};
+        imageInfos[3] = {VK_NULL_HANDLE, sharpenImageView, VK_IMAGE_LAYOUT_GENERAL};
+
+        VkWriteDescriptorSet writes[4]{};
+        for (uint32_t i = 0; i < 4; ++i) {
+            writes[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            writes[i].dstSet = i < 2 ? easuDescriptorSet : rcasDescriptorSet;
+            writes[i].dstBinding = i % 2;
+            writes[i].descriptorCount = 1;
+            writes[i].descriptorType = (i % 2 == 0)
+                                           ? VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER
+                                           : VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+            writes[i].pImageInfo = &imageInfos[i];
+        }
+        vkUpdateDescriptorSets(device, 4, writes, 0, nullptr);
+        spdlog::info("FSR upscaler targets created ({}x{}).", swapChainExtent.width, swapChainExtent.height);
+    }
+
+    void VulkanEngine::cleanupUpscalerTargets() {
+        if (upscaleDescriptorPool != VK_NULL_HANDLE) vkDestroyDescriptorPool(device, upscaleDescriptorPool, nullptr);
+        upscaleDescriptorPool = VK_NULL_HANDLE; // Sets are freed with the pool
+        easuDescriptorSet = VK_NULL_HANDLE;
+        rcasDescriptorSet = VK_NULL_HANDLE;
+        if (sharpenImageView != VK_NULL_HANDLE) vkDestroyImageView(device, sharpenImageView, nullptr);
+        sharpenImageView = VK_NULL_HANDLE;
+        if (sharpenImage != VK_NULL_HANDLE) vkDestroyImage(device, sharpenImage, nullptr);
+        sharpenImage = VK_NULL_HANDLE;
+        if (sharpenImageMemory != VK_NULL_HANDLE) freeMemory(sharpenImageMemory);
+        sharpenImageMemory = VK_NULL_HANDLE;
+        if (upscaleImageView != VK_NULL_HANDLE) vkDestroyImageView(device, upscaleImageView, nullptr);
+        upscaleImageView = VK_NULL_HANDLE;
+        if (upscaleImage != VK_NULL_HANDLE) vkDestroyImage(device, upscaleImage, nullptr);
+        upscaleImage = VK_NULL_HANDLE;
+        if (upscaleImageMemory != VK_NULL_HANDLE) freeMemory(upscaleImageMemory);
+        upscaleImageMemory = VK_NULL_HANDLE;
+    }
+
+    bool VulkanEngine::isFsrActive() const {
+        const bool nativePhase = benchmarkPhaseB && config.benchmarkCompare == BenchmarkCompare::Upscaler;
+        return config.upscaler == UpscalerMode::Fsr && !nativePhase;
+    }
+
+    // --- Post Processing ---
+
+    void VulkanEngine::createPostProcessPipelines() {
+        if (config.postEffects == 0) return;
+        spdlog::debug("Creating post-processing pipelines...");
+
+        VkSamplerCreateInfo samplerInfo{};
+        samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+        samplerInfo.magFilter = VK_FILTER_NEAREST;
+        samplerInfo.minFilter = VK_FILTER_NEAREST;
+        samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+        samplerInfo.maxLod = 0.0f;
+        VK_CHECK(vkCreateSampler(device, &samplerInfo, nullptr, &postSampler), "Failed to create post sampler");
+        samplerInfo.magFilter = VK_FILTER_LINEAR; // Trilinear LUT interpolation
+        samplerInfo.minFilter = VK_FILTER_LINEAR;
+        VK_CHECK(vkCreateSampler(device, &samplerInfo, nullptr, &gradingLutSampler),
+                 "Failed to create grading LUT sampler");
+
+        // binding 0: input color, 1: scene depth, 2: grading LUT, 3: output storage image,
+        // 4-6: atmosphere sky view, aerial perspective and transmittance
+        VkDescriptorSetLayoutBinding bindings[POST_BINDING_COUNT]{};
+        for (uint32_t i = 0; i < POST_BINDING_COUNT; ++i) {
+            bindings[i].binding = i;
+            bindings[i].descriptorType = i != 3
+                                             ? VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER
+                                             : VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+            bindings[i].descriptorCount = 1;
+            bindings[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        }
+
+        VkDescriptorSetLayoutCreateInfo layoutInfo{};
+        layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        layoutInfo.bindingCount = POST_BINDING_COUNT;
+        layoutInfo.pBindings = bindings;
+        VK_CHECK(vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &postDescriptorSetLayout),
+                 "Failed to create post descriptor set layout");
+
+        VkPushConstantRange pushConstantRange{};
+        pushConstantRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        pushConstantRange.offset = 0;
+        pushConstantRange.size = sizeof(PostPushConstants);
+
+        VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+        pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        pipelineLayoutInfo.setLayoutCount = 1;
+        pipelineLayoutInfo.pSetLayouts = &postDescriptorSetLayout;
+        pipelineLayoutInfo.pushConstantRangeCount = 1;
+        pipelineLayoutInfo.pPushConstantRanges = &pushConstantRange;
+        VK_CHECK(vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &postPipelineLayout),
+                 "Failed to create post pipeline layout");
+
+        // Each effect is a boolean specialization constant (constant_id = effect bit index), so
+        // every permutation compiles down to exactly the enabled effects.
+        VkShaderModule shaderModule = createShaderModule(readFile("shaders/post.spv"));
+        auto createPermutation = [this, shaderModule](uint32_t effectMask, VkPipeline &pipeline) {
+            VkSpecializationMapEntry mapEntries[POST_EFFECT_COUNT];
+            VkBool32 enabled[POST_EFFECT_COUNT];
+            for (uint32_t i = 0; i < POST_EFFECT_COUNT; ++i) {
+                mapEntries[i] = {i, static_cast<uint32_t>(i * sizeof(VkBool32)), sizeof(VkBool32)};
+                enabled[i] = (effectMask & (1u << i)) ? VK_TRUE : VK_FALSE;
+            }
+            VkSpecializationInfo specializationInfo{};
+            specializationInfo.mapEntryCount = POST_EFFECT_COUNT;
+            specializationInfo.pMapEntries = mapEntries;
+            specializationInfo.dataSize = sizeof(enabled);
+            specializationInfo.pData = enabled;
+
+            VkComputePipelineCreateInfo pipelineInfo{};
+            pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+            pipelineInfo.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+            pipelineInfo.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+            pipelineInfo.stage.module = shaderModule;
+            pipelineInfo.stage.pName = "main";
+            pipelineInfo.stage.pSpecializationInfo = &specializationInfo;
+            pipelineInfo.layout = postPipelineLayout;
+            return vkCreateComputePipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &pipeline);
+        };
+
+        VkResult result = createPermutation(config.postEffects, postPipeline);
+        if (result == VK_SUCCESS && config.benchmarkCompare == BenchmarkCompare::PostChain) {
+            for (uint32_t i = 0; i < POST_EFFECT_COUNT && result == VK_SUCCESS; ++i) {
+                if (config.postEffects & (1u << i)) result = createPermutation(1u << i, postEffectPipelines[i]);
+            }
+        }
+        vkDestroyShaderModule(device, shaderModule, nullptr);
+        VK_CHECK(result, "Failed to create post-processing pipeline");
+
+        createGradingLut();
+        if (config.postEffects & POST_ATMOSPHERE) createAtmosphere();
+        spdlog::info("Post-processing pipelines created (effect mask 0x{:x}).", config.postEffects);
+    }
+
+    void VulkanEngine::createGradingLut() {
+        constexpr uint32_t LUT_SIZE = 16;
+        constexpr VkFormat lutFormat = VK_FORMAT_R8G8B8A8_UNORM;
+
+        // Procedural grade: slight saturation boost, soft S-curve contrast and a warm tint.
+        // Stands in for an artist-authored LUT until there is an asset pipeline for them.
+        std::vector<uint8_t> texels(LUT_SIZE * LUT_SIZE * LUT_SIZE * 4);
+        for (uint32_t b = 0; b < LUT_SIZE; ++b) {
+            for (uint32_t g = 0; g < LUT_SIZE; ++g) {
+                for (uint32_t r = 0; r < LUT_SIZE; ++r) {
+                    glm::vec3 color = glm::vec3(r, g, b) / static_cast<float>(LUT_SIZE - 1);
+                    const float luma = glm::dot(color, glm::vec3(0.2126f, 0.7152f, 0.0722f));
+                    color = glm::mix(glm::vec3(luma), color, 1.1f);
+                    color = glm::clamp(color, 0.0f, 1.0f);
+                    color = glm::mix(color, color * color * (3.0f - 2.0f * color), 0.3f);
+                    color = glm::clamp(color * glm::vec3(1.04f, 1.0f, 0.94f), 0.0f, 1.0f);
+
+                    uint8_t *texel = &texels[((b * LUT_SIZE + g) * LUT_SIZE + r) * 4];
+                    texel[0] = static_cast<uint8_t>(std::lround(color.r * 255.0f));
+                    texel[1] = static_cast<uint8_t>(std::lround(color.g * 255.0f));
+                    texel[2] = static_cast<uint8_t>(std::lround(color.b * 255.0f));
+                    texel[3] = 255;
+                }
+            }
+        }
+
+        VkImageCreateInfo imageInfo{};
+        imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        imageInfo.imageType = VK_IMAGE_TYPE_3D;
+        imageInfo.extent = {LUT_SIZE, LUT_SIZE, LUT_SIZE};
+        imageInfo.mipLevels = 1;
+        imageInfo.arrayLayers = 1;
+        imageInfo.format = lutFormat;
+        imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+        imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        imageInfo.usage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+        imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+        imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        createImage({MemoryCategory::Lut, "grading LUT"},
+                    imageInfo, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, gradingLutImage, gradingLutImageMemory, true);
+
+        VkImageViewCreateInfo viewInfo{};
+        viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        viewInfo.image = gradingLutImage;
+        viewInfo.viewType = VK_IMAGE_VIEW_TYPE_3D;
+        viewInfo.format = lutFormat;
+        viewInfo.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
+        VK_CHECK(vkCreateImageView(device, &viewInfo, nullptr, &gradingLutImageView),
+                 "Failed to create grading LUT image view");
+
+        // Upload through a staging buffer
+        const VkDeviceSize dataSize = texels.size();
+        VkBuffer stagingBuffer;
+        VkDeviceMemory stagingBufferMemory;
+        createBuffer({MemoryCategory::Staging, "grading LUT staging"}, dataSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                     VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                     stagingBuffer, stagingBufferMemory);
+        void *data;
+        VK_CHECK(vkMapMemory(device, stagingBufferMemory, 0, dataSize, 0, &data), "Failed to map LUT staging buffer");
+        memcpy(data, texels.data(), static_cast<size_t>(dataSize));
+        vkUnmapMemory(device, stagingBufferMemory);
+
+        VkCommandBuffer commandBuffer = beginSingleTimeCommands();
+        VkImageMemoryBarrier toTransfer = makeImageBarrier(gradingLutImage, VK_IMAGE_LAYOUT_UNDEFINED,
+                                                           VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 0,
+                                                           VK_ACCESS_TRANSFER_WRITE_BIT);
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             0, 0, nullptr, 0, nullptr, 1, &toTransfer);
+        VkBufferImageCopy region{};
+        region.imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
+        region.imageExtent = {LUT_SIZE, LUT_SIZE, LUT_SIZE};
+        vkCmdCopyBufferToImage(commandBuffer, stagingBuffer, gradingLutImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                               1, &region);
+        VkImageMemoryBarrier toShader = makeImageBarrier(gradingLutImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                                         VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                                                         VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT);
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                             0, 0, nullptr, 0, nullptr, 1, &toShader);
+        endSingleTimeCommands(commandBuffer);
+
+        vkDestroyBuffer(device, stagingBuffer, nullptr);
+        freeMemory(stagingBufferMemory);
+        spdlog::debug("Grading LUT created ({}^3).", LUT_SIZE);
+    }
+
+    void VulkanEngine::createAtmosphere() {
+        spdlog::debug("Creating atmosphere LUTs...");
+        constexpr VkFormat lutFormat = VK_FORMAT_R16G16B16A16_SFLOAT;
+        VkDeviceSize lutBytes = 0;
+        for (uint32_t i = 0; i < ATMOSPHERE_LUT_COUNT; ++i) {
+            const VkExtent3D extent = ATMOSPHERE_LUT_EXTENTS[i];
+            VkImageCreateInfo imageInfo{};
+            imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+            imageInfo.imageType = extent.depth > 1 ? VK_IMAGE_TYPE_3D : VK_IMAGE_TYPE_2D;
+            imageInfo.extent = extent;
+            imageInfo.mipLevels = 1;
+            imageInfo.arrayLayers = 1;
+            imageInfo.format = lutFormat;
+            imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+            imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+            imageInfo.usage = VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+            imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+            imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+            createImage({MemoryCategory::Lut, "atmosphere LUT " + std::to_string(i)},
+                        imageInfo, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, atmosphereImages[i], atmosphereImageMemory[i],
+                        true);
+            atmosphereImageViews[i] = createImageView(atmosphereImages[i], lutFormat, VK_IMAGE_ASPECT_COLOR_BIT,
+                                                      extent.depth > 1 ? VK_IMAGE_VIEW_TYPE_3D : VK_IMAGE_VIEW_TYPE_2D);
+            lutBytes += static_cast<VkDeviceSize>(extent.width) * extent.height * extent.depth * 8;
+        }
+
+        // Written as storage images and sampled by the next pass, so they never leave GENERAL
+        VkImageMemoryBarrier toGeneral[ATMOSPHERE_LUT_COUNT];
+        for (uint32_t i = 0; i < ATMOSPHERE_LUT_COUNT; ++i) {
+            toGeneral[i] = makeImageBarrier(atmosphereImages[i], VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_GENERAL, 0,
+                                            VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_SHADER_READ_BIT);
+        }
+        VkCommandBuffer commandBuffer = beginSingleTimeCommands();
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                             0, 0, nullptr, 0, nullptr, ATMOSPHERE_LUT_COUNT, toGeneral);
+        endSingleTimeCommands(commandBuffer);
+
+        VkSamplerCreateInfo samplerInfo{};
+        samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+        samplerInfo.magFilter = VK_FILTER_LINEAR;
+        samplerInfo.minFilter = VK_FILTER_LINEAR;
+        samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+        samplerInfo.maxLod = 0.0f;
+        VK_CHECK(vkCreateSampler(device, &samplerInfo, nullptr, &atmosphereSampler),
+                 "Failed to create atmosphere sampler");
+
+        // binding 0-3: the LUTs as storage images, 4: transmittance, 5: multiple scattering (sampled)
+        VkDescriptorSetLayoutBinding bindings[6]{};
+        for (uint32_t i = 0; i < 6; ++i) {
+            bindings[i].binding = i;
+            bindings[i].descriptorType = i < ATMOSPHERE_LUT_COUNT
+                                             ? VK_DESCRIPTOR_TYPE_STORAGE_IMAGE
+                                             : VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+            bindings[i].descriptorCount = 1;
+            bindings[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        }
+        VkDescriptorSetLayoutCreateInfo layoutInfo{};
+        layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        layoutInfo.bindingCount = 6;
+        layoutInfo.pBindings = bindings;
+        VK_CHECK(vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &atmosphereDescriptorSetLayout),
+                 "Failed to create atmosphere descriptor set layout");
+
+        const VkDescriptorPoolSize poolSizes[2] = {
+            {VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, ATMOSPHERE_LUT_COUNT}, {VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 2}
+        };
+        VkDescriptorPoolCreateInfo poolInfo{};
+        poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        poolInfo.poolSizeCount = 2;
+        poolInfo.pPoolSizes = poolSizes;
+        poolInfo.maxSets = 1;
+        VK_CHECK(vkCreateDescriptorPool(device, &poolInfo, nullptr, &atmosphereDescriptorPool),
+                 "Failed to create atmosphere descriptor pool");
+        VkDescriptorSetAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocInfo.descriptorPool = atmosphereDescriptorPool;
+        allocInfo.descriptorSetCount = 1;
+        allocInfo.pSetLayouts = &atmosphereDescriptorSetLayout;
+        VK_CHECK(vkAllocateDescriptorSets(device, &allocInfo, &atmosphereDescriptorSet),
+                 "Failed to allocate atmosphere descriptor set");
+
+        VkDescriptorImageInfo imageInfos[6];
+        for (uint32_t i = 0; i < ATMOSPHERE_LUT_COUNT; ++i) {
+            imageInfos[i] = {VK_NULL_HANDLE, atmosphereImageViews[i], VK_IMAGE_LAYOUT_GENERAL};
+        }
+        imageInfos[4] = {atmosphereSampler, atmosphereImageViews[0], VK_IMAGE_LAYOUT_GENERAL};
+        imageInfos[5] = {atmosphereSampler, atmosphereImageViews[1], VK_IMAGE_LAYOUT_GENERAL};
+        VkWriteDescriptorSet writes[6]{};
+        for (uint32_t binding = 0; binding < 6; ++binding) {
+            writes[binding].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            writes[binding].dstSet = atmosphereDescriptorSet;
+            writes[binding].dstBinding = binding;
+            writes[binding].descriptorCount = 1;
+            writes[binding].descriptorType = bindings[binding].descriptorType;
+            writes[binding].pImageInfo = &imageInfos[binding];
+        }
+        vkUpdateDescriptorSets(device, 6, writes, 0, nullptr);
+
+        VkPushConstantRange pushConstantRange{};
+        pushConstantRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        pushConstantRange.offset = 0;
+        pushConstantRange.size = sizeof(AtmospherePushConstants);
+        VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+        pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        pipelineLayoutInfo.setLayoutCount = 1;
+        pipelineLayoutInfo.pSetLayouts = &atmosphereDescriptorSetLayout;
+        pipelineLayoutInfo.pushConstantRangeCount = 1;
+        pipelineLayoutInfo.pPushConstantRanges = &pushConstantRange;
+        VK_CHECK(vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &atmospherePipelineLayout),
+                 "Failed to create atmosphere pipeline layout");
+
+        // PASS (constant_id 0) selects the LUT, in the order of the images
+        VkShaderModule shaderModule = createShaderModule(readFile("shaders/atmosphere.spv"));
+        VkResult result = VK_SUCCESS;
+        for (uint32_t pass = 0; pass < ATMOSPHERE_LUT_COUNT && result == VK_SUCCESS; ++pass) {
+            const int32_t specializationData = static_cast<int32_t>(pass);
+            const VkSpecializationMapEntry specializationEntry = {0, 0, sizeof(int32_t)};
+            VkSpecializationInfo specializationInfo{};
+            specializationInfo.mapEntryCount = 1;
+            specializationInfo.pMapEntries = &specializationEntry;
+            specializationInfo.dataSize = sizeof(specializationData);
+            specializationInfo.pData = &specializationData;
+
+            VkComputePipelineCreateInfo pipelineInfo{};
+            pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+            pipelineInfo.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+            pipelineInfo.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+            pipelineInfo.stage.module = shaderModule;
+            pipelineInfo.stage.pName = "main";
+            pipelineInfo.stage.pSpecializationInfo = &specializationInfo;
+            pipelineInfo.layout = atmospherePipelineLayout;
+            result = vkCreateComputePipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr,
+                                              &atmospherePipelines[pass]);
+        }
+        vkDestroyShaderModule(device, shaderModule, nullptr);
+        VK_CHECK(result, "Failed to create atmosphere pipeline");
+
+        spdlog::info("Atmosphere LUTs created ({:.1f} KB; sky view {}x{}, aerial perspective {}x{}x{}).",
+                     static_cast<double>(lutBytes) / 1024.0, ATMOSPHERE_LUT_EXTENTS[2].width,
+                     ATMOSPHERE_LUT_EXTENTS[2].height, ATMOSPHERE_LUT_EXTENTS[3].width,
+                     ATMOSPHERE_LUT_EXTENTS[3].height, ATMOSPHERE_LUT_EXTENTS[3].depth);
+    }
+
+    void VulkanEngine::cleanupAtmosphere() {
+        for (VkPipeline &pipeline: atmospherePipelines) {
+            if (pipeline != VK_NULL_HANDLE) vkDestroyPipeline(device, pipeline, nullptr);
+            pipeline = VK_NULL_HANDLE;
+        }
+        if (atmospherePipelineLayout != VK_NULL_HANDLE)
+            vkDestroyPipelineLayout(device, atmospherePipelineLayout, nullptr);
+        atmospherePipelineLayout = VK_NULL_HANDLE;
+        if (atmosphereDescriptorPool != VK_NULL_HANDLE)
+            vkDestroyDescriptorPool(device, atmosphereDescriptorPool, nullptr);
+        atmosphereDescriptorPool = VK_NULL_HANDLE; // The set is freed with the pool
+        atmosphereDescriptorSet = VK_NULL_HANDLE;
+        if (atmosphereDescriptorSetLayout != VK_NULL_HANDLE)
+            vkDestroyDescriptorSetLayout(device, atmosphereDescriptorSetLayout, nullptr);
+        atmosphereDescriptorSetLayout = VK_NULL_HANDLE;
+        if (atmosphereSampler != VK_NULL_HANDLE) vkDestroySampler(device, atmosphereSampler, nullptr);
+        atmosphereSampler = VK_NULL_HANDLE;
+        for (uint32_t i = 0; i < ATMOSPHERE_LUT_COUNT; ++i) {
+            if (atmosphereImageViews[i] != VK_NULL_HANDLE) vkDestroyImageView(device, atmosphereImageViews[i], nullptr);
+            atmosphereImageViews[i] = VK_NULL_HANDLE;
+            if (atmosphereImages[i] != VK_NULL_HANDLE) vkDestroyImage(device, atmosphereImages[i], nullptr);
+            atmosphereImages[i] = VK_NULL_HANDLE;
+            if (atmosphereImageMemory[i] != VK_NULL_HANDLE) freeMemory(atmosphereImageMemory[i]);
+            atmosphereImageMemory[i] = VK_NULL_HANDLE;
+        }
+    }
+
+    glm::vec4 VulkanEngine::atmosphereMedium() const {
+        return {1.0f, config.haze, ATMOSPHERE_GROUND_ALBEDO, ATMOSPHERE_AERIAL_DEPTH_KM};
+    }
+
+    void VulkanEngine::setHaze(float haze) {
+        config.haze = std::max(haze, 0.0f);
+        spdlog::info("Atmosphere haze: {:.2f}", config.haze);
+    }
+
+    void VulkanEngine::logMemoryReport(bool allocations) {
+        updateSwapChainMemoryEstimates();
+        memoryReport.log(allocations);
+    }
+
+    void VulkanEngine::updateSwapChainMemoryEstimates() {
+        // Presentable images are allocated by the driver; count, extent and format are all that is known of them
+        auto estimate = [](size_t images, VkExtent2D extent, VkFormat format) {
+            return static_cast<VkDeviceSize>(images) * extent.width * extent.height * formatBytesPerPixel(format);
+        };
+        memoryReport.setEstimate("swapchain", MemoryCategory::Swapchain,
+                                 estimate(swapChainImages.size(), presentExtent, swapChainImageFormat));
+        for (size_t i = 0; i < windowOutputs.size(); ++i) {
+            const WindowOutput &output = windowOutputs[i];
+            memoryReport.setEstimate("swapchain (window " + std::to_string(i + 1) + ")", MemoryCategory::Swapchain,
+                                     estimate(output.images.size(), output.extent, output.imageFormat));
+        }
+    }
+
+    void VulkanEngine::createPostProcessTargets() {
+        if (config.postEffects == 0) return;
+        spdlog::debug("Creating post-processing targets...");
+        const bool chained = config.benchmarkCompare == BenchmarkCompare::PostChain;
+
+        // HDR output, read by the upscaler as either a blit source or a sampled image
+        constexpr VkFormat postFormat = VK_FORMAT_R16G16B16A16_SFLOAT;
+        constexpr VkImageUsageFlags postUsage = VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_SAMPLED_BIT |
+                                                VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+        createImage({MemoryCategory::RenderTarget, "post"},
+                    swapChainExtent.width, swapChainExtent.height, postFormat, postUsage,
+                    VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, postImage, postImageMemory, VK_SAMPLE_COUNT_1_BIT, 1, true);
+        postImageView = createImageView(postImage, postFormat, VK_IMAGE_ASPECT_COLOR_BIT);
+        if (chained) {
+            createImage({MemoryCategory::RenderTarget, "post scratch"},
+                        swapChainExtent.width, swapChainExtent.height, postFormat,
+                        VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                        postScratchImage, postScratchImageMemory, VK_SAMPLE_COUNT_1_BIT, 1, true);
+            postScratchImageView = createImageView(postScratchImage, postFormat, VK_IMAGE_ASPECT_COLOR_BIT);
+        }
+
+        const uint32_t setCount = chained ? 4 : 1;
+        VkDescriptorPoolSize poolSizes[2]{};
+        poolSizes[0].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        poolSizes[0].descriptorCount = (POST_BINDING_COUNT - 1) * setCount;
+        poolSizes[1].type = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+        poolSizes[1].descriptorCount = setCount;
+
+        VkDescriptorPoolCreateInfo poolInfo{};
+        poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        poolInfo.poolSizeCount = 2;
+        poolInfo.pPoolSizes = poolSizes;
+        poolInfo.maxSets = setCount;
+        VK_CHECK(vkCreateDescriptorPool(device, &poolInfo, nullptr, &postDescriptorPool),
+                 "Failed to create post descriptor pool");
+
+        VkDescriptorSetLayout layouts[4] = {
+            postDescriptorSetLayout, postDescriptorSetLayout, postDescriptorSetLayout, postDescriptorSetLayout
+        };
+        VkDescriptorSetAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocInfo.descriptorPool = postDescriptorPool;
+        allocInfo.descriptorSetCount = setCount;
+        allocInfo.pSetLayouts = layouts;
+        VK_CHECK(vkAllocateDescriptorSets(device, &allocInfo, postDescriptorSets),
+                 "Failed to allocate post descriptor sets");
+
+        // Intermediates of the chain stay in GENERAL (written as storage, read as sampled)
+        const VkDescriptorImageInfo sceneInput = {
+            postSampler, sceneColorImageView, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
+        };
+        const VkDescriptorImageInfo scratchInput = {postSampler, postScratchImageView, VK_IMAGE_LAYOUT_GENERAL};
+        const VkDescriptorImageInfo postInput = {postSampler, postImageView, VK_IMAGE_LAYOUT_GENERAL};
+        const VkDescriptorImageInfo postOutput = {VK_NULL_HANDLE, postImageView, VK_IMAGE_LAYOUT_GENERAL};
+        const VkDescriptorImageInfo scratchOutput = {VK_NULL_HANDLE, postScratchImageView, VK_IMAGE_LAYOUT_GENERAL};
+        // Without fog or atmosphere the depth attachment is transient and cannot be sampled; the binding
+        // is compiled out of the permutation but must still be valid, so it aliases the scene color.
+        // The atmosphere LUTs do the same when the effect is off.
+        const VkDescriptorImageInfo depthInfo = isDepthSampled()
+                                                    ? VkDescriptorImageInfo{
+                                                        postSampler, sceneDepthImageView,
+                                                        VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL
+                                                    }
+                                                    : sceneInput;
+        const VkDescriptorImageInfo lutInfo = {
+            gradingLutSampler, gradingLutImageView, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
+        };
+        const bool atmosphere = (config.postEffects & POST_ATMOSPHERE) != 0;
+        auto atmosphereInfo = [&](uint32_t lut, const VkDescriptorImageInfo &alias) {
+            return atmosphere
+                       ? VkDescriptorImageInfo{atmosphereSampler, atmosphereImageViews[lut], VK_IMAGE_LAYOUT_GENERAL}
+                       : alias;
+        };
+        const VkDescriptorImageInfo skyViewInfo = atmosphereInfo(2, sceneInput);
+        const VkDescriptorImageInfo aerialInfo = atmosphereInfo(3, lutInfo);
+        const VkDescriptorImageInfo transmittanceInfo = atmosphereInfo(0, sceneInput);
+        const VkDescriptorImageInfo *inputs[4] = {&sceneInput, &sceneInput, &scratchInput, &postInput};
+        const VkDescriptorImageInfo *outputs[4] = {&postOutput, &scratchOutput, &postOutput, &scratchOutput};
+
+        std::vector<VkWriteDescriptorSet> writes;
+        writes.reserve(POST_BINDING_COUNT * setCount);
+        for (uint32_t set = 0; set < setCount; ++set) {
+            const VkDescriptorImageInfo *infos[POST_BINDING_COUNT] = {
+                inputs[set], &depthInfo, &lutInfo, outputs[set], &skyViewInfo, &aerialInfo, &transmittanceInfo
+            };
+            for (uint32_t binding = 0; binding < POST_BINDING_COUNT; ++binding) {
+                VkWriteDescriptorSet write{};
+                write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+                write.dstSet = postDescriptorSets[set];
+                write.dstBinding = binding;
+                write.descriptorCount = 1;
+                write.descriptorType = binding != 3
+                                           ? VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER
+                                           : VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+                write.pImageInfo = infos[binding];
+                writes.push_back(write);
+            }
+        }
+        vkUpdateDescriptorSets(device, static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
+        spdlog::info("Post-processing targets created ({}x{}{}).", swapChainExtent.width, swapChainExtent.height,
+                     chained ? ", with chained-pass scratch image" : "");
+    }
+
+    void VulkanEngine::cleanupPostProcessTargets() {
+        if (postDescriptorPool != VK_NULL_HANDLE) vkDestroyDescriptorPool(device, postDescriptorPool, nullptr);
+        postDescriptorPool = VK_NULL_HANDLE; // Sets are freed with the pool
+        for (VkDescriptorSet &set: postDescriptorSets) set = VK_NULL_HANDLE;
+        if (postScratchImageView != VK_NULL_HANDLE) vkDestroyImageView(device, postScratchImageView, nullptr);
+        postScratchImageView = VK_NULL_HANDLE;
+        if (postScratchImage != VK_NULL_HANDLE) vkDestroyImage(device, postScratchImage, nullptr);
+        postScratchImage = VK_NULL_HANDLE;
+        if (postScratchImageMemory != VK_NULL_HANDLE) freeMemory(postScratchImageMemory);
+        postScratchImageMemory = VK_NULL_HANDLE;
+        if (postImageView != VK_NULL_HANDLE) vkDestroyImageView(device, postImageView, nullptr);
+        postImageView = VK_NULL_HANDLE;
+        if (postImage != VK_NULL_HANDLE) vkDestroyImage(device, postImage, nullptr);
+        postImage = VK_NULL_HANDLE;
+        if (postImageMemory != VK_NULL_HANDLE) freeMemory(postImageMemory);
+        postImageMemory = VK_NULL_HANDLE;
+    }
+
+    uint64_t VulkanEngine::estimatePostTrafficBytes(bool chained) const {
+        // Per pixel: RGBA16F color read + write, plus a 32-bit depth read for fog and the atmosphere. The
+        // LUTs are tiny and cache resident, so they are not counted.
+        constexpr uint64_t COLOR_BYTES = 8;
+        constexpr uint64_t DEPTH_BYTES = 4;
+        const uint64_t pixels = static_cast<uint64_t>(renderExtent.width) * renderExtent.height;
+        const uint64_t depthReads = ((config.postEffects & POST_FOG) ? 1 : 0) +
+                                    ((config.postEffects & POST_ATMOSPHERE) ? 1 : 0);
+        if (!chained) return pixels * (2 * COLOR_BYTES + (depthReads > 0 ? DEPTH_BYTES : 0));
+        const uint64_t depthBytes = depthReads * DEPTH_BYTES; // Once per pass that reads it
+
+        uint64_t passes = 0;
+        for (uint32_t i = 0; i < POST_EFFECT_COUNT; ++i) {
+            if (config.postEffects & (1u << i)) passes++;
+        }
+        return pixels * (passes * 2 * COLOR_BYTES + depthBytes);
+    }
+
+    // --- Render Pass ---
+
+    void VulkanEngine::createRenderPass() {
+        spdlog::debug("Creating render pass...");
+        // Define the color attachment (scene target format: swapchain format or HDR).
+        // With MSAA this is the multisampled target; only its resolve (attachment 2) is stored.
+        const bool multisampled = msaaSamples != VK_SAMPLE_COUNT_1_BIT;
+        VkAttachmentDescription colorAttachment{};
+        colorAttachment.format = sceneColorFormat;
+        colorAttachment.samples = msaaSamples;
+        colorAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR; // Clear framebuffer before drawing
+        colorAttachment.storeOp = multisampled
+                                      ? VK_ATTACHMENT_STORE_OP_DONT_CARE // Samples die in tile memory
+                                      : VK_ATTACHMENT_STORE_OP_STORE; // Store result to be scaled into the swapchain
+        colorAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+        colorAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+        colorAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED; // Layout before render pass
+        colorAttachment.finalLayout = multisampled
+                                          ? VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL
+                                          : sceneFinalLayout; // Blit source or sampled by the post/FSR passes
+
+        // Resolve target: every pixel is written by the resolve, so nothing needs loading
+        VkAttachmentDescription resolveAttachment{};
+        resolveAttachment.format = sceneColorFormat;
+        resolveAttachment.samples = VK_SAMPLE_COUNT_1_BIT;
+        resolveAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+        resolveAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+        resolveAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+        resolveAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+        resolveAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        resolveAttachment.finalLayout = sceneFinalLayout;
+
+        // Depth is only written back when the post pass reads it for fog. Otherwise it is a transient
+        // attachment: cleared on load, discarded on store, so tilers never touch memory for it.
+        const bool depthSampled = isDepthSampled();
+        VkAttachmentDescription depthAttachment{};
+        depthAttachment.format = depthFormat;
+        depthAttachment.samples = msaaSamples;
+        depthAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+        depthAttachment.storeOp = depthSampled ? VK_ATTACHMENT_STORE_OP_STORE : VK_ATTACHMENT_STORE_OP_DONT_CARE;
+        depthAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+        depthAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+        depthAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        depthAttachment.finalLayout = depthSampled
+                                          ? VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL
+                                          : VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+
+        // Attachment reference for the subpass
+        VkAttachmentReference colorAttachmentRef{};
+        colorAttachmentRef.attachment = 0; // Index in the pAttachments array
+        colorAttachmentRef.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL; // Layout during subpass
+
+        VkAttachmentReference depthAttachmentRef{};
+        depthAttachmentRef.attachment = 1;
+        depthAttachmentRef.layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+
+        VkAttachmentReference resolveAttachmentRef{};
+        resolveAttachmentRef.attachment = 2;
+        resolveAttachmentRef.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+
+        // Define the subpass (the resolve happens at the end of it, while the samples are on chip)
+        VkSubpassDescription subpass{};
+        subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+        subpass.colorAttachmentCount = 1;
+        subpass.pColorAttachments = &colorAttachmentRef;
+        subpass.pResolveAttachments = multisampled ? &resolveAttachmentRef : nullptr;
+        subpass.pDepthStencilAttachment = &depthAttachmentRef;
+        // No input or preserve attachments for now
+
+        // Subpass dependencies: the scene targets are reused every frame, so writes must wait for the
+        // previous frame's post/upscale to finish reading them, and those must wait for our writes.
+        constexpr VkPipelineStageFlags depthStages = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT |
+                                                     VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+        VkSubpassDependency dependencies[2]{};
+        dependencies[0].srcSubpass = VK_SUBPASS_EXTERNAL; // Implicit subpass before render pass
+        dependencies[0].dstSubpass = 0; // Our first (and only) subpass
+        dependencies[0].srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT |
+                                       VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | depthStages;
+        // Write-after-read only needs an execution dependency; attachments are also written-after-written
+        dependencies[0].srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT |
+                                        VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+        dependencies[0].dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | depthStages;
+        dependencies[0].dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT |
+                                        VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT |
+                                        VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+
+        dependencies[1].srcSubpass = 0;
+        dependencies[1].dstSubpass = VK_SUBPASS_EXTERNAL; // Post and upscale (blit or compute) after the pass
+        dependencies[1].srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT |
+                                       VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+        dependencies[1].srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT |
+                                        VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+        dependencies[1].dstStageMask = VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+        dependencies[1].dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_SHADER_READ_BIT;
+
+        // Define the render pass
+        VkAttachmentDescription attachments[] = {colorAttachment, depthAttachment, resolveAttachment};
+        VkRenderPassCreateInfo renderPassInfo{};
+        renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+        renderPassInfo.attachmentCount = multisampled ? 3 : 2;
+        renderPassInfo.pAttachments = attachments;
+        renderPassInfo.subpassCount = 1;
+        renderPassInfo.pSubpasses = &subpass;
+        renderPassInfo.dependencyCount = 2;
+        renderPassInfo.pDependencies = dependencies;
+
+        // Multiview: the subpass is broadcast to one attachment layer per view. Stereo eyes see
+        // nearly the same geometry, which lets the implementation share work between them.
+        const uint32_t viewMask = (1u << viewCount) - 1u;
+        const uint32_t correlationMask = viewMask;
+        VkRenderPassMultiviewCreateInfo multiviewInfo{};
+        multiviewInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_MULTIVIEW_CREATE_INFO;
+        multiviewInfo.subpassCount = 1;
+        multiviewInfo.pViewMasks = &viewMask;
+        multiviewInfo.correlationMaskCount = config.viewLayout == ViewLayout::Stereo ? 1 : 0;
+        multiviewInfo.pCorrelationMasks = &correlationMask;
+        if (isMultiviewUsed()) {
+            renderPassInfo.pNext = &multiviewInfo;
+        }
+
+        VkResult result = vkCreateRenderPass(device, &renderPassInfo, nullptr, &renderPass);
+        VK_CHECK(result, "Failed to create render pass!");
+        spdlog::info("Render pass created ({}x MSAA, view mask 0x{:x}).", static_cast<int>(msaaSamples),
+                     isMultiviewUsed() ? viewMask : 0u);
+    }
+
+
+    // --- Descriptor Sets (for Uniform Buffer) ---
+
+    void VulkanEngine::createDescriptorSetLayout() {
+        spdlog::debug("Creating descriptor set layout...");
+        // Define layout binding for the Uniform Buffer Object (UBO)
+        VkDescriptorSetLayoutBinding uboLayoutBinding{};
+        uboLayoutBinding.binding = 0; // Binding point used in the shader (layout(binding = 0))
+        uboLayoutBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        uboLayoutBinding.descriptorCount = 1; // Number of descriptors in the binding (just one UBO)
+        uboLayoutBinding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT; // UBO is used in the vertex shader
+        uboLayoutBinding.pImmutableSamplers = nullptr; // Optional
+
+        // Create the descriptor set layout
+        VkDescriptorSetLayoutCreateInfo layoutInfo{};
+        layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        layoutInfo.bindingCount = 1;
+        layoutInfo.pBindings = &uboLayoutBinding;
+
+        VkResult result = vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &descriptorSetLayout);
+        VK_CHECK(result, "Failed to create descriptor set layout!");
+        spdlog::info("Descriptor set layout created.");
+    }
+
+
+    // --- Graphics Pipeline ---
+
+    // Helper to create shader modules
+    VkShaderModule VulkanEngine::createShaderModule(const std::vector<char> &code) {
+        VkShaderModuleCreateInfo createInfo{};
         createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
         createInfo.codeSize = code.size();
         // Note: pCode requires uint32_t*, need careful casting
         createInfo.pCode = reinterpret_cast<const uint32_t *>(code.data());
 
-        VkShaderModule shaderModule;
-        VkResult result = vkCreateShaderModule(device, &createInfo, nullptr, &shaderModule);
-        VK_CHECK(result, "Failed to create shader module!");
-        spdlog::debug("Shader module created (size: {} bytes)", code.size());
-        return shaderModule;
+        VkShaderModule shaderModule;
+        VkResult result = vkCreateShaderModule(device, &createInfo, nullptr, &shaderModule);
+        VK_CHECK(result, "Failed to create shader module!");
+        spdlog::debug("Shader module created (size: {} bytes)", code.size());
+        return shaderModule;
+    }
+
+    void VulkanEngine::createGraphicsPipeline() {
+        spdlog::debug("Creating graphics pipeline...");
+        // Load shader code
+        auto vertShaderCode = readFile("shaders/vert.spv");
+        auto fragShaderCode = readFile("shaders/frag.spv");
+
+        // Create shader modules
+        VkShaderModule vertShaderModule = createShaderModule(vertShaderCode);
+        VkShaderModule fragShaderModule = createShaderModule(fragShaderCode);
+
+        // Define shader stages
+        // MULTIVIEW (constant 0) picks the view matrix by gl_ViewIndex instead of the push constant
+        const VkBool32 multiview = isMultiviewUsed() ? VK_TRUE : VK_FALSE;
+        VkSpecializationMapEntry multiviewEntry{0, 0, sizeof(VkBool32)};
+        VkSpecializationInfo specializationInfo{};
+        specializationInfo.mapEntryCount = 1;
+        specializationInfo.pMapEntries = &multiviewEntry;
+        specializationInfo.dataSize = sizeof(multiview);
+        specializationInfo.pData = &multiview;
+
+        VkPipelineShaderStageCreateInfo vertShaderStageInfo{};
+        vertShaderStageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        vertShaderStageInfo.stage = VK_SHADER_STAGE_VERTEX_BIT;
+        vertShaderStageInfo.module = vertShaderModule;
+        vertShaderStageInfo.pName = "main"; // Entry point function name
+        vertShaderStageInfo.pSpecializationInfo = &specializationInfo;
+
+        VkPipelineShaderStageCreateInfo fragShaderStageInfo{};
+        fragShaderStageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        fragShaderStageInfo.stage = VK_SHADER_STAGE_FRAGMENT_BIT;
+        fragShaderStageInfo.module = fragShaderModule;
+        fragShaderStageInfo.pName = "main";
+
+        VkPipelineShaderStageCreateInfo shaderStages[] = {vertShaderStageInfo, fragShaderStageInfo};
+
+        // --- Fixed Function State ---
+
+        // Vertex Input
+        auto bindingDescription = Vertex::getBindingDescription();
+        auto attributeDescriptions = Vertex::getAttributeDescriptions();
+        VkPipelineVertexInputStateCreateInfo vertexInputInfo{};
+        vertexInputInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+        vertexInputInfo.vertexBindingDescriptionCount = 1;
+        vertexInputInfo.pVertexBindingDescriptions = &bindingDescription;
+        vertexInputInfo.vertexAttributeDescriptionCount = static_cast<uint32_t>(attributeDescriptions.size());
+        vertexInputInfo.pVertexAttributeDescriptions = attributeDescriptions.data();
+
+        // Input Assembly (Triangles)
+        VkPipelineInputAssemblyStateCreateInfo inputAssembly{};
+        inputAssembly.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+        inputAssembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+        inputAssembly.primitiveRestartEnable = VK_FALSE;
+
+        // Viewport and Scissor (Dynamic state allows changing without rebuilding pipeline)
+        VkPipelineViewportStateCreateInfo viewportState{};
+        viewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+        viewportState.viewportCount = 1;
+        viewportState.scissorCount = 1;
+        // pViewports and pScissors set dynamically via command buffer
+
+        std::vector<VkDynamicState> dynamicStates = {
+            VK_DYNAMIC_STATE_VIEWPORT,
+            VK_DYNAMIC_STATE_SCISSOR
+        };
+        VkPipelineDynamicStateCreateInfo dynamicState{};
+        dynamicState.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+        dynamicState.dynamicStateCount = static_cast<uint32_t>(dynamicStates.size());
+        dynamicState.pDynamicStates = dynamicStates.data();
+
+        // Rasterizer
+        VkPipelineRasterizationStateCreateInfo rasterizer{};
+        rasterizer.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+        rasterizer.depthClampEnable = VK_FALSE; // Clamping fragments beyond near/far planes
+        rasterizer.rasterizerDiscardEnable = VK_FALSE; // Don't discard geometry
+        rasterizer.polygonMode = VK_POLYGON_MODE_FILL; // Fill polygons
+        rasterizer.lineWidth = 1.0f;
+        rasterizer.cullMode = VK_CULL_MODE_BACK_BIT; // Cull back faces
+        rasterizer.frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE; // Define front face (due to proj matrix Y-flip)
+        rasterizer.depthBiasEnable = VK_FALSE;
+        // rasterizer.depthBiasConstantFactor = 0.0f; // Optional
+        // rasterizer.depthBiasClamp = 0.0f; // Optional
+        // rasterizer.depthBiasSlopeFactor = 0.0f; // Optional
+
+        // Multisampling (edge anti-aliasing only, no per-sample shading)
+        VkPipelineMultisampleStateCreateInfo multisampling{};
+        multisampling.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+        multisampling.sampleShadingEnable = VK_FALSE;
+        multisampling.rasterizationSamples = msaaSamples;
+        // multisampling.minSampleShading = 1.0f; // Optional
+        // multisampling.pSampleMask = nullptr; // Optional
+        // multisampling.alphaToCoverageEnable = VK_FALSE; // Optional
+        // multisampling.alphaToOneEnable = VK_FALSE; // Optional
+
+        // Depth/Stencil Testing
+        VkPipelineDepthStencilStateCreateInfo depthStencil{};
+        depthStencil.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+        depthStencil.depthTestEnable = VK_TRUE;
+        depthStencil.depthWriteEnable = VK_TRUE;
+        depthStencil.depthCompareOp = VK_COMPARE_OP_LESS;
+        depthStencil.depthBoundsTestEnable = VK_FALSE;
+        depthStencil.stencilTestEnable = VK_FALSE;
+
+        // Color Blending (Simple alpha blending, disabled here)
+        VkPipelineColorBlendAttachmentState colorBlendAttachment{};
+        colorBlendAttachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT |
+                                              VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+        colorBlendAttachment.blendEnable = VK_FALSE; // No blending
+        // colorBlendAttachment.srcColorBlendFactor = VK_BLEND_FACTOR_ONE; // Optional
+        // colorBlendAttachment.dstColorBlendFactor = VK_BLEND_FACTOR_ZERO; // Optional
+        // colorBlendAttachment.colorBlendOp = VK_BLEND_OP_ADD; // Optional
+        // colorBlendAttachment.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE; // Optional
+        // colorBlendAttachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ZERO; // Optional
+        // colorBlendAttachment.alphaBlendOp = VK_BLEND_OP_ADD; // Optional
+
+        VkPipelineColorBlendStateCreateInfo colorBlending{};
+        colorBlending.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+        colorBlending.logicOpEnable = VK_FALSE; // Use blend factors, not bitwise logic op
+        colorBlending.logicOp = VK_LOGIC_OP_COPY; // Optional
+        colorBlending.attachmentCount = 1;
+        colorBlending.pAttachments = &colorBlendAttachment;
+        // colorBlending.blendConstants[0] = 0.0f; // Optional
+        // colorBlending.blendConstants[1] = 0.0f; // Optional
+        // colorBlending.blendConstants[2] = 0.0f; // Optional
+        // colorBlending.blendConstants[3] = 0.0f; // Optional
+
+        // Pipeline Layout (Specifies uniforms/push constants)
+        VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+        pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        pipelineLayoutInfo.setLayoutCount = 1;
+        pipelineLayoutInfo.pSetLayouts = &descriptorSetLayout; // Use the UBO layout
+        // View index into the UBO matrices when drawing one viewport at a time
+        VkPushConstantRange viewRange{VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(uint32_t)};
+        pipelineLayoutInfo.pushConstantRangeCount = 1;
+        pipelineLayoutInfo.pPushConstantRanges = &viewRange;
+
+        VkResult layoutResult = vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &pipelineLayout);
+        VK_CHECK(layoutResult, "Failed to create pipeline layout!");
+        spdlog::debug("Pipeline layout created.");
+
+        // --- Create Graphics Pipeline ---
+        VkGraphicsPipelineCreateInfo pipelineInfo{};
+        pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+        pipelineInfo.stageCount = 2; // Vertex + Fragment stages
+        pipelineInfo.pStages = shaderStages;
+        pipelineInfo.pVertexInputState = &vertexInputInfo;
+        pipelineInfo.pInputAssemblyState = &inputAssembly;
+        pipelineInfo.pViewportState = &viewportState;
+        pipelineInfo.pRasterizationState = &rasterizer;
+        pipelineInfo.pMultisampleState = &multisampling;
+        pipelineInfo.pDepthStencilState = &depthStencil;
+        pipelineInfo.pColorBlendState = &colorBlending;
+        pipelineInfo.pDynamicState = &dynamicState; // Enable dynamic viewport/scissor
+        pipelineInfo.layout = pipelineLayout;
+        pipelineInfo.renderPass = renderPass; // Render pass the pipeline is compatible with
+        pipelineInfo.subpass = 0; // Index of the subpass
+        // pipelineInfo.basePipelineHandle = VK_NULL_HANDLE; // Optional: For pipeline derivation
+        // pipelineInfo.basePipelineIndex = -1; // Optional
+
+        VkResult pipelineResult = vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr,
+                                                            &graphicsPipeline);
+        VK_CHECK(pipelineResult, "Failed to create graphics pipeline!");
+        spdlog::info("Graphics pipeline created.");
+
+        // Cleanup shader modules after pipeline creation
+        vkDestroyShaderModule(device, fragShaderModule, nullptr);
+        vkDestroyShaderModule(device, vertShaderModule, nullptr);
+        spdlog::debug("Shader modules destroyed.");
+    }
+
+    // --- Framebuffers ---
+
+    void VulkanEngine::createFramebuffers() {
+        spdlog::debug("Creating scene framebuffer...");
+        const bool multisampled = msaaSamples != VK_SAMPLE_COUNT_1_BIT;
+        VkImageView attachments[] = {
+            multisampled ? msaaColorImageView : sceneColorImageView, sceneDepthImageView, sceneColorImageView
+        };
+
+        // Full-size framebuffer; each frame renders only into the renderExtent region of it.
+        // Under multiview it is one view wide and the render pass fans out over the layers.
+        VkFramebufferCreateInfo framebufferInfo{};
+        framebufferInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+        framebufferInfo.renderPass = renderPass; // Compatible render pass
+        framebufferInfo.attachmentCount = multisampled ? 3 : 2;
+        framebufferInfo.pAttachments = attachments; // Image views for the attachments
+        framebufferInfo.width = swapChainExtent.width / (isMultiviewUsed() ? viewCount : 1);
+        framebufferInfo.height = swapChainExtent.height;
+        framebufferInfo.layers = 1;
+
+        VkResult result = vkCreateFramebuffer(device, &framebufferInfo, nullptr, &sceneFramebuffer);
+        VK_CHECK(result, "Failed to create scene framebuffer");
+        spdlog::debug("Created scene framebuffer.");
+    }
+
+    // --- Terrain & Far-Field Impostor ---
+
+    bool VulkanEngine::isImpostorUsed() const {
+        return config.farField == FarFieldMode::Impostor &&
+               (config.farFieldSplit > 0.0f || config.benchmarkCompare == BenchmarkCompare::Impostor);
+    }
+
+    bool VulkanEngine::isRayMarchUsed() const {
+        return config.farField == FarFieldMode::RayMarch &&
+               (config.farFieldSplit > 0.0f || config.benchmarkCompare == BenchmarkCompare::RayMarch);
+    }
+
+    float VulkanEngine::currentFarFieldSplit() const {
+        if (config.benchmarkCompare == BenchmarkCompare::Impostor && !benchmarkSplits.empty()) {
+            return benchmarkSplits[benchmarkSplitIndex];
+        }
+        // Ray march comparison: phase B rasterizes the far ring as well
+        if (config.benchmarkCompare == BenchmarkCompare::RayMarch && benchmarkPhaseB) return 0.0f;
+        return config.farFieldSplit;
+    }
+
+    void VulkanEngine::createImpostorTargets() {
+        if (!isImpostorUsed()) return;
+        spdlog::debug("Creating far-field impostor targets...");
+        const uint32_t size = config.impostorResolution;
+        constexpr VkFormat impostorFormat = VK_FORMAT_R16G16B16A16_SFLOAT; // Float alpha holds the distance
+
+        VkImageCreateInfo imageInfo{};
+        imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        imageInfo.flags = VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT;
+        imageInfo.imageType = VK_IMAGE_TYPE_2D;
+        imageInfo.extent = {size, size, 1};
+        imageInfo.mipLevels = 1;
+        imageInfo.arrayLayers = 6;
+        imageInfo.format = impostorFormat;
+        imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+        imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        imageInfo.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+        imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+        imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        createImage({MemoryCategory::Props, "impostor faces"},
+                    imageInfo, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, impostorImage, impostorImageMemory);
+        impostorCubeView = createImageView(impostorImage, impostorFormat, VK_IMAGE_ASPECT_COLOR_BIT,
+                                           VK_IMAGE_VIEW_TYPE_CUBE, 0, 6);
+        for (uint32_t face = 0; face < 6; ++face) {
+            impostorFaceViews[face] = createImageView(impostorImage, impostorFormat, VK_IMAGE_ASPECT_COLOR_BIT,
+                                                      VK_IMAGE_VIEW_TYPE_2D, face, 1);
+        }
+
+        // One depth buffer serves all faces; it never leaves the render pass
+        impostorDepthFormat = findDepthFormat(false);
+        createImage({MemoryCategory::Props, "impostor depth"}, size, size, impostorDepthFormat,
+                    VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT,
+                    VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, impostorDepthImage, impostorDepthImageMemory);
+        impostorDepthImageView = createImageView(impostorDepthImage, impostorDepthFormat, VK_IMAGE_ASPECT_DEPTH_BIT);
+
+        // One face per render pass: color is cleared to the sky (alpha 0) and kept for sampling
+        VkAttachmentDescription attachments[2]{};
+        attachments[0].format = impostorFormat;
+        attachments[0].samples = VK_SAMPLE_COUNT_1_BIT;
+        attachments[0].loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+        attachments[0].storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+        attachments[0].stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+        attachments[0].stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+        attachments[0].initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        attachments[0].finalLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        attachments[1].format = impostorDepthFormat;
+        attachments[1].samples = VK_SAMPLE_COUNT_1_BIT;
+        attachments[1].loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+        attachments[1].storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+        attachments[1].stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+        attachments[1].stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+        attachments[1].initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        attachments[1].finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+
+        VkAttachmentReference colorAttachmentRef{0, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL};
+        VkAttachmentReference depthAttachmentRef{1, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL};
+        VkSubpassDescription subpass{};
+        subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+        subpass.colorAttachmentCount = 1;
+        subpass.pColorAttachments = &colorAttachmentRef;
+        subpass.pDepthStencilAttachment = &depthAttachmentRef;
+
+        // The previous frame's composite may still be sampling the face, and consecutive faces share
+        // the depth buffer. Afterwards the scene pass samples the faces in its fragment shader.
+        constexpr VkPipelineStageFlags depthStages = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT |
+                                                     VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+        VkSubpassDependency dependencies[2]{};
+        dependencies[0].srcSubpass = VK_SUBPASS_EXTERNAL;
+        dependencies[0].dstSubpass = 0;
+        dependencies[0].srcStageMask = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | depthStages;
+        dependencies[0].srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+        dependencies[0].dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | depthStages;
+        dependencies[0].dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT |
+                                        VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT |
+                                        VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+        dependencies[1].srcSubpass = 0;
+        dependencies[1].dstSubpass = VK_SUBPASS_EXTERNAL;
+        dependencies[1].srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+        dependencies[1].srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+        dependencies[1].dstStageMask = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+        dependencies[1].dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+        VkRenderPassCreateInfo renderPassInfo{};
+        renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+        renderPassInfo.attachmentCount = 2;
+        renderPassInfo.pAttachments = attachments;
+        renderPassInfo.subpassCount = 1;
+        renderPassInfo.pSubpasses = &subpass;
+        renderPassInfo.dependencyCount = 2;
+        renderPassInfo.pDependencies = dependencies;
+        VK_CHECK(vkCreateRenderPass(device, &renderPassInfo, nullptr, &impostorRenderPass),
+                 "Failed to create impostor render pass");
+
+        for (uint32_t face = 0; face < 6; ++face) {
+            VkImageView faceAttachments[] = {impostorFaceViews[face], impostorDepthImageView};
+            VkFramebufferCreateInfo framebufferInfo{};
+            framebufferInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+            framebufferInfo.renderPass = impostorRenderPass;
+            framebufferInfo.attachmentCount = 2;
+            framebufferInfo.pAttachments = faceAttachments;
+            framebufferInfo.width = size;
+            framebufferInfo.height = size;
+            framebufferInfo.layers = 1;
+            VK_CHECK(vkCreateFramebuffer(device, &framebufferInfo, nullptr, &impostorFramebuffers[face]),
+                     "Failed to create impostor framebuffer");
+        }
+
+        VkSamplerCreateInfo samplerInfo{};
+        samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+        samplerInfo.magFilter = VK_FILTER_LINEAR;
+        samplerInfo.minFilter = VK_FILTER_LINEAR;
+        samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+        samplerInfo.maxLod = 0.0f;
+        VK_CHECK(vkCreateSampler(device, &samplerInfo, nullptr, &impostorSampler),
+                 "Failed to create impostor sampler");
+
+        VkDescriptorSetLayoutBinding binding{};
+        binding.binding = 0;
+        binding.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        binding.descriptorCount = 1;
+        binding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+        VkDescriptorSetLayoutCreateInfo layoutInfo{};
+        layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        layoutInfo.bindingCount = 1;
+        layoutInfo.pBindings = &binding;
+        VK_CHECK(vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &impostorDescriptorSetLayout),
+                 "Failed to create impostor descriptor set layout");
+
+        VkDescriptorPoolSize poolSize{VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1};
+        VkDescriptorPoolCreateInfo poolInfo{};
+        poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        poolInfo.poolSizeCount = 1;
+        poolInfo.pPoolSizes = &poolSize;
+        poolInfo.maxSets = 1;
+        VK_CHECK(vkCreateDescriptorPool(device, &poolInfo, nullptr, &impostorDescriptorPool),
+                 "Failed to create impostor descriptor pool");
+
+        VkDescriptorSetAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocInfo.descriptorPool = impostorDescriptorPool;
+        allocInfo.descriptorSetCount = 1;
+        allocInfo.pSetLayouts = &impostorDescriptorSetLayout;
+        VK_CHECK(vkAllocateDescriptorSets(device, &allocInfo, &impostorDescriptorSet),
+                 "Failed to allocate impostor descriptor set");
+
+        const VkDescriptorImageInfo cubeInfo = {
+            impostorSampler, impostorCubeView, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
+        };
+        VkWriteDescriptorSet write{};
+        write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write.dstSet = impostorDescriptorSet;
+        write.dstBinding = 0;
+        write.descriptorCount = 1;
+        write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        write.pImageInfo = &cubeInfo;
+        vkUpdateDescriptorSets(device, 1, &write, 0, nullptr);
+
+        const double megabytes = static_cast<double>(size) * size * 6 * formatBytesPerPixel(impostorFormat) /
+                                 (1024.0 * 1024.0);
+        spdlog::info("Far-field impostor created (6 x {}x{}, {:.1f} MB).", size, size, megabytes);
+    }
+
+    void VulkanEngine::cleanupImpostorTargets() {
+        if (impostorDescriptorPool != VK_NULL_HANDLE) vkDestroyDescriptorPool(device, impostorDescriptorPool, nullptr);
+        impostorDescriptorPool = VK_NULL_HANDLE; // Set is freed with the pool
+        impostorDescriptorSet = VK_NULL_HANDLE;
+        if (impostorDescriptorSetLayout != VK_NULL_HANDLE)
+            vkDestroyDescriptorSetLayout(device, impostorDescriptorSetLayout, nullptr);
+        impostorDescriptorSetLayout = VK_NULL_HANDLE;
+        if (impostorSampler != VK_NULL_HANDLE) vkDestroySampler(device, impostorSampler, nullptr);
+        impostorSampler = VK_NULL_HANDLE;
+        for (VkFramebuffer &framebuffer: impostorFramebuffers) {
+            if (framebuffer != VK_NULL_HANDLE) vkDestroyFramebuffer(device, framebuffer, nullptr);
+            framebuffer = VK_NULL_HANDLE;
+        }
+        if (impostorRenderPass != VK_NULL_HANDLE) vkDestroyRenderPass(device, impostorRenderPass, nullptr);
+        impostorRenderPass = VK_NULL_HANDLE;
+        if (impostorDepthImageView != VK_NULL_HANDLE) vkDestroyImageView(device, impostorDepthImageView, nullptr);
+        impostorDepthImageView = VK_NULL_HANDLE;
+        if (impostorDepthImage != VK_NULL_HANDLE) vkDestroyImage(device, impostorDepthImage, nullptr);
+        impostorDepthImage = VK_NULL_HANDLE;
+        if (impostorDepthImageMemory != VK_NULL_HANDLE) freeMemory(impostorDepthImageMemory);
+        impostorDepthImageMemory = VK_NULL_HANDLE;
+        for (VkImageView &view: impostorFaceViews) {
+            if (view != VK_NULL_HANDLE) vkDestroyImageView(device, view, nullptr);
+            view = VK_NULL_HANDLE;
+        }
+        if (impostorCubeView != VK_NULL_HANDLE) vkDestroyImageView(device, impostorCubeView, nullptr);
+        impostorCubeView = VK_NULL_HANDLE;
+        if (impostorImage != VK_NULL_HANDLE) vkDestroyImage(device, impostorImage, nullptr);
+        impostorImage = VK_NULL_HANDLE;
+        if (impostorImageMemory != VK_NULL_HANDLE) freeMemory(impostorImageMemory);
+        impostorImageMemory = VK_NULL_HANDLE;
+    }
+
+    void VulkanEngine::createTerrainPipelines() {
+        spdlog::debug("Creating terrain pipelines...");
+        const bool impostor = isImpostorUsed();
+        const bool rayMarch = isRayMarchUsed();
+
+        VkPushConstantRange pushConstantRange{};
+        pushConstantRange.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+        pushConstantRange.offset = 0;
+        pushConstantRange.size = sizeof(TerrainPushConstants);
+        // Set 1 is the per-frame UBO, whose per-view matrices the vertex shader reads under multiview
+        const VkDescriptorSetLayout terrainSetLayouts[2] = {terrainDescriptorSetLayout, descriptorSetLayout};
+        VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+        pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        pipelineLayoutInfo.setLayoutCount = 2;
+        pipelineLayoutInfo.pSetLayouts = terrainSetLayouts;
+        pipelineLayoutInfo.pushConstantRangeCount = 1;
+        pipelineLayoutInfo.pPushConstantRanges = &pushConstantRange;
+        VK_CHECK(vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &terrainPipelineLayout),
+                 "Failed to create terrain pipeline layout");
+
+        // CLIP_RING (constant_id 0) adds the distance-ring discard for the near and impostor passes,
+        // PARALLAX (constant_id 1) the detail relief; impostor faces are too far away to need it.
+        // MULTIVIEW (constant_id 2) takes the matrix of gl_ViewIndex from the UBO.
+        VkBool32 specializationData[3] = {
+            VK_FALSE, config.parallaxRadius > 0.0f ? VK_TRUE : VK_FALSE, isMultiviewUsed() ? VK_TRUE : VK_FALSE
+        };
+        const VkSpecializationMapEntry specializationEntries[3] = {
+            {0, 0, sizeof(VkBool32)}, {1, sizeof(VkBool32), sizeof(VkBool32)},
+            {2, 2 * sizeof(VkBool32), sizeof(VkBool32)}
+        };
+        VkSpecializationInfo specializationInfo{};
+        specializationInfo.mapEntryCount = 3;
+        specializationInfo.pMapEntries = specializationEntries;
+        specializationInfo.dataSize = sizeof(specializationData);
+        specializationInfo.pData = specializationData;
+
+        VkShaderModule vertShaderModule = createShaderModule(readFile("shaders/terrain_vert.spv"));
+        VkShaderModule fragShaderModule = createShaderModule(readFile("shaders/terrain_frag.spv"));
+        VkPipelineShaderStageCreateInfo shaderStages[2]{};
+        shaderStages[0].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        shaderStages[0].stage = VK_SHADER_STAGE_VERTEX_BIT;
+        shaderStages[0].module = vertShaderModule;
+        shaderStages[0].pName = "main";
+        shaderStages[0].pSpecializationInfo = &specializationInfo;
+        shaderStages[1].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        shaderStages[1].stage = VK_SHADER_STAGE_FRAGMENT_BIT;
+        shaderStages[1].module = fragShaderModule;
+        shaderStages[1].pName = "main";
+        shaderStages[1].pSpecializationInfo = &specializationInfo;
+
+        auto bindingDescription = VkProjectOne::TerrainVertex::getBindingDescription();
+        auto attributeDescriptions = VkProjectOne::TerrainVertex::getAttributeDescriptions();
+        VkPipelineVertexInputStateCreateInfo vertexInputInfo{};
+        vertexInputInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+        vertexInputInfo.vertexBindingDescriptionCount = 1;
+        vertexInputInfo.pVertexBindingDescriptions = &bindingDescription;
+        vertexInputInfo.vertexAttributeDescriptionCount = static_cast<uint32_t>(attributeDescriptions.size());
+        vertexInputInfo.pVertexAttributeDescriptions = attributeDescriptions.data();
+
+        VkPipelineInputAssemblyStateCreateInfo inputAssembly{};
+        inputAssembly.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+        inputAssembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+
+        VkPipelineViewportStateCreateInfo viewportState{};
+        viewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+        viewportState.viewportCount = 1;
+        viewportState.scissorCount = 1;
+
+        const VkDynamicState dynamicStates[] = {VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR};
+        VkPipelineDynamicStateCreateInfo dynamicState{};
+        dynamicState.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+        dynamicState.dynamicStateCount = 2;
+        dynamicState.pDynamicStates = dynamicStates;
+
+        VkPipelineRasterizationStateCreateInfo rasterizer{};
+        rasterizer.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+        rasterizer.polygonMode = VK_POLYGON_MODE_FILL;
+        rasterizer.lineWidth = 1.0f;
+        rasterizer.cullMode = VK_CULL_MODE_BACK_BIT;
+        rasterizer.frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE; // Same Y-flipped projection as the cube
+
+        VkPipelineMultisampleStateCreateInfo multisampling{};
+        multisampling.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+        multisampling.rasterizationSamples = msaaSamples;
+
+        VkPipelineDepthStencilStateCreateInfo depthStencil{};
+        depthStencil.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+        depthStencil.depthTestEnable = VK_TRUE;
+        depthStencil.depthWriteEnable = VK_TRUE;
+        depthStencil.depthCompareOp = VK_COMPARE_OP_LESS;
+
+        VkPipelineColorBlendAttachmentState colorBlendAttachment{};
+        colorBlendAttachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT |
+                                              VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+        VkPipelineColorBlendStateCreateInfo colorBlending{};
+        colorBlending.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+        colorBlending.attachmentCount = 1;
+        colorBlending.pAttachments = &colorBlendAttachment;
+
+        VkGraphicsPipelineCreateInfo pipelineInfo{};
+        pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+        pipelineInfo.stageCount = 2;
+        pipelineInfo.pStages = shaderStages;
+        pipelineInfo.pVertexInputState = &vertexInputInfo;
+        pipelineInfo.pInputAssemblyState = &inputAssembly;
+        pipelineInfo.pViewportState = &viewportState;
+        pipelineInfo.pRasterizationState = &rasterizer;
+        pipelineInfo.pMultisampleState = &multisampling;
+        pipelineInfo.pDepthStencilState = &depthStencil;
+        pipelineInfo.pColorBlendState = &colorBlending;
+        pipelineInfo.pDynamicState = &dynamicState;
+        pipelineInfo.layout = terrainPipelineLayout;
+        pipelineInfo.renderPass = renderPass;
+        pipelineInfo.subpass = 0;
+        auto createPipeline = [this, &pipelineInfo](VkPipeline &pipeline) {
+            return vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &pipeline);
+        };
+
+        VkResult result = createPipeline(terrainPipeline);
+        if (result == VK_SUCCESS && (impostor || rayMarch)) {
+            specializationData[0] = VK_TRUE;
+            result = createPipeline(terrainNearPipeline);
+        }
+        if (result == VK_SUCCESS && impostor) {
+            // Cube faces are single-sampled and projected without the Y flip, which mirrors the winding
+            pipelineInfo.renderPass = impostorRenderPass;
+            multisampling.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+            rasterizer.frontFace = VK_FRONT_FACE_CLOCKWISE;
+            specializationData[1] = VK_FALSE;
+            specializationData[2] = VK_FALSE;
+            result = createPipeline(impostorTerrainPipeline);
+        }
+        vkDestroyShaderModule(device, fragShaderModule, nullptr);
+        vkDestroyShaderModule(device, vertShaderModule, nullptr);
+        VK_CHECK(result, "Failed to create terrain pipeline");
+        if (!impostor && !rayMarch) {
+            spdlog::info("Terrain pipeline created.");
+            return;
+        }
+
+        // Far-field composites: full-screen triangle in the scene pass, depth written per pixel
+        VkPipelineVertexInputStateCreateInfo emptyVertexInput{};
+        emptyVertexInput.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+        pipelineInfo.pVertexInputState = &emptyVertexInput;
+        pipelineInfo.renderPass = renderPass;
+        multisampling.rasterizationSamples = msaaSamples;
+        rasterizer.cullMode = VK_CULL_MODE_NONE;
+        shaderStages[0].pSpecializationInfo = nullptr;
+        shaderStages[1].pSpecializationInfo = nullptr;
+        pipelineLayoutInfo.setLayoutCount = 1;
+        vertShaderModule = createShaderModule(readFile("shaders/impostor_vert.spv"));
+        shaderStages[0].module = vertShaderModule;
+
+        auto createComposite = [&](const char *fragmentPath, VkDescriptorSetLayout setLayout, uint32_t pushSize,
+                                   VkPipelineLayout &layout, VkPipeline &pipeline) {
+            pushConstantRange.size = pushSize;
+            pipelineLayoutInfo.pSetLayouts = &setLayout;
+            VkResult layoutResult = vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &layout);
+            if (layoutResult != VK_SUCCESS) return layoutResult;
+            VkShaderModule compositeFragModule = createShaderModule(readFile(fragmentPath));
+            shaderStages[1].module = compositeFragModule;
+            pipelineInfo.layout = layout;
+            VkResult pipelineResult = createPipeline(pipeline);
+            vkDestroyShaderModule(device, compositeFragModule, nullptr);
+            return pipelineResult;
+        };
+        result = VK_SUCCESS;
+        if (impostor) {
+            result = createComposite("shaders/impostor_frag.spv", impostorDescriptorSetLayout,
+                                     sizeof(ImpostorPushConstants), impostorCompositePipelineLayout,
+                                     impostorCompositePipeline);
+        }
+        if (result == VK_SUCCESS && rayMarch) {
+            result = createComposite("shaders/raymarch_frag.spv", rayMarchDescriptorSetLayout,
+                                     sizeof(RayMarchPushConstants), rayMarchPipelineLayout, rayMarchPipeline);
+        }
+        vkDestroyShaderModule(device, vertShaderModule, nullptr);
+        VK_CHECK(result, "Failed to create far-field composite pipeline");
+        spdlog::info("Terrain pipelines created (with {} far field).", impostor ? "impostor" : "ray-marched");
+    }
+
+    void VulkanEngine::cleanupTerrainPipelines() {
+        for (VkPipeline *pipeline: {
+                 &terrainPipeline, &terrainNearPipeline, &impostorTerrainPipeline, &impostorCompositePipeline,
+                 &rayMarchPipeline
+             }) {
+            if (*pipeline != VK_NULL_HANDLE) vkDestroyPipeline(device, *pipeline, nullptr);
+            *pipeline = VK_NULL_HANDLE;
+        }
+        if (terrainPipelineLayout != VK_NULL_HANDLE) vkDestroyPipelineLayout(device, terrainPipelineLayout, nullptr);
+        terrainPipelineLayout = VK_NULL_HANDLE;
+        if (impostorCompositePipelineLayout != VK_NULL_HANDLE)
+            vkDestroyPipelineLayout(device, impostorCompositePipelineLayout, nullptr);
+        impostorCompositePipelineLayout = VK_NULL_HANDLE;
+        if (rayMarchPipelineLayout != VK_NULL_HANDLE) vkDestroyPipelineLayout(device, rayMarchPipelineLayout, nullptr);
+        rayMarchPipelineLayout = VK_NULL_HANDLE;
+    }
+
+    uint64_t VulkanEngine::cullTerrainChunks(const Frustum *frusta, uint32_t frustumCount, const glm::vec3 &origin,
+                                             float minDistance, float maxDistance) {
+        terrainDrawRuns.clear();
+        uint64_t indicesDrawn = 0;
+        uint32_t runFirst = 0;
+        uint32_t runCount = 0;
+        auto flush = [&]() {
+            if (runCount == 0) return;
+            terrainDrawRuns.push_back({runFirst, runCount, 0});
+            indicesDrawn += runCount;
+            runCount = 0;
+        };
+        auto inAnyFrustum = [&](const VkProjectOne::TerrainChunk &chunk) {
+            for (uint32_t i = 0; i < frustumCount; ++i) {
+                if (frusta[i].intersects(chunk.boundsMin, chunk.boundsMax)) return true;
+            }
+            return false;
+        };
+
+        const bool streaming = !terrainChunkSlots.empty();
+        for (uint32_t i = 0; i < terrainChunks.size(); ++i) {
+            const VkProjectOne::TerrainChunk &chunk = terrainChunks[i];
+            if (streaming && terrainChunkSlots[i] == ChunkPool::INVALID_SLOT) continue;
+            // Nearest point of the box and its farthest corner, seen from the origin
+            const glm::vec3 nearest = glm::clamp(origin, chunk.boundsMin, chunk.boundsMax);
+            const glm::vec3 farthest = glm::max(glm::abs(origin - chunk.boundsMin), glm::abs(origin - chunk.boundsMax));
+            const bool visible = glm::distance(origin, nearest) < maxDistance && glm::length(farthest) >= minDistance &&
+                                 inAnyFrustum(chunk);
+            if (!visible) {
+                flush();
+                continue;
+            }
+            // Streamed chunks sit in pool slots with indices local to the slot
+            if (streaming) {
+                const uint32_t slot = terrainChunkSlots[i];
+                terrainDrawRuns.push_back({terrainChunkPool.firstIndex(slot), chunk.indexCount,
+                                           static_cast<int32_t>(terrainChunkPool.vertexOffset(slot))});
+                indicesDrawn += chunk.indexCount;
+                continue;
+            }
+            // Chunks are stored back to back, so neighbours in a row merge into one draw
+            if (runCount > 0 && runFirst + runCount != chunk.firstIndex) flush();
+            if (runCount == 0) runFirst = chunk.firstIndex;
+            runCount += chunk.indexCount;
+        }
+        flush();
+        return indicesDrawn;
+    }
+
+    void VulkanEngine::recordTerrainDraws(VkCommandBuffer commandBuffer) const {
+        const VkDeviceSize offset = 0;
+        vkCmdBindVertexBuffers(commandBuffer, 0, 1, &terrainVertexBuffer, &offset);
+        vkCmdBindIndexBuffer(commandBuffer, terrainIndexBuffer, 0, VK_INDEX_TYPE_UINT32);
+        for (const TerrainDrawRun &run: terrainDrawRuns) {
+            vkCmdDrawIndexed(commandBuffer, run.indexCount, 1, run.firstIndex, run.vertexOffset, 0);
+        }
+    }
+
+    void VulkanEngine::recordTerrainStreaming(VkCommandBuffer commandBuffer) {
+        // Velocity from the last frame; the look-ahead position is where the camera will be in a second
+        const auto now = std::chrono::steady_clock::now();
+        const float seconds = std::chrono::duration<float>(now - streamingUpdateTime).count();
+        if (seconds > 0.0f && frameCount > 0) {
+            streamingCameraVelocity = (cameraPosition - streamingCameraPosition) / seconds;
+        }
+        streamingCameraPosition = cameraPosition;
+        streamingUpdateTime = now;
+        const glm::vec3 predicted = cameraPosition + streamingCameraVelocity * STREAM_LOOKAHEAD_SECONDS;
+        const bool moved = recordTerrainPoolDefrag(commandBuffer);
+
+        Frustum viewFrusta[MAX_VIEWS];
+        for (uint32_t view = 0; view < viewCount; ++view) viewFrusta[view] = Frustum(views[view].viewProj);
+        const float pixelsPerUnit = static_cast<float>(renderExtent.height) /
+                                    (2.0f * std::tan(glm::radians(CAMERA_FOV_Y) * 0.5f));
+        const float radius = config.streamRadius;
+        for (uint32_t i = 0; i < terrainChunks.size(); ++i) {
+            const VkProjectOne::TerrainChunk &chunk = terrainChunks[i];
+            const float current = glm::distance(cameraPosition,
+                                                glm::clamp(cameraPosition, chunk.boundsMin, chunk.boundsMax));
+            const float ahead = glm::distance(predicted, glm::clamp(predicted, chunk.boundsMin, chunk.boundsMax));
+            const float distance = std::min(current, ahead);
+            if (terrainChunkSlots[i] != ChunkPool::INVALID_SLOT) {
+                if (distance > radius * STREAM_EVICT_MARGIN) evictTerrainChunk(i);
+                continue;
+            }
+            if (distance > radius) continue;
+            // Projected size of the chunk from the nearer position; visible chunks near the camera are critical
+            const float chunkRadius = 0.5f * glm::length(chunk.boundsMax - chunk.boundsMin);
+            bool visible = false;
+            for (uint32_t view = 0; view < viewCount; ++view) {
+                visible = visible || viewFrusta[view].intersects(chunk.boundsMin, chunk.boundsMax);
+            }
+            terrainStreamer.request(i, pixelsPerUnit * chunkRadius / std::max(distance, chunkRadius),
+                                    visible && current <= radius);
+        }
+        terrainStagingUsed = 0;
+        terrainStreamer.update();
+        if (terrainChunkUploads.empty() && !moved) return;
+
+        for (const TerrainChunkUpload &upload: terrainChunkUploads) {
+            const uint32_t slot = terrainChunkSlots[upload.chunk];
+            const VkBufferCopy vertexCopy{
+                upload.stagingOffset, terrainChunkPool.vertexOffset(slot) * sizeof(VkProjectOne::TerrainVertex),
+                upload.vertexBytes
+            };
+            const VkBufferCopy indexCopy{
+                upload.stagingOffset + upload.vertexBytes, terrainChunkPool.firstIndex(slot) * sizeof(uint32_t),
+                upload.indexBytes
+            };
+            vkCmdCopyBuffer(commandBuffer, terrainStagingBuffer, terrainVertexBuffer, 1, &vertexCopy);
+            vkCmdCopyBuffer(commandBuffer, terrainStagingBuffer, terrainIndexBuffer, 1, &indexCopy);
+        }
+        terrainChunkUploads.clear();
+        VkMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT;
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, 0, 1,
+                             &barrier, 0, nullptr, 0, nullptr);
+    }
+
+    void VulkanEngine::uploadTerrainChunk(uint32_t chunk, const std::vector<uint8_t> &data) {
+        const uint32_t slot = terrainChunkPool.allocate(chunk);
+        if (slot == ChunkPool::INVALID_SLOT) {
+            // Evicted slots are reused once the frames drawing them have completed
+            auto distance = [this](uint32_t i) {
+                const VkProjectOne::TerrainChunk &other = terrainChunks[i];
+                return glm::distance(cameraPosition, glm::clamp(cameraPosition, other.boundsMin, other.boundsMax));
+            };
+            uint32_t farthest = chunk;
+            for (uint32_t i = 0; i < terrainChunks.size(); ++i) {
+                if (terrainChunkSlots[i] != ChunkPool::INVALID_SLOT && distance(i) > distance(farthest)) farthest = i;
+            }
+            if (farthest != chunk) evictTerrainChunk(farthest);
+            droppedTerrainUploads++;
+            return;
+        }
+        terrainChunkSlots[chunk] = slot;
+        residentTerrainChunks++;
+
+        TerrainChunkUpload upload;
+        upload.chunk = chunk;
+        upload.vertexBytes = terrainChunkPayloads[chunk].vertexCount * sizeof(VkProjectOne::TerrainVertex);
+        upload.indexBytes = data.size() - upload.vertexBytes;
+
+        // Next in the current frame's region of the staging ring, read by this frame's copies
+        if (terrainStagingUsed + data.size() > terrainStagingRegionBytes) {
+            throw std::runtime_error("Terrain chunk uploads exceed the staging ring region");
+        }
+        upload.stagingOffset = currentFrame * terrainStagingRegionBytes + terrainStagingUsed;
+        std::memcpy(static_cast<uint8_t *>(terrainStagingMapped) + upload.stagingOffset, data.data(), data.size());
+        terrainStagingUsed += data.size();
+        terrainChunkUploads.push_back(upload);
     }
 
-    void VulkanEngine::createGraphicsPipeline() {
-        spdlog::debug("Creating graphics pipeline...");
-        // Load shader code
-        auto vertShaderCode = readFile("shaders/vert.spv");
-        auto fragShaderCode = readFile("shaders/frag.spv");
+    bool VulkanEngine::recordTerrainPoolDefrag(VkCommandBuffer commandBuffer) {
+        if (config.defragBytesPerFrame == 0) return false;
+        const VkDeviceSize slotBytes = terrainChunkPool.getSlotVertices() * sizeof(VkProjectOne::TerrainVertex) +
+                                       terrainChunkPool.getSlotIndices() * sizeof(uint32_t);
+        VkDeviceSize movedBytes = 0;
+        ChunkPool::Move move{};
+        // At least one move per frame, so a budget below one chunk still makes progress
+        while ((movedBytes == 0 || movedBytes + slotBytes <= config.defragBytesPerFrame) &&
+               terrainChunkPool.planMove(move)) {
+            if (movedBytes == 0) {
+                // The chunk may have been uploaded by the previous frame's copies
+                VkMemoryBarrier barrier{};
+                barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+                barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+                barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+                vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0,
+                                     1, &barrier, 0, nullptr, 0, nullptr);
+            }
+            // Source and destination slots never overlap, so one buffer can be both
+            const VkDeviceSize vertexBytes = terrainChunkPayloads[move.owner].vertexCount *
+                                             sizeof(VkProjectOne::TerrainVertex);
+            const VkDeviceSize indexBytes = terrainChunks[move.owner].indexCount * sizeof(uint32_t);
+            const VkBufferCopy vertexCopy{
+                terrainChunkPool.vertexOffset(move.from) * sizeof(VkProjectOne::TerrainVertex),
+                terrainChunkPool.vertexOffset(move.to) * sizeof(VkProjectOne::TerrainVertex), vertexBytes
+            };
+            const VkBufferCopy indexCopy{
+                terrainChunkPool.firstIndex(move.from) * sizeof(uint32_t),
+                terrainChunkPool.firstIndex(move.to) * sizeof(uint32_t), indexBytes
+            };
+            vkCmdCopyBuffer(commandBuffer, terrainVertexBuffer, terrainVertexBuffer, 1, &vertexCopy);
+            vkCmdCopyBuffer(commandBuffer, terrainIndexBuffer, terrainIndexBuffer, 1, &indexCopy);
+            terrainChunkSlots[move.owner] = move.to;
+            terrainChunkPool.release(move.from, frameCount);
+            movedBytes += vertexBytes + indexBytes;
+        }
+        defragMovedBytes += movedBytes;
+        return movedBytes > 0;
+    }
 
-        // Create shader modules
-        VkShaderModule vertShaderModule = createShaderModule(vertShaderCode);
-        VkShaderModule fragShaderModule = createShaderModule(fragShaderCode);
+    void VulkanEngine::evictTerrainChunk(uint32_t chunk) {
+        terrainChunkPool.release(terrainChunkSlots[chunk], frameCount);
+        terrainChunkSlots[chunk] = ChunkPool::INVALID_SLOT;
+        residentTerrainChunks--;
+    }
 
-        // Define shader stages
-        VkPipelineShaderStageCreateInfo vertShaderStageInfo{};
-        vertShaderStageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
-        vertShaderStageInfo.stage = VK_SHADER_STAGE_VERTEX_BIT;
-        vertShaderStageInfo.module = vertShaderModule;
-        vertShaderStageInfo.pName = "main"; // Entry point function name
+    void VulkanEngine::recordImpostorFace(VkCommandBuffer commandBuffer, uint32_t face) {
+        if (face == 0) {
+            impostorCenter = cameraPosition;
+            impostorRenderedSplit = currentFarFieldSplit();
+            impostorRefreshFrame = frameCount;
+        }
+        const float split = impostorRenderedSplit;
+        // The far field starts inside the split: near terrain is clipped around the camera, which may
+        // drift up to the move threshold from the center before the next refresh.
+        const float ringStart = std::max(split - config.impostorMoveThreshold, 0.0f);
+
+        // Vulkan cube face order; with these up vectors and no Y flip, image rows match the face layout
+        static const glm::vec3 faceDirections[6] = {
+            {1.0f, 0.0f, 0.0f}, {-1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f},
+            {0.0f, -1.0f, 0.0f}, {0.0f, 0.0f, 1.0f}, {0.0f, 0.0f, -1.0f}
+        };
+        static const glm::vec3 faceUps[6] = {
+            {0.0f, -1.0f, 0.0f}, {0.0f, -1.0f, 0.0f}, {0.0f, 0.0f, 1.0f},
+            {0.0f, 0.0f, -1.0f}, {0.0f, -1.0f, 0.0f}, {0.0f, -1.0f, 0.0f}
+        };
+        const glm::mat4 faceProj = glm::perspective(glm::radians(90.0f), 1.0f, CAMERA_NEAR, CAMERA_FAR);
+
+        const VkExtent2D faceExtent = {config.impostorResolution, config.impostorResolution};
+        VkClearValue clearValues[2]{};
+        clearValues[0].color = {{0.1f, 0.1f, 0.1f, 0.0f}}; // Scene clear color; alpha 0 marks sky
+        clearValues[1].depthStencil = {1.0f, 0};
+        const VkViewport viewport{
+            0.0f, 0.0f, static_cast<float>(faceExtent.width), static_cast<float>(faceExtent.height), 0.0f, 1.0f
+        };
+        const VkRect2D scissor{{0, 0}, faceExtent};
+        const VkDescriptorSet terrainSets[2] = {terrainDescriptorSet, descriptorSets[currentFrame]};
 
-        VkPipelineShaderStageCreateInfo fragShaderStageInfo{};
-        fragShaderStageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
-        fragShaderStageInfo.stage = VK_SHADER_STAGE_FRAGMENT_BIT;
-        fragShaderStageInfo.module = fragShaderModule;
-        fragShaderStageInfo.pName = "main";
+        VkRenderPassBeginInfo renderPassInfo{};
+        renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+        renderPassInfo.renderPass = impostorRenderPass;
+        renderPassInfo.framebuffer = impostorFramebuffers[face];
+        renderPassInfo.renderArea.extent = faceExtent;
+        renderPassInfo.clearValueCount = 2;
+        renderPassInfo.pClearValues = clearValues;
+        vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
 
-        VkPipelineShaderStageCreateInfo shaderStages[] = {vertShaderStageInfo, fragShaderStageInfo};
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, impostorTerrainPipeline);
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, terrainPipelineLayout, 0, 2,
+                                terrainSets, 0, nullptr);
+        vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+        vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
 
-        // --- Fixed Function State ---
+        TerrainPushConstants constants{};
+        constants.viewProj = faceProj * glm::lookAt(impostorCenter, impostorCenter + faceDirections[face],
+                                                    faceUps[face]);
+        constants.eye = glm::vec4(impostorCenter, TERRAIN_HEIGHT_SCALE);
+        constants.ring = glm::vec4(ringStart, CAMERA_FAR, 1.0f, 0.0f);
+        constants.detail = glm::vec4(0.0f, config.parallaxDepth, DETAIL_TILE_SIZE,
+                                     static_cast<float>(PARALLAX_MAX_STEPS));
+        vkCmdPushConstants(commandBuffer, terrainPipelineLayout,
+                           VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(constants),
+                           &constants);
+        const Frustum faceFrustum(constants.viewProj);
+        terrainStats.farIndices += cullTerrainChunks(&faceFrustum, 1, impostorCenter, ringStart, CAMERA_FAR);
+        recordTerrainDraws(commandBuffer);
+        vkCmdEndRenderPass(commandBuffer);
+        if (face == 5) terrainStats.refreshes++;
+    }
 
-        // Vertex Input
-        auto bindingDescription = Vertex::getBindingDescription();
-        auto attributeDescriptions = Vertex::getAttributeDescriptions();
+    void VulkanEngine::recordTerrain(VkCommandBuffer commandBuffer, float split, uint32_t view) {
+        const bool farField = split > 0.0f;
+        const float nearLimit = farField ? split : CAMERA_FAR;
+        const VkDescriptorSet terrainSets[2] = {terrainDescriptorSet, descriptorSets[currentFrame]};
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
+                          farField ? terrainNearPipeline : terrainPipeline);
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, terrainPipelineLayout, 0, 2,
+                                terrainSets, 0, nullptr);
+
+        // Under multiview the matrices come from the UBO and the shading eye is the shared camera
+        const View &current = views[view];
+        const glm::vec3 eye = isMultiviewUsed() ? cameraPosition : current.eye;
+        TerrainPushConstants constants{};
+        constants.viewProj = current.viewProj;
+        constants.eye = glm::vec4(eye, TERRAIN_HEIGHT_SCALE);
+        constants.ring = glm::vec4(0.0f, nearLimit, 0.0f, 0.0f);
+        constants.detail = glm::vec4(config.parallaxRadius, config.parallaxDepth, DETAIL_TILE_SIZE,
+                                     static_cast<float>(PARALLAX_MAX_STEPS));
+        vkCmdPushConstants(commandBuffer, terrainPipelineLayout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
+                           0, sizeof(constants), &constants);
+        recordTerrainDraws(commandBuffer);
+        if (!farField) return;
+
+        // Far field last, so the early depth test skips every pixel near geometry already covers.
+        // The full-screen triangle sits at the nearest view depth any far-field pixel can have: its
+        // distance along the pixel ray times the cosine of the frustum corner angle.
+        const float aspect = viewAspect();
+        const float tanHalfFov = std::tan(glm::radians(CAMERA_FOV_Y) * 0.5f);
+        const float cosCorner = 1.0f / std::sqrt(1.0f + tanHalfFov * tanHalfFov * (1.0f + aspect * aspect));
+        auto triangleDepth = [cosCorner](float minDistance) {
+            const float viewZ = std::clamp(minDistance * cosCorner, CAMERA_NEAR, CAMERA_FAR);
+            return CAMERA_FAR / (CAMERA_FAR - CAMERA_NEAR) * (1.0f - CAMERA_NEAR / viewZ);
+        };
+
+        if (config.farField == FarFieldMode::RayMarch) {
+            // Rays start exactly where the near pass stops
+            RayMarchPushConstants rayConstants{};
+            rayConstants.invViewProj = glm::inverse(current.viewProj);
+            rayConstants.eye = glm::vec4(current.eye, CAMERA_NEAR);
+            rayConstants.grid = glm::vec4(terrainBoundsMin.x, terrainBoundsMin.z, terrainCellSize, CAMERA_FAR);
+            rayConstants.forward = glm::vec4(current.forward, triangleDepth(split));
+            rayConstants.ray = glm::vec4(split, static_cast<float>(RAY_MARCH_MAX_STEPS),
+                                         static_cast<float>(heightBoundsLevels - 1), TERRAIN_HEIGHT_SCALE);
+            vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, rayMarchPipeline);
+            vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, rayMarchPipelineLayout, 0, 1,
+                                    &rayMarchDescriptorSet, 0, nullptr);
+            vkCmdPushConstants(commandBuffer, rayMarchPipelineLayout,
+                               VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(rayConstants),
+                               &rayConstants);
+            vkCmdDraw(commandBuffer, 3, 1, 0, 0);
+            return;
+        }
+
+        // Impostor pixels are at least split - 2 * move away: the ring starts one move threshold
+        // inside the split, and the camera may be up to one threshold away from the center
+        ImpostorPushConstants compositeConstants{};
+        compositeConstants.invViewProj = glm::inverse(current.viewProj);
+        compositeConstants.eye = glm::vec4(current.eye, CAMERA_NEAR);
+        compositeConstants.center = glm::vec4(impostorCenter, CAMERA_FAR);
+        compositeConstants.forward = glm::vec4(current.forward,
+                                               triangleDepth(split - 2.0f * config.impostorMoveThreshold));
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, impostorCompositePipeline);
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, impostorCompositePipelineLayout, 0, 1,
+                                &impostorDescriptorSet, 0, nullptr);
+        vkCmdPushConstants(commandBuffer, impostorCompositePipelineLayout,
+                           VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(compositeConstants),
+                           &compositeConstants);
+        vkCmdDraw(commandBuffer, 3, 1, 0, 0);
+    }
+
+    // --- GPU Particles ---
+
+    void VulkanEngine::createParticleSystem() {
+        if (config.particleCount == 0) return;
+        spdlog::debug("Creating particle system...");
+        const uint32_t capacity = config.particleCount;
+
+        const VkDeviceSize poolBytes = static_cast<VkDeviceSize>(capacity) * sizeof(ParticleData);
+        for (uint32_t i = 0; i < 2; ++i) {
+            createBuffer({MemoryCategory::Particles, "particle pool " + std::to_string(i)},
+                         poolBytes, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                         particlePools[i], particlePoolMemory[i], true);
+        }
+        createBuffer({MemoryCategory::Particles, "particle state"},
+                     sizeof(ParticleState), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT |
+                     VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                     VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, particleStateBuffer, particleStateBufferMemory, true);
+        const VkDeviceSize readbackBytes = MAX_FRAMES_IN_FLIGHT * 2 * sizeof(uint32_t);
+        createBuffer({MemoryCategory::Staging, "particle readback"}, readbackBytes, VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                     VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                     particleReadbackBuffer, particleReadbackBufferMemory, true);
+        void *mapped;
+        VK_CHECK(vkMapMemory(device, particleReadbackBufferMemory, 0, readbackBytes, 0, &mapped),
+                 "Failed to map particle readback buffer");
+        particleReadbackMapped = static_cast<uint32_t *>(mapped);
+        memset(particleReadbackMapped, 0, readbackBytes);
+
+        // Both pools start empty; the first simulate dispatch has no work groups
+        ParticleState initialState{};
+        initialState.simulateArgs = {0, 1, 1};
+        initialState.drawArgs = {6, 0, 0, 0};
+        VkCommandBuffer commandBuffer = beginSingleTimeCommands();
+        vkCmdUpdateBuffer(commandBuffer, particleStateBuffer, 0, sizeof(initialState), &initialState);
+        endSingleTimeCommands(commandBuffer);
+
+        // binding 0: source pool, 1: destination pool (also read by the billboards), 2: state, 3: heights
+        VkDescriptorSetLayoutBinding bindings[4]{};
+        for (uint32_t i = 0; i < 4; ++i) {
+            bindings[i].binding = i;
+            bindings[i].descriptorType = i < 3
+                                             ? VK_DESCRIPTOR_TYPE_STORAGE_BUFFER
+                                             : VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+            bindings[i].descriptorCount = 1;
+            bindings[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        }
+        bindings[1].stageFlags |= VK_SHADER_STAGE_VERTEX_BIT;
+        VkDescriptorSetLayoutCreateInfo layoutInfo{};
+        layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        layoutInfo.bindingCount = 4;
+        layoutInfo.pBindings = bindings;
+        VK_CHECK(vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &particleDescriptorSetLayout),
+                 "Failed to create particle descriptor set layout");
+
+        const VkDescriptorPoolSize poolSizes[2] = {
+            {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 6}, {VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 2}
+        };
+        VkDescriptorPoolCreateInfo poolInfo{};
+        poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        poolInfo.poolSizeCount = 2;
+        poolInfo.pPoolSizes = poolSizes;
+        poolInfo.maxSets = 2;
+        VK_CHECK(vkCreateDescriptorPool(device, &poolInfo, nullptr, &particleDescriptorPool),
+                 "Failed to create particle descriptor pool");
+
+        const VkDescriptorSetLayout setLayouts[2] = {particleDescriptorSetLayout, particleDescriptorSetLayout};
+        VkDescriptorSetAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocInfo.descriptorPool = particleDescriptorPool;
+        allocInfo.descriptorSetCount = 2;
+        allocInfo.pSetLayouts = setLayouts;
+        VK_CHECK(vkAllocateDescriptorSets(device, &allocInfo, particleDescriptorSets),
+                 "Failed to allocate particle descriptor sets");
+
+        // Set i reads pool i and writes the other one
+        const VkDescriptorImageInfo heightInfo{heightfieldSampler, heightImageView,
+                                               VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL};
+        const VkDescriptorBufferInfo stateInfo{particleStateBuffer, 0, VK_WHOLE_SIZE};
+        for (uint32_t i = 0; i < 2; ++i) {
+            const VkDescriptorBufferInfo poolInfos[2] = {
+                {particlePools[i], 0, VK_WHOLE_SIZE}, {particlePools[1 - i], 0, VK_WHOLE_SIZE}
+            };
+            VkWriteDescriptorSet writes[4]{};
+            for (uint32_t binding = 0; binding < 4; ++binding) {
+                writes[binding].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+                writes[binding].dstSet = particleDescriptorSets[i];
+                writes[binding].dstBinding = binding;
+                writes[binding].descriptorCount = 1;
+                writes[binding].descriptorType = bindings[binding].descriptorType;
+            }
+            writes[0].pBufferInfo = &poolInfos[0];
+            writes[1].pBufferInfo = &poolInfos[1];
+            writes[2].pBufferInfo = &stateInfo;
+            writes[3].pImageInfo = &heightInfo;
+            vkUpdateDescriptorSets(device, 4, writes, 0, nullptr);
+        }
+
+        VkPushConstantRange pushConstantRange{};
+        pushConstantRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        pushConstantRange.offset = 0;
+        pushConstantRange.size = sizeof(ParticlePushConstants);
+        VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+        pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        pipelineLayoutInfo.setLayoutCount = 1;
+        pipelineLayoutInfo.pSetLayouts = &particleDescriptorSetLayout;
+        pipelineLayoutInfo.pushConstantRangeCount = 1;
+        pipelineLayoutInfo.pPushConstantRanges = &pushConstantRange;
+        VK_CHECK(vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &particleComputePipelineLayout),
+                 "Failed to create particle pipeline layout");
+
+        // PASS (constant_id 0) selects simulate, emit or finalize; EFFECT (constant_id 1) the particle motion
+        VkShaderModule shaderModule = createShaderModule(readFile("shaders/particle.spv"));
+        auto createPass = [this, shaderModule](int32_t pass, VkPipeline &pipeline) {
+            const int32_t specializationData[2] = {pass, static_cast<int32_t>(config.particleEffect)};
+            const VkSpecializationMapEntry specializationEntries[2] = {
+                {0, 0, sizeof(int32_t)}, {1, sizeof(int32_t), sizeof(int32_t)}
+            };
+            VkSpecializationInfo specializationInfo{};
+            specializationInfo.mapEntryCount = 2;
+            specializationInfo.pMapEntries = specializationEntries;
+            specializationInfo.dataSize = sizeof(specializationData);
+            specializationInfo.pData = specializationData;
+
+            VkComputePipelineCreateInfo pipelineInfo{};
+            pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+            pipelineInfo.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+            pipelineInfo.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+            pipelineInfo.stage.module = shaderModule;
+            pipelineInfo.stage.pName = "main";
+            pipelineInfo.stage.pSpecializationInfo = &specializationInfo;
+            pipelineInfo.layout = particleComputePipelineLayout;
+            return vkCreateComputePipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &pipeline);
+        };
+        VkResult result = createPass(0, particleSimulatePipeline);
+        if (result == VK_SUCCESS) result = createPass(1, particleEmitPipeline);
+        if (result == VK_SUCCESS) result = createPass(2, particleFinalizePipeline);
+        vkDestroyShaderModule(device, shaderModule, nullptr);
+        VK_CHECK(result, "Failed to create particle compute pipeline");
+
+        spdlog::info("Particle system created ({} particles, {:.1f} MB of pools).", capacity,
+                     static_cast<double>(2 * poolBytes) / (1024.0 * 1024.0));
+    }
+
+    void VulkanEngine::cleanupParticleSystem() {
+        for (VkPipeline *pipeline: {&particleSimulatePipeline, &particleEmitPipeline, &particleFinalizePipeline}) {
+            if (*pipeline != VK_NULL_HANDLE) vkDestroyPipeline(device, *pipeline, nullptr);
+            *pipeline = VK_NULL_HANDLE;
+        }
+        if (particleComputePipelineLayout != VK_NULL_HANDLE)
+            vkDestroyPipelineLayout(device, particleComputePipelineLayout, nullptr);
+        particleComputePipelineLayout = VK_NULL_HANDLE;
+        if (particleDescriptorPool != VK_NULL_HANDLE) vkDestroyDescriptorPool(device, particleDescriptorPool, nullptr);
+        particleDescriptorPool = VK_NULL_HANDLE; // Sets are freed with the pool
+        particleDescriptorSets[0] = particleDescriptorSets[1] = VK_NULL_HANDLE;
+        if (particleDescriptorSetLayout != VK_NULL_HANDLE)
+            vkDestroyDescriptorSetLayout(device, particleDescriptorSetLayout, nullptr);
+        particleDescriptorSetLayout = VK_NULL_HANDLE;
+        for (uint32_t i = 0; i < 2; ++i) {
+            if (particlePools[i] != VK_NULL_HANDLE) vkDestroyBuffer(device, particlePools[i], nullptr);
+            particlePools[i] = VK_NULL_HANDLE;
+            if (particlePoolMemory[i] != VK_NULL_HANDLE) freeMemory(particlePoolMemory[i]);
+            particlePoolMemory[i] = VK_NULL_HANDLE;
+        }
+        if (particleStateBuffer != VK_NULL_HANDLE) vkDestroyBuffer(device, particleStateBuffer, nullptr);
+        particleStateBuffer = VK_NULL_HANDLE;
+        if (particleStateBufferMemory != VK_NULL_HANDLE) freeMemory(particleStateBufferMemory);
+        particleStateBufferMemory = VK_NULL_HANDLE;
+        if (particleReadbackBuffer != VK_NULL_HANDLE) vkDestroyBuffer(device, particleReadbackBuffer, nullptr);
+        particleReadbackBuffer = VK_NULL_HANDLE;
+        if (particleReadbackBufferMemory != VK_NULL_HANDLE)
+            freeMemory(particleReadbackBufferMemory); // Unmapped implicitly
+        particleReadbackBufferMemory = VK_NULL_HANDLE;
+        particleReadbackMapped = nullptr;
+    }
+
+    void VulkanEngine::createParticleDrawPipeline() {
+        if (config.particleCount == 0) return;
+
+        // Set 1 is the per-frame UBO with the view matrices
+        const VkDescriptorSetLayout setLayouts[2] = {particleDescriptorSetLayout, descriptorSetLayout};
+        VkPushConstantRange pushConstantRange{};
+        pushConstantRange.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+        pushConstantRange.offset = 0;
+        pushConstantRange.size = sizeof(ParticleDrawPushConstants);
+        VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+        pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        pipelineLayoutInfo.setLayoutCount = 2;
+        pipelineLayoutInfo.pSetLayouts = setLayouts;
+        pipelineLayoutInfo.pushConstantRangeCount = 1;
+        pipelineLayoutInfo.pPushConstantRanges = &pushConstantRange;
+        VK_CHECK(vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &particleDrawPipelineLayout),
+                 "Failed to create particle draw pipeline layout");
+
+        // MULTIVIEW (constant_id 0) and EFFECT (constant_id 1)
+        const int32_t specializationData[2] = {
+            isMultiviewUsed() ? 1 : 0, static_cast<int32_t>(config.particleEffect)
+        };
+        const VkSpecializationMapEntry specializationEntries[2] = {
+            {0, 0, sizeof(VkBool32)}, {1, sizeof(VkBool32), sizeof(int32_t)}
+        };
+        VkSpecializationInfo specializationInfo{};
+        specializationInfo.mapEntryCount = 2;
+        specializationInfo.pMapEntries = specializationEntries;
+        specializationInfo.dataSize = sizeof(specializationData);
+        specializationInfo.pData = specializationData;
+
+        VkShaderModule vertShaderModule = createShaderModule(readFile("shaders/particle_vert.spv"));
+        VkShaderModule fragShaderModule = createShaderModule(readFile("shaders/particle_frag.spv"));
+        VkPipelineShaderStageCreateInfo shaderStages[2]{};
+        shaderStages[0].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        shaderStages[0].stage = VK_SHADER_STAGE_VERTEX_BIT;
+        shaderStages[0].module = vertShaderModule;
+        shaderStages[0].pName = "main";
+        shaderStages[0].pSpecializationInfo = &specializationInfo;
+        shaderStages[1].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        shaderStages[1].stage = VK_SHADER_STAGE_FRAGMENT_BIT;
+        shaderStages[1].module = fragShaderModule;
+        shaderStages[1].pName = "main";
+        shaderStages[1].pSpecializationInfo = &specializationInfo;
+
+        // Billboards are generated from gl_VertexIndex and the pool; no vertex buffers
         VkPipelineVertexInputStateCreateInfo vertexInputInfo{};
         vertexInputInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
-        vertexInputInfo.vertexBindingDescriptionCount = 1;
-        vertexInputInfo.pVertexBindingDescriptions = &bindingDescription;
-        vertexInputInfo.vertexAttributeDescriptionCount = static_cast<uint32_t>(attributeDescriptions.size());
-        vertexInputInfo.pVertexAttributeDescriptions = attributeDescriptions.data();
 
-        // Input Assembly (Triangles)
         VkPipelineInputAssemblyStateCreateInfo inputAssembly{};
         inputAssembly.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
         inputAssembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
-        inputAssembly.primitiveRestartEnable = VK_FALSE;
 
-        // Viewport and Scissor (Dynamic state allows changing without rebuilding pipeline)
         VkPipelineViewportStateCreateInfo viewportState{};
         viewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
         viewportState.viewportCount = 1;
         viewportState.scissorCount = 1;
-        // pViewports and pScissors set dynamically via command buffer
 
-        std::vector<VkDynamicState> dynamicStates = {
-            VK_DYNAMIC_STATE_VIEWPORT,
-            VK_DYNAMIC_STATE_SCISSOR
-        };
+        const VkDynamicState dynamicStates[] = {VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR};
         VkPipelineDynamicStateCreateInfo dynamicState{};
         dynamicState.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
-        dynamicState.dynamicStateCount = static_cast<uint32_t>(dynamicStates.size());
-        dynamicState.pDynamicStates = dynamicStates.data();
+        dynamicState.dynamicStateCount = 2;
+        dynamicState.pDynamicStates = dynamicStates;
 
-        // Rasterizer
         VkPipelineRasterizationStateCreateInfo rasterizer{};
         rasterizer.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
-        rasterizer.depthClampEnable = VK_FALSE; // Clamping fragments beyond near/far planes
-        rasterizer.rasterizerDiscardEnable = VK_FALSE; // Don't discard geometry
-        rasterizer.polygonMode = VK_POLYGON_MODE_FILL; // Fill polygons
+        rasterizer.polygonMode = VK_POLYGON_MODE_FILL;
         rasterizer.lineWidth = 1.0f;
-        rasterizer.cullMode = VK_CULL_MODE_BACK_BIT; // Cull back faces
-        rasterizer.frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE; // Define front face (due to proj matrix Y-flip)
-        rasterizer.depthBiasEnable = VK_FALSE;
-        // rasterizer.depthBiasConstantFactor = 0.0f; // Optional
-        // rasterizer.depthBiasClamp = 0.0f; // Optional
-        // rasterizer.depthBiasSlopeFactor = 0.0f; // Optional
+        rasterizer.cullMode = VK_CULL_MODE_NONE;
 
-        // Multisampling (Disabled for now)
         VkPipelineMultisampleStateCreateInfo multisampling{};
         multisampling.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
-        multisampling.sampleShadingEnable = VK_FALSE;
-        multisampling.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
-        // multisampling.minSampleShading = 1.0f; // Optional
-        // multisampling.pSampleMask = nullptr; // Optional
-        // multisampling.alphaToCoverageEnable = VK_FALSE; // Optional
-        // multisampling.alphaToOneEnable = VK_FALSE; // Optional
+        multisampling.rasterizationSamples = msaaSamples;
 
-        // Depth/Stencil Testing (Disabled for now)
-        // VkPipelineDepthStencilStateCreateInfo depthStencil{};
-        // ...
+        // Tested against the opaque scene, never written: particles are unsorted and blend in any order
+        VkPipelineDepthStencilStateCreateInfo depthStencil{};
+        depthStencil.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+        depthStencil.depthTestEnable = VK_TRUE;
+        depthStencil.depthWriteEnable = VK_FALSE;
+        depthStencil.depthCompareOp = VK_COMPARE_OP_LESS;
 
-        // Color Blending (Simple alpha blending, disabled here)
+        // Premultiplied alpha; scene alpha is left alone
         VkPipelineColorBlendAttachmentState colorBlendAttachment{};
+        colorBlendAttachment.blendEnable = VK_TRUE;
+        colorBlendAttachment.srcColorBlendFactor = VK_BLEND_FACTOR_ONE;
+        colorBlendAttachment.dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+        colorBlendAttachment.colorBlendOp = VK_BLEND_OP_ADD;
+        colorBlendAttachment.srcAlphaBlendFactor = VK_BLEND_FACTOR_ZERO;
+        colorBlendAttachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+        colorBlendAttachment.alphaBlendOp = VK_BLEND_OP_ADD;
         colorBlendAttachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT |
-                                              VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
-        colorBlendAttachment.blendEnable = VK_FALSE; // No blending
-        // colorBlendAttachment.srcColorBlendFactor = VK_BLEND_FACTOR_ONE; // Optional
-        // colorBlendAttachment.dstColorBlendFactor = VK_BLEND_FACTOR_ZERO; // Optional
-        // colorBlendAttachment.colorBlendOp = VK_BLEND_OP_ADD; // Optional
-        // colorBlendAttachment.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE; // Optional
-        // colorBlendAttachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ZERO; // Optional
-        // colorBlendAttachment.alphaBlendOp = VK_BLEND_OP_ADD; // Optional
-
+                                              VK_COLOR_COMPONENT_B_BIT;
         VkPipelineColorBlendStateCreateInfo colorBlending{};
         colorBlending.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
-        colorBlending.logicOpEnable = VK_FALSE; // Use blend factors, not bitwise logic op
-        colorBlending.logicOp = VK_LOGIC_OP_COPY; // Optional
         colorBlending.attachmentCount = 1;
         colorBlending.pAttachments = &colorBlendAttachment;
-        // colorBlending.blendConstants[0] = 0.0f; // Optional
-        // colorBlending.blendConstants[1] = 0.0f; // Optional
-        // colorBlending.blendConstants[2] = 0.0f; // Optional
-        // colorBlending.blendConstants[3] = 0.0f; // Optional
 
-        // Pipeline Layout (Specifies uniforms/push constants)
+        VkGraphicsPipelineCreateInfo pipelineInfo{};
+        pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+        pipelineInfo.stageCount = 2;
+        pipelineInfo.pStages = shaderStages;
+        pipelineInfo.pVertexInputState = &vertexInputInfo;
+        pipelineInfo.pInputAssemblyState = &inputAssembly;
+        pipelineInfo.pViewportState = &viewportState;
+        pipelineInfo.pRasterizationState = &rasterizer;
+        pipelineInfo.pMultisampleState = &multisampling;
+        pipelineInfo.pDepthStencilState = &depthStencil;
+        pipelineInfo.pColorBlendState = &colorBlending;
+        pipelineInfo.pDynamicState = &dynamicState;
+        pipelineInfo.layout = particleDrawPipelineLayout;
+        pipelineInfo.renderPass = renderPass;
+        pipelineInfo.subpass = 0;
+        VkResult result = vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr,
+                                                    &particleDrawPipeline);
+        vkDestroyShaderModule(device, fragShaderModule, nullptr);
+        vkDestroyShaderModule(device, vertShaderModule, nullptr);
+        VK_CHECK(result, "Failed to create particle draw pipeline");
+        spdlog::debug("Particle draw pipeline created.");
+    }
+
+    void VulkanEngine::cleanupParticleDrawPipeline() {
+        if (particleDrawPipeline != VK_NULL_HANDLE) vkDestroyPipeline(device, particleDrawPipeline, nullptr);
+        particleDrawPipeline = VK_NULL_HANDLE;
+        if (particleDrawPipelineLayout != VK_NULL_HANDLE)
+            vkDestroyPipelineLayout(device, particleDrawPipelineLayout, nullptr);
+        particleDrawPipelineLayout = VK_NULL_HANDLE;
+    }
+
+    void VulkanEngine::recordParticleSimulation(VkCommandBuffer commandBuffer, bool computeQueue) {
+        const ParticleEffectSettings &effect = PARTICLE_EFFECTS[static_cast<size_t>(config.particleEffect)];
+        const uint32_t capacity = config.particleCount;
+        const uint32_t source = particleSourcePool;
+        const uint32_t destination = 1 - source;
+
+        // Emit at the rate that keeps a full pool at the mean lifetime; the first step fills the pool at once
+        const bool firstStep = particleTime < 0.0f;
+        const float dt = firstStep ? 0.0f : std::clamp(simulationTime - particleTime, 0.0f, 0.1f);
+        particleTime = simulationTime;
+        uint32_t emitCount = capacity;
+        if (!firstStep) {
+            const float owed = static_cast<float>(capacity) * dt / effect.meanLife + particleEmitCarry;
+            emitCount = std::min(static_cast<uint32_t>(owed), capacity);
+            particleEmitCarry = owed - static_cast<float>(emitCount);
+        }
+
+        // Last frame's billboards and indirect reads are done before the pools and arguments change;
+        // its compute writes (the live counts) become visible to this frame's passes. On the compute queue
+        // the billboards are ordered by the timeline semaphores instead, which has no vertex stage.
+        const VkPipelineStageFlags billboardStages = computeQueue ? 0 : VK_PIPELINE_STAGE_VERTEX_SHADER_BIT;
+        VkMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT |
+                                VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | billboardStages |
+                             VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT,
+                             VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT, 0, 1,
+                             &barrier, 0, nullptr, 0, nullptr);
+
+        ParticlePushConstants constants{};
+        constants.emitter = glm::vec4(cameraPosition, effect.radius);
+        constants.grid = glm::vec4(terrainBoundsMin.x, terrainBoundsMin.z, terrainCellSize, dt);
+        constants.wind = glm::vec4(PARTICLE_WIND, simulationTime);
+        constants.counts = glm::uvec4(capacity, emitCount, source, static_cast<uint32_t>(frameCount));
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, particleComputePipelineLayout, 0, 1,
+                                &particleDescriptorSets[source], 0, nullptr);
+        vkCmdPushConstants(commandBuffer, particleComputePipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0,
+                           sizeof(constants), &constants);
+
+        // Each pass appends to (or finalizes) the destination count the previous pass left
+        VkMemoryBarrier passBarrier{};
+        passBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        passBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+        passBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+        auto passDependency = [&]() {
+            vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                                 VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &passBarrier, 0, nullptr, 0, nullptr);
+        };
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, particleSimulatePipeline);
+        vkCmdDispatchIndirect(commandBuffer, particleStateBuffer, offsetof(ParticleState, simulateArgs));
+        passDependency();
+        if (emitCount > 0) {
+            vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, particleEmitPipeline);
+            vkCmdDispatch(commandBuffer, (emitCount + PARTICLE_GROUP_SIZE - 1) / PARTICLE_GROUP_SIZE, 1, 1);
+            passDependency();
+        }
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, particleFinalizePipeline);
+        vkCmdDispatch(commandBuffer, 1, 1, 1);
+
+        // Pool and arguments to the billboards, counts to the readback slot of this frame
+        barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_INDIRECT_COMMAND_READ_BIT |
+                                VK_ACCESS_TRANSFER_READ_BIT;
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                             billboardStages | VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT, 0,
+                             1, &barrier, 0, nullptr, 0, nullptr);
+        const VkDeviceSize readbackOffset = static_cast<VkDeviceSize>(currentFrame) * 2 * sizeof(uint32_t);
+        const VkBufferCopy copies[2] = {
+            {offsetof(ParticleState, alive) + destination * sizeof(uint32_t), readbackOffset, sizeof(uint32_t)},
+            {offsetof(ParticleState, emitted), readbackOffset + sizeof(uint32_t), sizeof(uint32_t)}
+        };
+        vkCmdCopyBuffer(commandBuffer, particleStateBuffer, particleReadbackBuffer, 2, copies);
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0, 1,
+                             &barrier, 0, nullptr, 0, nullptr);
+
+        particleSourcePool = destination; // This frame's output is next frame's input
+    }
+
+    void VulkanEngine::recordParticleDraw(VkCommandBuffer commandBuffer, uint32_t view) const {
+        // The simulation already swapped pools: the set of the new source binds last frame's destination
+        // as binding 0, so bind the other set, whose binding 1 is the pool just written
+        const VkDescriptorSet sets[2] = {particleDescriptorSets[1 - particleSourcePool], descriptorSets[currentFrame]};
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, particleDrawPipeline);
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, particleDrawPipelineLayout, 0, 2, sets,
+                                0, nullptr);
+        ParticleDrawPushConstants constants{};
+        constants.eye = glm::vec4(cameraPosition, 0.0f);
+        constants.view = glm::uvec4(view, 0u, 0u, 0u);
+        vkCmdPushConstants(commandBuffer, particleDrawPipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0,
+                           sizeof(constants), &constants);
+        vkCmdDrawIndirect(commandBuffer, particleStateBuffer, offsetof(ParticleState, drawArgs), 1,
+                          sizeof(VkDrawIndirectCommand));
+    }
+
+    // --- Props ---
+
+    void VulkanEngine::createProps(const std::vector<VkProjectOne::TerrainVertex> &vertices) {
+        if (config.propCount == 0 || vertices.empty()) return;
+        spdlog::debug("Creating props...");
+
+        // Deterministic scatter over the terrain vertices: trees on gentle slopes, rocks also on steeper ground
+        std::mt19937 random(20240611u);
+        std::uniform_int_distribution<size_t> pickVertex(0, vertices.size() - 1);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        propInstances.reserve(config.propCount);
+        for (uint32_t attempt = 0; propInstances.size() < config.propCount && attempt < 8 * config.propCount;
+             ++attempt) {
+            const VkProjectOne::TerrainVertex &vertex = vertices[pickVertex(random)];
+            const PropType type = unit(random) < 0.7f ? PropType::Tree : PropType::Rock;
+            if (vertex.normal.y < (type == PropType::Tree ? 0.85f : 0.6f)) continue;
+            const float scale = type == PropType::Tree ? 0.7f + 0.6f * unit(random) : 0.4f + 1.2f * unit(random);
+            const float yaw = 6.2831853f * unit(random);
+            propInstances.push_back({
+                glm::vec4(vertex.pos, scale), glm::vec4(yaw, static_cast<float>(type), 0.0f, 0.0f)
+            });
+        }
+        if (propInstances.size() < config.propCount) {
+            spdlog::warn("Only {} of {} props found a place on the terrain.", propInstances.size(), config.propCount);
+        }
+
+        // A mesh from --prop-mesh stands in for the procedural tree
+        PropMesh meshes[PROP_TYPE_COUNT] = {Props::BuildTree(32, 8), Props::BuildRock(4, 7u)};
+        if (!config.propMeshPath.empty()) {
+            PropMesh loaded;
+            GlbLoadStats glbStats;
+            if (GlbLoader::LoadMesh(config.propMeshPath, loaded, &glbStats)) {
+                const float totalMs = glbStats.mapMs + glbStats.parseMs + glbStats.decodeMs;
+                const double fileMb = static_cast<double>(glbStats.fileBytes) / (1024.0 * 1024.0);
+                spdlog::info("Loaded '{}': {:.1f} MB, {} primitives, {} vertices, {} triangles in {:.1f} ms "
+                             "({:.0f} MB/s; map {:.2f} ms, JSON {:.2f} ms, decode {:.1f} ms on {} threads; "
+                             "{:.1f} MB copied as is, {:.1f} MB converted).", config.propMeshPath, fileMb,
+                             glbStats.primitives, loaded.vertices.size(), loaded.indices.size() / 3, totalMs,
+                             fileMb / std::max(totalMs / 1000.0, 1e-6), glbStats.mapMs, glbStats.parseMs,
+                             glbStats.decodeMs, glbStats.threads,
+                             static_cast<double>(glbStats.directBytes) / (1024.0 * 1024.0),
+                             static_cast<double>(glbStats.convertedBytes) / (1024.0 * 1024.0));
+                meshes[static_cast<uint32_t>(PropType::Tree)] = std::move(loaded);
+            } else {
+                spdlog::warn("Keeping the procedural tree mesh.");
+            }
+        }
+
+        // LOD chains are cooked while loading, one thread per mesh
+        const auto simplifyStart = std::chrono::high_resolution_clock::now();
+        std::future<std::vector<PropLod>> chainFutures[PROP_TYPE_COUNT];
+        for (uint32_t type = 0; type < PROP_TYPE_COUNT; ++type) {
+            chainFutures[type] = std::async(std::launch::async, MeshSimplifier::BuildLodChain,
+                                            std::cref(meshes[type]), config.propLodLevels, 1.0f);
+        }
+        std::vector<PropLod> chains[PROP_TYPE_COUNT];
+        for (uint32_t type = 0; type < PROP_TYPE_COUNT; ++type) chains[type] = chainFutures[type].get();
+        const float simplifyMs = std::chrono::duration<float, std::milli>(
+            std::chrono::high_resolution_clock::now() - simplifyStart).count();
+
+        // One vertex and one index buffer for all meshes; each type and level draws its own index range
+        std::vector<PropVertex> meshVertices;
+        std::vector<uint32_t> meshIndices;
+        uint64_t simplifiedTriangles = 0; // Input triangles of every simplification step
+        for (uint32_t type = 0; type < PROP_TYPE_COUNT; ++type) {
+            const PropMesh &mesh = meshes[type];
+            const glm::vec3 center = (mesh.boundsMin + mesh.boundsMax) * 0.5f;
+            propLodCounts[type] = static_cast<uint32_t>(chains[type].size());
+            for (uint32_t lod = 0; lod < propLodCounts[type]; ++lod) {
+                const PropLod &level = chains[type][lod];
+                propMeshRanges[type][lod] = {
+                    static_cast<uint32_t>(meshIndices.size()), static_cast<uint32_t>(level.indices.size()),
+                    static_cast<int32_t>(meshVertices.size()),
+                    glm::vec4(center, glm::length(mesh.boundsMax - mesh.boundsMin) * 0.5f), level.error
+                };
+                meshIndices.insert(meshIndices.end(), level.indices.begin(), level.indices.end());
+                if (lod > 0) simplifiedTriangles += chains[type][lod - 1].indices.size() / 3;
+            }
+            meshVertices.insert(meshVertices.end(), mesh.vertices.begin(), mesh.vertices.end());
+            for (uint32_t lod = 0; lod < propLodCounts[type]; ++lod) {
+                spdlog::debug("Prop type {} LOD {}: {} triangles, error {:.4f}", type, lod,
+                              chains[type][lod].indices.size() / 3, chains[type][lod].error);
+            }
+        }
+        if (simplifiedTriangles > 0) {
+            spdlog::info("Prop LOD chains: simplified {} triangles in {:.1f} ms ({:.2f} M tris/s, {} threads).",
+                         simplifiedTriangles, simplifyMs,
+                         static_cast<double>(simplifiedTriangles) / std::max(simplifyMs, 1e-3f) / 1000.0,
+                         PROP_TYPE_COUNT);
+        }
+        const VkDeviceSize vertexBytes = sizeof(PropVertex) * meshVertices.size();
+        const VkDeviceSize indexBytes = sizeof(uint32_t) * meshIndices.size();
+        VkBuffer stagingBuffer;
+        VkDeviceMemory stagingBufferMemory;
+        createBuffer({MemoryCategory::Staging, "prop mesh staging"},
+                     vertexBytes + indexBytes, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                     VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                     stagingBuffer, stagingBufferMemory);
+        void *data;
+        VK_CHECK(vkMapMemory(device, stagingBufferMemory, 0, vertexBytes + indexBytes, 0, &data),
+                 "Failed to map prop staging buffer");
+        memcpy(data, meshVertices.data(), static_cast<size_t>(vertexBytes));
+        memcpy(static_cast<char *>(data) + vertexBytes, meshIndices.data(), static_cast<size_t>(indexBytes));
+        vkUnmapMemory(device, stagingBufferMemory);
+        createBuffer({MemoryCategory::Props, "prop vertices"},
+                     vertexBytes, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+                     VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, propVertexBuffer, propVertexBufferMemory);
+        createBuffer({MemoryCategory::Props, "prop indices"},
+                     indexBytes, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
+                     VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, propIndexBuffer, propIndexBufferMemory);
+        VkCommandBuffer commandBuffer = beginSingleTimeCommands();
+        const VkBufferCopy vertexCopy{0, 0, vertexBytes};
+        const VkBufferCopy indexCopy{vertexBytes, 0, indexBytes};
+        vkCmdCopyBuffer(commandBuffer, stagingBuffer, propVertexBuffer, 1, &vertexCopy);
+        vkCmdCopyBuffer(commandBuffer, stagingBuffer, propIndexBuffer, 1, &indexCopy);
+        endSingleTimeCommands(commandBuffer);
+        vkDestroyBuffer(device, stagingBuffer, nullptr);
+        freeMemory(stagingBufferMemory);
+
+        // Instance buffers are rewritten by the culling pass every frame, so they stay mapped
+        const VkDeviceSize instanceBytes = sizeof(PropInstance) * std::max<size_t>(propInstances.size(), 1);
+        propInstanceBuffers.resize(MAX_FRAMES_IN_FLIGHT);
+        propInstanceBuffersMemory.resize(MAX_FRAMES_IN_FLIGHT);
+        propInstanceBuffersMapped.resize(MAX_FRAMES_IN_FLIGHT);
+        for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i) {
+            createBuffer({MemoryCategory::Props, "prop instances " + std::to_string(i)},
+                         instanceBytes, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+                         VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                         propInstanceBuffers[i], propInstanceBuffersMemory[i]);
+            void *mapped;
+            VK_CHECK(vkMapMemory(device, propInstanceBuffersMemory[i], 0, instanceBytes, 0, &mapped),
+                     "Failed to map prop instance buffer");
+            propInstanceBuffersMapped[i] = static_cast<PropInstance *>(mapped);
+        }
+
+        // Set 0: the atlas (impostor fragment shader); set 1: the per-frame UBO (multiview matrices)
+        VkDescriptorSetLayoutBinding binding{};
+        binding.binding = 0;
+        binding.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        binding.descriptorCount = 1;
+        binding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+        VkDescriptorSetLayoutCreateInfo layoutInfo{};
+        layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        layoutInfo.bindingCount = 1;
+        layoutInfo.pBindings = &binding;
+        VK_CHECK(vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &propDescriptorSetLayout),
+                 "Failed to create prop descriptor set layout");
+
+        const VkDescriptorSetLayout setLayouts[2] = {propDescriptorSetLayout, descriptorSetLayout};
+        VkPushConstantRange pushConstantRange{};
+        pushConstantRange.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+        pushConstantRange.offset = 0;
+        pushConstantRange.size = sizeof(PropPushConstants);
         VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
         pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-        pipelineLayoutInfo.setLayoutCount = 1;
-        pipelineLayoutInfo.pSetLayouts = &descriptorSetLayout; // Use the UBO layout
-        // pipelineLayoutInfo.pushConstantRangeCount = 0; // Optional
-        // pipelineLayoutInfo.pPushConstantRanges = nullptr; // Optional
+        pipelineLayoutInfo.setLayoutCount = 2;
+        pipelineLayoutInfo.pSetLayouts = setLayouts;
+        pipelineLayoutInfo.pushConstantRangeCount = 1;
+        pipelineLayoutInfo.pPushConstantRanges = &pushConstantRange;
+        VK_CHECK(vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &propPipelineLayout),
+                 "Failed to create prop pipeline layout");
+
+        const auto bakeStart = std::chrono::high_resolution_clock::now();
+        bakePropAtlas();
+        const float bakeMs = std::chrono::duration<float, std::milli>(
+            std::chrono::high_resolution_clock::now() - bakeStart).count();
+
+        VkSamplerCreateInfo samplerInfo{};
+        samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+        samplerInfo.magFilter = VK_FILTER_LINEAR;
+        samplerInfo.minFilter = VK_FILTER_LINEAR;
+        samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
+        samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.maxLod = static_cast<float>(PROP_ATLAS_LEVELS);
+        VK_CHECK(vkCreateSampler(device, &samplerInfo, nullptr, &propAtlasSampler),
+                 "Failed to create prop atlas sampler");
+
+        VkDescriptorPoolSize poolSize{VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1};
+        VkDescriptorPoolCreateInfo poolInfo{};
+        poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        poolInfo.poolSizeCount = 1;
+        poolInfo.pPoolSizes = &poolSize;
+        poolInfo.maxSets = 1;
+        VK_CHECK(vkCreateDescriptorPool(device, &poolInfo, nullptr, &propDescriptorPool),
+                 "Failed to create prop descriptor pool");
+
+        VkDescriptorSetAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocInfo.descriptorPool = propDescriptorPool;
+        allocInfo.descriptorSetCount = 1;
+        allocInfo.pSetLayouts = &propDescriptorSetLayout;
+        VK_CHECK(vkAllocateDescriptorSets(device, &allocInfo, &propDescriptorSet),
+                 "Failed to allocate prop descriptor set");
+
+        const VkDescriptorImageInfo atlasInfo{
+            propAtlasSampler, propAtlasImageView, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
+        };
+        VkWriteDescriptorSet write{};
+        write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write.dstSet = propDescriptorSet;
+        write.dstBinding = 0;
+        write.descriptorCount = 1;
+        write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        write.pImageInfo = &atlasInfo;
+        vkUpdateDescriptorSets(device, 1, &write, 0, nullptr);
+
+        size_t treeCount = 0;
+        for (const PropInstance &instance: propInstances) {
+            if (static_cast<PropType>(instance.params.y) == PropType::Tree) treeCount++;
+        }
+        const uint32_t atlasSize = PROP_ATLAS_FRAMES * PROP_ATLAS_FRAME_SIZE;
+        spdlog::info("Props created: {} trees ({} tris each), {} rocks ({} tris each); impostor atlas {}x{} x {} "
+                     "layers ({}x{} frames), baked in {:.1f} ms.", treeCount, meshes[0].indices.size() / 3,
+                     propInstances.size() - treeCount, meshes[1].indices.size() / 3, atlasSize, atlasSize,
+                     2 * PROP_TYPE_COUNT, PROP_ATLAS_FRAMES, PROP_ATLAS_FRAMES, bakeMs);
+    }
+
+    void VulkanEngine::bakePropAtlas() {
+        constexpr VkFormat atlasFormat = VK_FORMAT_R8G8B8A8_UNORM;
+        constexpr uint32_t layerCount = 2 * PROP_TYPE_COUNT;
+        const uint32_t atlasSize = PROP_ATLAS_FRAMES * PROP_ATLAS_FRAME_SIZE;
+
+        VkImageCreateInfo imageInfo{};
+        imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        imageInfo.imageType = VK_IMAGE_TYPE_2D;
+        imageInfo.extent = {atlasSize, atlasSize, 1};
+        imageInfo.mipLevels = PROP_ATLAS_LEVELS;
+        imageInfo.arrayLayers = layerCount;
+        imageInfo.format = atlasFormat;
+        imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+        imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        imageInfo.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT |
+                          VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+        imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+        imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        createImage({MemoryCategory::Props, "prop atlas"},
+                    imageInfo, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, propAtlasImage, propAtlasImageMemory);
+        propAtlasImageView = createImageView(propAtlasImage, atlasFormat, VK_IMAGE_ASPECT_COLOR_BIT,
+                                             VK_IMAGE_VIEW_TYPE_2D_ARRAY, 0, layerCount, PROP_ATLAS_LEVELS);
+
+        // Everything below only lives for the bake
+        VkImageView layerViews[layerCount];
+        for (uint32_t layer = 0; layer < layerCount; ++layer) {
+            layerViews[layer] = createImageView(propAtlasImage, atlasFormat, VK_IMAGE_ASPECT_COLOR_BIT,
+                                                VK_IMAGE_VIEW_TYPE_2D, layer, 1);
+        }
+        const VkFormat bakeDepthFormat = findDepthFormat(false);
+        VkImage depthImage;
+        VkDeviceMemory depthImageMemory;
+        createImage({MemoryCategory::Props, "prop atlas bake depth"}, atlasSize, atlasSize, bakeDepthFormat,
+                    VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT,
+                    VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, depthImage, depthImageMemory);
+        VkImageView depthImageView = createImageView(depthImage, bakeDepthFormat, VK_IMAGE_ASPECT_DEPTH_BIT);
+
+        // Albedo and normal of one type per pass, cleared to zero (no coverage) and left for the mip blits
+        VkAttachmentDescription attachments[3]{};
+        for (uint32_t i = 0; i < 3; ++i) {
+            attachments[i].format = i < 2 ? atlasFormat : bakeDepthFormat;
+            attachments[i].samples = VK_SAMPLE_COUNT_1_BIT;
+            attachments[i].loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+            attachments[i].storeOp = i < 2 ? VK_ATTACHMENT_STORE_OP_STORE : VK_ATTACHMENT_STORE_OP_DONT_CARE;
+            attachments[i].stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+            attachments[i].stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+            attachments[i].initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+            attachments[i].finalLayout = i < 2
+                                             ? VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL
+                                             : VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+        }
+        const VkAttachmentReference colorAttachmentRefs[2] = {
+            {0, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL}, {1, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL}
+        };
+        VkAttachmentReference depthAttachmentRef{2, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL};
+        VkSubpassDescription subpass{};
+        subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+        subpass.colorAttachmentCount = 2;
+        subpass.pColorAttachments = colorAttachmentRefs;
+        subpass.pDepthStencilAttachment = &depthAttachmentRef;
+
+        // Consecutive passes share the depth buffer; the mip blits read the color afterwards
+        constexpr VkPipelineStageFlags depthStages = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT |
+                                                     VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+        VkSubpassDependency dependencies[2]{};
+        dependencies[0].srcSubpass = VK_SUBPASS_EXTERNAL;
+        dependencies[0].dstSubpass = 0;
+        dependencies[0].srcStageMask = depthStages;
+        dependencies[0].srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+        dependencies[0].dstStageMask = depthStages;
+        dependencies[0].dstAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT |
+                                        VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+        dependencies[1].srcSubpass = 0;
+        dependencies[1].dstSubpass = VK_SUBPASS_EXTERNAL;
+        dependencies[1].srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+        dependencies[1].srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+        dependencies[1].dstStageMask = VK_PIPELINE_STAGE_TRANSFER_BIT;
+        dependencies[1].dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+
+        VkRenderPassCreateInfo renderPassInfo{};
+        renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+        renderPassInfo.attachmentCount = 3;
+        renderPassInfo.pAttachments = attachments;
+        renderPassInfo.subpassCount = 1;
+        renderPassInfo.pSubpasses = &subpass;
+        renderPassInfo.dependencyCount = 2;
+        renderPassInfo.pDependencies = dependencies;
+        VkRenderPass bakeRenderPass;
+        VK_CHECK(vkCreateRenderPass(device, &renderPassInfo, nullptr, &bakeRenderPass),
+                 "Failed to create prop atlas render pass");
+
+        VkFramebuffer framebuffers[PROP_TYPE_COUNT];
+        for (uint32_t type = 0; type < PROP_TYPE_COUNT; ++type) {
+            VkImageView typeAttachments[] = {layerViews[2 * type], layerViews[2 * type + 1], depthImageView};
+            VkFramebufferCreateInfo framebufferInfo{};
+            framebufferInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+            framebufferInfo.renderPass = bakeRenderPass;
+            framebufferInfo.attachmentCount = 3;
+            framebufferInfo.pAttachments = typeAttachments;
+            framebufferInfo.width = atlasSize;
+            framebufferInfo.height = atlasSize;
+            framebufferInfo.layers = 1;
+            VK_CHECK(vkCreateFramebuffer(device, &framebufferInfo, nullptr, &framebuffers[type]),
+                     "Failed to create prop atlas framebuffer");
+        }
+        VkPipeline bakePipeline = createPropPipeline(bakeRenderPass, PropPipelineKind::Bake);
+
+        // The meshes are drawn untransformed through a single identity instance
+        propInstanceBuffersMapped[0][0] = {glm::vec4(0.0f, 0.0f, 0.0f, 1.0f), glm::vec4(0.0f)};
+
+        VkCommandBuffer commandBuffer = beginSingleTimeCommands();
+        VkClearValue clearValues[3]{};
+        clearValues[0].color = {{0.0f, 0.0f, 0.0f, 0.0f}};
+        clearValues[1].color = {{0.0f, 0.0f, 0.0f, 0.0f}};
+        clearValues[2].depthStencil = {1.0f, 0};
+        const VkBuffer vertexBuffers[2] = {propVertexBuffer, propInstanceBuffers[0]};
+        const VkDeviceSize offsets[2] = {0, 0};
+        for (uint32_t type = 0; type < PROP_TYPE_COUNT; ++type) {
+            VkRenderPassBeginInfo passInfo{};
+            passInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+            passInfo.renderPass = bakeRenderPass;
+            passInfo.framebuffer = framebuffers[type];
+            passInfo.renderArea.extent = {atlasSize, atlasSize};
+            passInfo.clearValueCount = 3;
+            passInfo.pClearValues = clearValues;
+            vkCmdBeginRenderPass(commandBuffer, &passInfo, VK_SUBPASS_CONTENTS_INLINE);
+            vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, bakePipeline);
+            // Only the UBO set is statically used by the bake shaders
+            vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, propPipelineLayout, 1, 1,
+                                    &descriptorSets[0], 0, nullptr);
+            vkCmdBindVertexBuffers(commandBuffer, 0, 2, vertexBuffers, offsets);
+            vkCmdBindIndexBuffer(commandBuffer, propIndexBuffer, 0, VK_INDEX_TYPE_UINT32);
+
+            // Orthographic frame camera around the bounding sphere, looking at its center from each direction
+            const PropMeshRange &range = propMeshRanges[type][0];
+            const glm::vec3 center(range.bounds);
+            const float radius = range.bounds.w;
+            const glm::mat4 frameProj = glm::ortho(-radius, radius, -radius, radius, 0.0f, 4.0f * radius);
+            for (uint32_t y = 0; y < PROP_ATLAS_FRAMES; ++y) {
+                for (uint32_t x = 0; x < PROP_ATLAS_FRAMES; ++x) {
+                    const glm::vec3 direction = Props::HemiOctahedralDirection(x, y, PROP_ATLAS_FRAMES);
+                    const glm::vec3 up = std::abs(direction.y) > 0.99f ? glm::vec3(0.0f, 0.0f, 1.0f)
+                                                                       : glm::vec3(0.0f, 1.0f, 0.0f);
+                    PropPushConstants constants{};
+                    constants.viewProj = frameProj * glm::lookAt(center + direction * 2.0f * radius, center, up);
+                    vkCmdPushConstants(commandBuffer, propPipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0,
+                                       sizeof(constants), &constants);
+                    const VkRect2D frame{
+                        {
+                            static_cast<int32_t>(x * PROP_ATLAS_FRAME_SIZE),
+                            static_cast<int32_t>(y * PROP_ATLAS_FRAME_SIZE)
+                        },
+                        {PROP_ATLAS_FRAME_SIZE, PROP_ATLAS_FRAME_SIZE}
+                    };
+                    const VkViewport viewport{
+                        static_cast<float>(frame.offset.x), static_cast<float>(frame.offset.y),
+                        static_cast<float>(PROP_ATLAS_FRAME_SIZE), static_cast<float>(PROP_ATLAS_FRAME_SIZE), 0.0f, 1.0f
+                    };
+                    vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+                    vkCmdSetScissor(commandBuffer, 0, 1, &frame);
+                    vkCmdDrawIndexed(commandBuffer, range.indexCount, 1, range.firstIndex, range.vertexOffset, 0);
+                }
+            }
+            vkCmdEndRenderPass(commandBuffer);
+        }
+
+        // Mips by successive linear blits; frames are a power of two, so they never straddle texels
+        for (uint32_t level = 1; level < PROP_ATLAS_LEVELS; ++level) {
+            VkImageMemoryBarrier toDst = makeImageBarrier(propAtlasImage, VK_IMAGE_LAYOUT_UNDEFINED,
+                                                          VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 0,
+                                                          VK_ACCESS_TRANSFER_WRITE_BIT);
+            toDst.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, level, 1, 0, layerCount};
+            vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0,
+                                 nullptr, 0, nullptr, 1, &toDst);
+            const int32_t srcSize = static_cast<int32_t>(atlasSize >> (level - 1));
+            VkImageBlit blit{};
+            blit.srcSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, level - 1, 0, layerCount};
+            blit.srcOffsets[1] = {srcSize, srcSize, 1};
+            blit.dstSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, level, 0, layerCount};
+            blit.dstOffsets[1] = {srcSize / 2, srcSize / 2, 1};
+            vkCmdBlitImage(commandBuffer, propAtlasImage, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, propAtlasImage,
+                           VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &blit, VK_FILTER_LINEAR);
+            VkImageMemoryBarrier toSrc = makeImageBarrier(propAtlasImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                                          VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                                                          VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT);
+            toSrc.subresourceRange = toDst.subresourceRange;
+            vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0,
+                                 nullptr, 0, nullptr, 1, &toSrc);
+        }
+        VkImageMemoryBarrier toShader = makeImageBarrier(propAtlasImage, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                                                         VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                                                         VK_ACCESS_TRANSFER_READ_BIT, VK_ACCESS_SHADER_READ_BIT);
+        toShader.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, PROP_ATLAS_LEVELS, 0, layerCount};
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0,
+                             nullptr, 0, nullptr, 1, &toShader);
+        endSingleTimeCommands(commandBuffer);
+
+        vkDestroyPipeline(device, bakePipeline, nullptr);
+        for (VkFramebuffer framebuffer: framebuffers) vkDestroyFramebuffer(device, framebuffer, nullptr);
+        vkDestroyRenderPass(device, bakeRenderPass, nullptr);
+        vkDestroyImageView(device, depthImageView, nullptr);
+        vkDestroyImage(device, depthImage, nullptr);
+        freeMemory(depthImageMemory);
+        for (VkImageView view: layerViews) vkDestroyImageView(device, view, nullptr);
+    }
+
+    void VulkanEngine::cleanupProps() {
+        if (propDescriptorPool != VK_NULL_HANDLE) vkDestroyDescriptorPool(device, propDescriptorPool, nullptr);
+        propDescriptorPool = VK_NULL_HANDLE; // Set is freed with the pool
+        propDescriptorSet = VK_NULL_HANDLE;
+        if (propPipelineLayout != VK_NULL_HANDLE) vkDestroyPipelineLayout(device, propPipelineLayout, nullptr);
+        propPipelineLayout = VK_NULL_HANDLE;
+        if (propDescriptorSetLayout != VK_NULL_HANDLE)
+            vkDestroyDescriptorSetLayout(device, propDescriptorSetLayout, nullptr);
+        propDescriptorSetLayout = VK_NULL_HANDLE;
+        if (propAtlasSampler != VK_NULL_HANDLE) vkDestroySampler(device, propAtlasSampler, nullptr);
+        propAtlasSampler = VK_NULL_HANDLE;
+        if (propAtlasImageView != VK_NULL_HANDLE) vkDestroyImageView(device, propAtlasImageView, nullptr);
+        propAtlasImageView = VK_NULL_HANDLE;
+        if (propAtlasImage != VK_NULL_HANDLE) vkDestroyImage(device, propAtlasImage, nullptr);
+        propAtlasImage = VK_NULL_HANDLE;
+        if (propAtlasImageMemory != VK_NULL_HANDLE) freeMemory(propAtlasImageMemory);
+        propAtlasImageMemory = VK_NULL_HANDLE;
+        for (size_t i = 0; i < propInstanceBuffers.size(); ++i) {
+            if (propInstanceBuffers[i] != VK_NULL_HANDLE) vkDestroyBuffer(device, propInstanceBuffers[i], nullptr);
+            if (propInstanceBuffersMemory[i] != VK_NULL_HANDLE)
+                freeMemory(propInstanceBuffersMemory[i]); // Unmapped implicitly
+        }
+        propInstanceBuffers.clear();
+        propInstanceBuffersMemory.clear();
+        propInstanceBuffersMapped.clear();
+        if (propIndexBuffer != VK_NULL_HANDLE) vkDestroyBuffer(device, propIndexBuffer, nullptr);
+        propIndexBuffer = VK_NULL_HANDLE;
+        if (propIndexBufferMemory != VK_NULL_HANDLE) freeMemory(propIndexBufferMemory);
+        propIndexBufferMemory = VK_NULL_HANDLE;
+        if (propVertexBuffer != VK_NULL_HANDLE) vkDestroyBuffer(device, propVertexBuffer, nullptr);
+        propVertexBuffer = VK_NULL_HANDLE;
+        if (propVertexBufferMemory != VK_NULL_HANDLE) freeMemory(propVertexBufferMemory);
+        propVertexBufferMemory = VK_NULL_HANDLE;
+        propInstances.clear();
+    }
+
+    VkPipeline VulkanEngine::createPropPipeline(VkRenderPass targetPass, PropPipelineKind kind) {
+        const bool impostor = kind == PropPipelineKind::Impostor;
+        const bool bake = kind == PropPipelineKind::Bake;
+
+        // MULTIVIEW (constant_id 0); the bake renders single frames with the pushed matrix
+        const VkBool32 multiview = !bake && isMultiviewUsed() ? VK_TRUE : VK_FALSE;
+        const VkSpecializationMapEntry specializationEntry{0, 0, sizeof(VkBool32)};
+        VkSpecializationInfo specializationInfo{};
+        specializationInfo.mapEntryCount = 1;
+        specializationInfo.pMapEntries = &specializationEntry;
+        specializationInfo.dataSize = sizeof(multiview);
+        specializationInfo.pData = &multiview;
+
+        VkShaderModule vertShaderModule = createShaderModule(
+            readFile(impostor ? "shaders/prop_impostor_vert.spv" : "shaders/prop_vert.spv"));
+        VkShaderModule fragShaderModule = createShaderModule(
+            readFile(impostor ? "shaders/prop_impostor_frag.spv" : bake ? "shaders/prop_bake_frag.spv"
+                                                                          : "shaders/prop_frag.spv"));
+        VkPipelineShaderStageCreateInfo shaderStages[2]{};
+        shaderStages[0].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        shaderStages[0].stage = VK_SHADER_STAGE_VERTEX_BIT;
+        shaderStages[0].module = vertShaderModule;
+        shaderStages[0].pName = "main";
+        shaderStages[0].pSpecializationInfo = &specializationInfo;
+        shaderStages[1].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        shaderStages[1].stage = VK_SHADER_STAGE_FRAGMENT_BIT;
+        shaderStages[1].module = fragShaderModule;
+        shaderStages[1].pName = "main";
+
+        // Meshes read vertices (binding 0) and instances (binding 1); impostor quads only the instances
+        std::vector<VkVertexInputBindingDescription> bindingDescriptions = PropVertex::getBindingDescriptions();
+        std::vector<VkVertexInputAttributeDescription> attributeDescriptions = PropVertex::getAttributeDescriptions();
+        if (impostor) {
+            bindingDescriptions.erase(bindingDescriptions.begin());
+            std::erase_if(attributeDescriptions, [](const VkVertexInputAttributeDescription &attribute) {
+                return attribute.binding == 0;
+            });
+        }
+        VkPipelineVertexInputStateCreateInfo vertexInputInfo{};
+        vertexInputInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+        vertexInputInfo.vertexBindingDescriptionCount = static_cast<uint32_t>(bindingDescriptions.size());
+        vertexInputInfo.pVertexBindingDescriptions = bindingDescriptions.data();
+        vertexInputInfo.vertexAttributeDescriptionCount = static_cast<uint32_t>(attributeDescriptions.size());
+        vertexInputInfo.pVertexAttributeDescriptions = attributeDescriptions.data();
+
+        VkPipelineInputAssemblyStateCreateInfo inputAssembly{};
+        inputAssembly.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+        inputAssembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+
+        VkPipelineViewportStateCreateInfo viewportState{};
+        viewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+        viewportState.viewportCount = 1;
+        viewportState.scissorCount = 1;
+
+        const VkDynamicState dynamicStates[] = {VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR};
+        VkPipelineDynamicStateCreateInfo dynamicState{};
+        dynamicState.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+        dynamicState.dynamicStateCount = 2;
+        dynamicState.pDynamicStates = dynamicStates;
 
-        VkResult layoutResult = vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &pipelineLayout);
-        VK_CHECK(layoutResult, "Failed to create pipeline layout!");
-        spdlog::debug("Pipeline layout created.");
+        // The frame cameras of the bake are not Y-flipped, which mirrors the winding
+        VkPipelineRasterizationStateCreateInfo rasterizer{};
+        rasterizer.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+        rasterizer.polygonMode = VK_POLYGON_MODE_FILL;
+        rasterizer.lineWidth = 1.0f;
+        rasterizer.cullMode = impostor ? VK_CULL_MODE_NONE : VK_CULL_MODE_BACK_BIT;
+        rasterizer.frontFace = bake ? VK_FRONT_FACE_CLOCKWISE : VK_FRONT_FACE_COUNTER_CLOCKWISE;
+
+        VkPipelineMultisampleStateCreateInfo multisampling{};
+        multisampling.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+        multisampling.rasterizationSamples = bake ? VK_SAMPLE_COUNT_1_BIT : msaaSamples;
+
+        VkPipelineDepthStencilStateCreateInfo depthStencil{};
+        depthStencil.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+        depthStencil.depthTestEnable = VK_TRUE;
+        depthStencil.depthWriteEnable = VK_TRUE;
+        depthStencil.depthCompareOp = VK_COMPARE_OP_LESS;
+
+        VkPipelineColorBlendAttachmentState colorBlendAttachments[2]{};
+        for (VkPipelineColorBlendAttachmentState &attachment: colorBlendAttachments) {
+            attachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT |
+                                        VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+        }
+        VkPipelineColorBlendStateCreateInfo colorBlending{};
+        colorBlending.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+        colorBlending.attachmentCount = bake ? 2 : 1;
+        colorBlending.pAttachments = colorBlendAttachments;
 
-        // --- Create Graphics Pipeline ---
         VkGraphicsPipelineCreateInfo pipelineInfo{};
         pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
-        pipelineInfo.stageCount = 2; // Vertex + Fragment stages
+        pipelineInfo.stageCount = 2;
         pipelineInfo.pStages = shaderStages;
         pipelineInfo.pVertexInputState = &vertexInputInfo;
         pipelineInfo.pInputAssemblyState = &inputAssembly;
         pipelineInfo.pViewportState = &viewportState;
         pipelineInfo.pRasterizationState = &rasterizer;
         pipelineInfo.pMultisampleState = &multisampling;
-        // pipelineInfo.pDepthStencilState = nullptr; // No depth testing yet
+        pipelineInfo.pDepthStencilState = &depthStencil;
         pipelineInfo.pColorBlendState = &colorBlending;
-        pipelineInfo.pDynamicState = &dynamicState; // Enable dynamic viewport/scissor
-        pipelineInfo.layout = pipelineLayout;
-        pipelineInfo.renderPass = renderPass; // Render pass the pipeline is compatible with
-        pipelineInfo.subpass = 0; // Index of the subpass
-        // pipelineInfo.basePipelineHandle = VK_NULL_HANDLE; // Optional: For pipeline derivation
-        // pipelineInfo.basePipelineIndex = -1; // Optional
-
-        VkResult pipelineResult = vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr,
-                                                            &graphicsPipeline);
-        VK_CHECK(pipelineResult, "Failed to create graphics pipeline!");
-        spdlog::info("Graphics pipeline created.");
-
-        // Cleanup shader modules after pipeline creation
+        pipelineInfo.pDynamicState = &dynamicState;
+        pipelineInfo.layout = propPipelineLayout;
+        pipelineInfo.renderPass = targetPass;
+        pipelineInfo.subpass = 0;
+        VkPipeline pipeline = VK_NULL_HANDLE;
+        VkResult result = vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &pipeline);
         vkDestroyShaderModule(device, fragShaderModule, nullptr);
         vkDestroyShaderModule(device, vertShaderModule, nullptr);
-        spdlog::debug("Shader modules destroyed.");
+        VK_CHECK(result, "Failed to create prop pipeline");
+        return pipeline;
     }
 
-    // --- Framebuffers ---
+    void VulkanEngine::createPropPipelines() {
+        if (config.propCount == 0) return;
+        propMeshPipeline = createPropPipeline(renderPass, PropPipelineKind::Mesh);
+        propImpostorPipeline = createPropPipeline(renderPass, PropPipelineKind::Impostor);
+        spdlog::debug("Prop pipelines created.");
+    }
 
-    void VulkanEngine::createFramebuffers() {
-        spdlog::debug("Creating framebuffers...");
-        swapChainFramebuffers.resize(swapChainImageViews.size());
+    void VulkanEngine::cleanupPropPipelines() {
+        for (VkPipeline *pipeline: {&propMeshPipeline, &propImpostorPipeline}) {
+            if (*pipeline != VK_NULL_HANDLE) vkDestroyPipeline(device, *pipeline, nullptr);
+            *pipeline = VK_NULL_HANDLE;
+        }
+    }
 
-        for (size_t i = 0; i < swapChainImageViews.size(); i++) {
-            VkImageView attachments[] = {swapChainImageViews[i]};
+    void VulkanEngine::cullProps(const Frustum *frusta, uint32_t frustumCount) {
+        for (std::vector<PropInstance> &range: propVisible) range.clear();
+        const float lodDistance = config.propLodDistance > 0.0f
+                                      ? config.propLodDistance
+                                      : std::numeric_limits<float>::max();
+        // Pixels per mesh unit at distance 1; a level is used while its error stays within the budget
+        const float pixelsPerUnit = static_cast<float>(renderExtent.height) /
+                                    (2.0f * std::tan(glm::radians(CAMERA_FOV_Y) * 0.5f));
+        const float errorBudget = config.propLodError / pixelsPerUnit;
+        uint64_t fullDetailTriangles = 0; // What the visible instances would cost as full-detail meshes
+        for (const PropInstance &instance: propInstances) {
+            const uint32_t type = static_cast<uint32_t>(instance.params.y);
+            const glm::vec4 &bounds = propMeshRanges[type][0].bounds;
+            // Sphere around the vertical axis that contains the bounds at any yaw
+            const float scale = instance.positionScale.w;
+            const glm::vec3 center = glm::vec3(instance.positionScale) + glm::vec3(0.0f, bounds.y * scale, 0.0f);
+            const float radius = (bounds.w + glm::length(glm::vec2(bounds.x, bounds.z))) * scale;
+            bool visible = false;
+            for (uint32_t i = 0; i < frustumCount && !visible; ++i) {
+                visible = frusta[i].intersects(center - radius, center + radius);
+            }
+            if (!visible) continue;
+            const float distance = glm::distance(cameraPosition, center);
+            if (distance > lodDistance) {
+                propVisible[PROP_RANGE_COUNT - 1].push_back(instance);
+                fullDetailTriangles += propMeshRanges[type][0].indexCount / 3;
+                continue;
+            }
+            // Coarsest level whose error, scaled with the instance, projects within the budget
+            const float maxError = errorBudget * std::max(distance - radius, CAMERA_NEAR) / scale;
+            uint32_t lod = propLodCounts[type] - 1;
+            while (lod > 0 && propMeshRanges[type][lod].error > maxError) lod--;
+            propVisible[type * MAX_PROP_LODS + lod].push_back(instance);
+        }
 
-            VkFramebufferCreateInfo framebufferInfo{};
-            framebufferInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
-            framebufferInfo.renderPass = renderPass; // Compatible render pass
-            framebufferInfo.attachmentCount = 1;
-            framebufferInfo.pAttachments = attachments; // Image view for the attachment
-            framebufferInfo.width = swapChainExtent.width;
-            framebufferInfo.height = swapChainExtent.height;
-            framebufferInfo.layers = 1;
+        // Ranges back to back in this frame's instance buffer: meshes of each type and level, then the impostors
+        PropInstance *mapped = propInstanceBuffersMapped[currentFrame];
+        uint64_t meshTriangles = 0;
+        for (uint32_t range = 0; range < PROP_RANGE_COUNT; ++range) {
+            propDrawCounts[range] = static_cast<uint32_t>(propVisible[range].size());
+            memcpy(mapped, propVisible[range].data(), propVisible[range].size() * sizeof(PropInstance));
+            mapped += propVisible[range].size();
+            if (range + 1 < PROP_RANGE_COUNT) {
+                const PropMeshRange &mesh = propMeshRanges[range / MAX_PROP_LODS][range % MAX_PROP_LODS];
+                meshTriangles += static_cast<uint64_t>(propDrawCounts[range]) * (mesh.indexCount / 3);
+                fullDetailTriangles += static_cast<uint64_t>(propDrawCounts[range]) *
+                        (propMeshRanges[range / MAX_PROP_LODS][0].indexCount / 3);
+                propStats.meshInstances += propDrawCounts[range];
+                propStats.lodInstances[range % MAX_PROP_LODS] += propDrawCounts[range];
+            }
+        }
+        propStats.frames++;
+        propStats.impostorInstances += propDrawCounts[PROP_RANGE_COUNT - 1];
+        propStats.triangles += meshTriangles + 2 * static_cast<uint64_t>(propDrawCounts[PROP_RANGE_COUNT - 1]);
+        propStats.meshTriangles += fullDetailTriangles;
+    }
 
-            VkResult result = vkCreateFramebuffer(device, &framebufferInfo, nullptr, &swapChainFramebuffers[i]);
-            VK_CHECK(result, "Failed to create framebuffer " + std::to_string(i));
+    void VulkanEngine::recordProps(VkCommandBuffer commandBuffer, uint32_t view) const {
+        const VkDescriptorSet sets[2] = {propDescriptorSet, descriptorSets[currentFrame]};
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, propPipelineLayout, 0, 2, sets, 0,
+                                nullptr);
+        // Under multiview the matrices come from the UBO and the impostors face the shared camera
+        PropPushConstants constants{};
+        constants.viewProj = views[view].viewProj;
+        constants.eye = glm::vec4(isMultiviewUsed() ? cameraPosition : views[view].eye,
+                                  static_cast<float>(PROP_ATLAS_FRAMES));
+        for (uint32_t type = 0; type < PROP_TYPE_COUNT; ++type) {
+            constants.bounds[type] = propMeshRanges[type][0].bounds;
+        }
+        vkCmdPushConstants(commandBuffer, propPipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(constants),
+                           &constants);
+        const VkBuffer vertexBuffers[2] = {propVertexBuffer, propInstanceBuffers[currentFrame]};
+        const VkDeviceSize offsets[2] = {0, 0};
+        vkCmdBindVertexBuffers(commandBuffer, 0, 2, vertexBuffers, offsets);
+        vkCmdBindIndexBuffer(commandBuffer, propIndexBuffer, 0, VK_INDEX_TYPE_UINT32);
+
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, propMeshPipeline);
+        uint32_t firstInstance = 0;
+        for (uint32_t range = 0; range + 1 < PROP_RANGE_COUNT; ++range) {
+            const PropMeshRange &mesh = propMeshRanges[range / MAX_PROP_LODS][range % MAX_PROP_LODS];
+            if (propDrawCounts[range] > 0) {
+                vkCmdDrawIndexed(commandBuffer, mesh.indexCount, propDrawCounts[range], mesh.firstIndex,
+                                 mesh.vertexOffset, firstInstance);
+            }
+            firstInstance += propDrawCounts[range];
         }
-        spdlog::debug("Created {} framebuffers.", swapChainFramebuffers.size());
+        if (propDrawCounts[PROP_RANGE_COUNT - 1] == 0) return;
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, propImpostorPipeline);
+        vkCmdDraw(commandBuffer, 6, propDrawCounts[PROP_RANGE_COUNT - 1], 0, firstInstance);
     }
 
     // --- Command Pool ---
@@ -1079,6 +5010,15 @@ namespace vk_project_one {
     // --- Buffer Creation Helpers ---
 
     uint32_t VulkanEngine::findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties) {
+        uint32_t typeIndex;
+        if (tryFindMemoryType(typeFilter, properties, typeIndex)) return typeIndex;
+
+        spdlog::critical("Failed to find suitable memory type!");
+        throw std::runtime_error("Failed to find suitable memory type!");
+    }
+
+    bool VulkanEngine::tryFindMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties,
+                                         uint32_t &typeIndex) const {
         VkPhysicalDeviceMemoryProperties memProperties;
         vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memProperties);
 
@@ -1087,22 +5027,50 @@ namespace vk_project_one {
             // AND if it has the required properties (matches all property flags)
             if ((typeFilter & (1 << i)) && (memProperties.memoryTypes[i].propertyFlags & properties) == properties) {
                 spdlog::trace("Found suitable memory type: index {}", i);
-                return i;
+                typeIndex = i;
+                return true;
             }
         }
+        return false;
+    }
 
-        spdlog::critical("Failed to find suitable memory type!");
-        throw std::runtime_error("Failed to find suitable memory type!");
+    VkFormat VulkanEngine::findSupportedFormat(const std::vector<VkFormat> &candidates, VkImageTiling tiling,
+                                               VkFormatFeatureFlags features) const {
+        for (VkFormat format: candidates) {
+            VkFormatProperties properties;
+            vkGetPhysicalDeviceFormatProperties(physicalDevice, format, &properties);
+            const VkFormatFeatureFlags supported = tiling == VK_IMAGE_TILING_LINEAR
+                                                       ? properties.linearTilingFeatures
+                                                       : properties.optimalTilingFeatures;
+            if ((supported & features) == features) return format;
+        }
+
+        spdlog::critical("Failed to find a supported format!");
+        throw std::runtime_error("Failed to find a supported format!");
+    }
+
+    VkFormat VulkanEngine::findDepthFormat(bool sampled) const {
+        VkFormatFeatureFlags features = VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT;
+        if (sampled) features |= VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT;
+        return findSupportedFormat({VK_FORMAT_D32_SFLOAT, VK_FORMAT_D32_SFLOAT_S8_UINT, VK_FORMAT_D24_UNORM_S8_UINT},
+                                   VK_IMAGE_TILING_OPTIMAL, features);
     }
 
-    void VulkanEngine::createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties,
-                                    VkBuffer &buffer, VkDeviceMemory &bufferMemory) {
+    void VulkanEngine::createBuffer(const MemoryTag &tag, VkDeviceSize size, VkBufferUsageFlags usage,
+                                    VkMemoryPropertyFlags properties, VkBuffer &buffer, VkDeviceMemory &bufferMemory,
+                                    bool computeShared) {
         spdlog::trace("Creating buffer (size: {}, usage: {}, properties: {})", size, usage, properties);
         VkBufferCreateInfo bufferInfo{};
         bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
         bufferInfo.size = size;
         bufferInfo.usage = usage;
         bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE; // Assume exclusive for simplicity
+        if (computeShared && asyncComputeAvailable) {
+            // Concurrent sharing spares the ownership transfers between the graphics and compute queue
+            bufferInfo.sharingMode = VK_SHARING_MODE_CONCURRENT;
+            bufferInfo.queueFamilyIndexCount = 2;
+            bufferInfo.pQueueFamilyIndices = sharedQueueFamilies;
+        }
 
         VkResult createResult = vkCreateBuffer(device, &bufferInfo, nullptr, &buffer);
         VK_CHECK(createResult, "Failed to create buffer");
@@ -1118,6 +5086,9 @@ namespace vk_project_one {
 
         VkResult allocResult = vkAllocateMemory(device, &allocInfo, nullptr, &bufferMemory);
         VK_CHECK(allocResult, "Failed to allocate buffer memory");
+        memoryReport.add(bufferMemory, tag, size, allocInfo.allocationSize, allocInfo.memoryTypeIndex);
+        nameObject(VK_OBJECT_TYPE_BUFFER, reinterpret_cast<uint64_t>(buffer), tag.name);
+        nameObject(VK_OBJECT_TYPE_DEVICE_MEMORY, reinterpret_cast<uint64_t>(bufferMemory), tag.name);
 
         // Bind the memory to the buffer
         VkResult bindResult = vkBindBufferMemory(device, buffer, bufferMemory, 0); // Bind at offset 0
@@ -1125,6 +5096,79 @@ namespace vk_project_one {
         spdlog::trace("Buffer created and memory bound successfully.");
     }
 
+    void VulkanEngine::createImage(const MemoryTag &tag, uint32_t width, uint32_t height, VkFormat format,
+                                   VkImageUsageFlags usage, VkMemoryPropertyFlags properties, VkImage &image,
+                                   VkDeviceMemory &imageMemory, VkSampleCountFlagBits numSamples,
+                                   uint32_t arrayLayers, bool computeShared) {
+        spdlog::trace("Creating image ({}x{}, format: {}, usage: {})", width, height, static_cast<int>(format), usage);
+        VkImageCreateInfo imageInfo{};
+        imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        imageInfo.imageType = VK_IMAGE_TYPE_2D;
+        imageInfo.extent = {width, height, 1};
+        imageInfo.mipLevels = 1;
+        imageInfo.arrayLayers = arrayLayers;
+        imageInfo.format = format;
+        imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+        imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        imageInfo.usage = usage;
+        imageInfo.samples = numSamples;
+        imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        createImage(tag, imageInfo, properties, image, imageMemory, computeShared);
+    }
+
+    void VulkanEngine::createImage(const MemoryTag &tag, const VkImageCreateInfo &imageInfo,
+                                   VkMemoryPropertyFlags properties, VkImage &image, VkDeviceMemory &imageMemory,
+                                   bool computeShared) {
+        VkImageCreateInfo sharedInfo = imageInfo;
+        if (computeShared && asyncComputeAvailable) {
+            sharedInfo.sharingMode = VK_SHARING_MODE_CONCURRENT;
+            sharedInfo.queueFamilyIndexCount = 2;
+            sharedInfo.pQueueFamilyIndices = sharedQueueFamilies;
+        }
+        VkResult createResult = vkCreateImage(device, &sharedInfo, nullptr, &image);
+        VK_CHECK(createResult, "Failed to create image");
+
+        VkMemoryRequirements memRequirements;
+        vkGetImageMemoryRequirements(device, image, &memRequirements);
+
+        VkMemoryAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        allocInfo.allocationSize = memRequirements.size;
+        // Lazily allocated memory is only committed if the attachment ever has to leave tile memory.
+        // Desktop GPUs usually do not expose it, so fall back to ordinary device memory.
+        if (!(imageInfo.usage & VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT) ||
+            !tryFindMemoryType(memRequirements.memoryTypeBits, properties | VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT,
+                               allocInfo.memoryTypeIndex)) {
+            allocInfo.memoryTypeIndex = findMemoryType(memRequirements.memoryTypeBits, properties);
+        }
+
+        VkResult allocResult = vkAllocateMemory(device, &allocInfo, nullptr, &imageMemory);
+        VK_CHECK(allocResult, "Failed to allocate image memory");
+        // The layout of an optimal-tiling image is opaque: its whole requirement counts as requested
+        memoryReport.add(imageMemory, tag, memRequirements.size, allocInfo.allocationSize, allocInfo.memoryTypeIndex);
+        nameObject(VK_OBJECT_TYPE_IMAGE, reinterpret_cast<uint64_t>(image), tag.name);
+        nameObject(VK_OBJECT_TYPE_DEVICE_MEMORY, reinterpret_cast<uint64_t>(imageMemory), tag.name);
+
+        VkResult bindResult = vkBindImageMemory(device, image, imageMemory, 0);
+        VK_CHECK(bindResult, "Failed to bind image memory");
+        spdlog::trace("Image created and memory bound successfully.");
+    }
+
+    void VulkanEngine::freeMemory(VkDeviceMemory memory) {
+        memoryReport.remove(memory);
+        vkFreeMemory(device, memory, nullptr);
+    }
+
+    void VulkanEngine::nameObject(VkObjectType type, uint64_t handle, const std::string &name) {
+        if (!setDebugObjectName) return;
+        VkDebugUtilsObjectNameInfoEXT nameInfo{};
+        nameInfo.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_OBJECT_NAME_INFO_EXT;
+        nameInfo.objectType = type;
+        nameInfo.objectHandle = handle;
+        nameInfo.pObjectName = name.c_str();
+        setDebugObjectName(device, &nameInfo);
+    }
+
     // Helper to execute short-lived commands (like buffer copies)
     VkCommandBuffer VulkanEngine::beginSingleTimeCommands() {
         VkCommandBufferAllocateInfo allocInfo{};
@@ -1188,7 +5232,7 @@ namespace vk_project_one {
         // Create staging buffer (CPU accessible)
         VkBuffer stagingBuffer;
         VkDeviceMemory stagingBufferMemory;
-        createBuffer(bufferSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+        createBuffer({MemoryCategory::Staging, "vertex staging"}, bufferSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
                      VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
                      stagingBuffer, stagingBufferMemory);
 
@@ -1201,7 +5245,8 @@ namespace vk_project_one {
         spdlog::trace("  Vertex data copied to staging buffer.");
 
         // Create vertex buffer (GPU local)
-        createBuffer(bufferSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+        createBuffer({MemoryCategory::Geometry, "vertices"},
+                     bufferSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
                      VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
                      vertexBuffer, vertexBufferMemory);
 
@@ -1210,7 +5255,7 @@ namespace vk_project_one {
 
         // Clean up staging buffer
         vkDestroyBuffer(device, stagingBuffer, nullptr);
-        vkFreeMemory(device, stagingBufferMemory, nullptr);
+        freeMemory(stagingBufferMemory);
         spdlog::info("Vertex buffer created (Device Local).");
     }
 
@@ -1222,7 +5267,7 @@ namespace vk_project_one {
         // Staging buffer
         VkBuffer stagingBuffer;
         VkDeviceMemory stagingBufferMemory;
-        createBuffer(bufferSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+        createBuffer({MemoryCategory::Staging, "index staging"}, bufferSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
                      VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
                      stagingBuffer, stagingBufferMemory);
 
@@ -1234,7 +5279,8 @@ namespace vk_project_one {
         spdlog::trace("  Index data copied to staging buffer.");
 
         // Index buffer (GPU local)
-        createBuffer(bufferSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
+        createBuffer({MemoryCategory::Geometry, "indices"},
+                     bufferSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
                      VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
                      indexBuffer, indexBufferMemory);
 
@@ -1243,7 +5289,7 @@ namespace vk_project_one {
 
         // Cleanup staging
         vkDestroyBuffer(device, stagingBuffer, nullptr);
-        vkFreeMemory(device, stagingBufferMemory, nullptr);
+        freeMemory(stagingBufferMemory);
         spdlog::info("Index buffer created (Device Local).");
     }
 
@@ -1258,7 +5304,8 @@ namespace vk_project_one {
         uniformBuffersMapped.resize(MAX_FRAMES_IN_FLIGHT); // Store mapped pointers
 
         for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
-            createBuffer(bufferSize, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+            createBuffer({MemoryCategory::Uniform, "uniforms " + std::to_string(i)},
+                         bufferSize, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
                          // Host Visible: CPU can see it, Host Coherent: No manual flushing needed
                          VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
                          uniformBuffers[i], uniformBuffersMemory[i]);
@@ -1377,6 +5424,143 @@ namespace vk_project_one {
         spdlog::debug("Created {} sets of semaphores and fences.", MAX_FRAMES_IN_FLIGHT);
     }
 
+    void VulkanEngine::createAsyncCompute() {
+        if (!asyncComputeAvailable) return;
+        spdlog::debug("Creating async compute command buffers and timelines...");
+        VkCommandPoolCreateInfo poolInfo{};
+        poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        poolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+        poolInfo.queueFamilyIndex = sharedQueueFamilies[1];
+        VK_CHECK(vkCreateCommandPool(device, &poolInfo, nullptr, &computeCommandPool),
+                 "Failed to create compute command pool!");
+
+        VkCommandBufferAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        allocInfo.commandPool = computeCommandPool;
+        computeCommandBuffers.resize(2 * MAX_FRAMES_IN_FLIGHT);
+        allocInfo.commandBufferCount = static_cast<uint32_t>(computeCommandBuffers.size());
+        VK_CHECK(vkAllocateCommandBuffers(device, &allocInfo, computeCommandBuffers.data()),
+                 "Failed to allocate compute command buffers!");
+        allocInfo.commandPool = commandPool;
+        frameEndCommandBuffers.resize(MAX_FRAMES_IN_FLIGHT);
+        allocInfo.commandBufferCount = static_cast<uint32_t>(frameEndCommandBuffers.size());
+        VK_CHECK(vkAllocateCommandBuffers(device, &allocInfo, frameEndCommandBuffers.data()),
+                 "Failed to allocate frame end command buffers!");
+
+        // Each queue counts its batches up on its own timeline; the other queue waits for a value
+        VkSemaphoreTypeCreateInfo typeInfo{};
+        typeInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+        typeInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+        typeInfo.initialValue = 0;
+        VkSemaphoreCreateInfo semaphoreInfo{};
+        semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+        semaphoreInfo.pNext = &typeInfo;
+        VK_CHECK(vkCreateSemaphore(device, &semaphoreInfo, nullptr, &graphicsTimeline),
+                 "Failed to create graphics timeline semaphore!");
+        VK_CHECK(vkCreateSemaphore(device, &semaphoreInfo, nullptr, &computeTimeline),
+                 "Failed to create compute timeline semaphore!");
+        graphicsTimelineValue = 0;
+        computeTimelineValue = 0;
+    }
+
+    void VulkanEngine::cleanupAsyncCompute() {
+        if (graphicsTimeline != VK_NULL_HANDLE) vkDestroySemaphore(device, graphicsTimeline, nullptr);
+        graphicsTimeline = VK_NULL_HANDLE;
+        if (computeTimeline != VK_NULL_HANDLE) vkDestroySemaphore(device, computeTimeline, nullptr);
+        computeTimeline = VK_NULL_HANDLE;
+        if (computeCommandPool != VK_NULL_HANDLE) vkDestroyCommandPool(device, computeCommandPool, nullptr);
+        computeCommandPool = VK_NULL_HANDLE; // Command buffers freed with pool
+        computeCommandBuffers.clear();
+        frameEndCommandBuffers.clear(); // Freed with the graphics pool
+        computeTimer.destroy();
+    }
+
+    bool VulkanEngine::isAsyncComputeActive() const {
+        if (computeCommandPool == VK_NULL_HANDLE) return false;
+        if (config.particleCount == 0 && config.postEffects == 0) return false; // Nothing to move
+        return !(benchmarkPhaseB && config.benchmarkCompare == BenchmarkCompare::AsyncCompute);
+    }
+
+    // --- GPU Timing ---
+
+    void VulkanEngine::initGpuTiming() {
+        spdlog::debug("Initializing GPU timing...");
+        vk_project_one::QueueFamilyIndices indices = findQueueFamilies(physicalDevice);
+        gpuTimer.init(device, physicalDevice, indices.graphicsFamily.value(), MAX_FRAMES_IN_FLIGHT);
+        gpuScheduler.init(&gpuTimer, MAX_FRAMES_IN_FLIGHT, config.amortizedBudgetMs);
+        gpuScopeFrame = gpuTimer.registerScope("Frame");
+        gpuScopeScene = gpuTimer.registerScope("Scene");
+        gpuScopePost = gpuTimer.registerScope("Post");
+        gpuScopeUpscale = gpuTimer.registerScope("Upscale");
+        gpuScopeEasu = gpuTimer.registerScope("EASU");
+        gpuScopeRcas = gpuTimer.registerScope("RCAS");
+        // A far-field refresh is one slice per cube face; the job's timer scope is named after it
+        impostorJob = gpuScheduler.addJob("Impostor", 6, [this](VkCommandBuffer commandBuffer, uint32_t face) {
+            recordImpostorFace(commandBuffer, face);
+        });
+        gpuScopeImpostor = gpuScheduler.getScope(impostorJob);
+        gpuScopeParticles = gpuTimer.registerScope("Particles");
+        // The static atmosphere LUTs are baked one per slice; the camera-dependent ones every frame
+        atmosphereJob = gpuScheduler.addJob("Atmosphere LUTs", 2, [this](VkCommandBuffer commandBuffer, uint32_t lut) {
+            recordAtmosphereBake(commandBuffer, lut);
+        });
+        gpuScopeAtmosphere = gpuTimer.registerScope("Atmosphere");
+        if (asyncComputeAvailable) {
+            computeTimer.init(device, physicalDevice, sharedQueueFamilies[1], MAX_FRAMES_IN_FLIGHT, 2);
+            computeScopeParticles = computeTimer.registerScope("Particles");
+            computeScopePost = computeTimer.registerScope("Post");
+        }
+
+        if (dynamicResolution && !gpuTimer.isSupported()) {
+            spdlog::warn("Dynamic resolution requires GPU timestamps. Rendering at a fixed scale.");
+            dynamicResolution.reset();
+        }
+    }
+
+    // --- Resource Report ---
+
+    void VulkanEngine::updateResourceReport() {
+        resourceReport.clear();
+        const VkDeviceSize pixels = static_cast<VkDeviceSize>(swapChainExtent.width) * swapChainExtent.height;
+
+        auto addAttachment = [&](const char *name, VkImage image, VkDeviceMemory memory, VkFormat format,
+                                 VkSampleCountFlagBits samples, bool transient, bool stored) {
+            VkMemoryRequirements memRequirements;
+            vkGetImageMemoryRequirements(device, image, &memRequirements);
+            uint32_t lazyType;
+            ResourceReport::Attachment attachment{};
+            attachment.name = name;
+            attachment.format = format;
+            attachment.samples = static_cast<uint32_t>(samples);
+            attachment.allocationSize = memRequirements.size;
+            attachment.transient = transient;
+            // Same choice createImage made for this image
+            attachment.lazilyAllocated = transient && tryFindMemoryType(
+                                             memRequirements.memoryTypeBits,
+                                             VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT |
+                                             VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT, lazyType);
+            attachment.committedSize = attachment.allocationSize;
+            if (attachment.lazilyAllocated) vkGetDeviceMemoryCommitment(device, memory, &attachment.committedSize);
+
+            // Every scene attachment is cleared or fully resolved (no load); only attachments read later are stored
+            const VkDeviceSize surfaceBytes = pixels * formatBytesPerPixel(format) * attachment.samples;
+            attachment.storeBytes = stored ? surfaceBytes : 0;
+            attachment.avoidedBytes = surfaceBytes + (stored ? 0 : surfaceBytes);
+            resourceReport.addAttachment(attachment);
+        };
+
+        if (msaaSamples != VK_SAMPLE_COUNT_1_BIT) {
+            addAttachment("MSAA color", msaaColorImage, msaaColorImageMemory, sceneColorFormat, msaaSamples, true,
+                          false);
+        }
+        addAttachment(msaaSamples != VK_SAMPLE_COUNT_1_BIT ? "Scene resolve" : "Scene color", sceneColorImage,
+                      sceneColorImageMemory, sceneColorFormat, VK_SAMPLE_COUNT_1_BIT, false, true);
+        addAttachment("Scene depth", sceneDepthImage, sceneDepthImageMemory, depthFormat, msaaSamples,
+                      !isDepthSampled(), isDepthSampled());
+        resourceReport.log(swapChainExtent);
+    }
+
     // --- Command Buffer Recording ---
 
     void VulkanEngine::recordCommandBuffer(VkCommandBuffer commandBuffer, uint32_t imageIndex) {
@@ -1389,84 +5573,550 @@ namespace vk_project_one {
         VkResult beginResult = vkBeginCommandBuffer(commandBuffer, &beginInfo);
         VK_CHECK(beginResult, "Failed to begin recording command buffer!");
 
-        // Begin Render Pass
-        VkRenderPassBeginInfo renderPassInfo{};
-        renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-        renderPassInfo.renderPass = renderPass;
-        renderPassInfo.framebuffer = swapChainFramebuffers[imageIndex];
-        renderPassInfo.renderArea.offset = {0, 0};
-        renderPassInfo.renderArea.extent = swapChainExtent;
-        VkClearValue clearColor = {{{0.1f, 0.1f, 0.1f, 1.0f}}}; // Clear color
-        renderPassInfo.clearValueCount = 1;
-        renderPassInfo.pClearValues = &clearColor;
+        gpuTimer.beginFrame(commandBuffer, currentFrame);
+        gpuTimer.beginScope(commandBuffer, gpuScopeFrame);
+
+        // Streamed terrain chunks arrive before anything draws terrain (impostor faces included)
+        if (!terrainChunkSlots.empty()) recordTerrainStreaming(commandBuffer);
+
+        // With async compute, particles and post go into batches of the compute queue (see submitAsyncCompute)
+        const bool async = isAsyncComputeActive();
+        asyncBatchRecorded[0] = asyncBatchRecorded[1] = false;
+        auto beginComputeBatch = [this, &beginInfo](uint32_t batch) {
+            VkCommandBuffer computeBuffer = computeCommandBuffers[2 * currentFrame + batch];
+            vkResetCommandBuffer(computeBuffer, 0);
+            VK_CHECK(vkBeginCommandBuffer(computeBuffer, &beginInfo), "Failed to begin compute command buffer!");
+            if (!asyncBatchRecorded[0]) computeTimer.beginFrame(computeBuffer, currentFrame);
+            asyncBatchRecorded[batch] = true;
+            return computeBuffer;
+        };
 
-        vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+        // Re-render the far-field impostor when it is stale, one face per slice within the GPU budget; the
+        // scene pass samples it below. A new split (or the first render) cannot wait for the slices.
+        const float farFieldSplit = currentFarFieldSplit();
+        if (farFieldSplit > 0.0f && config.farField == FarFieldMode::Impostor) {
+            if (impostorRenderedSplit != farFieldSplit) {
+                gpuScheduler.request(impostorJob, true);
+            } else if (!gpuScheduler.isPending(impostorJob) &&
+                       (frameCount - impostorRefreshFrame >= config.impostorRefreshFrames ||
+                        glm::distance(cameraPosition, impostorCenter) > config.impostorMoveThreshold)) {
+                gpuScheduler.request(impostorJob);
+            }
+        }
+        // Static atmosphere LUTs are re-baked when their parameters change; the first bake cannot wait
+        if (config.postEffects & POST_ATMOSPHERE) {
+            const glm::vec4 medium = atmosphereMedium();
+            if (medium != atmosphereBakedMedium) {
+                gpuScheduler.request(atmosphereJob, atmosphereBakedMedium.x < 0.0f);
+                atmosphereBakedMedium = medium;
+            }
+        }
+        gpuScheduler.record(commandBuffer, currentFrame);
+        if (config.postEffects & POST_ATMOSPHERE) {
+            gpuTimer.beginScope(commandBuffer, gpuScopeAtmosphere);
+            recordAtmosphere(commandBuffer);
+            gpuTimer.endScope(commandBuffer, gpuScopeAtmosphere);
+        }
 
-        // Bind pipeline
-        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, graphicsPipeline);
-
-        // Set dynamic viewport
-        VkViewport viewport{};
-        viewport.x = 0.0f;
-        viewport.y = 0.0f;
-        viewport.width = static_cast<float>(swapChainExtent.width);
-        viewport.height = static_cast<float>(swapChainExtent.height);
-        viewport.minDepth = 0.0f;
-        viewport.maxDepth = 1.0f;
-        vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+        // Particles move before the scene pass draws them
+        if (config.particleCount > 0 && async) {
+            VkCommandBuffer computeBuffer = beginComputeBatch(0);
+            computeTimer.beginScope(computeBuffer, computeScopeParticles);
+            recordParticleSimulation(computeBuffer, true);
+            computeTimer.endScope(computeBuffer, computeScopeParticles);
+            VK_CHECK(vkEndCommandBuffer(computeBuffer), "Failed to record compute command buffer!");
+        } else if (config.particleCount > 0) {
+            gpuTimer.beginScope(commandBuffer, gpuScopeParticles);
+            recordParticleSimulation(commandBuffer, false);
+            gpuTimer.endScope(commandBuffer, gpuScopeParticles);
+        }
 
-        // Set dynamic scissor
-        VkRect2D scissor{};
-        scissor.offset = {0, 0};
-        scissor.extent = swapChainExtent;
-        vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+        // Terrain culling runs once for all views: a chunk is drawn if any view can see it
+        const bool multiview = isMultiviewUsed();
+        Frustum viewFrusta[MAX_VIEWS];
+        for (uint32_t view = 0; view < viewCount; ++view) viewFrusta[view] = Frustum(views[view].viewProj);
+        terrainStats.nearIndices += cullTerrainChunks(viewFrusta, viewCount, cameraPosition, 0.0f,
+                                                      farFieldSplit > 0.0f ? farFieldSplit : CAMERA_FAR);
+        terrainStats.recordedFrames++;
+        if (config.propCount > 0) cullProps(viewFrusta, viewCount);
 
-        // Bind vertex buffer
-        VkBuffer vertexBuffers[] = {vertexBuffer};
-        VkDeviceSize offsets[] = {0};
-        vkCmdBindVertexBuffers(commandBuffer, 0, 1, vertexBuffers, offsets);
+        gpuTimer.beginScope(commandBuffer, gpuScopeScene);
 
-        // Bind index buffer
-        vkCmdBindIndexBuffer(commandBuffer, indexBuffer, 0, VK_INDEX_TYPE_UINT16);
+        // Begin Render Pass (only the scaled region of the scene target is rendered; under multiview
+        // that is one view wide and covers every layer)
+        VkRenderPassBeginInfo renderPassInfo{};
+        renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+        renderPassInfo.renderPass = renderPass;
+        renderPassInfo.framebuffer = sceneFramebuffer;
+        renderPassInfo.renderArea.offset = {0, 0};
+        renderPassInfo.renderArea.extent = multiview ? viewRegion(0).extent : renderExtent;
+        VkClearValue clearValues[2]{};
+        clearValues[0].color = {{0.1f, 0.1f, 0.1f, 1.0f}}; // Clear color
+        clearValues[1].depthStencil = {1.0f, 0};
+        renderPassInfo.clearValueCount = 2;
+        renderPassInfo.pClearValues = clearValues;
 
-        // Bind descriptor set for the current frame
-        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout,
-                                0, 1, &descriptorSets[currentFrame], 0, nullptr);
+        vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
 
-        // Draw indexed command
-        vkCmdDrawIndexed(commandBuffer, static_cast<uint32_t>(cubeIndices.size()), 1, 0, 0, 0);
+        // Multiview records the draws once for all layers; otherwise once per view into its viewport
+        const uint32_t passCount = multiview ? 1 : viewCount;
+        for (uint32_t view = 0; view < passCount; ++view) {
+            // Bind pipeline
+            vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, graphicsPipeline);
+
+            // Set dynamic viewport and scissor to the view's region
+            const VkRect2D region = viewRegion(view);
+            VkViewport viewport{};
+            viewport.x = static_cast<float>(region.offset.x);
+            viewport.y = 0.0f;
+            viewport.width = static_cast<float>(region.extent.width);
+            viewport.height = static_cast<float>(region.extent.height);
+            viewport.minDepth = 0.0f;
+            viewport.maxDepth = 1.0f;
+            vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+            vkCmdSetScissor(commandBuffer, 0, 1, &region);
+
+            // Bind vertex buffer
+            VkBuffer vertexBuffers[] = {vertexBuffer};
+            VkDeviceSize offsets[] = {0};
+            vkCmdBindVertexBuffers(commandBuffer, 0, 1, vertexBuffers, offsets);
+
+            // Bind index buffer
+            vkCmdBindIndexBuffer(commandBuffer, indexBuffer, 0, VK_INDEX_TYPE_UINT16);
+
+            // Bind descriptor set for the current frame
+            vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout,
+                                    0, 1, &descriptorSets[currentFrame], 0, nullptr);
+            vkCmdPushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(view), &view);
+
+            // Draw indexed command
+            vkCmdDrawIndexed(commandBuffer, static_cast<uint32_t>(cubeIndices.size()), 1, 0, 0, 0);
+
+            // Terrain: near chunks as geometry, then the far field when enabled
+            recordTerrain(commandBuffer, farFieldSplit, view);
+            if (config.propCount > 0) recordProps(commandBuffer, view);
+
+            // Particles last, blended over the opaque scene
+            if (config.particleCount > 0) recordParticleDraw(commandBuffer, view);
+        }
 
         // Draw Text (Placeholder)
         // drawText(commandBuffer);
 
         // End render pass
         vkCmdEndRenderPass(commandBuffer);
+        gpuTimer.endScope(commandBuffer, gpuScopeScene);
+
+        if (async) {
+            // The scene pass batch ends here; the rest of the frame follows the compute queue's post pass
+            VK_CHECK(vkEndCommandBuffer(commandBuffer), "Failed to record command buffer!");
+            commandBuffer = frameEndCommandBuffers[currentFrame];
+            vkResetCommandBuffer(commandBuffer, 0);
+            VK_CHECK(vkBeginCommandBuffer(commandBuffer, &beginInfo), "Failed to begin frame end command buffer!");
+        }
+        if (config.postEffects != 0 && async) {
+            VkCommandBuffer computeBuffer = beginComputeBatch(1);
+            computeTimer.beginScope(computeBuffer, computeScopePost);
+            recordPostProcess(computeBuffer);
+            computeTimer.endScope(computeBuffer, computeScopePost);
+            VK_CHECK(vkEndCommandBuffer(computeBuffer), "Failed to record compute command buffer!");
+        } else if (config.postEffects != 0) {
+            gpuTimer.beginScope(commandBuffer, gpuScopePost);
+            recordPostProcess(commandBuffer);
+            gpuTimer.endScope(commandBuffer, gpuScopePost);
+        }
+
+        // Scale the rendered region into the swapchain image
+        gpuTimer.beginScope(commandBuffer, gpuScopeUpscale);
+        recordSceneUpscale(commandBuffer, imageIndex);
+        gpuTimer.endScope(commandBuffer, gpuScopeUpscale);
+        gpuTimer.endScope(commandBuffer, gpuScopeFrame);
 
         // End recording
         VkResult endResult = vkEndCommandBuffer(commandBuffer);
         VK_CHECK(endResult, "Failed to record command buffer!");
     }
 
+    void VulkanEngine::recordSceneUpscale(VkCommandBuffer commandBuffer, uint32_t imageIndex) {
+        if (isFsrActive()) {
+            recordFsrUpscale(commandBuffer, imageIndex);
+            return;
+        }
+
+        // The post pass already left its output in the transfer source layout
+        const bool postEnabled = config.postEffects != 0;
+        VkImage sourceImage = postEnabled ? postImage : sceneColorImage;
+
+        // Swapchain image: previous contents are irrelevant, it is fully overwritten.
+        // The acquire semaphore is waited on at the transfer stage, which this barrier chains to.
+        VkImageMemoryBarrier barriers[2];
+        uint32_t barrierCount = 0;
+        barriers[barrierCount++] = makeImageBarrier(swapChainImages[imageIndex], VK_IMAGE_LAYOUT_UNDEFINED,
+                                                    VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 0,
+                                                    VK_ACCESS_TRANSFER_WRITE_BIT);
+        const bool multiview = isMultiviewUsed();
+        if (!postEnabled && sceneFinalLayout != VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL) {
+            barriers[barrierCount] = makeImageBarrier(sceneColorImage, sceneFinalLayout,
+                                                      VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, 0,
+                                                      VK_ACCESS_TRANSFER_READ_BIT);
+            barriers[barrierCount++].subresourceRange.layerCount = multiview ? viewCount : 1;
+        }
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             0, 0, nullptr, 0, nullptr, barrierCount, barriers);
+
+        if (sceneBlitSupported) {
+            recordFrameBlit(commandBuffer, swapChainImages[imageIndex], presentExtent);
+        } else {
+            // No blit support: renderExtent is always the full extent and resizes are never deferred, so a
+            // plain copy is enough
+            VkImageCopy copy{};
+            copy.srcSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
+            copy.dstSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
+            copy.extent = {swapChainExtent.width, swapChainExtent.height, 1};
+            vkCmdCopyImage(commandBuffer, sourceImage, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                           swapChainImages[imageIndex], VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &copy);
+        }
+
+        // Transition for presentation (the present semaphore provides the visibility guarantee)
+        VkImageMemoryBarrier presentBarrier = makeImageBarrier(swapChainImages[imageIndex],
+                                                               VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                                               VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
+                                                               VK_ACCESS_TRANSFER_WRITE_BIT, 0);
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                             0, 0, nullptr, 0, nullptr, 1, &presentBarrier);
+    }
+
+    void VulkanEngine::recordFrameBlit(VkCommandBuffer commandBuffer, VkImage dstImage, VkExtent2D dstExtent) const {
+        if (isFsrActive()) {
+            // The RCAS output is already at the first window's resolution
+            VkImageBlit blit{};
+            blit.srcSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
+            blit.srcOffsets[1] = {
+                static_cast<int32_t>(swapChainExtent.width), static_cast<int32_t>(swapChainExtent.height), 1
+            };
+            blit.dstSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
+            blit.dstOffsets[1] = {static_cast<int32_t>(dstExtent.width), static_cast<int32_t>(dstExtent.height), 1};
+            vkCmdBlitImage(commandBuffer, sharpenImage, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, dstImage,
+                           VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &blit, VK_FILTER_LINEAR);
+            return;
+        }
+
+        // One region per view: its slice (or layer, under multiview) goes to its share of the width
+        const VkImage sourceImage = config.postEffects != 0 ? postImage : sceneColorImage;
+        const bool multiview = isMultiviewUsed();
+        VkImageBlit blits[MAX_VIEWS]{};
+        for (uint32_t view = 0; view < viewCount; ++view) {
+            const VkRect2D region = viewRegion(view);
+            VkImageBlit &blit = blits[view];
+            blit.srcSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, multiview ? view : 0, 1};
+            blit.srcOffsets[0] = {region.offset.x, 0, 0};
+            blit.srcOffsets[1] = {
+                region.offset.x + static_cast<int32_t>(region.extent.width),
+                static_cast<int32_t>(region.extent.height), 1
+            };
+            blit.dstSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
+            blit.dstOffsets[0] = {static_cast<int32_t>(view * dstExtent.width / viewCount), 0, 0};
+            blit.dstOffsets[1] = {
+                static_cast<int32_t>((view + 1) * dstExtent.width / viewCount), static_cast<int32_t>(dstExtent.height),
+                1
+            };
+        }
+        vkCmdBlitImage(commandBuffer, sourceImage, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, dstImage,
+                       VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, viewCount, blits, VK_FILTER_LINEAR);
+    }
+
+    void VulkanEngine::recordWindowOutput(VkCommandBuffer commandBuffer, const WindowOutput &output) const {
+        VkCommandBufferBeginInfo beginInfo{};
+        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+        VK_CHECK(vkBeginCommandBuffer(commandBuffer, &beginInfo), "Failed to begin window output command buffer!");
+
+        // The frame is already in the transfer source layout and visible to transfers: the main command
+        // buffer's barriers cover every later command of the submission. Only the swapchain image needs
+        // a transition, chained to the acquire wait at the transfer stage.
+        const VkImage image = output.images[output.imageIndex];
+        VkImageMemoryBarrier toTransfer = makeImageBarrier(image, VK_IMAGE_LAYOUT_UNDEFINED,
+                                                           VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 0,
+                                                           VK_ACCESS_TRANSFER_WRITE_BIT);
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0,
+                             nullptr, 0, nullptr, 1, &toTransfer);
+        recordFrameBlit(commandBuffer, image, output.extent);
+        VkImageMemoryBarrier toPresent = makeImageBarrier(image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                                          VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
+                                                          VK_ACCESS_TRANSFER_WRITE_BIT, 0);
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0,
+                             0, nullptr, 0, nullptr, 1, &toPresent);
+
+        VK_CHECK(vkEndCommandBuffer(commandBuffer), "Failed to record window output command buffer!");
+    }
+
+    void VulkanEngine::recordFsrUpscale(VkCommandBuffer commandBuffer, uint32_t imageIndex) {
+        const VkExtent2D outExtent = swapChainExtent;
+        const uint32_t groupsX = (outExtent.width + 7) / 8; // 8x8 local size
+        const uint32_t groupsY = (outExtent.height + 7) / 8;
+
+        // upscaleImage is fully overwritten; only wait for last frame's RCAS to stop reading it
+        VkImageMemoryBarrier toGeneral = makeImageBarrier(upscaleImage, VK_IMAGE_LAYOUT_UNDEFINED,
+                                                          VK_IMAGE_LAYOUT_GENERAL, 0, VK_ACCESS_SHADER_WRITE_BIT);
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                             0, 0, nullptr, 0, nullptr, 1, &toGeneral);
+
+        // --- EASU ---
+        gpuTimer.beginScope(commandBuffer, gpuScopeEasu);
+        UpscalePushConstants easuConstants{};
+        const float scaleX = static_cast<float>(renderExtent.width) / static_cast<float>(outExtent.width);
+        const float scaleY = static_cast<float>(renderExtent.height) / static_cast<float>(outExtent.height);
+        easuConstants.con0 = glm::vec4(scaleX, scaleY, 0.5f * scaleX - 0.5f, 0.5f * scaleY - 0.5f);
+        easuConstants.extents = glm::ivec4(outExtent.width, outExtent.height, renderExtent.width, renderExtent.height);
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, easuPipeline);
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, upscalePipelineLayout, 0, 1,
+                                &easuDescriptorSet, 0, nullptr);
+        vkCmdPushConstants(commandBuffer, upscalePipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0,
+                           sizeof(easuConstants), &easuConstants);
+        vkCmdDispatch(commandBuffer, groupsX, groupsY, 1);
+        gpuTimer.endScope(commandBuffer, gpuScopeEasu);
+
+        // EASU writes -> RCAS reads; sharpenImage must no longer be read by last frame's copy
+        VkImageMemoryBarrier rcasBarriers[2] = {
+            makeImageBarrier(upscaleImage, VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_LAYOUT_GENERAL,
+                             VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT),
+            makeImageBarrier(sharpenImage, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_GENERAL,
+                             0, VK_ACCESS_SHADER_WRITE_BIT)
+        };
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 2, rcasBarriers);
+
+        // --- RCAS ---
+        gpuTimer.beginScope(commandBuffer, gpuScopeRcas);
+        UpscalePushConstants rcasConstants{};
+        rcasConstants.con0 = glm::vec4(std::exp2(-config.sharpness), 0.0f, 0.0f, 0.0f);
+        rcasConstants.extents = glm::ivec4(outExtent.width, outExtent.height, outExtent.width, outExtent.height);
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, rcasPipeline);
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, upscalePipelineLayout, 0, 1,
+                                &rcasDescriptorSet, 0, nullptr);
+        vkCmdPushConstants(commandBuffer, upscalePipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0,
+                           sizeof(rcasConstants), &rcasConstants);
+        vkCmdDispatch(commandBuffer, groupsX, groupsY, 1);
+        gpuTimer.endScope(commandBuffer, gpuScopeRcas);
+
+        // RCAS output -> copy source; swapchain image -> copy destination (chains to the acquire wait)
+        VkImageMemoryBarrier copyBarriers[2] = {
+            makeImageBarrier(sharpenImage, VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                             VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT),
+            makeImageBarrier(swapChainImages[imageIndex], VK_IMAGE_LAYOUT_UNDEFINED,
+                             VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 0, VK_ACCESS_TRANSFER_WRITE_BIT)
+        };
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 2, copyBarriers);
+
+        // The blit converts RGBA8 UNORM into the swapchain format; it is same-size unless a resize is deferred
+        const bool stretched = presentExtent.width != outExtent.width || presentExtent.height != outExtent.height;
+        VkImageBlit blit{};
+        blit.srcSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
+        blit.srcOffsets[1] = {static_cast<int32_t>(outExtent.width), static_cast<int32_t>(outExtent.height), 1};
+        blit.dstSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
+        blit.dstOffsets[1] = {
+            static_cast<int32_t>(presentExtent.width), static_cast<int32_t>(presentExtent.height), 1
+        };
+        vkCmdBlitImage(commandBuffer, sharpenImage, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                       swapChainImages[imageIndex], VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &blit,
+                       stretched ? VK_FILTER_LINEAR : VK_FILTER_NEAREST);
+
+        VkImageMemoryBarrier presentBarrier = makeImageBarrier(swapChainImages[imageIndex],
+                                                               VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                                               VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
+                                                               VK_ACCESS_TRANSFER_WRITE_BIT, 0);
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                             0, 0, nullptr, 0, nullptr, 1, &presentBarrier);
+    }
+
+
+    void VulkanEngine::recordAtmosphereBake(VkCommandBuffer commandBuffer, uint32_t slice) {
+        // The LUT may still be read by earlier frames, and multiple scattering reads transmittance
+        VkMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                             0, 1, &barrier, 0, nullptr, 0, nullptr);
+
+        AtmospherePushConstants constants{};
+        constants.medium = atmosphereMedium();
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, atmospherePipelines[slice]);
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, atmospherePipelineLayout, 0, 1,
+                                &atmosphereDescriptorSet, 0, nullptr);
+        vkCmdPushConstants(commandBuffer, atmospherePipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(constants),
+                           &constants);
+        const VkExtent3D extent = ATMOSPHERE_LUT_EXTENTS[slice];
+        vkCmdDispatch(commandBuffer, (extent.width + 7) / 8, (extent.height + 7) / 8, 1);
+    }
+
+    void VulkanEngine::recordAtmosphere(VkCommandBuffer commandBuffer) {
+        // After a bake in this frame (or an earlier one), and after last frame's post pass stopped reading
+        VkMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                             0, 1, &barrier, 0, nullptr, 0, nullptr);
+
+        glm::vec3 rayX, rayY;
+        cameraRays(cameraForward, viewAspect(), rayX, rayY);
+        AtmospherePushConstants constants{};
+        constants.medium = atmosphereMedium();
+        constants.sun = glm::vec4(SUN_DIRECTION, cameraPosition.y * ATMOSPHERE_KM_PER_UNIT);
+        constants.rayX = glm::vec4(rayX, 0.0f);
+        constants.rayY = glm::vec4(rayY, 0.0f);
+        constants.rayZ = glm::vec4(cameraForward, 0.0f);
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, atmospherePipelineLayout, 0, 1,
+                                &atmosphereDescriptorSet, 0, nullptr);
+        vkCmdPushConstants(commandBuffer, atmospherePipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(constants),
+                           &constants);
+        // The sky view and the aerial perspective columns are independent of each other
+        for (uint32_t lut = 2; lut < ATMOSPHERE_LUT_COUNT; ++lut) {
+            const VkExtent3D extent = ATMOSPHERE_LUT_EXTENTS[lut];
+            vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, atmospherePipelines[lut]);
+            vkCmdDispatch(commandBuffer, (extent.width + 7) / 8, (extent.height + 7) / 8, 1);
+        }
+
+        // Sampled by the post pass after the scene pass
+        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                             0, 1, &barrier, 0, nullptr, 0, nullptr);
+    }
+
+    void VulkanEngine::recordPostProcess(VkCommandBuffer commandBuffer) {
+        const bool chained = benchmarkPhaseB && config.benchmarkCompare == BenchmarkCompare::PostChain;
+        const uint32_t groupsX = (renderExtent.width + 7) / 8; // 8x8 local size
+        const uint32_t groupsY = (renderExtent.height + 7) / 8;
+
+        // Outputs are fully overwritten; only wait for last frame's upscale to stop reading them.
+        // Scene color and depth are made visible by the render pass's outgoing dependency.
+        VkImageMemoryBarrier toGeneral[2];
+        uint32_t barrierCount = 0;
+        toGeneral[barrierCount++] = makeImageBarrier(postImage, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_GENERAL,
+                                                     0, VK_ACCESS_SHADER_WRITE_BIT);
+        if (chained) {
+            toGeneral[barrierCount++] = makeImageBarrier(postScratchImage, VK_IMAGE_LAYOUT_UNDEFINED,
+                                                         VK_IMAGE_LAYOUT_GENERAL, 0, VK_ACCESS_SHADER_WRITE_BIT);
+        }
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                             VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 0, nullptr, 0, nullptr, barrierCount, toGeneral);
+
+        PostPushConstants constants{};
+        constants.fogColorDensity = glm::vec4(0.5f, 0.55f, 0.6f, config.fogDensity);
+        constants.camera = glm::vec4(CAMERA_NEAR, CAMERA_FAR, config.exposure, config.vignetteStrength);
+        constants.extents = glm::ivec4(renderExtent.width, renderExtent.height, swapChainExtent.width,
+                                       swapChainExtent.height);
+        constants.frame = glm::uvec4(static_cast<uint32_t>(frameCount), 0u, 0u, 0u);
+        glm::vec3 rayX, rayY;
+        cameraRays(cameraForward, viewAspect(), rayX, rayY);
+        constants.rayX = glm::vec4(rayX, SUN_DIRECTION.x);
+        constants.rayY = glm::vec4(rayY, SUN_DIRECTION.y);
+        constants.rayZ = glm::vec4(cameraForward, SUN_DIRECTION.z);
+        constants.atmosphere = glm::vec4(cameraPosition.y * ATMOSPHERE_KM_PER_UNIT, ATMOSPHERE_KM_PER_UNIT,
+                                         SUN_ILLUMINANCE, ATMOSPHERE_AERIAL_DEPTH_KM);
+        vkCmdPushConstants(commandBuffer, postPipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(constants),
+                           &constants);
+
+        if (!chained) {
+            vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, postPipeline);
+            vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, postPipelineLayout, 0, 1,
+                                    &postDescriptorSets[0], 0, nullptr);
+            vkCmdDispatch(commandBuffer, groupsX, groupsY, 1);
+        } else {
+            // One full-screen pass per effect, ping-ponging so that the last pass lands in postImage.
+            // Sets: 0 scene->post, 1 scene->scratch, 2 scratch->post, 3 post->scratch
+            uint32_t remaining = 0;
+            for (uint32_t i = 0; i < POST_EFFECT_COUNT; ++i) {
+                if (config.postEffects & (1u << i)) remaining++;
+            }
+            bool first = true;
+            for (uint32_t i = 0; i < POST_EFFECT_COUNT; ++i) {
+                if (!(config.postEffects & (1u << i))) continue;
+                remaining--;
+                const bool toPost = remaining % 2 == 0;
+                const uint32_t setIndex = first ? (toPost ? 0 : 1) : (toPost ? 2 : 3);
+                if (!first) {
+                    // Previous pass output -> this pass input (and its input may now be overwritten)
+                    VkMemoryBarrier passBarrier{};
+                    passBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+                    passBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+                    passBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+                    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                                         VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &passBarrier, 0, nullptr, 0,
+                                         nullptr);
+                }
+                vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, postEffectPipelines[i]);
+                vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, postPipelineLayout, 0, 1,
+                                        &postDescriptorSets[setIndex], 0, nullptr);
+                vkCmdDispatch(commandBuffer, groupsX, groupsY, 1);
+                first = false;
+            }
+        }
+
+        // Hand the result to the upscaler: sampled by EASU or blitted into the swapchain image
+        const bool fsr = isFsrActive();
+        VkImageMemoryBarrier toUpscale = makeImageBarrier(postImage, VK_IMAGE_LAYOUT_GENERAL,
+                                                          fsr
+                                                              ? VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
+                                                              : VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                                                          VK_ACCESS_SHADER_WRITE_BIT,
+                                                          fsr ? VK_ACCESS_SHADER_READ_BIT : VK_ACCESS_TRANSFER_READ_BIT);
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                             fsr ? VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT : VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             0, 0, nullptr, 0, nullptr, 1, &toUpscale);
+    }
+
 
     // --- Update and Drawing Logic ---
 
     // Renamed from updateUniformBuffer to reflect purpose
     void VulkanEngine::updateCubeRotation(float time) {
+        simulationTime = time; // The particles step by the difference to their last update
         // This now calculates AND copies the UBO data
         UniformBufferObject ubo{};
-        // Rotate model around Y axis
-        ubo.model = glm::rotate(glm::mat4(1.0f), time * glm::radians(45.0f), glm::vec3(0.0f, 1.0f, 0.0f));
-        // Set up view matrix (camera)
-        ubo.view = glm::lookAt(glm::vec3(2.0f, 2.0f, 2.0f), // Eye position
-                               glm::vec3(0.0f, 0.0f, 0.0f), // Target position
-                               glm::vec3(0.0f, 1.0f, 0.0f)); // Up direction (Y-up)
-        // Set up projection matrix
-        ubo.proj = glm::perspective(glm::radians(45.0f), // Field of view
-                                    (float) swapChainExtent.width / (float) swapChainExtent.height, // Aspect ratio
-                                    0.1f, // Near plane
-                                    10.0f); // Far plane
+        // The cube spins above the middle of the terrain
+        const glm::vec3 terrainCenter = (terrainBoundsMin + terrainBoundsMax) * 0.5f;
+        const glm::vec3 cubePosition = {terrainCenter.x, terrainBoundsMax.y + 8.0f, terrainCenter.z};
+        ubo.model = glm::translate(glm::mat4(1.0f), cubePosition) *
+                    glm::rotate(glm::mat4(1.0f), time * glm::radians(45.0f), glm::vec3(0.0f, 1.0f, 0.0f)) *
+                    glm::scale(glm::mat4(1.0f), glm::vec3(6.0f));
+        // Camera circles the cube slowly, so the near terrain keeps changing under it
+        const float orbitAngle = time * 0.1f;
+        cameraPosition = cubePosition + glm::vec3(96.0f * std::cos(orbitAngle), 16.0f, 96.0f * std::sin(orbitAngle));
+        cameraForward = glm::normalize(cubePosition - cameraPosition);
+        const glm::mat4 view = glm::lookAt(cameraPosition, // Eye position
+                                           cubePosition, // Target position
+                                           glm::vec3(0.0f, 1.0f, 0.0f)); // Up direction (Y-up)
+        // Set up projection matrix (one view wide)
+        const float aspect = viewAspect();
+        glm::mat4 proj = glm::perspective(glm::radians(CAMERA_FOV_Y), // Field of view
+                                          aspect, // Aspect ratio
+                                          CAMERA_NEAR, // Near plane
+                                          CAMERA_FAR); // Far plane
         // Adjust for Vulkan clip space (Y coordinate flipped)
-        ubo.proj[1][1] *= -1;
+        proj[1][1] *= -1;
+        cameraViewProj = proj * view;
+
+        // Wrap: views fan out around the camera, each turned by one horizontal field of view.
+        // Stereo: the eyes sit half the separation to either side, looking the same way.
+        const float horizontalFov = 2.0f * std::atan(std::tan(glm::radians(CAMERA_FOV_Y) * 0.5f) * aspect);
+        for (uint32_t i = 0; i < viewCount; ++i) {
+            glm::mat4 viewMatrix;
+            if (config.viewLayout == ViewLayout::Stereo) {
+                const float offset = (i == 0 ? 0.5f : -0.5f) * config.eyeSeparation;
+                viewMatrix = glm::translate(glm::mat4(1.0f), glm::vec3(offset, 0.0f, 0.0f)) * view;
+            } else {
+                const float angle = (static_cast<float>(i) - 0.5f * static_cast<float>(viewCount - 1)) * horizontalFov;
+                viewMatrix = glm::rotate(glm::mat4(1.0f), angle, glm::vec3(0.0f, 1.0f, 0.0f)) * view;
+            }
+            const glm::mat4 cameraToWorld = glm::inverse(viewMatrix);
+            views[i].viewProj = proj * viewMatrix;
+            views[i].eye = glm::vec3(cameraToWorld[3]);
+            views[i].forward = -glm::vec3(cameraToWorld[2]);
+            ubo.viewProj[i] = views[i].viewProj;
+        }
 
         // Copy data to the mapped buffer for the current frame in flight
         if (uniformBuffersMapped.size() > currentFrame && uniformBuffersMapped[currentFrame]) {
@@ -1478,13 +6128,47 @@ namespace vk_project_one {
     }
 
 
-    void VulkanEngine::drawFrame() {
+    VulkanEngine::FrameStatus VulkanEngine::drawFrame() {
+        // Resize benchmark: while measuring the resizing phase, the window changes width every few calls
+        constexpr uint32_t RESIZE_BENCHMARK_PERIOD = 4;
+        if (config.benchmarkCompare == BenchmarkCompare::Resize && !benchmarkPhaseB &&
+            resizeBenchmarkCalls++ % RESIZE_BENCHMARK_PERIOD == 0) {
+            int width = 0, height = 0;
+            SDL_GetWindowSize(window, &width, &height);
+            const bool grow = (resizeBenchmarkCalls / RESIZE_BENCHMARK_PERIOD) % 2 == 0;
+            SDL_SetWindowSize(window, grow ? width + 64 : width - 64, height);
+        }
+
+        const auto callStart = std::chrono::steady_clock::now();
+        const FrameStatus status = renderFrame();
+        FrameStatusStats &stats = frameStatusStats[static_cast<size_t>(status)];
+        stats.calls++;
+        const auto callTime = std::chrono::steady_clock::now() - callStart;
+        stats.cpuMsSum += std::chrono::duration<float, std::milli>(callTime).count();
+        return status;
+    }
+
+    VulkanEngine::FrameStatus VulkanEngine::renderFrame() {
         // spdlog::trace("drawFrame start (frame {})", currentFrame); // Can be noisy
+        if (swapChainState == SwapChainState::DeviceLost) return FrameStatus::DeviceLost;
+        if (swapChainState == SwapChainState::Minimized) {
+            int width = 0, height = 0;
+            SDL_GetWindowSizeInPixels(window, &width, &height);
+            if (width == 0 || height == 0) return FrameStatus::Skipped;
+            recreateSwapChain(); // Restored
+            return swapChainState == SwapChainState::DeviceLost ? FrameStatus::DeviceLost : FrameStatus::Recreated;
+        }
 
         // 1. Wait for the previous frame (using fence for the current frame index) to finish
-        vkWaitForFences(device, 1, &inFlightFences[currentFrame], VK_TRUE, UINT64_MAX);
+        const VkResult fenceResult = vkWaitForFences(device, 1, &inFlightFences[currentFrame], VK_TRUE, UINT64_MAX);
+        if (checkDeviceLost(fenceResult, "waiting for a frame")) return FrameStatus::DeviceLost;
         // Note: Fence was reset just after vkAcquireNextImageKHR in the previous successful submission
 
+        // The frame slot's GPU work is complete, so its timestamps can be read without stalling
+        updateFrameTimings();
+        destroyRetiredSwapChains(false);
+        if (frameCount >= MAX_FRAMES_IN_FLIGHT) terrainChunkPool.reclaim(frameCount - MAX_FRAMES_IN_FLIGHT);
+
         // 2. Acquire an image from the swap chain
         uint32_t imageIndex; // Index of the swap chain image that is available
         VkResult acquireResult = vkAcquireNextImageKHR(device, swapChain, UINT64_MAX,
@@ -1494,15 +6178,44 @@ namespace vk_project_one {
                                                        &imageIndex);
 
         if (acquireResult == VK_ERROR_OUT_OF_DATE_KHR) {
-            spdlog::warn("Swap chain out of date during image acquisition. Recreating.");
-            recreateSwapChain(); // Recreate swapchain and dependent resources
-            throw SwapChainOutOfDateError(); // Signal loop to potentially skip rest of frame logic
+            spdlog::debug("Swap chain out of date during image acquisition.");
+            noteSwapChainResize();
+            // Nothing was acquired, so the frame is dropped; the next call renders into the new swapchain
+            if (handleResize(true)) return FrameStatus::Recreated;
+            return swapChainState == SwapChainState::DeviceLost ? FrameStatus::DeviceLost : FrameStatus::Skipped;
+        } else if (checkDeviceLost(acquireResult, "acquiring a swapchain image")) {
+            return FrameStatus::DeviceLost;
         } else if (acquireResult != VK_SUCCESS && acquireResult != VK_SUBOPTIMAL_KHR) {
             // Suboptimal means it still works but presentation might not be perfect
             spdlog::critical("Failed to acquire swap chain image! VkResult: {}", static_cast<int>(acquireResult));
             throw std::runtime_error("Failed to acquire swap chain image!");
         }
 
+        // Further windows acquire after the first, whose failure above would leave their semaphores signaled.
+        // A window that cannot present this frame (minimized, out of date) is simply left out of it. The per-window
+        // lists below are fixed arrays (config clamps windowCount to MAX_WINDOWS), so presenting never allocates.
+        WindowOutput *presentedOutputs[MAX_WINDOWS];
+        uint32_t presentedCount = 0;
+        for (WindowOutput &output: windowOutputs) {
+            if (output.resized || isResizeDue(output.pendingResize)) recreateWindowOutputSwapChain(output);
+            if (output.swapChain == VK_NULL_HANDLE) continue;
+            VkResult outputAcquire = vkAcquireNextImageKHR(device, output.swapChain, UINT64_MAX,
+                                                           output.imageAvailableSemaphores[currentFrame],
+                                                           VK_NULL_HANDLE, &output.imageIndex);
+            if (outputAcquire == VK_ERROR_OUT_OF_DATE_KHR) {
+                noteResize(output.pendingResize);
+                output.resized = true;
+            } else if (checkDeviceLost(outputAcquire, "acquiring a window output image")) {
+                return FrameStatus::DeviceLost;
+            } else if (outputAcquire != VK_SUCCESS && outputAcquire != VK_SUBOPTIMAL_KHR) {
+                spdlog::critical("Failed to acquire window output image! VkResult: {}",
+                                 static_cast<int>(outputAcquire));
+                throw std::runtime_error("Failed to acquire window output image!");
+            } else {
+                presentedOutputs[presentedCount++] = &output;
+            }
+        }
+
         // Image acquired successfully (or suboptimal)
         // NOW we can reset the fence, because we know we are going to submit work for this frame
         vkResetFences(device, 1, &inFlightFences[currentFrame]);
@@ -1512,57 +6225,510 @@ namespace vk_project_one {
 
         // 4. Record the command buffer for the acquired image index
         vkResetCommandBuffer(commandBuffers[currentFrame], 0); // Reset before recording
+        const auto recordStart = std::chrono::steady_clock::now();
         recordCommandBuffer(commandBuffers[currentFrame], imageIndex); // Pass acquired image index
+        const auto recordTime = std::chrono::steady_clock::now() - recordStart;
+        recordCpuMsSum += std::chrono::duration<float, std::milli>(recordTime).count();
+        recordCpuFrames++;
+
+        // An async frame submits its scene pass and compute batches first; the final batch holds the upscale
+        const bool async = isAsyncComputeActive();
+        if (async && checkDeviceLost(submitAsyncCompute(), "submitting async compute")) return FrameStatus::DeviceLost;
+
+        // One command buffer, acquire and finish semaphore per window; the first window's comes first. The
+        // semaphore lists have room for the compute timelines after the windows' binary semaphores.
+        VkCommandBuffer submitCommandBuffers[MAX_WINDOWS];
+        VkSemaphore waitSemaphores[MAX_WINDOWS + 1];
+        VkSemaphore signalSemaphores[MAX_WINDOWS + 1];
+        VkSwapchainKHR swapChains[MAX_WINDOWS];
+        uint32_t imageIndices[MAX_WINDOWS];
+        submitCommandBuffers[0] = async ? frameEndCommandBuffers[currentFrame] : commandBuffers[currentFrame];
+        waitSemaphores[0] = imageAvailableSemaphores[currentFrame];
+        signalSemaphores[0] = renderFinishedSemaphores[currentFrame];
+        swapChains[0] = swapChain;
+        imageIndices[0] = imageIndex;
+        const uint32_t swapChainCount = presentedCount + 1;
+        for (uint32_t i = 0; i < presentedCount; ++i) {
+            WindowOutput &output = *presentedOutputs[i];
+            VkCommandBuffer outputCommandBuffer = output.commandBuffers[currentFrame];
+            vkResetCommandBuffer(outputCommandBuffer, 0);
+            recordWindowOutput(outputCommandBuffer, output);
+            submitCommandBuffers[i + 1] = outputCommandBuffer;
+            waitSemaphores[i + 1] = output.imageAvailableSemaphores[currentFrame];
+            signalSemaphores[i + 1] = output.renderFinishedSemaphores[currentFrame];
+            swapChains[i + 1] = output.swapChain;
+            imageIndices[i + 1] = output.imageIndex;
+        }
 
-        // 5. Submit the command buffer
+        // 5. Submit the command buffers of all windows at once
         VkSubmitInfo submitInfo{};
         submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-        // Wait for image available semaphore before executing color output stage
-        VkSemaphore waitSemaphores[] = {imageAvailableSemaphores[currentFrame]};
-        VkPipelineStageFlags waitStages[] = {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT};
-        submitInfo.waitSemaphoreCount = 1;
+        // Only the upscale and the window copies touch swapchain images, so the scene pass can start
+        // before acquisition
+        VkPipelineStageFlags waitStages[MAX_WINDOWS + 1];
+        for (uint32_t i = 0; i < swapChainCount; ++i) waitStages[i] = VK_PIPELINE_STAGE_TRANSFER_BIT;
+        // With a compute queue, wait for its last batch: this frame's post pass before the upscale, or whatever
+        // an earlier async frame left running before this one reuses the resources. Binary semaphores ignore
+        // their timeline values.
+        uint64_t waitValues[MAX_WINDOWS + 1] = {};
+        uint64_t signalValues[MAX_WINDOWS + 1] = {};
+        uint32_t waitCount = swapChainCount;
+        uint32_t signalCount = swapChainCount;
+        VkTimelineSemaphoreSubmitInfo timelineInfo{};
+        if (asyncComputeAvailable) {
+            waitSemaphores[waitCount] = computeTimeline;
+            waitStages[waitCount] = async
+                                        ? VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT
+                                        : VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+            waitValues[waitCount++] = computeTimelineValue;
+            if (!async) {
+                // Lets the next async frame's compute batches wait for this one's graphics work
+                signalSemaphores[signalCount] = graphicsTimeline;
+                signalValues[signalCount++] = ++graphicsTimelineValue;
+            }
+            timelineInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+            timelineInfo.waitSemaphoreValueCount = waitCount;
+            timelineInfo.pWaitSemaphoreValues = waitValues;
+            timelineInfo.signalSemaphoreValueCount = signalCount;
+            timelineInfo.pSignalSemaphoreValues = signalValues;
+            submitInfo.pNext = &timelineInfo;
+        }
+        submitInfo.waitSemaphoreCount = waitCount;
         submitInfo.pWaitSemaphores = waitSemaphores;
         submitInfo.pWaitDstStageMask = waitStages;
-        // Command buffer to execute
-        submitInfo.commandBufferCount = 1;
-        submitInfo.pCommandBuffers = &commandBuffers[currentFrame];
-        // Semaphore to signal when rendering finishes
-        VkSemaphore signalSemaphores[] = {renderFinishedSemaphores[currentFrame]};
-        submitInfo.signalSemaphoreCount = 1;
+        // Command buffers to execute, in order
+        submitInfo.commandBufferCount = swapChainCount;
+        submitInfo.pCommandBuffers = submitCommandBuffers;
+        // Semaphores to signal when rendering finishes
+        submitInfo.signalSemaphoreCount = signalCount;
         submitInfo.pSignalSemaphores = signalSemaphores;
 
         // Submit to graphics queue, signal fence when done
         VkResult submitResult = vkQueueSubmit(graphicsQueue, 1, &submitInfo, inFlightFences[currentFrame]);
+        if (checkDeviceLost(submitResult, "submitting a frame")) return FrameStatus::DeviceLost;
         VK_CHECK(submitResult, "Failed to submit draw command buffer!");
 
         // 6. Presentation
         VkPresentInfoKHR presentInfo{};
         presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
-        // Wait for rendering to finish before presentation
-        presentInfo.waitSemaphoreCount = 1;
+        // Wait for rendering to finish before presentation (one binary semaphore per swapchain; a signaled
+        // timeline comes after them)
+        presentInfo.waitSemaphoreCount = swapChainCount;
         presentInfo.pWaitSemaphores = signalSemaphores;
-        // Specify swapchain and image index to present
-        VkSwapchainKHR swapChains[] = {swapChain};
-        presentInfo.swapchainCount = 1;
+        // Specify swapchains and image indices to present (every window in one call)
+        VkResult presentResults[MAX_WINDOWS];
+        for (uint32_t i = 0; i < swapChainCount; ++i) presentResults[i] = VK_SUCCESS;
+        presentInfo.swapchainCount = swapChainCount;
         presentInfo.pSwapchains = swapChains;
-        presentInfo.pImageIndices = &imageIndex;
-        // presentInfo.pResults = nullptr; // Optional: Check results for multiple swapchains
-
-        VkResult presentResult = vkQueuePresentKHR(presentQueue, &presentInfo);
+        presentInfo.pImageIndices = imageIndices;
+        presentInfo.pResults = presentResults;
+
+        VkResult queuePresentResult = vkQueuePresentKHR(presentQueue, &presentInfo);
+        if (checkDeviceLost(queuePresentResult, "presenting")) return FrameStatus::DeviceLost;
+        // Per-swapchain results; the further windows are recreated before their next acquire, right away when
+        // out of date and once the resize is due when merely suboptimal
+        for (uint32_t i = 0; i < presentedCount; ++i) {
+            const VkResult outputResult = presentResults[i + 1];
+            WindowOutput &output = *presentedOutputs[i];
+            if (outputResult == VK_ERROR_OUT_OF_DATE_KHR) {
+                noteResize(output.pendingResize);
+                output.resized = true;
+            } else if (outputResult == VK_SUBOPTIMAL_KHR) {
+                if (!output.pendingResize.pending) noteResize(output.pendingResize);
+            } else if (outputResult != VK_SUCCESS) {
+                spdlog::critical("Failed to present window output image! VkResult: {}", static_cast<int>(outputResult));
+                throw std::runtime_error("Failed to present window output image!");
+            }
+        }
+        VkResult presentResult = presentResults[0];
+        if (queuePresentResult != VK_SUCCESS && queuePresentResult != VK_SUBOPTIMAL_KHR &&
+            queuePresentResult != VK_ERROR_OUT_OF_DATE_KHR) {
+            presentResult = queuePresentResult; // Device-level failure, no per-swapchain results
+        }
 
-        if (presentResult == VK_ERROR_OUT_OF_DATE_KHR || presentResult == VK_SUBOPTIMAL_KHR || framebufferResized) {
-            spdlog::warn("Swap chain out of date or suboptimal during presentation, or window resized. Recreating.");
-            framebufferResized = false; // Reset flag after handling
-            recreateSwapChain();
-            // No exception needed here, next frame's acquire will handle OOD properly
-        } else if (presentResult != VK_SUCCESS) {
+        // A suboptimal swapchain starts a resize like an event would (unless one is pending) but is kept presenting
+        if (presentResult == VK_ERROR_OUT_OF_DATE_KHR ||
+            (presentResult == VK_SUBOPTIMAL_KHR && !pendingResize.pending)) {
+            noteSwapChainResize();
+        } else if (presentResult != VK_SUCCESS && presentResult != VK_SUBOPTIMAL_KHR) {
             spdlog::critical("Failed to present swap chain image! VkResult: {}", static_cast<int>(presentResult));
             throw std::runtime_error("Failed to present swap chain image!");
         }
+        const bool recreated = handleResize(presentResult == VK_ERROR_OUT_OF_DATE_KHR);
 
         // 7. Advance frame counter
         currentFrame = (currentFrame + 1) % MAX_FRAMES_IN_FLIGHT;
+        frameCount++;
         // spdlog::trace("drawFrame end (advancing to frame {})", currentFrame); // Can be noisy
+        return recreated ? FrameStatus::Recreated : FrameStatus::Ok;
+    }
+
+
+    VkResult VulkanEngine::submitAsyncCompute() {
+        // One batch waiting for a value of the other queue's timeline and signaling the next value of its own
+        VkResult result = VK_SUCCESS;
+        auto submit = [&result](VkQueue queue, VkCommandBuffer commandBuffer, VkSemaphore waitTimeline,
+                                uint64_t waitValue, VkPipelineStageFlags waitStage, VkSemaphore signalTimeline,
+                                uint64_t signalValue) {
+            if (result != VK_SUCCESS) return; // The device was lost by an earlier batch
+            VkTimelineSemaphoreSubmitInfo timelineInfo{};
+            timelineInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+            timelineInfo.waitSemaphoreValueCount = 1;
+            timelineInfo.pWaitSemaphoreValues = &waitValue;
+            timelineInfo.signalSemaphoreValueCount = 1;
+            timelineInfo.pSignalSemaphoreValues = &signalValue;
+            VkSubmitInfo submitInfo{};
+            submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+            submitInfo.pNext = &timelineInfo;
+            submitInfo.waitSemaphoreCount = 1;
+            submitInfo.pWaitSemaphores = &waitTimeline;
+            submitInfo.pWaitDstStageMask = &waitStage;
+            submitInfo.commandBufferCount = 1;
+            submitInfo.pCommandBuffers = &commandBuffer;
+            submitInfo.signalSemaphoreCount = 1;
+            submitInfo.pSignalSemaphores = &signalTimeline;
+            result = vkQueueSubmit(queue, 1, &submitInfo, VK_NULL_HANDLE);
+            if (result != VK_ERROR_DEVICE_LOST) {
+                VK_CHECK(result, "Failed to submit async batch!");
+            }
+        };
+
+        // Particles: after last frame's scene pass has drawn (and stopped reading) the pools
+        if (asyncBatchRecorded[0]) {
+            submit(computeQueue, computeCommandBuffers[2 * currentFrame], graphicsTimeline, graphicsTimelineValue,
+                   VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, computeTimeline,
+                   ++computeTimelineValue);
+        }
+
+        // Scene pass: the compute queue's last value covers this frame's particles and last frame's post pass,
+        // which still reads the scene target and the atmosphere LUTs. Only the stages that touch them wait,
+        // so the frame's first draws and vertex work overlap the post pass.
+        VkPipelineStageFlags sceneWaitStages = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT |
+                                               VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT |
+                                               VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT |
+                                               VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+        if (asyncBatchRecorded[0]) {
+            sceneWaitStages |= VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT;
+        }
+        submit(graphicsQueue, commandBuffers[currentFrame], computeTimeline, computeTimelineValue, sceneWaitStages,
+               graphicsTimeline, ++graphicsTimelineValue);
+
+        // Post: after this frame's scene pass; the upscale in the final batch waits for it
+        if (asyncBatchRecorded[1]) {
+            submit(computeQueue, computeCommandBuffers[2 * currentFrame + 1], graphicsTimeline, graphicsTimelineValue,
+                   VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, computeTimeline, ++computeTimelineValue);
+        }
+        return result;
+    }
+
+    void VulkanEngine::updateFrameTimings() {
+        // Particle counts of the finished frame slot (zero until the slot has been used)
+        if (particleReadbackMapped != nullptr) {
+            particleStats.frames++;
+            particleStats.aliveSum += particleReadbackMapped[currentFrame * 2];
+            particleStats.emittedSum += particleReadbackMapped[currentFrame * 2 + 1];
+        }
+
+        computeTimer.collect(currentFrame); // Only has results if the slot's last frame was async
+        if (!gpuTimer.collect(currentFrame)) return;
+
+        gpuScheduler.collect(currentFrame);
+        terrainStats.frames++;
+        terrainStats.frameMsSum += gpuTimer.getLastMs(gpuScopeFrame);
+        if (gpuScheduler.recordedIn(impostorJob, currentFrame)) {
+            terrainStats.refreshMsSum += gpuTimer.getLastMs(gpuScopeImpostor);
+        }
+        if (config.benchmarkMode) benchmarkFrameMs.push_back(gpuTimer.getLastMs(gpuScopeFrame));
+
+        if (dynamicResolution) dynamicResolution->update(gpuTimer.getLastMs(gpuScopeFrame));
+        if (config.benchmarkMode) reportBenchmark();
+        renderExtent = computeRenderExtent();
+    }
+
+    void VulkanEngine::reportBenchmark() {
+        constexpr uint64_t REPORT_INTERVAL = 120; // Frames between reports
+        if (frameCount == 0 || frameCount % REPORT_INTERVAL != 0) return;
+
+        spdlog::info("[Benchmark] Frame {}: render {}x{} of {}x{}", frameCount, renderExtent.width,
+                     renderExtent.height, swapChainExtent.width, swapChainExtent.height);
+        for (uint32_t i = 0; i < gpuTimer.getScopeCount(); ++i) {
+            spdlog::info("[Benchmark]   GPU {:<10} {:7.3f} ms (avg {:7.3f} ms)", gpuTimer.getScopeName(i),
+                         gpuTimer.getLastMs(i), gpuTimer.getAverageMs(i));
+        }
+        // Async frames time particles and post on the compute queue, overlapping the graphics scopes above
+        const bool async = isAsyncComputeActive();
+        if (async) {
+            for (uint32_t i = 0; i < computeTimer.getScopeCount(); ++i) {
+                spdlog::info("[Benchmark]   GPU {:<10} {:7.3f} ms (avg {:7.3f} ms, compute queue)",
+                             computeTimer.getScopeName(i), computeTimer.getLastMs(i), computeTimer.getAverageMs(i));
+            }
+            const float busyMs = computeTimer.getAverageMs(computeScopeParticles) +
+                                 computeTimer.getAverageMs(computeScopePost);
+            const float frameMs = gpuTimer.getAverageMs(gpuScopeFrame);
+            spdlog::info("[Benchmark]   Async compute: queue busy {:.3f} ms of a {:.3f} ms frame ({:.0f}%)", busyMs,
+                         frameMs, frameMs > 0.0f ? 100.0f * busyMs / frameMs : 0.0f);
+        }
+        const float particlesMs = async ? computeTimer.getAverageMs(computeScopeParticles)
+                                        : gpuTimer.getAverageMs(gpuScopeParticles);
+        const float postMs = async ? computeTimer.getAverageMs(computeScopePost) : gpuTimer.getAverageMs(gpuScopePost);
+        if (dynamicResolution) {
+            const DynamicResolution::Stats &stats = dynamicResolution->getStats();
+            const float meanMs = stats.samples > 0 ? stats.sumFrameMs / static_cast<float>(stats.samples) : 0.0f;
+            spdlog::info("[Benchmark]   DynRes target {:.2f} ms: mean {:.2f} ms, max {:.2f} ms, scale {:.2f} "
+                         "(range {:.2f}-{:.2f}), {} adjustments, {} reversals",
+                         dynamicResolution->getSettings().targetFrameMs, meanMs, stats.maxFrameMs,
+                         dynamicResolution->getScale(), stats.minScale, stats.maxScale, stats.adjustments,
+                         stats.directionChanges);
+            dynamicResolution->resetStats();
+        }
+
+        if (config.postEffects != 0) {
+            const bool chained = benchmarkPhaseB && config.benchmarkCompare == BenchmarkCompare::PostChain;
+            const double trafficMb = static_cast<double>(estimatePostTrafficBytes(chained)) / (1024.0 * 1024.0);
+            spdlog::info("[Benchmark]   Post ({}): ~{:.1f} MB/frame, {:.1f} GB/s effective",
+                         chained ? "chained" : "fused", trafficMb,
+                         postMs > 0.0f ? trafficMb / 1024.0 / (postMs / 1000.0) : 0.0);
+        }
+        if (config.postEffects & POST_ATMOSPHERE) {
+            // Per frame: sky view + aerial perspective; the static LUTs only when re-baked (per LUT)
+            spdlog::info("[Benchmark]   Atmosphere: {:.3f} ms/frame (sky view + aerial perspective), static LUT bake "
+                         "{:.3f} ms per LUT", gpuTimer.getAverageMs(gpuScopeAtmosphere),
+                         gpuScheduler.getSliceMs(atmosphereJob));
+        }
+
+        // Terrain: geometry drawn per frame, and the impostor refreshes amortized over the interval
+        const TerrainStats terrain = terrainStats;
+        terrainStats = {};
+        const float meanFrameMs = terrain.frames > 0 ? terrain.frameMsSum / static_cast<float>(terrain.frames) : 0.0f;
+        const float refreshMs = terrain.refreshes > 0 ? terrain.refreshMsSum / static_cast<float>(terrain.refreshes)
+                                                      : 0.0f;
+        const uint32_t recordedFrames = std::max(terrain.recordedFrames, 1u);
+        spdlog::info("[Benchmark]   Terrain (split {:.0f}): {:.0f}k tris/frame near, frame {:.3f} ms; {} impostor "
+                     "refreshes, {:.0f}k tris and {:.3f} ms each ({:.3f} ms/frame amortized)",
+                     currentFarFieldSplit(), static_cast<double>(terrain.nearIndices) / 3000.0 / recordedFrames,
+                     meanFrameMs, terrain.refreshes,
+                     terrain.refreshes > 0 ? static_cast<double>(terrain.farIndices) / 3000.0 / terrain.refreshes : 0.0,
+                     refreshMs, terrain.frames > 0 ? terrain.refreshMsSum / static_cast<float>(terrain.frames) : 0.0f);
+        if (!terrainChunkSlots.empty()) {
+            // Time-to-visible of critical chunks: from their first critical request to the upload
+            const StreamingScheduler::Stats streaming = terrainStreamer.getStats();
+            terrainStreamer.resetStats();
+            std::vector<float> critical = streaming.criticalMs;
+            std::sort(critical.begin(), critical.end());
+            auto percentile = [&critical](float p) {
+                return critical.empty() ? 0.0f : critical[static_cast<size_t>(p * (critical.size() - 1))];
+            };
+            spdlog::info("[Benchmark]   Streaming: {}/{} chunks resident; {} requested, {} uploaded ({:.1f} MB), {} "
+                         "cancelled ({} in flight); critical time-to-visible p50 {:.1f} / p95 {:.1f} / max {:.1f} ms "
+                         "({} chunks); backlog {} queued, {} reading, {} decoding, {} to upload", residentTerrainChunks,
+                         terrainChunks.size(), streaming.requested, streaming.uploaded,
+                         static_cast<double>(streaming.uploadedBytes) / (1024.0 * 1024.0), streaming.cancelled,
+                         streaming.cancelledInFlight, percentile(0.5f), percentile(0.95f),
+                         critical.empty() ? 0.0f : critical.back(), critical.size(),
+                         terrainStreamer.countInStage(StreamingScheduler::Stage::Queued),
+                         terrainStreamer.countInStage(StreamingScheduler::Stage::Reading),
+                         terrainStreamer.countInStage(StreamingScheduler::Stage::Read) +
+                         terrainStreamer.countInStage(StreamingScheduler::Stage::Decoding),
+                         terrainStreamer.countInStage(StreamingScheduler::Stage::Decoded));
+            const ChunkPool::Stats pool = terrainChunkPool.getStats();
+            terrainChunkPool.resetStats();
+            spdlog::info("[Benchmark]   Chunk pool: {}/{} slots used (peak {}), {} allocations, {} uploads dropped "
+                         "with the pool full; fragmentation {:.0f}%, {}/{} blocks empty, {} moves ({:.2f} MB)",
+                         terrainChunkPool.getUsedCount(), terrainChunkPool.getSlotCount(), pool.peakUsed,
+                         pool.allocations, droppedTerrainUploads, terrainChunkPool.getFragmentation() * 100.0f,
+                         terrainChunkPool.getEmptyBlockCount(), terrainChunkPool.getBlockCount(), pool.moves,
+                         static_cast<double>(defragMovedBytes) / (1024.0 * 1024.0));
+            droppedTerrainUploads = 0;
+            defragMovedBytes = 0;
+        }
+        updateSwapChainMemoryEstimates();
+        memoryReport.logSummary();
+        const float recordMs = recordCpuFrames > 0 ? recordCpuMsSum / static_cast<float>(recordCpuFrames) : 0.0f;
+        recordCpuMsSum = 0.0f;
+        recordCpuFrames = 0;
+        spdlog::info("[Benchmark]   CPU command recording: {:.3f} ms/frame for {} view(s) ({})", recordMs, viewCount,
+                     isMultiviewUsed() ? "multiview" : "per viewport");
+        // drawFrame calls by outcome, each with its CPU time (recreations include their device wait)
+        FrameStatusStats allCalls;
+        for (const FrameStatusStats &calls: frameStatusStats) {
+            allCalls.calls += calls.calls;
+            allCalls.cpuMsSum += calls.cpuMsSum;
+        }
+        auto callMs = [](const FrameStatusStats &calls) {
+            return calls.calls > 0 ? calls.cpuMsSum / static_cast<float>(calls.calls) : 0.0f;
+        };
+        const FrameStatusStats &okCalls = frameStatusStats[static_cast<size_t>(FrameStatus::Ok)];
+        const FrameStatusStats &recreatedCalls = frameStatusStats[static_cast<size_t>(FrameStatus::Recreated)];
+        const FrameStatusStats &skippedCalls = frameStatusStats[static_cast<size_t>(FrameStatus::Skipped)];
+        const float drawFrameMs = callMs(allCalls);
+        spdlog::info("[Benchmark]   drawFrame CPU: {:.3f} ms/call; {} ok ({:.3f} ms), {} recreated ({:.3f} ms), "
+                     "{} skipped ({:.3f} ms)", drawFrameMs, okCalls.calls, callMs(okCalls), recreatedCalls.calls,
+                     callMs(recreatedCalls), skippedCalls.calls, callMs(skippedCalls));
+        for (FrameStatusStats &calls: frameStatusStats) calls = {};
+        if (resizeStats.events > 0) {
+            spdlog::info("[Benchmark]   Resize: {} event(s) -> {} full recreation(s), {} swapchain-only "
+                         "replacement(s) (delay {} ms)", resizeStats.events, resizeStats.recreations,
+                         resizeStats.swapChainOnly, config.resizeDelayMs);
+            resizeStats = {};
+        }
+        if (config.particleCount > 0) {
+            const ParticleStats particles = particleStats;
+            particleStats = {};
+            const uint32_t particleFrames = std::max(particles.frames, 1u);
+            spdlog::info("[Benchmark]   Particles: {} live of {} (avg), {} emitted/frame, simulation {:.3f} ms "
+                         "({:.3f} ms per million)", particles.aliveSum / particleFrames, config.particleCount,
+                         particles.emittedSum / particleFrames, particlesMs,
+                         particlesMs * 1.0e6f / static_cast<float>(config.particleCount));
+        }
+
+        if (config.propCount > 0) {
+            const PropStats props = propStats;
+            propStats = {};
+            const uint32_t propFrames = std::max(props.frames, 1u);
+            const double triangles = static_cast<double>(props.triangles) / propFrames;
+            const double meshTriangles = static_cast<double>(props.meshTriangles) / propFrames;
+            spdlog::info("[Benchmark]   Props (LOD {:.0f}): {} meshes + {} impostors visible/frame, {:.0f}k tris/frame "
+                         "vs {:.0f}k as meshes ({:.1f}%)", config.propLodDistance, props.meshInstances / propFrames,
+                         props.impostorInstances / propFrames, triangles / 1000.0, meshTriangles / 1000.0,
+                         meshTriangles > 0.0 ? 100.0 * triangles / meshTriangles : 100.0);
+            static_assert(MAX_PROP_LODS == 4, "One count per mesh level below");
+            spdlog::info("[Benchmark]   Prop mesh levels ({:.1f} px error): {} / {} / {} / {} instances/frame",
+                         config.propLodError, props.lodInstances[0] / propFrames, props.lodInstances[1] / propFrames,
+                         props.lodInstances[2] / propFrames, props.lodInstances[3] / propFrames);
+        }
+
+        // Frame time spread, and the sliced GPU jobs that would otherwise show up as spikes in it
+        std::sort(benchmarkFrameMs.begin(), benchmarkFrameMs.end());
+        const size_t frameSamples = benchmarkFrameMs.size();
+        const float p50FrameMs = frameSamples > 0 ? benchmarkFrameMs[frameSamples / 2] : 0.0f;
+        const size_t p99Index = std::min(frameSamples * 99 / 100, frameSamples - 1);
+        const float p99FrameMs = frameSamples > 0 ? benchmarkFrameMs[p99Index] : 0.0f;
+        benchmarkFrameMs.clear();
+        const GpuScheduler::Stats amortized = gpuScheduler.getStats();
+        gpuScheduler.resetStats();
+        spdlog::info("[Benchmark]   GPU frame p50 {:.3f} ms, p99 {:.3f} ms; amortized work ({:.2f} ms budget, 0 = "
+                     "eager): {} jobs in {} slices over {} frames, {:.3f} ms/frame, max {:.3f} ms, {} over budget",
+                     p50FrameMs, p99FrameMs, gpuScheduler.getBudgetMs(), amortized.completions, amortized.slices,
+                     amortized.frames, terrain.frames > 0 ? amortized.msSum / static_cast<float>(terrain.frames) : 0.0f,
+                     amortized.maxFrameMs, amortized.overBudgetFrames);
+
+        // Impostor sweep: one report interval per split distance, refreshes included in the frame time
+        if (config.benchmarkCompare == BenchmarkCompare::Impostor) {
+            benchmarkSplitFrameMs[benchmarkSplitIndex] = meanFrameMs;
+            benchmarkSplitIndex = (benchmarkSplitIndex + 1) % benchmarkSplits.size();
+            if (benchmarkSplitIndex == 0) {
+                const float baseMs = benchmarkSplitFrameMs[0];
+                spdlog::info("[Benchmark]   Impostor sweep summary (mean GPU frame incl. refreshes):");
+                spdlog::info("[Benchmark]     no impostor: {:.3f} ms", baseMs);
+                for (size_t i = 1; i < benchmarkSplits.size(); ++i) {
+                    spdlog::info("[Benchmark]     split {:>5.0f}: {:.3f} ms ({:+.3f} ms, {:+.1f}% vs no impostor)",
+                                 benchmarkSplits[i], benchmarkSplitFrameMs[i], benchmarkSplitFrameMs[i] - baseMs,
+                                 baseMs > 0.0f ? 100.0f * (benchmarkSplitFrameMs[i] - baseMs) / baseMs : 0.0f);
+                }
+            }
+            return;
+        }
+
+        // View sweep: one report interval per view count, from 1 up to the configured count
+        if (config.benchmarkCompare == BenchmarkCompare::Views) {
+            benchmarkViewFrameMs[viewCount - 1] = gpuTimer.getAverageMs(gpuScopeFrame);
+            benchmarkViewRecordMs[viewCount - 1] = recordMs;
+            const uint32_t next = viewCount % config.viewCount + 1;
+            if (next == 1) {
+                const float baseMs = benchmarkViewFrameMs[0];
+                const float baseRecordMs = benchmarkViewRecordMs[0];
+                spdlog::info("[Benchmark]   View sweep summary (GPU frame, CPU recording; x = cost relative to 1 view):");
+                for (uint32_t i = 0; i < config.viewCount; ++i) {
+                    spdlog::info("[Benchmark]     {} view(s): GPU {:.3f} ms ({:.2f}x), CPU {:.3f} ms ({:.2f}x)", i + 1,
+                                 benchmarkViewFrameMs[i], baseMs > 0.0f ? benchmarkViewFrameMs[i] / baseMs : 0.0f,
+                                 benchmarkViewRecordMs[i],
+                                 baseRecordMs > 0.0f ? benchmarkViewRecordMs[i] / baseRecordMs : 0.0f);
+                }
+            }
+            if (config.viewCount > 1) setViewCount(next);
+            return;
+        }
+
+        // MSAA sweep: measure each supported sample count for one report interval
+        if (config.benchmarkCompare == BenchmarkCompare::Msaa) {
+            benchmarkSampleSceneMs[benchmarkSampleIndex] = gpuTimer.getAverageMs(gpuScopeScene);
+            spdlog::info("[Benchmark]   MSAA {}x: scene {:.3f} ms, frame {:.3f} ms",
+                         static_cast<int>(msaaSamples), gpuTimer.getAverageMs(gpuScopeScene),
+                         gpuTimer.getAverageMs(gpuScopeFrame));
+            benchmarkSampleIndex = (benchmarkSampleIndex + 1) % benchmarkSampleCounts.size();
+            if (benchmarkSampleIndex == 0) {
+                const float baseMs = benchmarkSampleSceneMs[0];
+                spdlog::info("[Benchmark]   MSAA sweep summary (scene pass incl. resolve):");
+                for (size_t i = 0; i < benchmarkSampleCounts.size(); ++i) {
+                    spdlog::info("[Benchmark]     {}x: {:.3f} ms ({:+.3f} ms vs 1x)",
+                                 static_cast<int>(benchmarkSampleCounts[i]), benchmarkSampleSceneMs[i],
+                                 benchmarkSampleSceneMs[i] - baseMs);
+                }
+            }
+            if (benchmarkSampleCounts.size() > 1) setSampleCount(benchmarkSampleCounts[benchmarkSampleIndex]);
+            return;
+        }
+
+        // A/B comparison: alternate between the two variants every report interval
+        if (config.benchmarkCompare == BenchmarkCompare::None) return;
+        const bool upscalerCompare = config.benchmarkCompare == BenchmarkCompare::Upscaler;
+        const bool rayMarchCompare = config.benchmarkCompare == BenchmarkCompare::RayMarch;
+        const bool amortizedCompare = config.benchmarkCompare == BenchmarkCompare::Amortized;
+        const bool asyncCompare = config.benchmarkCompare == BenchmarkCompare::AsyncCompute;
+        const bool resizeCompare = config.benchmarkCompare == BenchmarkCompare::Resize;
+        benchmarkPhaseMs[benchmarkPhaseB ? 1 : 0] =
+                resizeCompare
+                    ? drawFrameMs
+                    : amortizedCompare
+                          ? p99FrameMs
+                          : gpuTimer.getAverageMs(upscalerCompare || rayMarchCompare || asyncCompare
+                                                      ? gpuScopeFrame
+                                                      : gpuScopePost);
+        const float msA = benchmarkPhaseMs[0];
+        const float msB = benchmarkPhaseMs[1];
+        if (msA > 0.0f && msB > 0.0f) {
+            if (upscalerCompare) {
+                const VkExtent2D upscaledFrom = DynamicResolution::ScaleExtent(swapChainExtent, config.maxRenderScale);
+                spdlog::info("[Benchmark]   {} {}x{} -> {}x{}: {:.3f} ms vs native {:.3f} ms ({:+.1f}%)",
+                             config.upscaler == UpscalerMode::Fsr ? "FSR" : "Bilinear", upscaledFrom.width,
+                             upscaledFrom.height, swapChainExtent.width, swapChainExtent.height, msA, msB,
+                             100.0f * (msA - msB) / msB);
+            } else if (amortizedCompare) {
+                spdlog::info("[Benchmark]   GPU frame p99: amortized ({:.2f} ms budget) {:.3f} ms vs eager {:.3f} ms "
+                             "({:+.1f}%)", config.amortizedBudgetMs, msA, msB, 100.0f * (msA - msB) / msB);
+            } else if (resizeCompare) {
+                spdlog::info("[Benchmark]   drawFrame CPU: resizing {:.3f} ms/call vs steady {:.3f} ms/call "
+                             "({:+.1f}%, delay {} ms)", msA, msB, 100.0f * (msA - msB) / msB, config.resizeDelayMs);
+            } else if (asyncCompare) {
+                spdlog::info("[Benchmark]   GPU frame: async compute {:.3f} ms vs graphics queue only {:.3f} ms "
+                             "({:+.1f}%)", msA, msB, 100.0f * (msA - msB) / msB);
+            } else if (rayMarchCompare) {
+                spdlog::info("[Benchmark]   Terrain beyond {:.0f}: ray-marched {:.3f} ms vs rasterized {:.3f} ms "
+                             "({:+.1f}%)", config.farFieldSplit, msA, msB, 100.0f * (msA - msB) / msB);
+            } else {
+                const uint64_t fusedBytes = estimatePostTrafficBytes(false);
+                const uint64_t chainedBytes = estimatePostTrafficBytes(true);
+                spdlog::info("[Benchmark]   Post fused {:.3f} ms vs chained {:.3f} ms ({:+.1f}%), "
+                             "~{:.1f} MB/frame saved ({:.0f}% of chained traffic)",
+                             msA, msB, 100.0f * (msA - msB) / msB,
+                             static_cast<double>(chainedBytes - fusedBytes) / (1024.0 * 1024.0),
+                             100.0 * static_cast<double>(chainedBytes - fusedBytes) / static_cast<double>(chainedBytes));
+            }
+        }
+        benchmarkPhaseB = !benchmarkPhaseB;
+        if (amortizedCompare) gpuScheduler.setBudgetMs(benchmarkPhaseB ? 0.0f : config.amortizedBudgetMs);
+        spdlog::info("[Benchmark]   Next phase: {}",
+                     upscalerCompare
+                         ? (benchmarkPhaseB ? "native" : "upscaled")
+                         : rayMarchCompare
+                               ? (benchmarkPhaseB ? "rasterized" : "ray-marched")
+                               : amortizedCompare
+                                     ? (benchmarkPhaseB ? "eager" : "amortized")
+                                     : asyncCompare
+                                           ? (benchmarkPhaseB ? "graphics queue only" : "async compute")
+                                           : resizeCompare
+                                                 ? (benchmarkPhaseB ? "steady" : "resizing")
+                                                 : (benchmarkPhaseB ? "chained" : "fused"));
     }
 
 
@@ -1571,10 +6737,12 @@ namespace vk_project_one {
     void VulkanEngine::cleanupSwapChain() {
         spdlog::debug("Cleaning up swap chain resources...");
 
-        // Destroy Framebuffers
-        for (auto framebuffer: swapChainFramebuffers) vkDestroyFramebuffer(device, framebuffer, nullptr);
-        swapChainFramebuffers.clear();
-        // Destroy Graphics Pipeline
+        // Destroy Scene Framebuffer and Targets (plus the post/upscale targets referencing them)
+        cleanupSceneTargets();
+        // Destroy Graphics Pipelines
+        cleanupTerrainPipelines();
+        cleanupParticleDrawPipeline();
+        cleanupPropPipelines();
         if (graphicsPipeline != VK_NULL_HANDLE) vkDestroyPipeline(device, graphicsPipeline, nullptr);
         graphicsPipeline = VK_NULL_HANDLE;
         // Destroy Pipeline Layout
@@ -1586,9 +6754,10 @@ namespace vk_project_one {
         // Destroy Image Views
         for (auto imageView: swapChainImageViews) vkDestroyImageView(device, imageView, nullptr);
         swapChainImageViews.clear();
-        // Destroy Swapchain itself
+        // Destroy Swapchain itself, and those replaced during a resize (the device is idle)
         if (swapChain != VK_NULL_HANDLE) vkDestroySwapchainKHR(device, swapChain, nullptr);
         swapChain = VK_NULL_HANDLE;
+        destroyRetiredSwapChains(true);
         // Destroy Uniform Buffers & Memory & Mapped pointers
         for (size_t i = 0; i < uniformBuffers.size(); ++i) {
             if (uniformBuffersMapped.size() > i && uniformBuffersMapped[i]) {
@@ -1597,8 +6766,7 @@ namespace vk_project_one {
             }
             if (uniformBuffers[i] != VK_NULL_HANDLE) vkDestroyBuffer(device, uniformBuffers[i], nullptr);
             if (uniformBuffersMemory.size() > i && uniformBuffersMemory[i] != VK_NULL_HANDLE)
-                vkFreeMemory(
-                    device, uniformBuffersMemory[i], nullptr);
+                freeMemory(uniformBuffersMemory[i]);
         }
         uniformBuffers.clear();
         uniformBuffersMemory.clear();
@@ -1614,18 +6782,19 @@ namespace vk_project_one {
     void VulkanEngine::recreateSwapChain() {
         spdlog::info("Recreating swap chain...");
 
-        // Handle minimization: pause rendering until window has size > 0
+        // Handle minimization: drawFrame skips frames and comes back here once the window has a size again
         int width = 0, height = 0;
         SDL_GetWindowSizeInPixels(window, &width, &height);
-        while (width == 0 || height == 0) {
-            spdlog::debug("Window minimized, waiting for resize...");
-            SDL_GetWindowSizeInPixels(window, &width, &height);
-            SDL_WaitEvent(nullptr); // Wait for any SDL event
+        if (width == 0 || height == 0) {
+            spdlog::debug("Window minimized, deferring swap chain recreation.");
+            setSwapChainState(SwapChainState::Minimized);
+            return;
         }
         spdlog::debug("Window has size {}x{}, proceeding with swap chain recreation.", width, height);
 
         // Wait for current operations to complete before destroying old resources
         VkResult waitResult = vkDeviceWaitIdle(device);
+        if (checkDeviceLost(waitResult, "recreating the swap chain")) return;
         if (waitResult != VK_SUCCESS) {
             spdlog::error("vkDeviceWaitIdle failed before swapchain recreation! VkResult: {}",
                           static_cast<int>(waitResult));
@@ -1637,14 +6806,24 @@ namespace vk_project_one {
         // Recreate swapchain and dependent objects
         createSwapChain();
         createImageViews();
+        createSceneTargets(); // Sized to the new swapchain extent
+        createPostProcessTargets(); // References the new scene targets
+        createUpscalerTargets(); // References the new scene target (or post output)
         createRenderPass(); // Might need changes if multisampling/depth added
         createGraphicsPipeline(); // Depends on renderpass, extent etc.
+        createTerrainPipelines();
+        createParticleDrawPipeline();
+        createPropPipelines();
         createFramebuffers();
+        updateResourceReport();
         createUniformBuffers(); // Depends on number of swapchain images / frames in flight
         createDescriptorPool(); // Recreate pool
         createDescriptorSets(); // Recreate and bind sets
         // Command buffers are usually okay unless render pass compatibility changes,
         // but they will be re-recorded anyway in drawFrame.
+        pendingResize = {};
+        resizeStats.recreations++;
+        setSwapChainState(SwapChainState::Ready);
 
         spdlog::info("Swap chain recreated successfully.");
     }
@@ -1654,7 +6833,7 @@ namespace vk_project_one {
             spdlog::warn("Attempted to create terrain vertex buffer with empty vertex data.");
             // Ensure old buffers are potentially cleaned up if recreating
             if (terrainVertexBuffer != VK_NULL_HANDLE) vkDestroyBuffer(device, terrainVertexBuffer, nullptr);
-            if (terrainVertexBufferMemory != VK_NULL_HANDLE) vkFreeMemory(device, terrainVertexBufferMemory, nullptr);
+            if (terrainVertexBufferMemory != VK_NULL_HANDLE) freeMemory(terrainVertexBufferMemory);
             terrainVertexBuffer = VK_NULL_HANDLE;
             terrainVertexBufferMemory = VK_NULL_HANDLE;
             return;
@@ -1667,7 +6846,7 @@ namespace vk_project_one {
         // 1. Create Staging Buffer (CPU visible)
         VkBuffer stagingBuffer;
         VkDeviceMemory stagingBufferMemory;
-        createBuffer(bufferSize,
+        createBuffer({MemoryCategory::Staging, "terrain vertex staging"}, bufferSize,
                      VK_BUFFER_USAGE_TRANSFER_SRC_BIT, // Source for transfer
                      VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, // CPU writeable
                      stagingBuffer, stagingBufferMemory);
@@ -1684,9 +6863,9 @@ namespace vk_project_one {
         // 3. Create Final Vertex Buffer (GPU local)
         // Destroy old buffer if it exists (e.g., during swapchain recreation if terrain changes)
         if (terrainVertexBuffer != VK_NULL_HANDLE) vkDestroyBuffer(device, terrainVertexBuffer, nullptr);
-        if (terrainVertexBufferMemory != VK_NULL_HANDLE) vkFreeMemory(device, terrainVertexBufferMemory, nullptr);
+        if (terrainVertexBufferMemory != VK_NULL_HANDLE) freeMemory(terrainVertexBufferMemory);
 
-        createBuffer(bufferSize,
+        createBuffer({MemoryCategory::TerrainVertices, "terrain vertices"}, bufferSize,
                      VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
                      // Destination and Vertex buffer usage
                      VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, // Optimal GPU memory
@@ -1699,7 +6878,7 @@ namespace vk_project_one {
 
         // 5. Cleanup Staging Buffer
         vkDestroyBuffer(device, stagingBuffer, nullptr);
-        vkFreeMemory(device, stagingBufferMemory, nullptr);
+        freeMemory(stagingBufferMemory);
         spdlog::trace("  Staging buffer destroyed.");
 
         spdlog::info("Terrain vertex buffer created successfully.");
@@ -1710,7 +6889,7 @@ namespace vk_project_one {
         if (indices.empty()) {
             spdlog::warn("Attempted to create terrain index buffer with empty index data.");
             if (terrainIndexBuffer != VK_NULL_HANDLE) vkDestroyBuffer(device, terrainIndexBuffer, nullptr);
-            if (terrainIndexBufferMemory != VK_NULL_HANDLE) vkFreeMemory(device, terrainIndexBufferMemory, nullptr);
+            if (terrainIndexBufferMemory != VK_NULL_HANDLE) freeMemory(terrainIndexBufferMemory);
             terrainIndexBuffer = VK_NULL_HANDLE;
             terrainIndexBufferMemory = VK_NULL_HANDLE;
             terrainIndexCount = 0;
@@ -1726,7 +6905,7 @@ namespace vk_project_one {
         // 1. Create Staging Buffer
         VkBuffer stagingBuffer;
         VkDeviceMemory stagingBufferMemory;
-        createBuffer(bufferSize,
+        createBuffer({MemoryCategory::Staging, "terrain index staging"}, bufferSize,
                      VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
                      VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
                      stagingBuffer, stagingBufferMemory);
@@ -1742,9 +6921,9 @@ namespace vk_project_one {
 
         // 3. Create Final Index Buffer (GPU local)
         if (terrainIndexBuffer != VK_NULL_HANDLE) vkDestroyBuffer(device, terrainIndexBuffer, nullptr);
-        if (terrainIndexBufferMemory != VK_NULL_HANDLE) vkFreeMemory(device, terrainIndexBufferMemory, nullptr);
+        if (terrainIndexBufferMemory != VK_NULL_HANDLE) freeMemory(terrainIndexBufferMemory);
 
-        createBuffer(bufferSize,
+        createBuffer({MemoryCategory::TerrainIndices, "terrain indices"}, bufferSize,
                      VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
                      // Destination and Index buffer usage
                      VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
@@ -1758,7 +6937,7 @@ namespace vk_project_one {
 
         // 5. Cleanup Staging Buffer
         vkDestroyBuffer(device, stagingBuffer, nullptr);
-        vkFreeMemory(device, stagingBufferMemory, nullptr);
+        freeMemory(stagingBufferMemory);
         spdlog::trace("  Staging buffer destroyed.");
 
         spdlog::info("Terrain index buffer created successfully.");
@@ -1768,11 +6947,29 @@ namespace vk_project_one {
 
     void VulkanEngine::cleanup() {
         spdlog::debug("Starting main VulkanEngine cleanup...");
+        if (device != VK_NULL_HANDLE && (config.memoryReport || config.benchmarkMode)) {
+            logMemoryReport(config.memoryReport);
+        }
         // Cleanup swapchain first (calls vkDeviceWaitIdle implicitly via recreate or explicitly in destructor)
         cleanupSwapChain(); // Ensures swapchain resources are gone first
+        cleanupImpostorTargets();
+        cleanupParticleSystem();
+        cleanupProps();
+        cleanupHeightfield();
+        cleanupTerrainDetail();
 
         // --- Clean up Terrain Buffers ---
         spdlog::debug("Cleaning up terrain buffers...");
+        terrainStreamer.drain();
+        terrainChunkSlots.clear();
+        if (terrainStagingBuffer != VK_NULL_HANDLE) {
+            vkUnmapMemory(device, terrainStagingBufferMemory);
+            vkDestroyBuffer(device, terrainStagingBuffer, nullptr);
+            freeMemory(terrainStagingBufferMemory);
+            terrainStagingBuffer = VK_NULL_HANDLE;
+            terrainStagingBufferMemory = VK_NULL_HANDLE;
+            terrainStagingMapped = nullptr;
+        }
         if (terrainVertexBuffer != VK_NULL_HANDLE) {
             if (device != VK_NULL_HANDLE) { // Check device validity too
                 vkDestroyBuffer(device, terrainVertexBuffer, nullptr);
@@ -1783,7 +6980,7 @@ namespace vk_project_one {
         }
         if (terrainVertexBufferMemory != VK_NULL_HANDLE) {
             if (device != VK_NULL_HANDLE) {
-                vkFreeMemory(device, terrainVertexBufferMemory, nullptr);
+                freeMemory(terrainVertexBufferMemory);
                 terrainVertexBufferMemory = VK_NULL_HANDLE;
             } else {
                 spdlog::warn("Device handle was null when trying to free terrainVertexBufferMemory.");
@@ -1800,7 +6997,7 @@ namespace vk_project_one {
         }
         if (terrainIndexBufferMemory != VK_NULL_HANDLE) {
             if (device != VK_NULL_HANDLE) {
-                vkFreeMemory(device, terrainIndexBufferMemory, nullptr);
+                freeMemory(terrainIndexBufferMemory);
                 terrainIndexBufferMemory = VK_NULL_HANDLE;
             } else {
                 spdlog::warn("Device handle was null when trying to free terrainIndexBufferMemory.");
@@ -1808,20 +7005,60 @@ namespace vk_project_one {
         }
         // --- End Terrain Buffer Cleanup ---
 
+        // Destroy the FSR upscaler pipelines (targets are gone with the swapchain)
+        if (easuPipeline != VK_NULL_HANDLE) vkDestroyPipeline(device, easuPipeline, nullptr);
+        easuPipeline = VK_NULL_HANDLE;
+        if (rcasPipeline != VK_NULL_HANDLE) vkDestroyPipeline(device, rcasPipeline, nullptr);
+        rcasPipeline = VK_NULL_HANDLE;
+        if (upscalePipelineLayout != VK_NULL_HANDLE) vkDestroyPipelineLayout(device, upscalePipelineLayout, nullptr);
+        upscalePipelineLayout = VK_NULL_HANDLE;
+        if (upscaleDescriptorSetLayout != VK_NULL_HANDLE)
+            vkDestroyDescriptorSetLayout(device, upscaleDescriptorSetLayout, nullptr);
+        upscaleDescriptorSetLayout = VK_NULL_HANDLE;
+        if (upscaleSampler != VK_NULL_HANDLE) vkDestroySampler(device, upscaleSampler, nullptr);
+        upscaleSampler = VK_NULL_HANDLE;
+
+        // Destroy the post-processing pipelines and LUTs (targets are gone with the swapchain)
+        cleanupAtmosphere();
+        if (postPipeline != VK_NULL_HANDLE) vkDestroyPipeline(device, postPipeline, nullptr);
+        postPipeline = VK_NULL_HANDLE;
+        for (VkPipeline &pipeline: postEffectPipelines) {
+            if (pipeline != VK_NULL_HANDLE) vkDestroyPipeline(device, pipeline, nullptr);
+            pipeline = VK_NULL_HANDLE;
+        }
+        if (postPipelineLayout != VK_NULL_HANDLE) vkDestroyPipelineLayout(device, postPipelineLayout, nullptr);
+        postPipelineLayout = VK_NULL_HANDLE;
+        if (postDescriptorSetLayout != VK_NULL_HANDLE)
+            vkDestroyDescriptorSetLayout(device, postDescriptorSetLayout, nullptr);
+        postDescriptorSetLayout = VK_NULL_HANDLE;
+        if (gradingLutImageView != VK_NULL_HANDLE) vkDestroyImageView(device, gradingLutImageView, nullptr);
+        gradingLutImageView = VK_NULL_HANDLE;
+        if (gradingLutImage != VK_NULL_HANDLE) vkDestroyImage(device, gradingLutImage, nullptr);
+        gradingLutImage = VK_NULL_HANDLE;
+        if (gradingLutImageMemory != VK_NULL_HANDLE) freeMemory(gradingLutImageMemory);
+        gradingLutImageMemory = VK_NULL_HANDLE;
+        if (gradingLutSampler != VK_NULL_HANDLE) vkDestroySampler(device, gradingLutSampler, nullptr);
+        gradingLutSampler = VK_NULL_HANDLE;
+        if (postSampler != VK_NULL_HANDLE) vkDestroySampler(device, postSampler, nullptr);
+        postSampler = VK_NULL_HANDLE;
+
         // Destroy objects created before swapchain dependencies
         if (descriptorSetLayout != VK_NULL_HANDLE) vkDestroyDescriptorSetLayout(device, descriptorSetLayout, nullptr);
         descriptorSetLayout = VK_NULL_HANDLE;
 
         if (indexBuffer != VK_NULL_HANDLE) vkDestroyBuffer(device, indexBuffer, nullptr);
         indexBuffer = VK_NULL_HANDLE;
-        if (indexBufferMemory != VK_NULL_HANDLE) vkFreeMemory(device, indexBufferMemory, nullptr);
+        if (indexBufferMemory != VK_NULL_HANDLE) freeMemory(indexBufferMemory);
         indexBufferMemory = VK_NULL_HANDLE;
 
         if (vertexBuffer != VK_NULL_HANDLE) vkDestroyBuffer(device, vertexBuffer, nullptr);
         vertexBuffer = VK_NULL_HANDLE;
-        if (vertexBufferMemory != VK_NULL_HANDLE) vkFreeMemory(device, vertexBufferMemory, nullptr);
+        if (vertexBufferMemory != VK_NULL_HANDLE) freeMemory(vertexBufferMemory);
         vertexBufferMemory = VK_NULL_HANDLE;
 
+        // Further windows: swapchains, semaphores and surfaces
+        cleanupWindowOutputs();
+
         // Destroy sync objects
         for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i) {
             // Check vector size before accessing index
@@ -1836,10 +7073,14 @@ namespace vk_project_one {
         renderFinishedSemaphores.clear();
         imageAvailableSemaphores.clear();
         inFlightFences.clear();
+        cleanupAsyncCompute();
 
         if (commandPool != VK_NULL_HANDLE) vkDestroyCommandPool(device, commandPool, nullptr);
         commandPool = VK_NULL_HANDLE; // Command buffers freed with pool
 
+        gpuTimer.destroy();
+        memoryReport.logLeaks();
+
         // Destroy logical device LAST before instance-level objects
         if (device != VK_NULL_HANDLE) vkDestroyDevice(device, nullptr);
         device = VK_NULL_HANDLE;
@@ -6,6 +6,8 @@
 #include <vector>
 #include <optional>
 #include <stdexcept>
+#include <memory>
+#include <chrono>
 #include <vulkan/vulkan.h>
 
 // GLM math library
@@ -14,6 +16,17 @@
 #include <glm/glm.hpp>
 
 #include "Terrain.h"
+#include "EngineConfig.h"
+#include "GpuTimer.h"
+#include "GpuScheduler.h"
+#include "StreamingScheduler.h"
+#include "ChunkPool.h"
+#include "DynamicResolution.h"
+#include "ResourceReport.h"
+#include "MemoryReport.h"
+#include "DeviceSelection.h"
+#include "Frustum.h"
+#include "Props.h"
 
 // Forward declare SDL_Window instead of including full SDL.h
 struct SDL_Window;
@@ -35,14 +48,14 @@ namespace vk_project_one {
     // Use alignas to ensure proper alignment for mat4 according to Vulkan spec
     struct UniformBufferObject {
         alignas(16) glm::mat4 model;
-        alignas(16) glm::mat4 view;
-        alignas(16) glm::mat4 proj;
+        alignas(16) glm::mat4 viewProj[MAX_VIEWS]; // One per view; also read by terrain.vert under multiview
     };
 
     // Structure to hold queue family indices
     struct QueueFamilyIndices {
         std::optional<uint32_t> graphicsFamily;
         std::optional<uint32_t> presentFamily;
+        std::optional<uint32_t> computeFamily; // Compute without graphics (async compute), if the device has one
 
         bool isComplete() const {
             return graphicsFamily.has_value() && presentFamily.has_value();
@@ -57,15 +70,18 @@ namespace vk_project_one {
 
     class VulkanEngine {
     public:
-        // Custom exception class for handling swapchain invalidation during rendering
-        class SwapChainOutOfDateError : public std::runtime_error {
-        public:
-            SwapChainOutOfDateError() : std::runtime_error("Swap chain out of date/suboptimal and needs recreation") {
-            }
+        // Outcome of one drawFrame call. Swapchain invalidation and device loss recur at runtime and are
+        // reported here; exceptions are left for failures the engine cannot recover from.
+        enum class FrameStatus {
+            Ok, // Rendered and presented
+            Skipped, // Nothing rendered: the window is minimized
+            Recreated, // The first window's swapchain was recreated or replaced; the frame may be missing
+            DeviceLost // The device is gone: destroy the engine and create it again
         };
 
-        // Constructor initializes Vulkan with the given SDL window. Throws on failure.
-        explicit VulkanEngine(SDL_Window *sdlWindow);
+        // Constructor initializes Vulkan for the given SDL windows (at least one). The first window
+        // drives the render resolution; the others show a scaled copy of its frame. Throws on failure.
+        explicit VulkanEngine(const std::vector<SDL_Window *> &sdlWindows, const EngineConfig &engineConfig = {});
 
         // Destructor cleans up all Vulkan resources.
         ~VulkanEngine();
@@ -79,26 +95,43 @@ namespace vk_project_one {
 
         VulkanEngine &operator=(VulkanEngine &&) = delete;
 
-        // Main rendering function to draw a single frame.
-        // Throws SwapChainOutOfDateError if swapchain needs recreation.
-        void drawFrame();
+        // Main rendering function to draw a single frame. Throws only on unrecoverable errors.
+        FrameStatus drawFrame();
 
-        // Recreates the swapchain and dependent resources (e.g., after window resize).
+        // Recreates the swapchain and dependent resources (e.g., after window resize). Leaves the swapchain
+        // alone while the window is minimized; drawFrame recreates it once the window is restored.
         void recreateSwapChain();
 
-        // Call this when the window framebuffer is resized (e.g., from SDL resize event).
-        void notifyFramebufferResized() { framebufferResized = true; }
+        // Call this when a window framebuffer is resized (e.g., from SDL resize event). Events are coalesced:
+        // the recreation happens once the size has held for EngineConfig::resizeDelayMs.
+        void notifyFramebufferResized(SDL_Window *resizedWindow);
 
-        // Updates the model matrix in the uniform buffer based on time for rotation.
+        // Moves the camera along its flight path over the terrain and updates the uniform buffer
+        // (cube rotation and camera matrices) for the given time.
         void updateCubeRotation(float time);
 
+        // Number of frames submitted so far.
+        uint64_t getFrameCount() const { return frameCount; }
+
+        // Atmosphere haze (Mie density relative to a clear day). A change re-bakes the static
+        // atmosphere LUTs over the next frames.
+        float getHaze() const { return config.haze; }
+
+        void setHaze(float haze);
+
+        // Logs the device memory in use per category, heap and memory type; with allocations, each of them.
+        void logMemoryReport(bool allocations);
+
     private:
         // --- Core Objects ---
-        SDL_Window *window = nullptr; // Non-owning pointer to the SDL window
+        SDL_Window *window = nullptr; // Non-owning pointer to the first SDL window
+        EngineConfig config;
         VkInstance instance = VK_NULL_HANDLE;
         VkDebugUtilsMessengerEXT debugMessenger = VK_NULL_HANDLE;
+        PFN_vkSetDebugUtilsObjectNameEXT setDebugObjectName = nullptr; // Null without validation layers
         VkSurfaceKHR surface = VK_NULL_HANDLE;
         VkPhysicalDevice physicalDevice = VK_NULL_HANDLE;
+        DeviceCapabilities deviceCapabilities; // Of physicalDevice; optional features are enabled from it
         VkDevice device = VK_NULL_HANDLE; // Logical device
         VkQueue graphicsQueue = VK_NULL_HANDLE;
         VkQueue presentQueue = VK_NULL_HANDLE;
@@ -107,9 +140,166 @@ namespace vk_project_one {
         VkSwapchainKHR swapChain = VK_NULL_HANDLE;
         std::vector<VkImage> swapChainImages;
         VkFormat swapChainImageFormat = VK_FORMAT_UNDEFINED;
-        VkExtent2D swapChainExtent = {0, 0};
+        VkExtent2D swapChainExtent = {0, 0}; // Size the render targets were created for
+        VkExtent2D presentExtent = {0, 0}; // Swapchain image size; differs while a resize is deferred
         std::vector<VkImageView> swapChainImageViews;
-        std::vector<VkFramebuffer> swapChainFramebuffers;
+
+        // --- Resize Coalescing ---
+        // Resize events of one window since its last recreation. In between, a suboptimal swapchain keeps
+        // being presented and an out-of-date one is replaced on its own, the frame stretched into it.
+        struct PendingResize {
+            bool pending = false;
+            std::chrono::steady_clock::time_point firstEvent;
+            std::chrono::steady_clock::time_point lastEvent;
+            uint32_t events = 0;
+        };
+        PendingResize pendingResize; // First window
+
+        // Presentation state of the first window, advanced by drawFrame.
+        enum class SwapChainState {
+            Ready, // Swapchain and render targets match the window
+            Resizing, // Resize pending (see PendingResize): the frame is stretched until the size settles
+            Minimized, // No area to present to: frames are skipped until the window is restored
+            DeviceLost // Terminal: every further frame reports FrameStatus::DeviceLost
+        };
+        SwapChainState swapChainState = SwapChainState::Ready;
+
+        // A swapchain handed to its replacement as oldSwapchain instead of waiting for the device; destroyed
+        // once the frames that may still use it have completed.
+        struct RetiredSwapChain {
+            VkSwapchainKHR swapChain = VK_NULL_HANDLE;
+            std::vector<VkImageView> imageViews;
+            uint64_t retiredFrame = 0; // frameCount when it was replaced
+        };
+        std::vector<RetiredSwapChain> retiredSwapChains;
+
+        struct ResizeStats {
+            uint32_t events = 0; // Resize events plus out-of-date/suboptimal results that started a resize
+            uint32_t recreations = 0; // Full recreations of the first window's swapchain and render targets
+            uint32_t swapChainOnly = 0; // Swapchains replaced without touching the render targets
+        } resizeStats;
+
+        // --- Further Windows ---
+        // Every window after the first has its own surface and swapchain on the same device. Each frame
+        // their command buffers copy the finished frame into their swapchain images; all of them go into
+        // the one vkQueueSubmit of the frame and are presented with a single vkQueuePresentKHR.
+        struct WindowOutput {
+            SDL_Window *window = nullptr; // Non-owning
+            VkSurfaceKHR surface = VK_NULL_HANDLE;
+            VkSwapchainKHR swapChain = VK_NULL_HANDLE; // Null while the window is minimized
+            std::vector<VkImage> images;
+            VkFormat imageFormat = VK_FORMAT_UNDEFINED;
+            VkExtent2D extent = {0, 0};
+            std::vector<VkImageView> imageViews;
+            std::vector<VkCommandBuffer> commandBuffers; // One per frame in flight
+            std::vector<VkSemaphore> imageAvailableSemaphores;
+            std::vector<VkSemaphore> renderFinishedSemaphores;
+            uint32_t imageIndex = 0; // Acquired this frame
+            bool resized = false; // Out of date or minimized: replaced before the next acquire
+            PendingResize pendingResize;
+        };
+        std::vector<WindowOutput> windowOutputs;
+
+        // --- Offscreen Scene Target ---
+        // The scene is rendered into the top-left renderExtent region of a swapchain-sized image
+        // and then scaled into the swapchain image, so resolution changes never reallocate.
+        VkImage sceneColorImage = VK_NULL_HANDLE;
+        VkDeviceMemory sceneColorImageMemory = VK_NULL_HANDLE;
+        VkImageView sceneColorImageView = VK_NULL_HANDLE;
+        VkFormat sceneColorFormat = VK_FORMAT_UNDEFINED; // Swapchain format, or RGBA16F (HDR) with post-processing
+        VkImage sceneDepthImage = VK_NULL_HANDLE;
+        VkDeviceMemory sceneDepthImageMemory = VK_NULL_HANDLE;
+        VkImageView sceneDepthImageView = VK_NULL_HANDLE;
+        VkFormat depthFormat = VK_FORMAT_UNDEFINED;
+        // With MSAA the scene renders into a transient multisampled color target that is resolved
+        // into sceneColorImage at the end of the subpass; depth is multisampled and transient too.
+        VkSampleCountFlagBits msaaSamples = VK_SAMPLE_COUNT_1_BIT;
+        VkImage msaaColorImage = VK_NULL_HANDLE;
+        VkDeviceMemory msaaColorImageMemory = VK_NULL_HANDLE;
+        VkImageView msaaColorImageView = VK_NULL_HANDLE;
+        VkFramebuffer sceneFramebuffer = VK_NULL_HANDLE;
+        VkExtent2D renderExtent = {0, 0}; // Region of the scene target rendered this frame
+        bool sceneBlitSupported = false; // Format supports blit src/dst (required for scaling)
+        VkImageLayout sceneFinalLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL; // Layout the upscaler reads from
+
+        // --- FSR Upscaler (EASU + RCAS compute passes) ---
+        // EASU upsamples the scene region into upscaleImage, RCAS sharpens it into sharpenImage,
+        // which is then copied into the swapchain image (storage writes to sRGB swapchains are not portable).
+        VkImage upscaleImage = VK_NULL_HANDLE;
+        VkDeviceMemory upscaleImageMemory = VK_NULL_HANDLE;
+        VkImageView upscaleImageView = VK_NULL_HANDLE;
+        VkImage sharpenImage = VK_NULL_HANDLE;
+        VkDeviceMemory sharpenImageMemory = VK_NULL_HANDLE;
+        VkImageView sharpenImageView = VK_NULL_HANDLE;
+        VkSampler upscaleSampler = VK_NULL_HANDLE;
+        VkDescriptorSetLayout upscaleDescriptorSetLayout = VK_NULL_HANDLE;
+        VkPipelineLayout upscalePipelineLayout = VK_NULL_HANDLE;
+        VkPipeline easuPipeline = VK_NULL_HANDLE;
+        VkPipeline rcasPipeline = VK_NULL_HANDLE;
+        VkDescriptorPool upscaleDescriptorPool = VK_NULL_HANDLE;
+        VkDescriptorSet easuDescriptorSet = VK_NULL_HANDLE;
+        VkDescriptorSet rcasDescriptorSet = VK_NULL_HANDLE;
+
+        // --- Post Processing (fused compute pass) ---
+        // Runs at render resolution between the scene pass and the upscale. postImage holds the result
+        // and replaces the scene target as the upscaler input. The scratch image and the per-effect
+        // pipelines only exist for the chained-pass benchmark comparison.
+        VkImage postImage = VK_NULL_HANDLE;
+        VkDeviceMemory postImageMemory = VK_NULL_HANDLE;
+        VkImageView postImageView = VK_NULL_HANDLE;
+        VkImage postScratchImage = VK_NULL_HANDLE;
+        VkDeviceMemory postScratchImageMemory = VK_NULL_HANDLE;
+        VkImageView postScratchImageView = VK_NULL_HANDLE;
+        VkImage gradingLutImage = VK_NULL_HANDLE; // 3D color grading LUT
+        VkDeviceMemory gradingLutImageMemory = VK_NULL_HANDLE;
+        VkImageView gradingLutImageView = VK_NULL_HANDLE;
+        VkSampler postSampler = VK_NULL_HANDLE; // Nearest, for texelFetch of scene color/depth
+        VkSampler gradingLutSampler = VK_NULL_HANDLE; // Linear, for LUT interpolation
+        VkDescriptorSetLayout postDescriptorSetLayout = VK_NULL_HANDLE;
+        VkPipelineLayout postPipelineLayout = VK_NULL_HANDLE;
+        VkPipeline postPipeline = VK_NULL_HANDLE; // All enabled effects fused into one dispatch
+        VkPipeline postEffectPipelines[POST_EFFECT_COUNT] = {}; // One effect each (chained comparison)
+        VkDescriptorPool postDescriptorPool = VK_NULL_HANDLE;
+        // scene->post, scene->scratch, scratch->post, post->scratch (only the first without chaining)
+        VkDescriptorSet postDescriptorSets[4] = {};
+
+        // --- Atmosphere (post effect) ---
+        // LUTs in GENERAL layout: transmittance, multiple scattering, sky view and the aerial perspective
+        // volume. The first two only depend on the atmosphere parameters and are re-baked through the GPU
+        // scheduler when those change; the other two follow the camera and are rendered every frame.
+        static constexpr uint32_t ATMOSPHERE_LUT_COUNT = 4;
+        VkImage atmosphereImages[ATMOSPHERE_LUT_COUNT] = {};
+        VkDeviceMemory atmosphereImageMemory[ATMOSPHERE_LUT_COUNT] = {};
+        VkImageView atmosphereImageViews[ATMOSPHERE_LUT_COUNT] = {};
+        VkSampler atmosphereSampler = VK_NULL_HANDLE; // Linear, clamped
+        VkDescriptorSetLayout atmosphereDescriptorSetLayout = VK_NULL_HANDLE;
+        VkPipelineLayout atmospherePipelineLayout = VK_NULL_HANDLE;
+        VkPipeline atmospherePipelines[ATMOSPHERE_LUT_COUNT] = {}; // One per LUT (PASS constant)
+        VkDescriptorPool atmosphereDescriptorPool = VK_NULL_HANDLE;
+        VkDescriptorSet atmosphereDescriptorSet = VK_NULL_HANDLE;
+        uint32_t atmosphereJob = 0; // Scheduler job baking the static LUTs, one per slice
+        glm::vec4 atmosphereBakedMedium{-1.0f}; // Parameters of the last requested bake (negative = none)
+
+        // --- Benchmark A/B Comparison ---
+        bool benchmarkPhaseB = false; // Native rendering (upscaler) or chained passes (post) this interval
+        float benchmarkPhaseMs[2] = {0.0f, 0.0f}; // Measured GPU time of phase A and phase B
+        std::vector<float> benchmarkFrameMs; // GPU frame times of the current report interval (for percentiles)
+        std::vector<VkSampleCountFlagBits> benchmarkSampleCounts; // MSAA sweep: supported counts
+        std::vector<float> benchmarkSampleSceneMs; // MSAA sweep: scene pass time per count
+        size_t benchmarkSampleIndex = 0;
+        std::vector<float> benchmarkSplits; // Impostor sweep: split distances, 0 (no impostor) first
+        std::vector<float> benchmarkSplitFrameMs; // Impostor sweep: mean frame time incl. amortized refreshes
+        size_t benchmarkSplitIndex = 0;
+        std::vector<float> benchmarkViewFrameMs; // View sweep: mean GPU frame time per view count
+        std::vector<float> benchmarkViewRecordMs; // View sweep: mean CPU recording time per view count
+        float recordCpuMsSum = 0.0f; // CPU time spent recording command buffers since the last report
+        uint32_t recordCpuFrames = 0;
+        // drawFrame calls and their CPU time since the last report, indexed by FrameStatus
+        struct FrameStatusStats {
+            uint32_t calls = 0;
+            float cpuMsSum = 0.0f;
+        } frameStatusStats[4];
+        uint32_t resizeBenchmarkCalls = 0; // drawFrame calls while --compare=resize resizes the window
 
         // --- Pipeline ---
         VkRenderPass renderPass = VK_NULL_HANDLE;
@@ -136,6 +326,218 @@ namespace vk_project_one {
         VkBuffer terrainIndexBuffer = VK_NULL_HANDLE;
         VkDeviceMemory terrainIndexBufferMemory = VK_NULL_HANDLE;
         uint32_t terrainIndexCount = 0; // Store the number of indices
+        std::vector<VkProjectOne::TerrainChunk> terrainChunks; // Index ranges in terrainIndexBuffer
+        glm::vec3 terrainBoundsMin{0.0f};
+        glm::vec3 terrainBoundsMax{0.0f};
+        float terrainCellSize = 1.0f; // World units between mesh vertices (grows with --terrain-step)
+        VkPipelineLayout terrainPipelineLayout = VK_NULL_HANDLE; // Detail texture set + push constants
+        VkPipeline terrainPipeline = VK_NULL_HANDLE; // All terrain, no distance clipping
+        VkPipeline terrainNearPipeline = VK_NULL_HANDLE; // Clipped at the far-field split
+        struct TerrainDrawRun {
+            uint32_t firstIndex;
+            uint32_t indexCount;
+            int32_t vertexOffset; // Streaming: first vertex of the chunk's pool slot (runs are never merged)
+        };
+        std::vector<TerrainDrawRun> terrainDrawRuns; // Chunks that passed the last culling, merged into ranges
+
+        // --- Terrain Streaming ---
+        // With config.streamRadius the terrain buffers above hold terrainChunkPool instead of the whole mesh.
+        // Each chunk is kept MeshCodec-compressed with its own vertices and local indices, and streamed into a
+        // pool slot by terrainStreamer when the camera comes near (see recordTerrainStreaming).
+        struct TerrainChunkPayload {
+            std::vector<uint8_t> packedVertices;
+            std::vector<uint8_t> packedIndices;
+            uint32_t vertexCount = 0;
+        };
+        std::vector<TerrainChunkPayload> terrainChunkPayloads; // Indexed like terrainChunks; read by workers
+        ChunkPool terrainChunkPool;
+        std::vector<uint32_t> terrainChunkSlots; // Pool slot per chunk, INVALID_SLOT while not resident
+        uint32_t residentTerrainChunks = 0;
+        uint32_t droppedTerrainUploads = 0; // Uploads that found the pool full, since the last benchmark report
+        uint64_t defragMovedBytes = 0; // Chunk bytes relocated by pool compaction, since the last benchmark report
+        // Copies from the staging ring filled by the upload callback, recorded before the frame's terrain draws
+        struct TerrainChunkUpload {
+            VkDeviceSize stagingOffset = 0; // Vertices, then indices, in terrainStagingBuffer
+            uint32_t chunk = 0;
+            VkDeviceSize vertexBytes = 0;
+            VkDeviceSize indexBytes = 0;
+        };
+        std::vector<TerrainChunkUpload> terrainChunkUploads;
+        // Persistently mapped upload ring with one region per frame in flight, each holding one update's uploads;
+        // a region is rewritten once the fence of the frame that last used it has been waited for
+        VkBuffer terrainStagingBuffer = VK_NULL_HANDLE;
+        VkDeviceMemory terrainStagingBufferMemory = VK_NULL_HANDLE;
+        void *terrainStagingMapped = nullptr;
+        VkDeviceSize terrainStagingRegionBytes = 0;
+        VkDeviceSize terrainStagingUsed = 0; // In the current frame's region
+        StreamingScheduler terrainStreamer;
+        glm::vec3 streamingCameraPosition{0.0f}; // Camera position of the previous frame ...
+        glm::vec3 streamingCameraVelocity{0.0f}; // ... and the velocity derived from it, per second
+        std::chrono::steady_clock::time_point streamingUpdateTime;
+
+        // --- Terrain Detail ---
+        // Tiling height texture for parallax occlusion mapped relief near the camera, which lets the
+        // terrain mesh itself be decimated (see EngineConfig::terrainStep).
+        VkImage terrainDetailImage = VK_NULL_HANDLE; // R8 height, full mip chain
+        VkDeviceMemory terrainDetailImageMemory = VK_NULL_HANDLE;
+        VkImageView terrainDetailImageView = VK_NULL_HANDLE;
+        VkSampler terrainDetailSampler = VK_NULL_HANDLE; // Trilinear, repeating
+        VkDescriptorSetLayout terrainDescriptorSetLayout = VK_NULL_HANDLE;
+        VkDescriptorPool terrainDescriptorPool = VK_NULL_HANDLE;
+        VkDescriptorSet terrainDescriptorSet = VK_NULL_HANDLE;
+
+        // --- Camera ---
+        glm::vec3 cameraPosition{0.0f};
+        glm::vec3 cameraForward{0.0f, 0.0f, -1.0f};
+        glm::mat4 cameraViewProj{1.0f};
+
+        // --- Views ---
+        // The window is split into viewCount side-by-side views around the camera above. Culling runs
+        // once against all of them; with multiview the scene target has one layer per view and every
+        // draw reaches all layers, otherwise each view is a viewport and its draws are recorded in turn.
+        struct View {
+            glm::mat4 viewProj{1.0f};
+            glm::vec3 eye{0.0f};
+            glm::vec3 forward{0.0f, 0.0f, -1.0f};
+        };
+        uint32_t viewCount = 1;
+        View views[MAX_VIEWS];
+
+        // --- Far-Field Terrain Impostor ---
+        // Terrain beyond the split distance is rendered into a cube map around the camera and
+        // only refreshed every few frames or after the camera moved; in between the scene pass
+        // draws near terrain and composites the cube map behind it with reconstructed depth.
+        VkImage impostorImage = VK_NULL_HANDLE; // Cube map: rgb = color, a = distance from impostorCenter
+        VkDeviceMemory impostorImageMemory = VK_NULL_HANDLE;
+        VkImageView impostorCubeView = VK_NULL_HANDLE;
+        VkImageView impostorFaceViews[6] = {};
+        VkImage impostorDepthImage = VK_NULL_HANDLE; // Transient, shared by all faces
+        VkDeviceMemory impostorDepthImageMemory = VK_NULL_HANDLE;
+        VkImageView impostorDepthImageView = VK_NULL_HANDLE;
+        VkFormat impostorDepthFormat = VK_FORMAT_UNDEFINED;
+        VkRenderPass impostorRenderPass = VK_NULL_HANDLE;
+        VkFramebuffer impostorFramebuffers[6] = {};
+        VkPipeline impostorTerrainPipeline = VK_NULL_HANDLE; // Far terrain into a cube face
+        VkSampler impostorSampler = VK_NULL_HANDLE;
+        VkDescriptorSetLayout impostorDescriptorSetLayout = VK_NULL_HANDLE;
+        VkDescriptorPool impostorDescriptorPool = VK_NULL_HANDLE;
+        VkDescriptorSet impostorDescriptorSet = VK_NULL_HANDLE;
+        VkPipelineLayout impostorCompositePipelineLayout = VK_NULL_HANDLE;
+        VkPipeline impostorCompositePipeline = VK_NULL_HANDLE;
+        glm::vec3 impostorCenter{0.0f}; // Camera position the cube map was rendered from
+        float impostorRenderedSplit = 0.0f; // Split the cube map was rendered with (0 = never rendered)
+        uint64_t impostorRefreshFrame = 0;
+        uint32_t impostorJob = 0; // Scheduler job rendering one cube face per slice
+
+        // --- Far-Field Heightfield Ray March ---
+        // The alternative far-field path: pixels beyond the split are intersected with the
+        // heightfield in the fragment shader, skipping empty space with a max-height mip pyramid,
+        // so no far terrain triangles are drawn at all.
+        VkImage heightImage = VK_NULL_HANDLE; // R32F vertex heights, for exact hits and normals
+        VkDeviceMemory heightImageMemory = VK_NULL_HANDLE;
+        VkImageView heightImageView = VK_NULL_HANDLE;
+        VkImage heightBoundsImage = VK_NULL_HANDLE; // RG32F min/max height per grid cell, full mip chain
+        VkDeviceMemory heightBoundsImageMemory = VK_NULL_HANDLE;
+        VkImageView heightBoundsImageView = VK_NULL_HANDLE;
+        uint32_t heightBoundsLevels = 0;
+        VkSampler heightfieldSampler = VK_NULL_HANDLE; // Unfiltered; the shader only uses texelFetch
+        VkDescriptorSetLayout rayMarchDescriptorSetLayout = VK_NULL_HANDLE;
+        VkDescriptorPool rayMarchDescriptorPool = VK_NULL_HANDLE;
+        VkDescriptorSet rayMarchDescriptorSet = VK_NULL_HANDLE;
+        VkPipelineLayout rayMarchPipelineLayout = VK_NULL_HANDLE;
+        VkPipeline rayMarchPipeline = VK_NULL_HANDLE;
+
+        // --- GPU Particles ---
+        // Two persistent pools trade roles every frame: the simulate pass appends last frame's survivors
+        // to the other pool (compacting it), the emit pass adds new particles behind them and a finalize
+        // pass writes the live count into the indirect dispatch and draw arguments of particleStateBuffer.
+        // The CPU only decides how many particles to emit; it never waits for the live count.
+        VkBuffer particlePools[2] = {};
+        VkDeviceMemory particlePoolMemory[2] = {};
+        VkBuffer particleStateBuffer = VK_NULL_HANDLE; // Counters + indirect arguments (see shaders/particle.comp)
+        VkDeviceMemory particleStateBufferMemory = VK_NULL_HANDLE;
+        VkBuffer particleReadbackBuffer = VK_NULL_HANDLE; // Live and emitted count per frame in flight
+        VkDeviceMemory particleReadbackBufferMemory = VK_NULL_HANDLE;
+        uint32_t *particleReadbackMapped = nullptr;
+        VkDescriptorSetLayout particleDescriptorSetLayout = VK_NULL_HANDLE;
+        VkDescriptorPool particleDescriptorPool = VK_NULL_HANDLE;
+        VkDescriptorSet particleDescriptorSets[2] = {}; // Indexed by the source pool of the frame
+        VkPipelineLayout particleComputePipelineLayout = VK_NULL_HANDLE;
+        VkPipeline particleSimulatePipeline = VK_NULL_HANDLE;
+        VkPipeline particleEmitPipeline = VK_NULL_HANDLE;
+        VkPipeline particleFinalizePipeline = VK_NULL_HANDLE;
+        VkPipelineLayout particleDrawPipelineLayout = VK_NULL_HANDLE;
+        VkPipeline particleDrawPipeline = VK_NULL_HANDLE; // Depends on the scene render pass
+        uint32_t particleSourcePool = 0; // Pool holding last frame's particles
+        float simulationTime = 0.0f; // Time passed to updateCubeRotation
+        float particleTime = -1.0f; // Simulation time of the last particle step (negative before the first)
+        float particleEmitCarry = 0.0f; // Fraction of a particle owed to the next frame
+
+        // Particle statistics since the last benchmark report (read back one frame in flight later)
+        struct ParticleStats {
+            uint32_t frames = 0;
+            uint64_t aliveSum = 0;
+            uint64_t emittedSum = 0;
+        } particleStats;
+
+        // --- Props ---
+        // Trees and rocks scattered over the terrain. Visible instances within config.propLodDistance are
+        // drawn as instanced meshes, farther ones as camera-facing quads from an impostor atlas that is
+        // baked offscreen at startup: every mesh seen from a grid of hemi-octahedral directions.
+        // Each mesh has a chain of simplified levels (MeshSimplifier) sharing its vertices; instances use
+        // the coarsest level whose error projects to at most config.propLodError pixels.
+        struct PropMeshRange {
+            uint32_t firstIndex;
+            uint32_t indexCount;
+            int32_t vertexOffset;
+            glm::vec4 bounds; // xyz = local bounding sphere center, w = radius
+            float error; // Simplification error in mesh units (0 for the full-detail level)
+        };
+        static constexpr uint32_t PROP_RANGE_COUNT = PROP_TYPE_COUNT * MAX_PROP_LODS + 1; // + the impostors
+        PropMeshRange propMeshRanges[PROP_TYPE_COUNT][MAX_PROP_LODS] = {};
+        uint32_t propLodCounts[PROP_TYPE_COUNT] = {}; // Levels built per type
+        VkBuffer propVertexBuffer = VK_NULL_HANDLE; // Every prop mesh back to back
+        VkDeviceMemory propVertexBufferMemory = VK_NULL_HANDLE;
+        VkBuffer propIndexBuffer = VK_NULL_HANDLE;
+        VkDeviceMemory propIndexBufferMemory = VK_NULL_HANDLE;
+        std::vector<PropInstance> propInstances; // Every placed prop
+        // Culled instances per frame in flight: meshes of each type and level, then all impostors
+        std::vector<VkBuffer> propInstanceBuffers;
+        std::vector<VkDeviceMemory> propInstanceBuffersMemory;
+        std::vector<PropInstance *> propInstanceBuffersMapped;
+        std::vector<PropInstance> propVisible[PROP_RANGE_COUNT]; // Culling scratch, same order
+        uint32_t propDrawCounts[PROP_RANGE_COUNT] = {}; // Instances per range of this frame
+        VkImage propAtlasImage = VK_NULL_HANDLE; // Layers: albedo and normal per PropType, mipmapped
+        VkDeviceMemory propAtlasImageMemory = VK_NULL_HANDLE;
+        VkImageView propAtlasImageView = VK_NULL_HANDLE;
+        VkSampler propAtlasSampler = VK_NULL_HANDLE;
+        VkDescriptorSetLayout propDescriptorSetLayout = VK_NULL_HANDLE;
+        VkDescriptorPool propDescriptorPool = VK_NULL_HANDLE;
+        VkDescriptorSet propDescriptorSet = VK_NULL_HANDLE;
+        VkPipelineLayout propPipelineLayout = VK_NULL_HANDLE; // Atlas set + UBO set + push constants
+        VkPipeline propMeshPipeline = VK_NULL_HANDLE; // Depends on the scene render pass
+        VkPipeline propImpostorPipeline = VK_NULL_HANDLE; // Same
+
+        // Prop statistics since the last benchmark report
+        struct PropStats {
+            uint32_t frames = 0;
+            uint64_t meshInstances = 0;
+            uint64_t impostorInstances = 0;
+            uint64_t lodInstances[MAX_PROP_LODS] = {}; // Mesh instances per level
+            uint64_t triangles = 0; // Drawn with LOD
+            uint64_t meshTriangles = 0; // The same instances drawn as full-detail meshes
+        } propStats;
+
+        // Terrain statistics since the last benchmark report
+        struct TerrainStats {
+            uint32_t recordedFrames = 0;
+            uint32_t frames = 0; // Frames with GPU timings
+            float frameMsSum = 0.0f; // GPU frame time, refresh frames included
+            uint32_t refreshes = 0;
+            float refreshMsSum = 0.0f;
+            uint64_t nearIndices = 0; // Terrain indices drawn by the scene pass
+            uint64_t farIndices = 0; // Terrain indices drawn into impostor faces
+        } terrainStats;
 
         // --- Descriptors ---
         VkDescriptorPool descriptorPool = VK_NULL_HANDLE;
@@ -146,7 +548,44 @@ namespace vk_project_one {
         std::vector<VkSemaphore> renderFinishedSemaphores;
         std::vector<VkFence> inFlightFences;
         uint32_t currentFrame = 0;
-        bool framebufferResized = false; // Flag to signal swapchain recreation needed
+        uint64_t frameCount = 0;
+
+        // --- GPU Timing & Dynamic Resolution ---
+        GpuTimer gpuTimer;
+        uint32_t gpuScopeFrame = 0; // Whole command buffer
+        uint32_t gpuScopeScene = 0; // Scene render pass
+        uint32_t gpuScopePost = 0; // Post-processing dispatch(es)
+        uint32_t gpuScopeUpscale = 0; // Scene -> swapchain scaling
+        uint32_t gpuScopeEasu = 0;
+        uint32_t gpuScopeRcas = 0;
+        uint32_t gpuScopeImpostor = 0; // Far-field cube map faces (only in frames that refresh some)
+        uint32_t gpuScopeParticles = 0; // Particle simulate, emit and finalize dispatches
+        uint32_t gpuScopeAtmosphere = 0; // Per-frame sky-view and aerial perspective LUTs
+        GpuScheduler gpuScheduler; // Time-sliced jobs, fitted into config.amortizedBudgetMs per frame
+
+        // --- Async Compute ---
+        // With a compute-only queue family, particle simulation and post-processing are submitted to its queue
+        // as separate batches around the scene pass, ordered by one timeline semaphore per queue (see
+        // submitAsyncCompute). Resources used by both queues are created with concurrent sharing.
+        bool asyncComputeAvailable = false;
+        uint32_t sharedQueueFamilies[2] = {}; // Graphics and compute family
+        VkQueue computeQueue = VK_NULL_HANDLE;
+        VkCommandPool computeCommandPool = VK_NULL_HANDLE;
+        std::vector<VkCommandBuffer> computeCommandBuffers; // Two per frame in flight: particles, post
+        std::vector<VkCommandBuffer> frameEndCommandBuffers; // Per frame in flight: upscale after the async post
+        VkSemaphore graphicsTimeline = VK_NULL_HANDLE; // Signaled by every scene pass batch
+        VkSemaphore computeTimeline = VK_NULL_HANDLE; // Signaled by every compute batch
+        uint64_t graphicsTimelineValue = 0; // Last value submitted for signaling
+        uint64_t computeTimelineValue = 0;
+        bool asyncBatchRecorded[2] = {}; // This frame's compute batches: particles, post
+        GpuTimer computeTimer; // Timestamps of the compute queue
+        uint32_t computeScopeParticles = 0;
+        uint32_t computeScopePost = 0;
+        std::unique_ptr<DynamicResolution> dynamicResolution; // Null when disabled
+
+        // --- Resource Report ---
+        ResourceReport resourceReport; // Rebuilt with the swapchain-sized targets
+        MemoryReport memoryReport; // Every live allocation of createBuffer/createImage
 
         // --- Private Helper Method Declarations ---
 
@@ -158,6 +597,134 @@ namespace vk_project_one {
 
         void createTerrainIndexBuffer(const std::vector<uint32_t>& indices);
 
+        void loadTerrain();
+
+        // Terrain and far-field composite pipelines; they depend on the scene render pass.
+        void createTerrainPipelines();
+
+        void cleanupTerrainPipelines();
+
+        // Impostor cube map, its render pass and the composite descriptor set (swapchain independent).
+        void createImpostorTargets();
+
+        void cleanupImpostorTargets();
+
+        // Benchmark mode: compresses the terrain mesh with MeshCodec, decodes it into a mapped staging buffer
+        // and logs the compression ratio and decode throughput.
+        void measureTerrainCodec(const std::vector<VkProjectOne::TerrainVertex> &vertices,
+                                 const std::vector<uint32_t> &indices);
+
+        // Streaming: compresses each chunk's vertices and local indices into terrainChunkPayloads, creates
+        // terrainChunkPool in the terrain buffers and sets up terrainStreamer to read, decode and upload them.
+        void createTerrainStreaming(const std::vector<VkProjectOne::TerrainVertex> &vertices,
+                                    const std::vector<uint32_t> &indices);
+
+        // Heightfield textures and descriptor set for the ray-marched far field (swapchain independent).
+        void createHeightfield(const std::vector<VkProjectOne::TerrainVertex> &vertices, uint32_t gridWidth,
+                               uint32_t gridHeight);
+
+        void cleanupHeightfield();
+
+        // Detail height texture and the terrain descriptor set (swapchain independent).
+        void createTerrainDetail();
+
+        void cleanupTerrainDetail();
+
+        // Particle pools, state buffer, descriptor sets and compute pipelines (swapchain independent).
+        // Needs the heightfield for terrain collisions.
+        void createParticleSystem();
+
+        void cleanupParticleSystem();
+
+        // Billboard pipeline of the particles; it depends on the scene render pass.
+        void createParticleDrawPipeline();
+
+        void cleanupParticleDrawPipeline();
+
+        // Simulates, compacts and emits the particles of this frame, outside the scene pass.
+        void recordParticleSimulation(VkCommandBuffer commandBuffer, bool computeQueue);
+
+        // Draws the live particles of one view (all views under multiview) inside the scene pass.
+        void recordParticleDraw(VkCommandBuffer commandBuffer, uint32_t view) const;
+
+        // Scatters the props over the terrain and uploads their meshes, instance buffers and baked
+        // impostor atlas (swapchain independent).
+        void createProps(const std::vector<VkProjectOne::TerrainVertex> &vertices);
+
+        void cleanupProps();
+
+        // Renders every prop mesh from every atlas frame direction and builds the atlas mips.
+        void bakePropAtlas();
+
+        enum class PropPipelineKind {
+            Mesh, // Scene pass, full geometry
+            Impostor, // Scene pass, atlas quads
+            Bake // Atlas render pass: albedo and normal targets
+        };
+
+        VkPipeline createPropPipeline(VkRenderPass targetPass, PropPipelineKind kind);
+
+        // Mesh and impostor pipelines of the scene pass.
+        void createPropPipelines();
+
+        void cleanupPropPipelines();
+
+        // Culling pass: keeps the props inside any of the frusta, chooses mesh or impostor per instance by
+        // distance and writes them into this frame's instance buffer.
+        void cullProps(const Frustum *frusta, uint32_t frustumCount);
+
+        // Draws the props culled for this frame into one view (all views under multiview).
+        void recordProps(VkCommandBuffer commandBuffer, uint32_t view) const;
+
+        bool isImpostorUsed() const;
+
+        bool isRayMarchUsed() const;
+
+        // Split distance in effect this frame (0 = all terrain rasterized every frame).
+        float currentFarFieldSplit() const;
+
+        // Collects the terrain chunks that intersect any of the frusta and the [minDistance, maxDistance)
+        // ring around origin into terrainDrawRuns, merging adjacent chunks. Returns the number of indices.
+        uint64_t cullTerrainChunks(const Frustum *frusta, uint32_t frustumCount, const glm::vec3 &origin,
+                                   float minDistance, float maxDistance);
+
+        // Binds the terrain buffers and draws the runs of the last cullTerrainChunks call.
+        void recordTerrainDraws(VkCommandBuffer commandBuffer) const;
+
+        // Streaming: requests the chunks within config.streamRadius of the camera and of where it is heading,
+        // evicts those beyond, and records the copies of the chunks uploaded this frame.
+        void recordTerrainStreaming(VkCommandBuffer commandBuffer);
+
+        // Main thread: stages a decoded chunk (vertices followed by indices) for recordTerrainStreaming. With
+        // the pool full the chunk is dropped (and requested again), and the farthest resident chunk evicted
+        // if it is farther away.
+        void uploadTerrainChunk(uint32_t chunk, const std::vector<uint8_t> &data);
+
+        void evictTerrainChunk(uint32_t chunk);
+
+        // Relocates chunks planned by ChunkPool::planMove within config.defragBytesPerFrame, before the frame's
+        // culling so its draws already use the new slots; the old slots are released with this frame.
+        // Returns whether copies were recorded.
+        bool recordTerrainPoolDefrag(VkCommandBuffer commandBuffer);
+
+        // Re-renders one impostor face. Face 0 starts a refresh from the current camera position, so faces
+        // not re-rendered yet are at most one refresh interval older (the tolerated camera drift).
+        void recordImpostorFace(VkCommandBuffer commandBuffer, uint32_t face);
+
+        // Near terrain (or all terrain without a far field) and the far-field composite of one view, inside
+        // the scene pass. The chunks must already be culled for the frame.
+        void recordTerrain(VkCommandBuffer commandBuffer, float split, uint32_t view);
+
+        // Multiview needs every consumer of the scene target to handle layers, so it is only used when the
+        // target goes straight to the swapchain blit (no post effects, FSR or far-field composite).
+        bool isMultiviewUsed() const;
+
+        // Region of the scene target a view renders into this frame (within its own layer under multiview).
+        VkRect2D viewRegion(uint32_t view) const;
+
+        // Width / height of one view.
+        float viewAspect() const;
+
         void setupDebugMessenger();
 
         void createSurface();
@@ -168,8 +735,118 @@ namespace vk_project_one {
 
         void createSwapChain();
 
+        // Creates a swapchain for any of the windows; used for the first one and for every WindowOutput.
+        // oldSwapChain is the one being replaced, if any (it is retired, not destroyed).
+        void createSwapChain(VkSurfaceKHR targetSurface, SDL_Window *targetWindow, VkSwapchainKHR &targetSwapChain,
+                             std::vector<VkImage> &images, VkFormat &imageFormat, VkExtent2D &extent,
+                             VkSwapchainKHR oldSwapChain = VK_NULL_HANDLE);
+
         void createImageViews();
 
+        // Surfaces, swapchains, command buffers and semaphores of the windows after the first.
+        void createWindowOutputs();
+
+        // Swapchain and image views of one further window (left null while it is minimized).
+        void createWindowOutputSwapChain(WindowOutput &output, VkSwapchainKHR oldSwapChain = VK_NULL_HANDLE);
+
+        void cleanupWindowOutputSwapChain(WindowOutput &output);
+
+        // Replaces the window's swapchain with one of its current size; the old one is retired.
+        void recreateWindowOutputSwapChain(WindowOutput &output);
+
+        void noteResize(PendingResize &resize);
+
+        // noteResize for the first window, which also leaves SwapChainState::Ready.
+        void noteSwapChainResize();
+
+        void setSwapChainState(SwapChainState state);
+
+        // drawFrame without the per-status accounting.
+        FrameStatus renderFrame();
+
+        // Enters SwapChainState::DeviceLost if the result says so.
+        bool checkDeviceLost(VkResult result, const char *operation);
+
+        // The size has held for resizeDelayMs, or the resize has been deferred for four times that.
+        bool isResizeDue(const PendingResize &resize) const;
+
+        // Full recreation of the first window once its resize is due; until then an out-of-date swapchain
+        // is only replaced.
+        // Returns whether the swapchain was recreated or replaced; false when the window turned out to be
+        // minimized (the state is then Minimized and the following frames are skipped until it is restored).
+        bool handleResize(bool outOfDate);
+
+        // Swapchain of the first window's current size with the render targets left as they are; the final
+        // blit stretches the frame into it. While minimized, falls back to recreateSwapChain(), which only
+        // enters the Minimized state.
+        void replaceSwapChain();
+
+        void retireSwapChain(VkSwapchainKHR oldSwapChain, std::vector<VkImageView> imageViews);
+
+        // Destroys the retired swapchains whose frames have completed (all of them once the device is idle).
+        void destroyRetiredSwapChains(bool all);
+
+        void cleanupWindowOutputs();
+
+        void createSceneTargets();
+
+        void cleanupSceneTargets();
+
+        // Sample counts usable for both the color and the depth attachment, ascending from 1x.
+        std::vector<VkSampleCountFlagBits> getSupportedSampleCounts() const;
+
+        // Rebuilds the scene targets, render pass and pipeline for a new MSAA sample count.
+        void setSampleCount(VkSampleCountFlagBits samples);
+
+        // Same for a new view count (benchmark view sweep).
+        void setViewCount(uint32_t count);
+
+        // Waits for the device and destroys / recreates everything the sample and view counts are baked into.
+        void destroyScenePass();
+
+        void createScenePass();
+
+        // Depth outlives the render pass only when the post pass reads it (fog, atmosphere); otherwise it is
+        // transient.
+        bool isDepthSampled() const;
+
+        // Render extent for the next frame: dynamic resolution, fixed upscale factor or native.
+        VkExtent2D computeRenderExtent() const;
+
+        void createUpscalerPipelines();
+
+        void createUpscalerTargets();
+
+        void cleanupUpscalerTargets();
+
+        // True when the configured upscaler (not the native benchmark phase) scales this frame.
+        bool isFsrActive() const;
+
+        void createPostProcessPipelines();
+
+        void createGradingLut();
+
+        // Atmosphere LUTs, their pipelines and descriptor set (swapchain independent).
+        void createAtmosphere();
+
+        void cleanupAtmosphere();
+
+        // Medium parameters of the atmosphere shaders: Rayleigh and Mie density, ground albedo, aerial depth.
+        glm::vec4 atmosphereMedium() const;
+
+        // Bakes one static LUT (slice 0: transmittance, 1: multiple scattering).
+        void recordAtmosphereBake(VkCommandBuffer commandBuffer, uint32_t slice);
+
+        // Renders the camera-dependent LUTs for this frame's post pass.
+        void recordAtmosphere(VkCommandBuffer commandBuffer);
+
+        void createPostProcessTargets();
+
+        void cleanupPostProcessTargets();
+
+        // Estimated DRAM traffic of one post-processing frame, fused or as one pass per effect.
+        uint64_t estimatePostTrafficBytes(bool chained) const;
+
         void createRenderPass();
 
         void createDescriptorSetLayout();
@@ -194,9 +871,49 @@ namespace vk_project_one {
 
         void createSyncObjects();
 
+        void initGpuTiming();
+
+        // Compute command pool, command buffers and timeline semaphores (when async compute is available).
+        void createAsyncCompute();
+
+        void cleanupAsyncCompute();
+
+        // True when this frame's particles and post-processing go to the compute queue.
+        bool isAsyncComputeActive() const;
+
+        // Submits the compute batches and the scene pass of an async frame; the frame-end batch follows.
+        // Returns VK_ERROR_DEVICE_LOST if the device was lost, throws on other failures.
+        VkResult submitAsyncCompute();
+
+        // Rebuilds and logs the render target memory / attachment traffic report.
+        void updateResourceReport();
+
         // --- Private Rendering & Update Methods ---
         void recordCommandBuffer(VkCommandBuffer commandBuffer, uint32_t imageIndex);
 
+        // Scales the rendered region of the scene target into the acquired swapchain image.
+        void recordSceneUpscale(VkCommandBuffer commandBuffer, uint32_t imageIndex);
+
+        // Scales the finished frame (rendered region, post output or FSR output) into an image that is in
+        // the transfer destination layout; every view goes to its share of the width.
+        void recordFrameBlit(VkCommandBuffer commandBuffer, VkImage dstImage, VkExtent2D dstExtent) const;
+
+        // Command buffer of a further window: the finished frame into its acquired swapchain image.
+        // Runs after the main command buffer in the same submission, which already made the frame readable.
+        void recordWindowOutput(VkCommandBuffer commandBuffer, const WindowOutput &output) const;
+
+        // EASU + RCAS compute passes followed by a copy into the swapchain image.
+        void recordFsrUpscale(VkCommandBuffer commandBuffer, uint32_t imageIndex);
+
+        // Post-processes the rendered region into postImage (fused, or chained in benchmark phase B).
+        void recordPostProcess(VkCommandBuffer commandBuffer);
+
+        // Reads the GPU timings of the frame slot that just finished and updates the render extent.
+        void updateFrameTimings();
+
+        // Logs GPU timings and controller statistics periodically in benchmark mode.
+        void reportBenchmark();
+
         // Updates the uniform buffer memory for the given frame index with current matrix data.
         void updateUniformBuffer(uint32_t currentImageIndex);
 
@@ -226,16 +943,51 @@ namespace vk_project_one {
 
         SwapChainSupportDetails querySwapChainSupport(VkPhysicalDevice queryDevice) const;
 
+        SwapChainSupportDetails querySwapChainSupport(VkPhysicalDevice queryDevice, VkSurfaceKHR querySurface) const;
+
         VkSurfaceFormatKHR chooseSwapSurfaceFormat(const std::vector<VkSurfaceFormatKHR> &availableFormats);
 
         VkPresentModeKHR chooseSwapPresentMode(const std::vector<VkPresentModeKHR> &availablePresentModes);
 
-        VkExtent2D chooseSwapExtent(const VkSurfaceCapabilitiesKHR &capabilities);
+        VkExtent2D chooseSwapExtent(const VkSurfaceCapabilitiesKHR &capabilities, SDL_Window *targetWindow);
 
         uint32_t findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties);
 
-        void createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties,
-                          VkBuffer &buffer, VkDeviceMemory &bufferMemory);
+        bool tryFindMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties, uint32_t &typeIndex) const;
+
+        VkFormat findSupportedFormat(const std::vector<VkFormat> &candidates, VkImageTiling tiling,
+                                     VkFormatFeatureFlags features) const;
+
+        VkFormat findDepthFormat(bool sampled) const;
+
+        // Buffers and images are tracked in memoryReport under their tag, whose name is also given to the
+        // object and its memory for debugging tools. Their memory is freed with freeMemory.
+        // computeShared: also used on the async compute queue (concurrent sharing when it is available).
+        void createBuffer(const MemoryTag &tag, VkDeviceSize size, VkBufferUsageFlags usage,
+                          VkMemoryPropertyFlags properties, VkBuffer &buffer, VkDeviceMemory &bufferMemory,
+                          bool computeShared = false);
+
+        // Transient attachments are placed in lazily allocated memory when the device has it.
+        void createImage(const MemoryTag &tag, uint32_t width, uint32_t height, VkFormat format,
+                         VkImageUsageFlags usage, VkMemoryPropertyFlags properties, VkImage &image,
+                         VkDeviceMemory &imageMemory, VkSampleCountFlagBits numSamples = VK_SAMPLE_COUNT_1_BIT,
+                         uint32_t arrayLayers = 1, bool computeShared = false);
+
+        // General form for layered, cube compatible or mipmapped images.
+        void createImage(const MemoryTag &tag, const VkImageCreateInfo &imageInfo, VkMemoryPropertyFlags properties,
+                         VkImage &image, VkDeviceMemory &imageMemory, bool computeShared = false);
+
+        void freeMemory(VkDeviceMemory memory);
+
+        // VK_EXT_debug_utils object name, shown by validation messages and capture tools.
+        void nameObject(VkObjectType type, uint64_t handle, const std::string &name);
+
+        // Estimates of the swapchain images for memoryReport, from their count, extent and format.
+        void updateSwapChainMemoryEstimates();
+
+        VkImageView createImageView(VkImage image, VkFormat format, VkImageAspectFlags aspectFlags,
+                                    VkImageViewType viewType = VK_IMAGE_VIEW_TYPE_2D, uint32_t baseArrayLayer = 0,
+                                    uint32_t layerCount = 1, uint32_t levelCount = 1);
 
         void copyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size);
 
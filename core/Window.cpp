@@ -8,24 +8,34 @@
 #include <SDL3/SDL_vulkan.h>
 
 namespace vk_project_one {
-    Window::Window(const int width, const int height, std::string title) {
-        if (SDL_Init(SDL_INIT_VIDEO) < 0) {
-            const std::string errorMsg = "SDL_Init failed: " + std::string(SDL_GetError());
-            spdlog::critical(errorMsg);
-            throw std::runtime_error(errorMsg);
-        }
+    namespace {
+        int liveWindowCount = 0; // Windows sharing the SDL video subsystem
 
-        if (SDL_Vulkan_LoadLibrary(nullptr) == -1) {
-            const std::string errorMsg = "SDL_Vulkan_LoadLibrary failed: " + std::string(SDL_GetError());
-            spdlog::critical(errorMsg);
-            throw std::runtime_error(errorMsg);
+        void initializeSdl() {
+            if (SDL_Init(SDL_INIT_VIDEO) < 0) {
+                const std::string errorMsg = "SDL_Init failed: " + std::string(SDL_GetError());
+                spdlog::critical(errorMsg);
+                throw std::runtime_error(errorMsg);
+            }
+
+            if (SDL_Vulkan_LoadLibrary(nullptr) == -1) {
+                const std::string errorMsg = "SDL_Vulkan_LoadLibrary failed: " + std::string(SDL_GetError());
+                spdlog::critical(errorMsg);
+                throw std::runtime_error(errorMsg);
+            }
+            spdlog::debug("SDL Initialized.");
         }
+    }
+
+    Window::Window(const int width, const int height, std::string title, const int x, const int y) {
+        if (liveWindowCount == 0) initializeSdl();
+        ++liveWindowCount;
 
-        spdlog::debug("SDL Initialized. Creating window...");
+        spdlog::debug("Creating window...");
         SDL_PropertiesID props = SDL_CreateProperties();
         SDL_SetStringProperty(props, SDL_PROP_WINDOW_CREATE_TITLE_STRING, title.c_str());
-        SDL_SetNumberProperty(props, SDL_PROP_WINDOW_CREATE_X_NUMBER, SDL_WINDOWPOS_CENTERED);
-        SDL_SetNumberProperty(props, SDL_PROP_WINDOW_CREATE_Y_NUMBER, SDL_WINDOWPOS_CENTERED);
+        SDL_SetNumberProperty(props, SDL_PROP_WINDOW_CREATE_X_NUMBER, x);
+        SDL_SetNumberProperty(props, SDL_PROP_WINDOW_CREATE_Y_NUMBER, y);
         SDL_SetNumberProperty(props, SDL_PROP_WINDOW_CREATE_WIDTH_NUMBER, width);
         SDL_SetNumberProperty(props, SDL_PROP_WINDOW_CREATE_HEIGHT_NUMBER, height);
         SDL_SetBooleanProperty(props, SDL_PROP_WINDOW_CREATE_VULKAN_BOOLEAN, true);
@@ -44,7 +54,7 @@ namespace vk_project_one {
                 errorMsg += " (No specific error message from SDL)";
             }
             spdlog::critical(errorMsg);
-            SDL_Quit();
+            if (--liveWindowCount == 0) SDL_Quit();
             throw std::runtime_error(errorMsg);
         }
         spdlog::info("Window created: '{}'", title);
@@ -53,7 +63,7 @@ namespace vk_project_one {
     Window::~Window() {
         spdlog::debug("Destroying Window...");
         if (sdlWindow != nullptr) SDL_DestroyWindow(sdlWindow);
-        SDL_Quit();
+        if (--liveWindowCount == 0) SDL_Quit();
         spdlog::info("Window destroyed.");
     }
 
@@ -11,7 +11,9 @@ namespace vk_project_one {
 
     class Window {
     public:
-        Window(int width, int height, std::string title);
+        // SDL is initialized with the first window and shut down with the last one.
+        Window(int width, int height, std::string title, int x = SDL_WINDOWPOS_CENTERED,
+               int y = SDL_WINDOWPOS_CENTERED);
 
         ~Window();
 
@@ -3,6 +3,7 @@
 
 #include "app/Application.h"
 #include "common/Log.h"
+#include "core/EngineConfig.h"
 #include <spdlog/spdlog.h>
 #include <stdexcept>
 #include <cstdlib>
@@ -12,7 +13,8 @@ int main(int argc, char *argv[]) {
     spdlog::info("Starting VkProjectOne Application...");
 
     try {
-        const vk_project_one::Application app;
+        const auto config = vk_project_one::EngineConfig::FromCommandLine(argc, argv);
+        vk_project_one::Application app(config);
         app.run();
     } catch (const std::exception &e) {
         spdlog::critical("Unhandled exception caught in main: {}", e.what());
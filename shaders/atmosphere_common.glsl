@@ -0,0 +1,124 @@
+// Earth-like atmosphere shared by the LUT passes (atmosphere.comp) and the post pass, after Hillaire,
+// "A Scalable and Production Ready Sky and Atmosphere Rendering Technique" (EGSR 2020).
+// Distances are in kilometres with the planet center at the origin and y up.
+
+const float PI = 3.14159265;
+const float PLANET_RADIUS = 6360.0;
+const float ATMOSPHERE_RADIUS = 6460.0;
+const vec3 RAYLEIGH_SCATTERING = vec3(5.802, 13.558, 33.1) * 1e-3; // Per km at sea level
+const float RAYLEIGH_HEIGHT = 8.0; // Scale height in km
+const float MIE_SCATTERING = 3.996e-3;
+const float MIE_EXTINCTION = 4.440e-3;
+const float MIE_HEIGHT = 1.2;
+const float MIE_G = 0.8;
+const vec3 OZONE_ABSORPTION = vec3(0.650, 1.881, 0.085) * 1e-3; // At the peak of the 25 km tent profile
+
+struct Medium {
+    vec3 rayleigh; // Scattering coefficients
+    vec3 mie;
+    vec3 extinction;
+};
+
+// densities: x = Rayleigh multiplier, y = Mie multiplier (haze)
+Medium sampleMedium(float height, vec2 densities) {
+    height = max(height, 0.0);
+    float ozone = max(0.0, 1.0 - abs(height - 25.0) / 15.0);
+    Medium medium;
+    medium.rayleigh = RAYLEIGH_SCATTERING * exp(-height / RAYLEIGH_HEIGHT) * densities.x;
+    float mieDensity = exp(-height / MIE_HEIGHT) * densities.y;
+    medium.mie = vec3(MIE_SCATTERING * mieDensity);
+    medium.extinction = medium.rayleigh + vec3(MIE_EXTINCTION * mieDensity) + OZONE_ABSORPTION * ozone;
+    return medium;
+}
+
+// Nearest non-negative distance along the ray to a sphere around the origin, -1 if there is none
+float raySphere(vec3 origin, vec3 dir, float radius) {
+    float b = dot(origin, dir);
+    float c = dot(origin, origin) - radius * radius;
+    float discriminant = b * b - c;
+    if (discriminant < 0.0) return -1.0;
+    float s = sqrt(discriminant);
+    if (-b - s >= 0.0) return -b - s;
+    return -b + s >= 0.0 ? -b + s : -1.0;
+}
+
+float rayleighPhase(float cosTheta) {
+    return 3.0 / (16.0 * PI) * (1.0 + cosTheta * cosTheta);
+}
+
+// Cornette-Shanks
+float miePhase(float cosTheta) {
+    float g2 = MIE_G * MIE_G;
+    return 3.0 / (8.0 * PI) * (1.0 - g2) * (1.0 + cosTheta * cosTheta) /
+           ((2.0 + g2) * pow(1.0 + g2 - 2.0 * MIE_G * cosTheta, 1.5));
+}
+
+// Transmittance LUT: Bruneton's mapping of (radius, view zenith cosine) to the distance to the top
+float horizonDistance() {
+    return sqrt(ATMOSPHERE_RADIUS * ATMOSPHERE_RADIUS - PLANET_RADIUS * PLANET_RADIUS);
+}
+
+vec2 transmittanceUv(float r, float mu) {
+    float H = horizonDistance();
+    float rho = sqrt(max(r * r - PLANET_RADIUS * PLANET_RADIUS, 0.0));
+    float discriminant = r * r * (mu * mu - 1.0) + ATMOSPHERE_RADIUS * ATMOSPHERE_RADIUS;
+    float d = max(0.0, -r * mu + sqrt(max(discriminant, 0.0)));
+    float dMin = ATMOSPHERE_RADIUS - r;
+    float dMax = rho + H;
+    return vec2((d - dMin) / (dMax - dMin), rho / H);
+}
+
+void transmittanceParameters(vec2 uv, out float r, out float mu) {
+    float H = horizonDistance();
+    float rho = H * uv.y;
+    r = sqrt(rho * rho + PLANET_RADIUS * PLANET_RADIUS);
+    float dMin = ATMOSPHERE_RADIUS - r;
+    float dMax = rho + H;
+    float d = dMin + uv.x * (dMax - dMin);
+    mu = d <= 0.0 ? 1.0 : clamp((H * H - rho * rho - d * d) / (2.0 * r * d), -1.0, 1.0);
+}
+
+vec3 sampleTransmittance(sampler2D lut, float r, float mu) {
+    return textureLod(lut, transmittanceUv(r, mu), 0.0).rgb;
+}
+
+// Multiple-scattering LUT: u = sun zenith cosine, v = height through the atmosphere
+vec3 sampleMultiScattering(sampler2D lut, float r, float muSun) {
+    vec2 uv = vec2(muSun * 0.5 + 0.5, (r - PLANET_RADIUS) / (ATMOSPHERE_RADIUS - PLANET_RADIUS));
+    return textureLod(lut, clamp(uv, 0.0, 1.0), 0.0).rgb;
+}
+
+// Sky-view LUT: u = azimuth away from the sun (the sky is symmetric about the sun's vertical plane),
+// v = zenith angle, mapped non-linearly so half of the rows lie close to the horizon
+vec2 skyViewUv(float r, vec3 dir, vec3 sunDir) {
+    float horizonZenith = PI - acos(sqrt(max(r * r - PLANET_RADIUS * PLANET_RADIUS, 0.0)) / r);
+    float viewZenith = acos(clamp(dir.y, -1.0, 1.0));
+    float v;
+    if (viewZenith < horizonZenith) {
+        v = 0.5 * (1.0 - sqrt(1.0 - viewZenith / horizonZenith));
+    } else {
+        v = 0.5 + 0.5 * sqrt((viewZenith - horizonZenith) / (PI - horizonZenith));
+    }
+    float cosAzimuth = 1.0;
+    if (dot(dir.xz, dir.xz) > 1e-8 && dot(sunDir.xz, sunDir.xz) > 1e-8) {
+        cosAzimuth = dot(normalize(dir.xz), normalize(sunDir.xz));
+    }
+    return vec2(acos(clamp(cosAzimuth, -1.0, 1.0)) / PI, v);
+}
+
+vec3 skyViewDirection(float r, vec2 uv, vec3 sunDir) {
+    float horizonZenith = PI - acos(sqrt(max(r * r - PLANET_RADIUS * PLANET_RADIUS, 0.0)) / r);
+    float viewZenith;
+    if (uv.y < 0.5) {
+        float coord = 1.0 - 2.0 * uv.y;
+        viewZenith = horizonZenith * (1.0 - coord * coord);
+    } else {
+        float coord = 2.0 * uv.y - 1.0;
+        viewZenith = horizonZenith + (PI - horizonZenith) * coord * coord;
+    }
+    vec2 toSun = dot(sunDir.xz, sunDir.xz) > 1e-8 ? normalize(sunDir.xz) : vec2(1.0, 0.0);
+    vec2 side = vec2(-toSun.y, toSun.x);
+    float azimuth = uv.x * PI;
+    vec2 horizontal = toSun * cos(azimuth) + side * sin(azimuth);
+    return vec3(horizontal.x * sin(viewZenith), cos(viewZenith), horizontal.y * sin(viewZenith));
+}
@@ -0,0 +1,41 @@
+#version 450
+
+// Far-field terrain from the cube map impostor. Each face stores color and the distance from
+// the impostor center in alpha (0 where only sky was visible). The lookup is corrected for the
+// camera having moved away from the center, and depth is reconstructed from the stored
+// distance so the far field composites with near geometry and fog like rendered terrain.
+
+layout (set = 0, binding = 0) uniform samplerCube farField;
+
+layout (location = 0) in vec2 fragNdc;
+
+layout (location = 0) out vec4 outColor;
+// Reconstructed depth is never nearer than the triangle, which keeps early depth testing valid
+layout (depth_greater) out float gl_FragDepth;
+
+layout (push_constant) uniform Params {
+    mat4 invViewProj;
+    vec4 eye;     // xyz = camera position, w = near plane
+    vec4 center;  // xyz = position the impostor was rendered from, w = far plane
+    vec4 forward; // xyz = camera view direction, w = depth of the full-screen triangle
+} params;
+
+void main() {
+    vec4 farPoint = params.invViewProj * vec4(fragNdc, 1.0, 1.0);
+    vec3 dir = normalize(farPoint.xyz / farPoint.w - params.eye.xyz);
+
+    // First guess as if the camera sat at the center, then re-sample toward the point it hit
+    vec4 guess = texture(farField, dir);
+    if (guess.a <= 0.0) discard;
+    vec3 toHit = params.eye.xyz + dir * guess.a - params.center.xyz;
+    vec4 far = texture(farField, toHit);
+    if (far.a <= 0.0) discard;
+    vec3 hit = params.center.xyz + normalize(toHit) * far.a;
+
+    // Perspective depth (zero-to-one range) of the hit point's view-space distance
+    float n = params.eye.w;
+    float f = params.center.w;
+    float viewZ = clamp(dot(hit - params.eye.xyz, params.forward.xyz), n, f);
+    gl_FragDepth = max(f / (f - n) * (1.0 - n / viewZ), gl_FragCoord.z);
+    outColor = vec4(far.rgb, 1.0);
+}
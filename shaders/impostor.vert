@@ -0,0 +1,21 @@
+#version 450
+
+// Full-screen triangle for compositing the far-field impostor. It is placed at the nearest
+// depth any far-field pixel can have, so the early depth test rejects pixels already covered
+// by near geometry before the fragment shader runs.
+// The ray-marched far field uses this shader too; its push constants keep forward at the same offset.
+
+layout (location = 0) out vec2 fragNdc;
+
+layout (push_constant) uniform Params {
+    mat4 invViewProj;
+    vec4 eye;     // xyz = camera position, w = near plane
+    vec4 center;  // xyz = position the impostor was rendered from, w = far plane
+    vec4 forward; // xyz = camera view direction, w = depth of the full-screen triangle
+} params;
+
+void main() {
+    vec2 uv = vec2((gl_VertexIndex << 1) & 2, gl_VertexIndex & 2);
+    fragNdc = uv * 2.0 - 1.0;
+    gl_Position = vec4(fragNdc, params.forward.w, 1.0);
+}
@@ -0,0 +1,29 @@
+#version 450
+
+// Soft round particles (or thin rain streaks), premultiplied alpha, no depth write.
+
+layout (constant_id = 1) const int EFFECT = 0; // 0 dust, 1 smoke, 2 rain (ParticleEffect)
+
+layout (location = 0) in vec2 fragCorner;
+layout (location = 1) in float fragFade;
+
+layout (location = 0) out vec4 outColor;
+
+void main() {
+    float falloff;
+    vec3 color;
+    float opacity;
+    if (EFFECT == 2) {
+        falloff = 1.0 - abs(fragCorner.x); // Across the streak only
+        color = vec3(0.7, 0.75, 0.8);
+        opacity = 0.35;
+    } else {
+        float r2 = dot(fragCorner, fragCorner);
+        if (r2 > 1.0) discard;
+        falloff = 1.0 - r2;
+        color = EFFECT == 1 ? vec3(0.55, 0.55, 0.55) : vec3(0.62, 0.52, 0.38);
+        opacity = EFFECT == 1 ? 0.12 : 0.6;
+    }
+    float alpha = falloff * opacity * fragFade;
+    outColor = vec4(color * alpha, alpha);
+}
@@ -0,0 +1,60 @@
+#version 450
+#extension GL_EXT_multiview : require
+
+// Camera-facing particle billboards, one instance per live particle and six vertices each. The
+// instance count comes from the finalize pass of particle.comp through an indirect draw, so the
+// CPU never learns how many particles are alive. Rain drops are stretched along their velocity.
+
+layout (constant_id = 0) const bool MULTIVIEW = false;
+layout (constant_id = 1) const int EFFECT = 0; // 0 dust, 1 smoke, 2 rain (ParticleEffect)
+
+struct Particle {
+    vec4 positionLife; // xyz = world position, w = remaining life in seconds
+    vec4 velocitySize; // xyz = velocity, w = billboard size
+};
+
+// The pool the compute passes just wrote (their destination)
+layout (std430, set = 0, binding = 1) readonly buffer Pool {
+    Particle particles[];
+} pool;
+
+layout (set = 1, binding = 0) uniform UniformBufferObject {
+    mat4 model;
+    mat4 viewProj[4]; // MAX_VIEWS
+} ubo;
+
+layout (push_constant) uniform Params {
+    vec4 eye;   // xyz = camera position
+    uvec4 view; // x = view drawn into its viewport (without MULTIVIEW)
+} params;
+
+layout (location = 0) out vec2 fragCorner; // [-1, 1] across the billboard
+layout (location = 1) out float fragFade;
+
+const vec2 CORNERS[6] = vec2[6](vec2(-1.0, -1.0), vec2(1.0, -1.0), vec2(1.0, 1.0),
+                                vec2(-1.0, -1.0), vec2(1.0, 1.0), vec2(-1.0, 1.0));
+
+void main() {
+    Particle p = pool.particles[gl_InstanceIndex];
+    vec3 position = p.positionLife.xyz;
+    float size = p.velocitySize.w;
+    vec2 corner = CORNERS[gl_VertexIndex];
+
+    vec3 toEye = normalize(params.eye.xyz - position);
+    vec3 right;
+    vec3 up;
+    if (EFFECT == 2) {
+        // Streak: long axis along the motion, width facing the camera
+        vec3 velocity = p.velocitySize.xyz;
+        up = velocity * 0.02; // Length covered in ~1/50 s
+        right = normalize(cross(up, toEye)) * size;
+    } else {
+        right = normalize(cross(vec3(0.0, 1.0, 0.0), toEye)) * size;
+        up = cross(toEye, right);
+    }
+
+    mat4 viewProj = ubo.viewProj[MULTIVIEW ? gl_ViewIndex : params.view.x];
+    gl_Position = viewProj * vec4(position + corner.x * right + corner.y * up, 1.0);
+    fragCorner = corner;
+    fragFade = clamp(p.positionLife.w, 0.0, 1.0); // Fade out over the last second of life
+}
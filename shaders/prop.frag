@@ -0,0 +1,16 @@
+#version 450
+#extension GL_GOOGLE_include_directive : require
+
+// Prop meshes, lit by the same sun as the terrain.
+
+#include "terrain_shading.glsl"
+
+layout (location = 0) in vec3 fragNormal;
+layout (location = 1) in vec3 fragColor;
+
+layout (location = 0) out vec4 outColor;
+
+void main() {
+    float diffuse = max(dot(normalize(fragNormal), normalize(SUN_DIRECTION)), 0.0);
+    outColor = vec4(fragColor * (0.25 + 0.75 * diffuse), 1.0);
+}
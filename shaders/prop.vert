@@ -0,0 +1,27 @@
+#version 450
+#extension GL_EXT_multiview : require
+#extension GL_GOOGLE_include_directive : require
+
+// Full-detail prop meshes, instanced: per-vertex data in binding 0, PropInstance in binding 1.
+// Also renders the impostor atlas frames, with an identity instance and the frame camera.
+
+layout (constant_id = 0) const bool MULTIVIEW = false;
+
+#include "prop_common.glsl"
+
+layout (location = 0) in vec3 inPosition;
+layout (location = 1) in vec3 inNormal;
+layout (location = 2) in vec3 inColor;
+layout (location = 3) in vec4 inPositionScale; // xyz = base position, w = scale
+layout (location = 4) in vec4 inParams;        // x = yaw
+
+layout (location = 0) out vec3 fragNormal;
+layout (location = 1) out vec3 fragColor;
+
+void main() {
+    vec3 worldPos = inPositionScale.xyz + rotateYaw(inPosition * inPositionScale.w, inParams.x);
+    mat4 viewProj = MULTIVIEW ? ubo.viewProj[gl_ViewIndex] : params.viewProj;
+    gl_Position = viewProj * vec4(worldPos, 1.0);
+    fragNormal = rotateYaw(inNormal, inParams.x);
+    fragColor = inColor;
+}
@@ -0,0 +1,15 @@
+#version 450
+
+// Impostor atlas bake: unlit albedo and the object-space normal of one frame. Empty texels keep the
+// clear value of zero, so both targets are premultiplied by coverage and filter cleanly into mips.
+
+layout (location = 0) in vec3 fragNormal;
+layout (location = 1) in vec3 fragColor;
+
+layout (location = 0) out vec4 outAlbedo;
+layout (location = 1) out vec4 outNormal;
+
+void main() {
+    outAlbedo = vec4(fragColor, 1.0);
+    outNormal = vec4(normalize(fragNormal) * 0.5 + 0.5, 1.0);
+}
@@ -0,0 +1,34 @@
+// Declarations shared by the prop mesh and impostor shaders (see core/Props.h).
+
+layout (set = 1, binding = 0) uniform UniformBufferObject {
+    mat4 model;
+    mat4 viewProj[4]; // MAX_VIEWS
+} ubo;
+
+layout (push_constant) uniform Params {
+    mat4 viewProj;    // Without MULTIVIEW (the atlas bake passes its orthographic frame camera here)
+    vec4 eye;         // xyz = camera position, w = impostor frames per atlas row
+    vec4 bounds[2];   // Per PropType: xyz = local bounding sphere center, w = radius
+} params;
+
+// Rotation about the Y axis; props turn with their instance yaw
+vec3 rotateYaw(vec3 v, float yaw) {
+    float s = sin(yaw);
+    float c = cos(yaw);
+    return vec3(c * v.x + s * v.z, v.y, -s * v.x + c * v.z);
+}
+
+// Direction toward the camera of a hemi-octahedral atlas frame; matches Props::HemiOctahedralDirection
+vec3 hemiOctDirection(vec2 frame, float frames) {
+    vec2 grid = frame * (2.0 / (frames - 1.0)) - 1.0;
+    vec2 p = vec2(grid.x + grid.y, grid.x - grid.y) * 0.5;
+    return normalize(vec3(p.x, max(1.0 - abs(p.x) - abs(p.y), 0.0), p.y));
+}
+
+// Nearest atlas frame for a local direction toward the camera (below the horizon counts as on it)
+vec2 hemiOctFrame(vec3 direction, float frames) {
+    vec3 d = vec3(direction.x, max(direction.y, 0.0), direction.z);
+    d /= max(abs(d.x) + d.y + abs(d.z), 1e-6);
+    vec2 grid = vec2(d.x + d.z, d.x - d.z);
+    return clamp(round((grid * 0.5 + 0.5) * (frames - 1.0)), 0.0, frames - 1.0);
+}
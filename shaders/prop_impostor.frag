@@ -0,0 +1,29 @@
+#version 450
+#extension GL_GOOGLE_include_directive : require
+
+// Impostor quads: alpha-tested atlas albedo, lit with the baked normal turned by the instance yaw.
+
+#include "terrain_shading.glsl"
+
+layout (set = 0, binding = 0) uniform sampler2DArray atlas; // Albedo and normal layer per PropType
+
+layout (location = 0) in vec2 fragTexCoord;
+layout (location = 1) flat in uint fragLayer;
+layout (location = 2) flat in float fragYaw;
+
+layout (location = 0) out vec4 outColor;
+
+void main() {
+    vec4 albedo = texture(atlas, vec3(fragTexCoord, float(fragLayer)));
+    if (albedo.a < 0.5) discard;
+    vec4 packedNormal = texture(atlas, vec3(fragTexCoord, float(fragLayer + 1u)));
+    // Both layers are premultiplied by coverage
+    vec3 color = albedo.rgb / albedo.a;
+    vec3 localNormal = packedNormal.rgb / max(packedNormal.a, 1e-3) * 2.0 - 1.0;
+    float s = sin(fragYaw);
+    float c = cos(fragYaw);
+    vec3 normal = normalize(vec3(c * localNormal.x + s * localNormal.z, localNormal.y,
+                                 -s * localNormal.x + c * localNormal.z));
+    float diffuse = max(dot(normal, normalize(SUN_DIRECTION)), 0.0);
+    outColor = vec4(color * (0.25 + 0.75 * diffuse), 1.0);
+}
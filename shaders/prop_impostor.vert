@@ -0,0 +1,49 @@
+#version 450
+#extension GL_EXT_multiview : require
+#extension GL_GOOGLE_include_directive : require
+
+// Distant props as camera-facing quads, six vertices per PropInstance (binding 1). Each quad shows
+// the atlas frame baked from the direction closest to the camera, oriented like that frame's camera.
+
+layout (constant_id = 0) const bool MULTIVIEW = false;
+
+#include "prop_common.glsl"
+
+layout (location = 3) in vec4 inPositionScale; // xyz = base position, w = scale
+layout (location = 4) in vec4 inParams;        // x = yaw, y = PropType
+
+layout (location = 0) out vec2 fragTexCoord; // Within the atlas layer
+layout (location = 1) flat out uint fragLayer; // Albedo layer; the normals are in the next one
+layout (location = 2) flat out float fragYaw;
+
+const vec2 CORNERS[6] = vec2[6](vec2(-1.0, -1.0), vec2(1.0, -1.0), vec2(1.0, 1.0),
+                                vec2(-1.0, -1.0), vec2(1.0, 1.0), vec2(-1.0, 1.0));
+
+void main() {
+    uint type = uint(inParams.y);
+    float yaw = inParams.x;
+    float scale = inPositionScale.w;
+    float frames = params.eye.w;
+    vec3 center = inPositionScale.xyz + rotateYaw(params.bounds[type].xyz * scale, yaw);
+    float radius = params.bounds[type].w * scale;
+
+    // Frame selection happens in the prop's own space, where the atlas was baked
+    vec3 toEye = rotateYaw(normalize(params.eye.xyz - center), -yaw);
+    vec2 frame = hemiOctFrame(toEye, frames);
+    vec3 direction = hemiOctDirection(frame, frames);
+
+    // Basis of the bake camera (glm::lookAt toward the center, Y up unless looking straight down)
+    vec3 forward = -direction;
+    vec3 upHint = abs(direction.y) > 0.99 ? vec3(0.0, 0.0, 1.0) : vec3(0.0, 1.0, 0.0);
+    vec3 right = normalize(cross(forward, upHint));
+    vec3 up = cross(right, forward);
+
+    vec2 corner = CORNERS[gl_VertexIndex];
+    vec3 offset = rotateYaw(corner.x * right + corner.y * up, yaw) * radius;
+    mat4 viewProj = MULTIVIEW ? ubo.viewProj[gl_ViewIndex] : params.viewProj;
+    gl_Position = viewProj * vec4(center + offset, 1.0);
+    // The bake projection has no Y flip: texture rows run from -up to +up, like the corners
+    fragTexCoord = (frame + (corner * 0.5 + 0.5)) / frames;
+    fragLayer = type * 2u;
+    fragYaw = yaw;
+}
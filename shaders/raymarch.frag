@@ -0,0 +1,157 @@
+#version 450
+#extension GL_GOOGLE_include_directive : require
+
+// Far-field terrain by ray marching the heightfield, drawn on the full-screen triangle of
+// impostor.vert. Rays start at the far-field split, where the rasterized near terrain stops,
+// and walk a max-height mip pyramid: a ray that stays above a texel's maximum skips the whole
+// texel and climbs to a coarser level, otherwise it descends. At level 0 the ray is intersected
+// with the cell's two triangles (same diagonal as TerrainLoader), so silhouettes match the mesh.
+
+#include "terrain_shading.glsl"
+
+layout (set = 0, binding = 0) uniform sampler2D heights;      // Vertex heights (texelFetch only)
+layout (set = 0, binding = 1) uniform sampler2D heightBounds; // rg = min/max height per cell, mip pyramid
+
+layout (location = 0) in vec2 fragNdc;
+
+layout (location = 0) out vec4 outColor;
+// The hit is never nearer than the triangle, which keeps early depth testing valid
+layout (depth_greater) out float gl_FragDepth;
+
+layout (push_constant) uniform Params {
+    mat4 invViewProj;
+    vec4 eye;     // xyz = camera position, w = near plane
+    vec4 grid;    // xy = world xz of the first height sample, z = cell size, w = far plane
+    vec4 forward; // xyz = camera view direction, w = depth of the full-screen triangle
+    vec4 ray;     // x = start distance, y = max steps, z = top mip level, w = terrain height scale
+} params;
+
+float heightAt(ivec2 v) {
+    return texelFetch(heights, clamp(v, ivec2(0), textureSize(heights, 0) - 1), 0).r;
+}
+
+// Vertex normal, with the same central differences as TerrainLoader
+vec3 normalAt(ivec2 v) {
+    float hl = heightAt(v - ivec2(1, 0));
+    float hr = heightAt(v + ivec2(1, 0));
+    float hd = heightAt(v - ivec2(0, 1));
+    float hu = heightAt(v + ivec2(0, 1));
+    float s = params.grid.z;
+    return normalize(vec3(hl - hr, 2.0 * s, hd - hu));
+}
+
+// Height of triangle 0 (u + v <= 1) or 1 of a cell; h = corner heights (00, 10, 01, 11)
+float triangleHeight(vec2 uv, bool first, vec4 h) {
+    return first ? h.x + uv.x * (h.y - h.x) + uv.y * (h.z - h.x)
+                 : h.w + (1.0 - uv.x) * (h.z - h.w) + (1.0 - uv.y) * (h.y - h.w);
+}
+
+vec2 cellUv(vec3 p, ivec2 cell) {
+    return (p.xz - params.grid.xy) / params.grid.z - vec2(cell);
+}
+
+// First crossing of the ray segment [ta, tb] (inside the cell) through the cell's triangles
+bool intersectCell(ivec2 cell, vec3 o, vec3 d, float ta, float tb, out float tHit) {
+    vec4 h = vec4(heightAt(cell), heightAt(cell + ivec2(1, 0)), heightAt(cell + ivec2(0, 1)),
+                  heightAt(cell + ivec2(1, 1)));
+    // Split the segment where it crosses the diagonal; each piece lies over one plane
+    vec2 ua = cellUv(o + d * ta, cell);
+    vec2 ub = cellUv(o + d * tb, cell);
+    float sa = ua.x + ua.y - 1.0;
+    float sb = ub.x + ub.y - 1.0;
+    float tm = sa * sb < 0.0 ? mix(ta, tb, sa / (sa - sb)) : tb;
+    float bounds[3] = float[3](ta, tm, tb);
+    for (int i = 0; i < 2; ++i) {
+        float a = bounds[i];
+        float b = bounds[i + 1];
+        if (b <= a) continue;
+        vec2 mid = cellUv(o + d * (0.5 * (a + b)), cell);
+        bool first = mid.x + mid.y <= 1.0;
+        float ga = o.y + d.y * a - triangleHeight(cellUv(o + d * a, cell), first, h);
+        float gb = o.y + d.y * b - triangleHeight(cellUv(o + d * b, cell), first, h);
+        if (ga >= 0.0 && gb < 0.0) {
+            tHit = a + (b - a) * ga / (ga - gb);
+            return true;
+        }
+    }
+    return false;
+}
+
+void main() {
+    vec4 farPoint = params.invViewProj * vec4(fragNdc, 1.0, 1.0);
+    vec3 o = params.eye.xyz;
+    vec3 d = normalize(farPoint.xyz / farPoint.w - o);
+    // Avoid infinities in the slab and cell exit tests
+    d = mix(d, vec3(1e-6), lessThan(abs(d), vec3(1e-6)));
+    vec3 invD = 1.0 / d;
+
+    float cellSize = params.grid.z;
+    ivec2 cells = textureSize(heightBounds, 0);
+    vec3 boxMin = vec3(params.grid.x, -1.0, params.grid.y);
+    vec3 boxMax = vec3(params.grid.x + float(cells.x) * cellSize, params.ray.w,
+                       params.grid.y + float(cells.y) * cellSize);
+    vec3 t0 = (boxMin - o) * invD;
+    vec3 t1 = (boxMax - o) * invD;
+    vec3 tNear = min(t0, t1);
+    vec3 tFar = max(t0, t1);
+    float tExit = min(min(tFar.x, tFar.y), tFar.z);
+    float t = max(max(max(tNear.x, tNear.y), tNear.z), params.ray.x);
+    if (t >= tExit) discard;
+
+    int topLevel = int(params.ray.z);
+    int level = topLevel;
+    float nudge = 1e-3 * cellSize;
+    bool hit = false;
+    ivec2 hitCell = ivec2(0);
+    for (int step = 0; step < int(params.ray.y) && t < tExit; ++step) {
+        vec3 p = o + d * t;
+        ivec2 levelSize = textureSize(heightBounds, level);
+        int scale = 1 << level;
+        vec2 g = (p.xz - params.grid.xy) / cellSize;
+        ivec2 c = clamp(ivec2(floor(g / float(scale))), ivec2(0), levelSize - 1);
+        // Texel extent in cells; the last row and column also cover any remainder of odd sizes
+        vec2 lo = vec2(c * scale);
+        vec2 hi = mix(vec2((c + 1) * scale), vec2(cells), equal(c, levelSize - 1));
+        vec2 exitXz = mix(lo, hi, greaterThan(d.xz, vec2(0.0))) * cellSize + params.grid.xy;
+        vec2 tb = (exitXz - o.xz) * invD.xz;
+        float tLeave = min(min(tb.x, tb.y), tExit);
+
+        float maxHeight = texelFetch(heightBounds, c, level).g;
+        if (min(p.y, o.y + d.y * tLeave) > maxHeight) {
+            // Above everything in this texel: skip it and try a coarser level next
+            t = tLeave + nudge;
+            level = min(level + 1, topLevel);
+            continue;
+        }
+        if (level > 0) {
+            level--;
+            continue;
+        }
+        float tHit;
+        if (intersectCell(c, o, d, t, tLeave, tHit)) {
+            t = tHit;
+            hitCell = c;
+            hit = true;
+            break;
+        }
+        t = tLeave + nudge;
+    }
+    // Misses see the sky. A ray that starts below the surface may find a later hit, but the near
+    // geometry it passed through is in front and wins the depth test.
+    if (!hit) discard;
+
+    vec3 pos = o + d * t;
+    vec2 uv = clamp(cellUv(pos, hitCell), 0.0, 1.0);
+    vec3 normal = uv.x + uv.y <= 1.0
+        ? normalAt(hitCell) * (1.0 - uv.x - uv.y) + normalAt(hitCell + ivec2(1, 0)) * uv.x +
+          normalAt(hitCell + ivec2(0, 1)) * uv.y
+        : normalAt(hitCell + ivec2(1, 1)) * (uv.x + uv.y - 1.0) + normalAt(hitCell + ivec2(0, 1)) * (1.0 - uv.x) +
+          normalAt(hitCell + ivec2(1, 0)) * (1.0 - uv.y);
+
+    // Perspective depth (zero-to-one range) of the hit point's view-space distance
+    float n = params.eye.w;
+    float f = params.grid.w;
+    float viewZ = clamp(dot(pos - o, params.forward.xyz), n, f);
+    gl_FragDepth = max(f / (f - n) * (1.0 - n / viewZ), gl_FragCoord.z);
+    outColor = vec4(shadeTerrain(pos, normal, params.ray.w), 1.0);
+}
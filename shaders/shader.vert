@@ -1,4 +1,9 @@
 #version 450
+#extension GL_EXT_multiview : require
+
+// With MULTIVIEW the draw is broadcast to every view and gl_ViewIndex picks the matrix;
+// otherwise the view being drawn into its viewport comes from the push constant.
+layout (constant_id = 0) const bool MULTIVIEW = false;
 
 layout (location = 0) in vec3 inPosition;
 layout (location = 1) in vec3 inColor;
@@ -8,11 +13,15 @@ layout (location = 0) out vec3 fragColor;
 // Uniform Buffer Object bound at set 0, binding 0
 layout (set = 0, binding = 0) uniform UniformBufferObject {
     mat4 model;
-    mat4 view;
-    mat4 proj;
+    mat4 viewProj[4]; // MAX_VIEWS
 } ubo;
 
+layout (push_constant) uniform Params {
+    uint view;
+} params;
+
 void main() {
-    gl_Position = ubo.proj * ubo.view * ubo.model * vec4(inPosition, 1.0);
+    uint view = MULTIVIEW ? gl_ViewIndex : params.view;
+    gl_Position = ubo.viewProj[view] * ubo.model * vec4(inPosition, 1.0);
     fragColor = inColor; // Pass color through
-}
\ No newline at end of file
+}
@@ -0,0 +1,95 @@
+#version 450
+#extension GL_GOOGLE_include_directive : require
+
+// Terrain shading. With CLIP_RING only fragments whose distance from the eye lies inside
+// [ring.x, ring.y) survive: near terrain stops at the far-field split and the impostor faces
+// only contain what lies beyond it. The full-terrain permutation has no discard at all.
+// With PARALLAX, a tiling detail height texture adds relief within detail.x of the eye through
+// parallax occlusion mapping, so the mesh itself can stay coarse.
+
+#include "terrain_shading.glsl"
+
+layout (constant_id = 0) const bool CLIP_RING = false;
+layout (constant_id = 1) const bool PARALLAX = false;
+
+layout (set = 0, binding = 0) uniform sampler2D detailHeight;
+
+layout (location = 0) in vec3 fragWorldPos;
+layout (location = 1) in vec3 fragNormal;
+layout (location = 2) in vec2 fragTexCoord;
+
+layout (location = 0) out vec4 outColor;
+
+layout (push_constant) uniform Params {
+    mat4 viewProj;
+    vec4 eye;    // xyz = position the distance ring is measured from, w = terrain height scale
+    vec4 ring;   // x = min distance, y = max distance, z = 1 to write the distance into alpha
+    vec4 detail; // x = parallax radius, y = relief depth, z = detail tile size, w = max steps
+} params;
+
+// Marches the view ray through the detail height field (stored as height, 1 = top) in texture
+// space and returns the texture coordinate where it first dips below the surface. Derivatives
+// are passed in, since this runs in non-uniform control flow.
+vec2 parallaxOcclusion(vec2 uv, vec2 dx, vec2 dy, vec3 viewTs, float depth, int steps) {
+    float layerStep = 1.0 / float(steps);
+    // Offset per layer; clamped at grazing angles where the shift would run away
+    vec2 delta = viewTs.xy / max(viewTs.z, 0.2) * depth * layerStep;
+
+    vec2 current = uv;
+    float layerDepth = 0.0;
+    float surfaceDepth = 1.0 - textureGrad(detailHeight, current, dx, dy).r;
+    for (int i = 0; i < steps && layerDepth < surfaceDepth; ++i) {
+        current -= delta;
+        layerDepth += layerStep;
+        surfaceDepth = 1.0 - textureGrad(detailHeight, current, dx, dy).r;
+    }
+
+    // Linear refinement between the last two layers
+    vec2 previous = current + delta;
+    float after = surfaceDepth - layerDepth;
+    float before = 1.0 - textureGrad(detailHeight, previous, dx, dy).r - (layerDepth - layerStep);
+    float weight = after / min(after - before, -1e-5);
+    return mix(current, previous, clamp(weight, 0.0, 1.0));
+}
+
+void main() {
+    float dist = distance(fragWorldPos, params.eye.xyz);
+    if (CLIP_RING && (dist < params.ring.x || dist >= params.ring.y)) discard;
+
+    vec3 normal = normalize(fragNormal);
+    float occlusion = 1.0;
+    float tileSize = params.detail.z;
+    vec2 detailUv = fragWorldPos.xz / tileSize;
+    vec2 dx = PARALLAX ? dFdx(detailUv) : vec2(0.0);
+    vec2 dy = PARALLAX ? dFdy(detailUv) : vec2(0.0);
+    if (PARALLAX && dist < params.detail.x) {
+        // Tangent frame of the world-aligned detail coordinates (x and z), following the surface
+        vec3 tangent = normalize(vec3(1.0, 0.0, 0.0) - normal * normal.x);
+        vec3 bitangent = cross(tangent, normal);
+        vec3 view = (params.eye.xyz - fragWorldPos) / max(dist, 1e-4);
+        vec3 viewTs = vec3(dot(view, tangent), dot(view, bitangent), dot(view, normal));
+
+        // Relief fades out toward the radius; steps grow at grazing angles and shrink with distance
+        float fade = 1.0 - smoothstep(0.6 * params.detail.x, params.detail.x, dist);
+        float depth = params.detail.y * fade / tileSize;
+        int steps = int(clamp(mix(params.detail.w, 4.0, abs(viewTs.z)) * fade, 4.0, params.detail.w));
+        vec2 uv = parallaxOcclusion(detailUv, dx, dy, viewTs, depth, steps);
+
+        // Detail normal from the height slopes at the displaced coordinate (no depth write, which
+        // would disable early depth testing; the relief is too shallow to need it)
+        vec2 texel = 1.0 / vec2(textureSize(detailHeight, 0));
+        float hl = textureGrad(detailHeight, uv - vec2(texel.x, 0.0), dx, dy).r;
+        float hr = textureGrad(detailHeight, uv + vec2(texel.x, 0.0), dx, dy).r;
+        float hd = textureGrad(detailHeight, uv - vec2(0.0, texel.y), dx, dy).r;
+        float hu = textureGrad(detailHeight, uv + vec2(0.0, texel.y), dx, dy).r;
+        vec2 slope = vec2(hr - hl, hu - hd) * (params.detail.y * fade) / (2.0 * texel * tileSize);
+        vec3 detailNormal = normalize(vec3(-slope, 1.0));
+        normal = normalize(tangent * detailNormal.x + bitangent * detailNormal.y + normal * detailNormal.z);
+        occlusion = mix(1.0, 0.7 + 0.3 * textureGrad(detailHeight, uv, dx, dy).r, fade);
+    }
+
+    vec3 color = shadeTerrain(fragWorldPos, normal, params.eye.w) * occlusion;
+
+    // Impostor faces keep the distance for depth reconstruction; alpha is unused otherwise
+    outColor = vec4(color, params.ring.z > 0.5 ? dist : 1.0);
+}
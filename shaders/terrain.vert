@@ -0,0 +1,35 @@
+#version 450
+#extension GL_EXT_multiview : require
+
+// Heightmap terrain. Matrices come from push constants so the same pipeline layout serves the
+// main camera and the six faces of the far-field impostor. With MULTIVIEW the scene pass is
+// broadcast to every view, and each view's matrix is read from the per-frame UBO instead.
+
+layout (constant_id = 2) const bool MULTIVIEW = false;
+
+layout (location = 0) in vec3 inPosition;
+layout (location = 1) in vec3 inNormal;
+layout (location = 2) in vec2 inTexCoord;
+
+layout (location = 0) out vec3 fragWorldPos;
+layout (location = 1) out vec3 fragNormal;
+layout (location = 2) out vec2 fragTexCoord;
+
+layout (set = 1, binding = 0) uniform UniformBufferObject {
+    mat4 model;
+    mat4 viewProj[4]; // MAX_VIEWS
+} ubo;
+
+layout (push_constant) uniform Params {
+    mat4 viewProj;
+    vec4 eye;  // xyz = position the distance ring is measured from, w = terrain height scale
+    vec4 ring; // x = min distance, y = max distance, z = 1 to write the distance into alpha
+} params;
+
+void main() {
+    mat4 viewProj = MULTIVIEW ? ubo.viewProj[gl_ViewIndex] : params.viewProj;
+    gl_Position = viewProj * vec4(inPosition, 1.0);
+    fragWorldPos = inPosition;
+    fragNormal = inNormal;
+    fragTexCoord = inTexCoord;
+}
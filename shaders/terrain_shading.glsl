@@ -0,0 +1,16 @@
+// Terrain surface color shared by the rasterized terrain and the ray-marched far field, so both
+// paths match where they meet at the far-field split.
+
+const vec3 SUN_DIRECTION = vec3(0.42, 0.82, 0.38);
+
+// Grass on flat ground, rock on slopes, lighter toward the peaks
+vec3 shadeTerrain(vec3 worldPos, vec3 normal, float heightScale) {
+    vec3 n = normalize(normal);
+    float slope = 1.0 - n.y;
+    float height = clamp(worldPos.y / max(heightScale, 1e-3), 0.0, 1.0);
+    vec3 color = mix(vec3(0.20, 0.34, 0.14), vec3(0.40, 0.37, 0.33), smoothstep(0.05, 0.25, slope));
+    color = mix(color, vec3(0.75, 0.74, 0.72), smoothstep(0.7, 1.0, height) * (1.0 - slope));
+
+    float diffuse = max(dot(n, normalize(SUN_DIRECTION)), 0.0);
+    return color * (0.25 + 0.75 * diffuse);
+}